@@ -7,6 +7,12 @@
 #include "interfaces/splittable.h"
 #include "cellml/02_callback_handler.h"
 
+namespace Control
+{
+// forward declaration
+template<typename TimeSteppingScheme> class BatchedCellmlInstances;
+}
+
 /** This is a class that contains cellml equations and can be used with a time stepping scheme.
  *  The nStates template parameter specifies the number of state variables that should be used with the integrator.
  *  It is necessary that this value is fixed at compile time because the timestepping scheme needs to know which field variable types it has to construct.
@@ -75,6 +81,9 @@ public:
   //! the FastMonodomainSolver accesses the internals of CellmlAdapter
   template<int a, int b, typename c> friend class FastMonodomainSolverBase;
 
+  //! the MultipleInstances class computes the instances of multiple CellmlAdapters at once, if option "batchedCellmlInstances" is set
+  template<typename T> friend class Control::BatchedCellmlInstances;
+
 protected:
 
   //! check if the callback function "setSpecificParameters" needs to be called and if so, execute the call
@@ -363,6 +363,21 @@ const int CellmlSourceCodeGeneratorBase::nParameters() const
   return nParameters_;
 }
 
+const std::vector<int> &CellmlSourceCodeGeneratorBase::parametersUsedAsAlgebraic() const
+{
+  return parametersUsedAsAlgebraic_;
+}
+
+const std::vector<int> &CellmlSourceCodeGeneratorBase::parametersUsedAsConstant() const
+{
+  return parametersUsedAsConstant_;
+}
+
+void CellmlSourceCodeGeneratorBase::setNInstances(int nInstances)
+{
+  nInstances_ = nInstances;
+}
+
 const std::string CellmlSourceCodeGeneratorBase::sourceFilename() const
 {
   return sourceFilename_;
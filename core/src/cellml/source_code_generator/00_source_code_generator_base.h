@@ -48,6 +48,15 @@ public:
   //! get the number of parameters
   const int nParameters() const;
 
+  //! get the indices of the algebraics that are replaced by parameters
+  const std::vector<int> &parametersUsedAsAlgebraic() const;
+
+  //! get the indices of the constants that are replaced by parameters
+  const std::vector<int> &parametersUsedAsConstant() const;
+
+  //! set the number of instances for which the source code will be generated, e.g. to compute the instances of multiple CellmlAdapters at once
+  void setNInstances(int nInstances);
+
   //! get the source filename of the initial file (which is inputFilename in initialize)
   const std::string sourceFilename() const;
 
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <vector>
+#include <string>
+
+#include "time_stepping_scheme/heun.h"
+#include "cellml/03_cellml_adapter.h"
+
+namespace Control
+{
+
+/** Helper class of MultipleInstances that computes all local instances together, option "batchedCellmlInstances".
+ *  In general, this is not possible and the instances are computed one after another. This class is specialized
+ *  for the types for which batched computation is implemented.
+ */
+template<typename TimeSteppingScheme>
+class BatchedCellmlInstances
+{
+public:
+
+  //! constructor
+  BatchedCellmlInstances(std::vector<TimeSteppingScheme> &instances);
+
+  //! check if the instances can be computed together, @return false because this is not implemented for the TimeSteppingScheme
+  bool initialize();
+
+  //! advance all instances by their time span, @return false because nothing was computed
+  bool advanceTimeSpan(bool withOutputWritersEnabled);
+};
+
+/** Batched computation of Heun<CellmlAdapter> instances, e.g. of the subcellular models of multiple fibers.
+ *  Normally, every instance calls the rhs routine of its CellmlAdapter with the few nodes of its own fiber.
+ *  Here, the states and parameters of all local instances are concatenated to one large vector in struct-of-array memory layout,
+ *  (state0 of all instances of all CellmlAdapters, state1 of all instances, ...). A rhs library is compiled for the total number of instances,
+ *  such that the rhs routine is called only once per rhs evaluation for all instances.
+ *
+ *  The states are gathered at the beginning of advanceTimeSpan and scattered back to the field variables of the instances at the end.
+ *  All time steps in between are computed only on the batched vectors.
+ *  All CellmlAdapters have to use the same CellML model and the same mappings, which is the case if they have been created from the same settings.
+ *  The callbacks "setSpecificStates" and "setSpecificParameters" are supported, "handleResult", output writers of the CellmlAdapter
+ *  and Dirichlet boundary conditions are not. In these cases, the instances are computed one after another as usual.
+ */
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+class BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>
+{
+public:
+  typedef CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType> CellmlAdapterType;
+  typedef ::TimeSteppingScheme::Heun<CellmlAdapterType> TimeSteppingSchemeType;
+
+  //! constructor
+  BatchedCellmlInstances(std::vector<TimeSteppingSchemeType> &instances);
+
+  //! check if the instances can be computed together and create the rhs library for all instances, has to be called after the instances are initialized
+  //! @return if the instances can be computed batched
+  bool initialize();
+
+  //! advance all instances by their time span, @return false if the instances can currently not be computed together, then nothing was computed
+  bool advanceTimeSpan(bool withOutputWritersEnabled);
+
+protected:
+
+  //! check if the instances fulfill the requirements for batched computation, @param reason is set to the reason if not
+  bool instancesAreCompatible(std::string &reason);
+
+  //! create the source file for all instances, compile and load the library
+  bool initializeRhsRoutine();
+
+  //! copy the states and parameters of all instances to the batched vectors
+  void gatherValues();
+
+  //! copy the states and algebraics from the batched vectors back to the field variables of the instances
+  void scatterValues();
+
+  //! call the callback functions "setSpecificParameters" and "setSpecificStates" of the CellmlAdapters and the rhs routine for all instances
+  void evaluateRightHandSide(double currentTime, std::vector<double> &rates);
+
+  std::vector<TimeSteppingSchemeType> &instances_;       //< the local instances of the MultipleInstances object
+  std::vector<int> nInstancesAdapter_;                   //< the number of instances (nodes) of every CellmlAdapter
+  std::vector<int> instancesOffset_;                     //< the index of the first instance of every CellmlAdapter in the batched vectors
+  int nInstancesTotal_;                                  //< the total number of instances of all CellmlAdapters, i.e. the size of one state in the batched vectors
+  int nParameters_;                                      //< number of parameters of the CellML model
+  bool checkForNanInf_;                                  //< if the solution should be checked for nan and inf values, as the option of the Heun scheme
+
+  std::vector<double> states_;                           //< states of all instances, struct-of-array memory layout
+  std::vector<double> increment_;                        //< rates of the first rhs evaluation of the Heun scheme
+  std::vector<double> algebraicIncrement_;               //< rates of the second rhs evaluation of the Heun scheme
+  std::vector<double> algebraics_;                       //< algebraics of all instances
+  std::vector<double> parameters_;                       //< parameters of all instances
+  std::vector<double> statesAdapter_;                    //< buffer for the states of a single CellmlAdapter for the "setSpecificStates" callback
+
+  void (*rhsRoutine_)(void *context, double t, double *states, double *rates, double *algebraics, double *parameters);   //< the rhs routine of the library for nInstancesTotal_ instances
+};
+
+}  // namespace
+
+#include "control/batched_cellml_instances.tpp"
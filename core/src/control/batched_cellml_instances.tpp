@@ -0,0 +1,440 @@
+#include "control/batched_cellml_instances.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <sys/stat.h>  // stat() to check if file exists
+#include <dlfcn.h>
+
+#include "utility/petsc_utility.h"
+#include "utility/string_utility.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+
+namespace Control
+{
+
+template<typename TimeSteppingScheme>
+BatchedCellmlInstances<TimeSteppingScheme>::
+BatchedCellmlInstances(std::vector<TimeSteppingScheme> &instances)
+{
+}
+
+template<typename TimeSteppingScheme>
+bool BatchedCellmlInstances<TimeSteppingScheme>::
+initialize()
+{
+  LOG(WARNING) << "MultipleInstances: Option \"batchedCellmlInstances\" is only implemented for Heun<CellmlAdapter> instances. "
+    << "The instances are computed one after another.";
+  return false;
+}
+
+template<typename TimeSteppingScheme>
+bool BatchedCellmlInstances<TimeSteppingScheme>::
+advanceTimeSpan(bool withOutputWritersEnabled)
+{
+  return false;
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+BatchedCellmlInstances(std::vector<TimeSteppingSchemeType> &instances) :
+  instances_(instances), nInstancesTotal_(0), nParameters_(0), checkForNanInf_(false), rhsRoutine_(nullptr)
+{
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+bool BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+initialize()
+{
+  LOG_SCOPE_FUNCTION;
+
+  std::string reason;
+  if (!instancesAreCompatible(reason))
+  {
+    LOG(WARNING) << "MultipleInstances: The instances cannot be computed batched (option \"batchedCellmlInstances\") because " << reason << ". "
+      << "The instances are computed one after another.";
+    return false;
+  }
+
+  // determine the offsets of the instances of all CellmlAdapters in the batched vectors
+  const int nAdapters = instances_.size();
+  nInstancesAdapter_.resize(nAdapters);
+  instancesOffset_.resize(nAdapters);
+  nInstancesTotal_ = 0;
+
+  for (int adapterNo = 0; adapterNo < nAdapters; adapterNo++)
+  {
+    nInstancesAdapter_[adapterNo] = instances_[adapterNo].discretizableInTime().nInstances_;
+    instancesOffset_[adapterNo] = nInstancesTotal_;
+    nInstancesTotal_ += nInstancesAdapter_[adapterNo];
+  }
+
+  CellmlAdapterType &cellmlAdapter = instances_[0].discretizableInTime();
+  nParameters_ = cellmlAdapter.cellmlSourceCodeGenerator().nParameters();
+  checkForNanInf_ = instances_[0].specificSettings().getOptionBool("checkForNanInf", false);
+
+  if (!initializeRhsRoutine())
+    return false;
+
+  // allocate the batched vectors
+  states_.resize(nStates*nInstancesTotal_);
+  increment_.resize(nStates*nInstancesTotal_);
+  algebraicIncrement_.resize(nStates*nInstancesTotal_);
+  algebraics_.resize(nAlgebraics*nInstancesTotal_);
+  parameters_.resize(std::max(1,nParameters_)*nInstancesTotal_);
+
+  LOG(INFO) << "MultipleInstances: compute " << nAdapters << " instances batched with " << nInstancesTotal_ << " CellML instances in total.";
+  return true;
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+bool BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+instancesAreCompatible(std::string &reason)
+{
+  if (instances_.size() < 2)
+  {
+    reason = "there are less than two local instances";
+    return false;
+  }
+
+  CellmlAdapterType &cellmlAdapter0 = instances_[0].discretizableInTime();
+
+  for (int adapterNo = 0; adapterNo < instances_.size(); adapterNo++)
+  {
+    TimeSteppingSchemeType &instance = instances_[adapterNo];
+    CellmlAdapterType &cellmlAdapter = instance.discretizableInTime();
+
+    std::stringstream s;
+    s << "instance " << adapterNo;
+
+    if (cellmlAdapter.specificSettings().hasKey("libraryFilename"))
+    {
+      reason = s.str() + " uses a given library (option \"libraryFilename\") instead of generating the code";
+      return false;
+    }
+    if (cellmlAdapter.cellmlSourceCodeGenerator().sourceFilename() != cellmlAdapter0.cellmlSourceCodeGenerator().sourceFilename()
+      || cellmlAdapter.cellmlSourceCodeGenerator().nParameters() != cellmlAdapter0.cellmlSourceCodeGenerator().nParameters()
+      || cellmlAdapter.optimizationType_ != cellmlAdapter0.optimizationType_)
+    {
+      reason = s.str() + " uses a different CellML model or optimizationType than instance 0";
+      return false;
+    }
+    if (cellmlAdapter.pythonHandleResultFunction_)
+    {
+      reason = s.str() + " has a \"handleResult\" callback";
+      return false;
+    }
+    if (cellmlAdapter.outputWriterManager_.hasOutputWriters())
+    {
+      reason = s.str() + " has output writers in the CellmlAdapter";
+      return false;
+    }
+    if (instance.dirichletBoundaryConditions() && !instance.dirichletBoundaryConditions()->boundaryConditionNonGhostDofLocalNos().empty())
+    {
+      reason = s.str() + " has Dirichlet boundary conditions";
+      return false;
+    }
+  }
+  return true;
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+bool BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+initializeRhsRoutine()
+{
+  CellmlAdapterType &cellmlAdapter = instances_[0].discretizableInTime();
+  PythonConfig specificSettingsCellML = cellmlAdapter.specificSettings();
+
+  // generate the code for all instances from the source code generator of the first CellmlAdapter
+  CellmlSourceCodeGenerator cellmlSourceCodeGenerator = cellmlAdapter.cellmlSourceCodeGenerator();
+  cellmlSourceCodeGenerator.setNInstances(nInstancesTotal_);
+
+  std::string optimizationType = cellmlAdapter.optimizationType_;
+
+  // the generated vc code stores all states, rates, algebraics and parameters on the stack
+  if (optimizationType == "vc")
+  {
+    long int stackSize = long(2*nStates + 2*nAlgebraics) * nInstancesTotal_ * sizeof(double);
+    if (stackSize > 4*1024*1024)
+    {
+      LOG(WARNING) << "MultipleInstances: The batched rhs routine for " << nInstancesTotal_ << " instances with optimizationType \"vc\" "
+        << "needs " << stackSize/1024/1024 << " MB on the stack. Consider to use optimizationType \"openmp\" or \"simd\".";
+    }
+  }
+
+  // determine file names of the source file and the library, the name contains everything the generated code depends on,
+  // such that a library of a different configuration is not reused, in the same way as in RhsRoutineHandler::initializeRhsRoutine
+  std::stringstream baseFilename;
+  baseFilename << StringUtility::extractBasename(cellmlSourceCodeGenerator.sourceFilename())
+    << "_" << nParameters_ << "_";
+
+  auto appendIndices = [&baseFilename](const std::vector<int> &indices)
+  {
+    for (int i = 0; i < indices.size(); i++)
+      baseFilename << (i == 0? "" : "-") << indices[i];
+    baseFilename << "_";
+  };
+  appendIndices(cellmlSourceCodeGenerator.parametersUsedAsAlgebraic());
+  appendIndices(cellmlSourceCodeGenerator.parametersUsedAsConstant());
+  appendIndices(cellmlAdapter.data_.statesForTransfer());
+  appendIndices(cellmlAdapter.data_.algebraicsForTransfer());
+  appendIndices(cellmlAdapter.data_.parametersForTransfer());
+
+  baseFilename << optimizationType << "_batched_" << nInstancesTotal_;
+
+  std::string libraryFilename = std::string("lib/") + baseFilename.str() + ".so";
+
+  int rankNoWorldCommunicator = DihuContext::ownRankNoCommWorld();
+  std::stringstream s;
+  s << "src/" << baseFilename.str() << "." << rankNoWorldCommunicator << cellmlSourceCodeGenerator.sourceFileSuffix();
+  std::string sourceToCompileFilename = s.str();
+
+  // The number of batched instances depends on the rank, therefore every rank compiles its own library if it does not yet exist.
+  // The library is compiled to a file with suffix ".<rankNo>" and then renamed, such that other ranks never load an incomplete library.
+  struct stat buffer;
+  if (stat(libraryFilename.c_str(), &buffer) == 0)
+  {
+    LOG(DEBUG) << "Library \"" << libraryFilename << "\" already exists.";
+  }
+  else
+  {
+    int ret = system("mkdir -p lib src");
+    if (ret != 0)
+    {
+      LOG(ERROR) << "Could not create paths \"lib\" and \"src\".";
+    }
+
+    cellmlSourceCodeGenerator.generateSourceFile(sourceToCompileFilename, optimizationType, cellmlAdapter.approximateExponentialFunction_,
+                                                 cellmlAdapter.maximumNumberOfThreads_, cellmlAdapter.useAoVSMemoryLayout_);
+
+    std::string compilerFlags = specificSettingsCellML.getOptionString("compilerFlags", "-O3 -march=native -fPIC -finstrument-functions -ftree-vectorize -fopt-info-vec-optimized=vectorizer_optimized.log -shared ");
+
+    std::stringstream compileCommand;
+    compileCommand << cellmlSourceCodeGenerator.compilerCommand() << " " << sourceToCompileFilename << " "
+      << compilerFlags << " " << cellmlSourceCodeGenerator.additionalCompileFlags() << " "
+      << " -o " << libraryFilename << "." << rankNoWorldCommunicator
+      << " && mv " << libraryFilename << "." << rankNoWorldCommunicator << " " << libraryFilename;
+
+    ret = system(compileCommand.str().c_str());
+    if (ret != 0)
+    {
+      LOG(ERROR) << "Compilation failed. Command: \"" << compileCommand.str() << "\".";
+      return false;
+    }
+    LOG(DEBUG) << "Compilation successful. Command: \"" << compileCommand.str() << "\".";
+  }
+
+  // load the rhs routine from the library
+  void *handle = CellmlAdapterType::loadRhsLibraryGetHandle(libraryFilename);
+  if (handle)
+  {
+    rhsRoutine_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeCellMLRightHandSide");
+    if (!rhsRoutine_)
+      rhsRoutine_ = (void (*)(void *,double,double*,double*,double*,double*)) dlsym(handle, "computeGPUCellMLRightHandSide");
+  }
+
+  if (!rhsRoutine_)
+  {
+    LOG(ERROR) << "Could not load rhs routine from library \"" << libraryFilename << "\".";
+    return false;
+  }
+  return true;
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+void BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+gatherValues()
+{
+  PetscErrorCode ierr;
+  for (int adapterNo = 0; adapterNo < instances_.size(); adapterNo++)
+  {
+    const int nInstances = nInstancesAdapter_[adapterNo];
+    const int offset = instancesOffset_[adapterNo];
+    CellmlAdapterType &cellmlAdapter = instances_[adapterNo].discretizableInTime();
+
+    // copy states, both vectors are in struct-of-array memory layout
+    const double *statesLocal;
+    Vec &solution = instances_[adapterNo].data().solution()->getValuesContiguous();
+    ierr = VecGetArrayRead(solution, &statesLocal); CHKERRV(ierr);
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
+    {
+      std::copy(statesLocal + stateNo*nInstances, statesLocal + (stateNo+1)*nInstances, states_.begin() + stateNo*nInstancesTotal_ + offset);
+    }
+    ierr = VecRestoreArrayRead(solution, &statesLocal); CHKERRV(ierr);
+
+    // copy parameters, they can have been changed by the slot connector data transfer, the parameter values stay prepared until scatterValues
+    cellmlAdapter.data_.prepareParameterValues();
+    const double *parameterValues = cellmlAdapter.data_.parameterValues();
+    for (int parameterNo = 0; parameterNo < nParameters_; parameterNo++)
+    {
+      std::copy(parameterValues + parameterNo*nInstances, parameterValues + (parameterNo+1)*nInstances, parameters_.begin() + parameterNo*nInstancesTotal_ + offset);
+    }
+  }
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+void BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+scatterValues()
+{
+  PetscErrorCode ierr;
+  for (int adapterNo = 0; adapterNo < instances_.size(); adapterNo++)
+  {
+    const int nInstances = nInstancesAdapter_[adapterNo];
+    const int offset = instancesOffset_[adapterNo];
+    CellmlAdapterType &cellmlAdapter = instances_[adapterNo].discretizableInTime();
+
+    // copy states
+    double *statesLocal;
+    Vec &solution = instances_[adapterNo].data().solution()->getValuesContiguous();
+    ierr = VecGetArray(solution, &statesLocal); CHKERRV(ierr);
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
+    {
+      std::copy(states_.begin() + stateNo*nInstancesTotal_ + offset, states_.begin() + stateNo*nInstancesTotal_ + offset + nInstances, statesLocal + stateNo*nInstances);
+    }
+    ierr = VecRestoreArray(solution, &statesLocal); CHKERRV(ierr);
+
+    // copy algebraics
+    double *algebraicsLocal;
+    Vec &algebraics = cellmlAdapter.data_.algebraics()->getValuesContiguous();
+    ierr = VecGetArray(algebraics, &algebraicsLocal); CHKERRV(ierr);
+    for (int algebraicNo = 0; algebraicNo < nAlgebraics; algebraicNo++)
+    {
+      std::copy(algebraics_.begin() + algebraicNo*nInstancesTotal_ + offset, algebraics_.begin() + algebraicNo*nInstancesTotal_ + offset + nInstances, algebraicsLocal + algebraicNo*nInstances);
+    }
+    ierr = VecRestoreArray(algebraics, &algebraicsLocal); CHKERRV(ierr);
+
+    cellmlAdapter.data_.restoreParameterValues();
+  }
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+void BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+evaluateRightHandSide(double currentTime, std::vector<double> &rates)
+{
+  // handle callback functions "setSpecificParameters" and "setSpecificStates", they operate on the values of a single CellmlAdapter
+  for (int adapterNo = 0; adapterNo < instances_.size(); adapterNo++)
+  {
+    CellmlAdapterType &cellmlAdapter = instances_[adapterNo].discretizableInTime();
+    const int nInstances = nInstancesAdapter_[adapterNo];
+    const int offset = instancesOffset_[adapterNo];
+
+    if (cellmlAdapter.pythonSetSpecificParametersFunction_)
+    {
+      cellmlAdapter.checkCallbackParameters(currentTime);
+
+      const double *parameterValues = cellmlAdapter.data_.parameterValues();
+      for (int parameterNo = 0; parameterNo < nParameters_; parameterNo++)
+      {
+        std::copy(parameterValues + parameterNo*nInstances, parameterValues + (parameterNo+1)*nInstances, parameters_.begin() + parameterNo*nInstancesTotal_ + offset);
+      }
+    }
+
+    if (cellmlAdapter.pythonSetSpecificStatesFunction_)
+    {
+      statesAdapter_.resize(nStates*nInstances);
+      for (int stateNo = 0; stateNo < nStates; stateNo++)
+      {
+        std::copy(states_.begin() + stateNo*nInstancesTotal_ + offset, states_.begin() + stateNo*nInstancesTotal_ + offset + nInstances, statesAdapter_.begin() + stateNo*nInstances);
+      }
+
+      cellmlAdapter.checkCallbackStates(currentTime, statesAdapter_.data());
+
+      for (int stateNo = 0; stateNo < nStates; stateNo++)
+      {
+        std::copy(statesAdapter_.begin() + stateNo*nInstances, statesAdapter_.begin() + (stateNo+1)*nInstances, states_.begin() + stateNo*nInstancesTotal_ + offset);
+      }
+    }
+
+    // the counter is used for the call intervals of the callbacks
+    cellmlAdapter.internalTimeStepNo_++;
+  }
+
+  // compute the rhs of all instances at once
+  rhsRoutine_(nullptr, currentTime, states_.data(), rates.data(), algebraics_.data(), parameters_.data());
+}
+
+template<int nStates, int nAlgebraics, typename FunctionSpaceType>
+bool BatchedCellmlInstances<::TimeSteppingScheme::Heun<CellmlAdapter<nStates,nAlgebraics,FunctionSpaceType>>>::
+advanceTimeSpan(bool withOutputWritersEnabled)
+{
+  if (!rhsRoutine_ || instances_.size() != nInstancesAdapter_.size())
+    return false;
+
+  // all instances have to advance over the same time span and must not write output in between
+  TimeSteppingSchemeType &instance0 = instances_[0];
+  for (int adapterNo = 0; adapterNo < instances_.size(); adapterNo++)
+  {
+    TimeSteppingSchemeType &instance = instances_[adapterNo];
+    if (instance.startTime() != instance0.startTime() || instance.endTime() != instance0.endTime()
+      || instance.numberTimeSteps() != instance0.numberTimeSteps()
+      || instance.discretizableInTime().nInstances_ != nInstancesAdapter_[adapterNo]
+      || (withOutputWritersEnabled && instance.outputWriterManager().hasOutputWriters()))
+    {
+      LOG(DEBUG) << "BatchedCellmlInstances: instance " << adapterNo << " cannot be computed batched, compute instances one after another.";
+      return false;
+    }
+  }
+
+  std::string durationLogKey = instance0.durationLogKey();
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::start(durationLogKey);
+
+  const double startTime = instance0.startTime();
+  const double timeSpan = instance0.endTime() - startTime;
+  const double timeStepWidth = instance0.timeStepWidth();
+  const int numberTimeSteps = instance0.numberTimeSteps();
+  const int timeStepOutputInterval = instance0.timeStepOutputInterval();
+  const int nValues = nStates*nInstancesTotal_;
+
+  gatherValues();
+
+  // loop over time steps, this is the same as in Heun::advanceTimeSpan
+  double currentTime = startTime;
+  for (int timeStepNo = 0; timeStepNo < numberTimeSteps;)
+  {
+    if (timeStepNo % timeStepOutputInterval == 0 && (timeStepOutputInterval <= 10 || timeStepNo > 0))
+    {
+      LOG(INFO) << "Heun (batched), timestep " << timeStepNo << "/" << numberTimeSteps << ", t=" << currentTime;
+    }
+
+    // compute delta_u = f(u_{t}) and u* = u_{t} + dt*delta_u
+    evaluateRightHandSide(currentTime, increment_);
+
+    for (int i = 0; i < nValues; i++)
+      states_[i] += timeStepWidth*increment_[i];
+
+    // compute delta_u* = f(u*) and u_{t+1} = u* + dt*0.5*(delta_u* - delta_u)
+    evaluateRightHandSide(currentTime + timeStepWidth, algebraicIncrement_);
+
+    for (int i = 0; i < nValues; i++)
+      states_[i] += 0.5*timeStepWidth*(algebraicIncrement_[i] - increment_[i]);
+
+    // check if the solution contains Nans or Inf values, only every 10th time step
+    if (checkForNanInf_ && timeStepNo % 10 == 0)
+    {
+      for (int i = 0; i < nValues; i++)
+      {
+        if (!std::isfinite(states_[i]))
+        {
+          LOG(ERROR) << "In Heun (batched), timestep " << timeStepNo << "/" << numberTimeSteps << ", t=" << currentTime << ": Solution contains Nan or Inf "
+            << "at state " << i / nInstancesTotal_ << " of instance " << i % nInstancesTotal_ << ". "
+            << "This probably means that the timestep width, " << timeStepWidth << ", is too high.";
+          LOG(FATAL) << "Abort because of nan or inf in solution. Set option \"checkForNanInf\": False to avoid this.";
+        }
+      }
+    }
+
+    // advance simulation time
+    timeStepNo++;
+    currentTime = startTime + double(timeStepNo) / numberTimeSteps * timeSpan;
+  }
+
+  scatterValues();
+
+  if (durationLogKey != "")
+    Control::PerformanceMeasurement::stop(durationLogKey);
+
+  return true;
+}
+
+}  // namespace
@@ -24,6 +24,7 @@
 #include "output_writer/python_callback/python_callback.h"
 #include "output_writer/python_file/python_file.h"
 #include "output_writer/exfile/exfile.h"
+#include "output_writer/asynchronous_file_writer.h"
 #include "mesh/mesh_manager/mesh_manager.h"
 #include "mesh/mapping_between_meshes/manager/04_manager.h"
 #include "solver/solver_manager.h"
@@ -586,6 +587,10 @@ DihuContext::~DihuContext()
   VLOG(1) << "~DihuContext, nObjects = " << nObjects_;
   if (nObjects_ == 0)
   {
+    // wait until all output files that are written asynchronously are on disk
+    OutputWriter::AsynchronousFileWriter::instance().flush();
+    Control::PerformanceMeasurement::setParameter("nBlockingAsynchronousOutputCalls", OutputWriter::AsynchronousFileWriter::instance().nBlockingCalls());
+
     // write log files
     writeSolverStructureDiagram();
     Control::StimulationLogging::writeLogFile();
@@ -2,6 +2,7 @@
 
 #include <omp.h>
 #include <sstream>
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace Control
 {
@@ -71,6 +72,9 @@ run()
   initialize();
 
   advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename TimeStepping>
@@ -1,6 +1,7 @@
 #include "control/map_dofs/map_dofs.h"
 
 #include "utility/python_capture_stderr.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace Control
 {
@@ -37,6 +38,9 @@ run()
 
   // advance one timestep
   advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 //! reset state of this object, such that a new initialize() is necessary ("uninitialize")
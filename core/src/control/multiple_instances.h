@@ -8,6 +8,7 @@
 #include "interfaces/runnable.h"
 #include "interfaces/multipliable.h"
 #include "control/dihu_context.h"
+#include "control/batched_cellml_instances.h"
 #include "data_management/control/multiple_instances.h"
 #include "output_writer/manager.h"
 #include "partition/mesh_partition/02_mesh_partition.h"
@@ -98,6 +99,8 @@ protected:
   std::string logKey_;                          //< the key under which the duration of all instances together is saved in the log
 
   bool outputInitializeThisInstance_;           //< if this instance displays progress of initialization
+  bool batchedCellmlInstances_;                 //< if all local instances should be computed together with one call to the CellML rhs routine, option "batchedCellmlInstances"
+  std::shared_ptr<BatchedCellmlInstances<TimeSteppingScheme>> batchedInstances_;   //< the helper object that computes the instances batched, nullptr if they are computed one after another
 };
 
 extern bool outputInitialize_;                  //< if the message about initialization was already printed
@@ -41,6 +41,9 @@ MultipleInstances(DihuContext context) :
   }
 
   outputWriterManager_.initialize(context_, specificSettings_);
+
+  // parse if the instances should be computed batched
+  batchedCellmlInstances_ = specificSettings_.getOptionBool("batchedCellmlInstances", false);
   
   //LOG(DEBUG) << "MultipleInstances constructor, settings: ";
   //PythonUtility::printDict(specificSettings_.pyObject());
@@ -245,10 +248,20 @@ advanceTimeSpan(bool withOutputWritersEnabled)
   if (this->logKey_ != "")
     Control::PerformanceMeasurement::start(this->logKey_);
 
+  // compute all instances at once, if enabled and possible
+  bool computedBatched = false;
+  if (batchedInstances_)
+  {
+    computedBatched = batchedInstances_->advanceTimeSpan(withOutputWritersEnabled);
+  }
+
   // This method advances the simulation by the specified time span. It will be needed when this MultipleInstances object is part of a parent control element, like a coupling to 3D model.
-  for (int i = 0; i < nInstancesLocal_; i++)
+  if (!computedBatched)
   {
-    instancesLocal_[i].advanceTimeSpan(withOutputWritersEnabled);
+    for (int i = 0; i < nInstancesLocal_; i++)
+    {
+      instancesLocal_[i].advanceTimeSpan(withOutputWritersEnabled);
+    }
   }
 
   // stop duration measurement
@@ -351,6 +364,16 @@ initialize()
   // initialize data object with all instances
   data_.setInstancesData(instancesLocal_);
 
+  // prepare the batched computation of all instances
+  if (batchedCellmlInstances_)
+  {
+    batchedInstances_ = std::make_shared<BatchedCellmlInstances<TimeSteppingScheme>>(instancesLocal_);
+    if (!batchedInstances_->initialize())
+    {
+      batchedInstances_ = nullptr;
+    }
+  }
+
   // initialize slot connector data
   slotConnectorData_ = std::make_shared<SlotConnectorDataType>();
   slotConnectorData_->reserve(nInstancesLocal_);
@@ -441,6 +464,9 @@ run()
     writeOwnOutput(instancesLocal_[0].numberTimeSteps(), instancesLocal_[0].endTime());
   }
   LOG(DEBUG) << "end of multiple_instances run";
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 //! return the data object
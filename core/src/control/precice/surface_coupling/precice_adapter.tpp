@@ -1,6 +1,7 @@
 #include "control/precice/surface_coupling/precice_adapter.h"
 
 #include <sstream>
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace Control
 {
@@ -36,6 +37,8 @@ run()
       // increase current simulation time
       currentTime += this->timeStepWidth_;
     }
+    // wait until all output files that are written asynchronously are on disk
+    OutputWriter::AsynchronousFileWriter::instance().finish();
     return;
   }
 
@@ -124,6 +127,9 @@ run()
 #else
   LOG(FATAL) << "Not compiled with preCICE!";
 #endif
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename NestedSolver>
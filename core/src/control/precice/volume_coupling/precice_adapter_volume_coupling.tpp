@@ -1,4 +1,5 @@
 #include "control/precice/volume_coupling/precice_adapter_volume_coupling.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace Control
 {
@@ -34,6 +35,8 @@ run()
       // increase current simulation time
       currentTime += this->timeStepWidth_;
     }
+    // wait until all output files that are written asynchronously are on disk
+    OutputWriter::AsynchronousFileWriter::instance().finish();
     return;
   }
 
@@ -125,6 +128,9 @@ run()
 #else
   LOG(FATAL) << "Not compiled with preCICE!";
 #endif
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename NestedSolver>
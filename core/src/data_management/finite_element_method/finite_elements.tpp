@@ -85,6 +85,7 @@ updateGeometry(double scalingFactor)
   
   // w = alpha * x + y, VecWAXPY(w, alpha, x, y)
   ierr = VecWAXPY(this->functionSpace_->geometryField().valuesGlobal(), scalingFactor, this->solution()->valuesGlobal(), this->referenceGeometry_->valuesGlobal()); CHKERRV(ierr);
+  this->functionSpace_->geometryField().increaseValuesVersion();
   
   this->functionSpace_->geometryField().startGhostManipulation();
   
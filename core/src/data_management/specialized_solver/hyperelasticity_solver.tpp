@@ -234,6 +234,7 @@ updateGeometry(double scalingFactor, bool updateLinearVariables)
   // w = alpha * x + y, VecWAXPY(w, alpha, x, y)
   ierr = VecWAXPY(this->displacementsFunctionSpace_->geometryField().valuesGlobal(),
                   scalingFactor, this->displacements_->valuesGlobal(), this->geometryReference_->valuesGlobal()); CHKERRV(ierr);
+  this->displacementsFunctionSpace_->geometryField().increaseValuesVersion();
 
   this->displacementsFunctionSpace_->geometryField().startGhostManipulation();
 
@@ -271,6 +272,7 @@ updateGeometry(double scalingFactor, bool updateLinearVariables)
     // w = alpha * x + y, VecWAXPY(w, alpha, x, y)
     ierr = VecWAXPY(this->pressureFunctionSpace_->geometryField().valuesGlobal(),
                     1, this->displacementsLinearMesh_->valuesGlobal(), this->geometryReferenceLinearMesh_->valuesGlobal()); CHKERRV(ierr);
+    this->pressureFunctionSpace_->geometryField().increaseValuesVersion();
 
     this->pressureFunctionSpace_->geometryField().startGhostManipulation();
   }
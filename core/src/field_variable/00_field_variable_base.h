@@ -41,6 +41,17 @@ public:
   //! set the field variable to be a "geometry field"
   void setIsGeometryField(bool isGeometryField);
 
+  //! get a counter that is increased whenever the values of this field variable have been changed by a set method or by increaseValuesVersion().
+  //! The output writers use it on the geometry field to detect that a mesh has not moved since the last output.
+  //! Copies of the field variable share the counter, like they share the values vector, such that a change through a copy is also seen here.
+  int valuesVersion() const;
+
+  //! increase the values version counter, this is called by all set methods. Code that changes the values directly through the Petsc Vecs, e.g. valuesGlobal(), has to call it afterwards.
+  void increaseValuesVersion();
+
+  //! use the same values version counter as rhs, this is needed when the values vector of rhs is reused
+  void shareValuesVersion(const FieldVariableBaseFunctionSpace<FunctionSpaceType> &rhs);
+
   //! check if there are NaNs or high values in the current variable, if yes output a warning
   void checkNansInfs(int componentNo = 0) const;
 
@@ -128,6 +139,7 @@ public:
 protected:
  
   bool isGeometryField_;     //< if the type of this FieldVariable is a coordinate, i.e. geometric information
+  std::shared_ptr<int> valuesVersion_ = std::make_shared<int>(0);    //< counter that is increased whenever the values have been changed, see valuesVersion(), shared by all copies of this field variable
 
   std::shared_ptr<FunctionSpaceType> functionSpace_;  //< the mesh/function_space for which the field variable is defined
   std::string name_;     //< name of the field variable
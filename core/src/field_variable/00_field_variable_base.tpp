@@ -46,6 +46,27 @@ setIsGeometryField(bool isGeometryField)
   isGeometryField_ = isGeometryField;
 }
 
+template<typename FunctionSpaceType>
+int FieldVariableBaseFunctionSpace<FunctionSpaceType>::
+valuesVersion() const
+{
+  return *valuesVersion_;
+}
+
+template<typename FunctionSpaceType>
+void FieldVariableBaseFunctionSpace<FunctionSpaceType>::
+increaseValuesVersion()
+{
+  (*valuesVersion_)++;
+}
+
+template<typename FunctionSpaceType>
+void FieldVariableBaseFunctionSpace<FunctionSpaceType>::
+shareValuesVersion(const FieldVariableBaseFunctionSpace<FunctionSpaceType> &rhs)
+{
+  valuesVersion_ = rhs.valuesVersion_;
+}
+
 template<typename FunctionSpaceType>
 void FieldVariableBaseFunctionSpace<FunctionSpaceType>::
 checkNansInfs(int componentNo) const
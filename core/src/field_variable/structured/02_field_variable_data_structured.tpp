@@ -38,6 +38,10 @@ FieldVariableDataStructured(FieldVariable<FunctionSpaceType,nComponents> &rhs, s
   {
     // if rhs is not a geometry field and therefore has a partitionedPetscVec, use that
     this->values_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,nComponents>>(*rhs.partitionedPetscVec(), name, reuseData);
+
+    // the values are the same as those of rhs, therefore also changes have to be counted together
+    if (reuseData)
+      this->shareValuesVersion(rhs);
   }
   else
   {
@@ -71,6 +75,10 @@ FieldVariableDataStructured(FieldVariable<FunctionSpaceType,nComponents2> &rhs,
   {
     // if rhs is not a geometry field and therefore has a partitionedPetscVec, use that
     this->values_ = std::make_shared<PartitionedPetscVec<FunctionSpaceType,nComponents>>(*rhs.partitionedPetscVec(), name, reuseData, rhsComponentNoBegin);
+
+    // the values are the same as those of rhs, therefore also changes have to be counted together
+    if (reuseData)
+      this->shareValuesVersion(rhs);
   }
   else
   {
@@ -148,6 +148,7 @@ setValues(FieldVariable<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableO
     rhs.getValues(componentNo, surfaceDofs_, values);
 
     //VLOG(1) << "component " << componentNo << ", values: " << values;
+    this->increaseValuesVersion();
     this->values_->setValues(componentNo, this->functionSpace_->meshPartition()->nDofsLocalWithoutGhosts(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), INSERT_VALUES);
   }
 
@@ -179,6 +180,7 @@ setValues(FieldVariable<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension<
     rhs.subFieldVariableWithoutUpdate(-1)->getValues(componentNo, surfaceDofs_, values);
 
     //VLOG(1) << "component " << componentNo << ", values: " << values;
+    this->increaseValuesVersion();
     this->values_->setValues(componentNo, this->functionSpace_->meshPartition()->nDofsLocalWithoutGhosts(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), INSERT_VALUES);
   }
 
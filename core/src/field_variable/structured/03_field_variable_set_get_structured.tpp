@@ -427,6 +427,7 @@ extractComponentCopy(int componentNo, std::shared_ptr<FieldVariable<FunctionSpac
   assert(extractedFieldVariable->partitionedPetscVec());
   assert(this->values_);
   this->values_->extractComponentCopy(componentNo, extractedFieldVariable->partitionedPetscVec());
+  extractedFieldVariable->increaseValuesVersion();
 }
 
 template<typename FunctionSpaceType, int nComponents>
@@ -436,6 +437,7 @@ extractComponentShared(int componentNo, std::shared_ptr<FieldVariable<FunctionSp
   assert(extractedFieldVariable->partitionedPetscVec());
   assert(this->values_);
   this->values_->extractComponentShared(componentNo, extractedFieldVariable->partitionedPetscVec());
+  extractedFieldVariable->increaseValuesVersion();
 }
 
 template<typename FunctionSpaceType, int nComponents>
@@ -453,12 +455,14 @@ restoreExtractedComponent(std::shared_ptr<PartitionedPetscVec<FunctionSpaceType,
 {
   assert(this->values_);
   this->values_->template restoreExtractedComponent<nComponents2>(extractedVec, componentNo);
+  this->increaseValuesVersion();
 }
 
 template<typename FunctionSpaceType, int nComponents>
 void FieldVariableSetGetStructured<FunctionSpaceType,nComponents>::
 setValues(int componentNo, Vec petscVector)
 {
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, petscVector);
 }
 
@@ -467,6 +471,7 @@ void FieldVariableSetGetStructured<FunctionSpaceType,nComponents>::
 setValues(int componentNo, std::shared_ptr<FieldVariable<FunctionSpaceType,1>> fieldVariable)
 {
   assert(fieldVariable->partitionedPetscVec());
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, fieldVariable->partitionedPetscVec());
 }
 
@@ -501,6 +506,7 @@ setValues(int componentNo, const std::vector<dof_no_t> &dofNosLocal, const std::
   assert(values.size() >= dofNosLocal.size());
 
   // set the values for the given component
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, dofNosLocal.size(), dofNosLocal.data(), values.data(), petscInsertMode);
 }
 
@@ -513,6 +519,7 @@ setValues(int componentNo, const std::array<dof_no_t,N> &dofNosLocal, const std:
   assert(this->values_);
 
   // set the values for the given component
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, N, dofNosLocal.data(), values.data(), petscInsertMode);
 }
 
@@ -525,6 +532,7 @@ setValues(int componentNo, int nValues, const dof_no_t *dofNosLocal, const doubl
   assert(this->values_);
 
   // set the values for the given component
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, nValues, dofNosLocal, values, petscInsertMode);
 }
 
@@ -557,6 +565,7 @@ setValues(int nValues, const std::vector<dof_no_t> &dofNosLocal, const std::vect
     }
 
     // set the values for the current component
+    this->increaseValuesVersion();
     this->values_->setValues(componentIndex, nValues, dofNosLocal.data(), valuesBuffer.data(), petscInsertMode);
   }
 
@@ -573,6 +582,7 @@ setValue(dof_no_t dofLocalNo, const std::array<double,nComponents> &value, Inser
   // loop over components and set single value for each component
   for (int componentIndex = 0; componentIndex < nComponents; componentIndex++)
   {
+    this->increaseValuesVersion();
     this->values_->setValues(componentIndex, 1, &dofLocalNo, value.data()+componentIndex, petscInsertMode);
   }
 
@@ -600,6 +610,7 @@ setValue(int componentNo, Vc::int_v dofLocalNo, Vc::double_v value, InsertMode p
 
   // count number of non-negative indices in dofLocalNo, it is assumed that they occur all before the negative indices
   int nEntries = Vc::double_v::size() - Vc::count(Vc::isnegative(dofLocalNo));
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, nEntries, (PetscInt *)&dofLocalNo, (double *)&value, petscInsertMode);
 }
 
@@ -624,6 +635,7 @@ setValue(int componentNo, Vc::int_v dofLocalNo, double value, InsertMode petscIn
   // count number of non-negative indices in dofLocalNo, it is assumed that they occur all before the negative indices
   int nEntries = Vc::double_v::size() - Vc::count(Vc::isnegative(dofLocalNo));
 
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, nEntries, indices.data(), data.data(), petscInsertMode);
 }
 
@@ -645,6 +657,7 @@ setValues(const std::array<dof_no_t,N> &dofNosLocal, const std::array<std::array
     }
 
     // set the values for the current component
+    this->increaseValuesVersion();
     this->values_->setValues(componentIndex, N, dofNosLocal.data(), valuesBuffer.data(), petscInsertMode);
   }
 }
@@ -656,6 +669,7 @@ setValue(int componentNo, dof_no_t dofLocalNo, double value, InsertMode petscIns
 {
   assert(this->values_);
 
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, 1, &dofLocalNo, &value, petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -688,6 +702,7 @@ setValuesWithGhosts(int componentNo, const std::vector<double> &values, InsertMo
   assert(this->values_);
  
   // set the values
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, values.size(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), petscInsertMode);
 }
 
@@ -701,6 +716,7 @@ setValuesWithoutGhosts(int componentNo, const std::vector<double> &values, Inser
   assert(this->values_);
 
   // set the values, this is the same call as setValuesWithGhosts, but the number of values is smaller and therefore the last dofs which are the ghosts are not touched
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, values.size(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), petscInsertMode);
 }
 
@@ -743,6 +759,7 @@ setValuesWithoutGhosts(const std::array<std::vector<double>,nComponents> &values
     assert(values[componentIndex].size() == this->functionSpace_->meshPartition()->nDofsLocalWithoutGhosts());
 
     // set the values, this is the same call as setValuesWithGhosts, but the number of values is smaller and therefore the last dofs which are the ghosts are not touched
+    this->increaseValuesVersion();
     this->values_->setValues(componentIndex, this->functionSpace_->meshPartition()->nDofsLocalWithoutGhosts(),
                              this->functionSpace_->meshPartition()->dofNosLocal().data(), values[componentIndex].data(), petscInsertMode);
   }
@@ -754,6 +771,7 @@ void FieldVariableSetGetStructured<FunctionSpaceType,nComponents>::
 zeroEntries()
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->zeroEntries();
 }
 }  // namespace
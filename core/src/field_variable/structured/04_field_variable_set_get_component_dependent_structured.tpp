@@ -120,6 +120,7 @@ setValue(dof_no_t dofLocalNo, double value, InsertMode petscInsertMode)
   assert(this->values_);
   assert(dofLocalNo < this->functionSpace_->meshPartition()->nDofsLocalWithGhosts());
 
+  this->increaseValuesVersion();
   this->values_->setValues(0, 1, (PetscInt*)&dofLocalNo, &value, petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -136,6 +137,7 @@ setValue(const Vc::int_v &dofLocalNo, const Vc::double_v &value, InsertMode pets
 
   //this->values_->setValues(0, nEntries, indices.data(), data.data(), petscInsertMode);
 
+  this->increaseValuesVersion();
   this->values_->setValues(0, nEntries, (PetscInt *)&dofLocalNo, (double *)&value, petscInsertMode);
 }
 
@@ -153,6 +155,7 @@ setValue(const Vc::int_v &dofLocalNo, double value, InsertMode petscInsertMode)
   // count number of non-negative indices in dofLocalNo, it is assumed that they occur all before the negative indices
   int nEntries = Vc::double_v::size() - Vc::count(Vc::isnegative(dofLocalNo));
 
+  this->increaseValuesVersion();
   this->values_->setValues(0, nEntries, (PetscInt *)&dofLocalNo, data.data(), petscInsertMode);
 }
 
@@ -162,6 +165,7 @@ void FieldVariableSetGetComponent<FunctionSpaceType,1>::
 setValues(Vec petscVector)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, petscVector);
 }
 
@@ -171,6 +175,7 @@ void FieldVariableSetGetComponent<FunctionSpaceType,1>::
 setValues(const std::vector<dof_no_t> &dofNosLocal, std::vector<double> &values, InsertMode petscInsertMode)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, dofNosLocal.size(), (PetscInt*)dofNosLocal.data(), values.data(), petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -182,6 +187,7 @@ void FieldVariableSetGetComponent<FunctionSpaceType,1>::
 setValues(const std::array<dof_no_t,nValues> dofNosLocal, std::array<double,nValues> values, InsertMode petscInsertMode)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, nValues, (PetscInt*)dofNosLocal.data(), values.data(), petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -198,6 +204,7 @@ setValuesWithGhosts(const std::vector<double> &values, InsertMode petscInsertMod
   assert(values.size() == this->functionSpace_->meshPartition()->nDofsLocalWithGhosts());
   assert(this->values_);
   
+  this->increaseValuesVersion();
   this->values_->setValues(0, values.size(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), petscInsertMode);
 }
 
@@ -210,6 +217,7 @@ setValuesWithoutGhosts(const std::vector<double> &values, InsertMode petscInsert
   assert(this->values_);
   
   // set the values, this is the same call as setValuesWithGhosts, but the number of values is smaller and therefore the last dofs which are the ghosts are not touched
+  this->increaseValuesVersion();
   this->values_->setValues(0, values.size(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), petscInsertMode);
 }
 
@@ -14,6 +14,7 @@ void FieldVariableSetGet<FunctionSpace::FunctionSpace<Mesh::StructuredDeformable
 setValues(FieldVariable<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>,BasisFunctionType>,nComponents> &rhs)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(*rhs.partitionedPetscVec());
 }
 
@@ -23,6 +24,7 @@ void FieldVariableSetGet<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension
 setValues(FieldVariable<FunctionSpace::FunctionSpace<Mesh::CompositeOfDimension<D>,BasisFunctionType>,nComponents> &rhs)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(*rhs.partitionedPetscVec());
 }
 
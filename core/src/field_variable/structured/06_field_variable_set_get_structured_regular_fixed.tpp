@@ -740,6 +740,7 @@ template<typename FunctionSpaceType, int nComponents>
 void FieldVariableSetGetRegularFixed<FunctionSpaceType,nComponents>::
 setValues(FieldVariable<FunctionSpaceType,nComponents> &rhs)
 {
+  this->increaseValuesVersion();
   this->values_->setValues(*rhs.partitionedPetscVec());
 }
 
@@ -326,6 +326,7 @@ setValues(int componentNo, const std::vector<dof_no_t> &dofNosLocal, const std::
   assert(dofNosLocal.size() == values.size());
 
   // set the values for the current component
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, dofNosLocal.size(), dofNosLocal.data(), values.data(), petscInsertMode);
 }
 
@@ -338,6 +339,7 @@ setValues(int componentNo, const std::array<dof_no_t,N> &dofNosLocal, const std:
   assert(this->values_);
 
   // set the values for the current component
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, N, dofNosLocal.data(), values.data(), petscInsertMode);
 }
 
@@ -350,6 +352,7 @@ setValues(int componentNo, int nValues, const dof_no_t *dofNosLocal, const doubl
   assert(this->values_);
 
   // set the values for the current component
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, nValues, dofNosLocal, values, petscInsertMode);
 }
 
@@ -380,6 +383,7 @@ setValues(const std::array<dof_no_t,N> &dofNosLocal, const std::array<std::array
     }
 
     // set the values for the current component
+    this->increaseValuesVersion();
     this->values_->setValues(componentIndex, N, dofNosLocal.data(), valuesBuffer.data(), petscInsertMode);
   }
 }
@@ -405,6 +409,7 @@ template<typename FunctionSpaceType, int nComponents>
 void FieldVariableSetGetUnstructured<FunctionSpaceType,nComponents>::
 setValues(FieldVariable<FunctionSpaceType,nComponents> &rhs)
 {
+  this->increaseValuesVersion();
   this->values_->setValues(*rhs.partitionedPetscVec());
 }
 
@@ -416,6 +421,7 @@ setValues(const std::vector<dof_no_t> &dofNosLocal, const std::vector<double> &v
   const int nValues = values.size();
   assert(this->values_);
 
+  this->increaseValuesVersion();
   this->values_->setValues(0, nValues, (const int *) dofNosLocal.data(), values.data(), petscInsertMode);
 
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
@@ -457,6 +463,7 @@ setValues(const std::vector<dof_no_t> &dofNosLocal, const std::vector<std::array
       valuesBuffer[dofIndex] = values[dofIndex][componentIndex];
     }
     
+    this->increaseValuesVersion();
     this->values_->setValues(componentIndex, nValues, dofNosLocal.data(), valuesBuffer.data(), petscInsertMode);
   }
 
@@ -474,6 +481,7 @@ setValue(dof_no_t dofLocalNo, const std::array<double,nComponents> &value, Inser
   for (int componentIndex = 0; componentIndex < nComponents; componentIndex++)
   {
     LOG(DEBUG) << "set value of \"" << this->name_ << "\" for component " << componentIndex << " to " << value[componentIndex];
+    this->increaseValuesVersion();
     this->values_->setValues(componentIndex, 1, &dofLocalNo, value.data()+componentIndex, petscInsertMode);
   }
 
@@ -497,6 +505,7 @@ setValue(int componentNo, dof_no_t dofLocalNo, double value, InsertMode petscIns
 {
   assert(this->values_);
 
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, 1, &dofLocalNo, &value, petscInsertMode);
 }
 
@@ -510,6 +519,7 @@ setValue(int componentNo, Vc::int_v dofLocalNo, Vc::double_v value, InsertMode p
   // count number of non-negative indices in dofLocalNo, it is assumed that they occur all before the negative indices
   int nEntries = Vc::double_v::size() - Vc::count(Vc::isnegative(dofLocalNo));
 
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, nEntries, (PetscInt *)&dofLocalNo, (double *)&value, petscInsertMode);
 }
 
@@ -529,6 +539,7 @@ setValue(int componentNo, Vc::int_v dofLocalNo, double value, InsertMode petscIn
   // count number of non-negative indices in dofLocalNo, it is assumed that they occur all before the negative indices
   int nEntries = Vc::double_v::size() - Vc::count(Vc::isnegative(dofLocalNo));
 
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, nEntries, (PetscInt *)&dofLocalNo, (double *)&value, petscInsertMode);
 }
 
@@ -542,6 +553,7 @@ setValuesWithGhosts(int componentNo, const std::vector<double> &values, InsertMo
   assert(values.size() == this->functionSpace_->meshPartition()->nDofsLocalWithGhosts());
   assert(this->values_);
  
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, values.size(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), petscInsertMode);
 
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
@@ -559,6 +571,7 @@ setValuesWithoutGhosts(int componentNo, const std::vector<double> &values, Inser
   assert(this->values_);
    
   // set the values, this is the same call as setValuesWithGhosts, but the number of values is smaller and therefore the last dofs which are the ghosts are not touched
+  this->increaseValuesVersion();
   this->values_->setValues(componentNo, values.size(), this->functionSpace_->meshPartition()->dofNosLocal().data(), values.data(), petscInsertMode);
 }
 
@@ -588,6 +601,7 @@ void FieldVariableSetGetUnstructured<FunctionSpaceType,nComponents>::
 zeroEntries()
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->zeroEntries();
 }
 
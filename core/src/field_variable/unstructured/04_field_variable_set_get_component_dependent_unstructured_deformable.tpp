@@ -121,6 +121,7 @@ void FieldVariableSetGet<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformab
 setValue(dof_no_t dofLocalNo, double value, InsertMode petscInsertMode)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, 1, (PetscInt*)&dofLocalNo, &value, petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -134,6 +135,7 @@ setValue(const Vc::int_v &dofLocalNo, const Vc::double_v &value, InsertMode pets
 
   // count number of non-negative indices in dofLocalNo, it is assumed that they occur all before the negative indices
   int nEntries = Vc::double_v::size() - Vc::count(Vc::isnegative(dofLocalNo));
+  this->increaseValuesVersion();
   this->values_->setValues(0, nEntries, (PetscInt *)&dofLocalNo, (double *)&value, petscInsertMode);
 
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
@@ -151,6 +153,7 @@ setValue(const Vc::int_v &dofLocalNo, double value, InsertMode petscInsertMode)
   // count number of non-negative indices in dofLocalNo, it is assumed that they occur all before the negative indices
   int nEntries = Vc::double_v::size() - Vc::count(Vc::isnegative(dofLocalNo));
 
+  this->increaseValuesVersion();
   this->values_->setValues(0, nEntries, (PetscInt *)&dofLocalNo, data.data(), petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -169,6 +172,7 @@ void FieldVariableSetGet<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformab
 setValues(const std::vector<dof_no_t> &dofNosLocal, const std::vector<double> &values, InsertMode petscInsertMode)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, dofNosLocal.size(), (PetscInt*)dofNosLocal.data(), values.data(), petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -180,6 +184,7 @@ void FieldVariableSetGet<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformab
 setValues(const std::array<dof_no_t,nValues> dofNosLocal, const std::array<double,nValues> values, InsertMode petscInsertMode)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, nValues, (PetscInt*)dofNosLocal.data(), values.data(), petscInsertMode);
   // after this VecAssemblyBegin() and VecAssemblyEnd(), i.e. finishGhostManipulation must be called
 }
@@ -190,6 +195,7 @@ void FieldVariableSetGet<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformab
 setValuesWithGhosts(const std::vector<double> &values, InsertMode petscInsertMode)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, values, petscInsertMode);
 }
 
@@ -199,6 +205,7 @@ void FieldVariableSetGet<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformab
 setValuesWithoutGhosts(const std::vector<double> &values, InsertMode petscInsertMode)
 {
   assert(this->values_);
+  this->increaseValuesVersion();
   this->values_->setValues(0, values, petscInsertMode);
 }
 
@@ -340,6 +340,7 @@ map(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
           {
             ierr = VecCopy(fieldVariableSource->valuesGlobal(componentNo), fieldVariableTarget->valuesGlobal(componentNo)); CHKERRV(ierr);
           }
+          fieldVariableTarget->increaseValuesVersion();
         }
         else
         {
@@ -348,6 +349,7 @@ map(std::shared_ptr<FieldVariableSourceType> fieldVariableSource,
           // Here, we copy the given component of fieldVariableSource to the componentNoTarget of fieldVariableTarget.
           PetscErrorCode ierr;
           ierr = VecCopy(fieldVariableSource->valuesGlobal(componentNoSource), fieldVariableTarget->valuesGlobal(componentNoTarget)); CHKERRV(ierr);
+          fieldVariableTarget->increaseValuesVersion();
 
           VLOG(1) << "afterwards, source representation: " << fieldVariableSource->partitionedPetscVec()->getCurrentRepresentationString();
           VLOG(1) << "afterwards, target representation: " << fieldVariableTarget->partitionedPetscVec()->getCurrentRepresentationString();
@@ -49,6 +49,9 @@ public:
   //! get access to the internal targetMappingInfo_ variable
   const std::vector<targetDof_t> &targetMappingInfo() const;
 
+  //! if every mapped source dof coincides with a node of the target mesh, then the mapping in both directions is a direct copy of values without interpolation
+  bool isDirectMapping() const;
+
 protected:
 
   //! add mapping to the target that have so far no contribution from any source dof, by interpolating the source mesh
@@ -58,6 +61,9 @@ protected:
                        int &nTargetDofsNotMapped, int &nTimesSearchedAllElements, int &nTargetDofNosLocaNotFixed
                       );
 
+  //! check if all mapped source dofs coincide with dofs of the target mesh, this is the case e.g. for fibers that were created from the same structured grid as the 3D mesh, then set up directMappingSourceDofNos_ and directMappingTargetDofNos_
+  void initializeDirectMapping();
+
   //! compute phi contribution for quadratic elements
   double quadraticElementComputePhiContribution(std::array<double,FunctionSpaceTargetType::dim()> xi,
                                                 int targetDofIndex, bool &sourceDofHasContributionToTargetDof);
@@ -68,6 +74,10 @@ protected:
 
 
   std::vector<targetDof_t> targetMappingInfo_;  //< [localDofNo source functionSpace (low dim)] information where in the target (high dim) to store the value from local dof No of the source (low dim)
+
+  bool isDirectMapping_;                        //< if all mapped source dofs coincide with target dofs, then values are copied directly using directMappingSourceDofNos_ and directMappingTargetDofNos_
+  std::vector<dof_no_t> directMappingSourceDofNos_;   //< for a direct mapping, the local source dof nos that are mapped, i.e. where mapThisDof is true
+  std::vector<dof_no_t> directMappingTargetDofNos_;   //< for a direct mapping, the local target dof nos (including ghosts) at the same positions as the dofs in directMappingSourceDofNos_
 };
 
 }  // namespace
@@ -18,7 +18,8 @@ MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionS
                               double xiTolerance, bool enableWarnings, bool compositeUseOnlyInitializedMappings,
                               bool isEnabledFixUnmappedDofs) :
   functionSpaceSource_(functionSpaceSource),
-  functionSpaceTarget_(functionSpaceTarget)
+  functionSpaceTarget_(functionSpaceTarget),
+  isDirectMapping_(false)
 {
   // for composite meshes if the option compositeUseOnlyInitializedMappings is set, do not create the mapping here
   if (Mesh::isComposite<std::shared_ptr<FunctionSpaceSourceType>>::value && compositeUseOnlyInitializedMappings)
@@ -239,6 +240,9 @@ MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionS
     fixUnmappedDofs(functionSpaceSource, functionSpaceTarget, xiTolerance, compositeUseOnlyInitializedMappings, isEnabledFixUnmappedDofs, targetDofIsMappedTo,
                     nTargetDofsNotMapped, nTimesSearchedAllElementsForFix, nTargetDofNosLocaNotFixed);
 
+    // check if the source dofs coincide with target dofs, then the mapping can be done by copying the values
+    initializeDirectMapping();
+
     Control::PerformanceMeasurement::stop("durationComputeMappingBetweenMeshes");
 
     if (nSourceDofsOutsideTargetMesh > 0)
@@ -268,6 +272,10 @@ MappingBetweenMeshesConstruct(std::shared_ptr<FunctionSpaceSourceType> functionS
         << "              iterated " << nTimesSearchedAllElements << " times over target mesh,\n"
         << "              \"xiTolerance\": " << xiTolerance << " (increase this value to reduce the number of (costly) iterations over the whole mesh, however increasing potentially leads to more elements being checked which takes longer).\n";
     }
+    if (isDirectMapping_)
+    {
+      logMessage << "              all source dofs coincide with target dofs, values are copied directly without interpolation,\n";
+    }
     logMessage << "              Total duration of all mappings so far: " << Control::PerformanceMeasurement::getDuration("durationComputeMappingBetweenMeshes") << " s.";
     DihuContext::mappingBetweenMeshesManager()->addLogMessage(logMessage.str());
 
@@ -529,4 +537,72 @@ targetMappingInfo() const
   return targetMappingInfo_;
 }
 
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+bool MappingBetweenMeshesConstruct<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+isDirectMapping() const
+{
+  return isDirectMapping_;
+}
+
+template<typename FunctionSpaceSourceType, typename FunctionSpaceTargetType>
+void MappingBetweenMeshesConstruct<FunctionSpaceSourceType, FunctionSpaceTargetType>::
+initializeDirectMapping()
+{
+  // If the source mesh was created from the same structured grid as the target mesh, e.g. the 1D fibers in the fibers_emg example that are
+  // lines of the 3D mesh, every source dof lies on a node of the target mesh. Then its scaling factors are 1 for this node and (practically) 0 for all
+  // other nodes of the element. The mapping then reduces to copying the values between the two dofs, in both directions.
+  // Additional target elements are only added by fixUnmappedDofs, in this case the mapping is not a pure copy.
+  const double tolerance = 1e-8;
+  const int nDofsPerTargetElement = FunctionSpaceTargetType::nDofsPerElement();
+
+  isDirectMapping_ = false;
+  directMappingSourceDofNos_.clear();
+  directMappingTargetDofNos_.clear();
+
+  // direct mapping of values is only possible with nodal basis functions, i.e. not for Hermite
+  if (FunctionSpaceSourceType::nDofsPerNode() != 1 || FunctionSpaceTargetType::nDofsPerNode() != 1)
+    return;
+
+  directMappingSourceDofNos_.reserve(targetMappingInfo_.size());
+  directMappingTargetDofNos_.reserve(targetMappingInfo_.size());
+
+  for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal < targetMappingInfo_.size(); sourceDofNoLocal++)
+  {
+    const targetDof_t &targetDof = targetMappingInfo_[sourceDofNoLocal];
+
+    if (!targetDof.mapThisDof)
+      continue;
+
+    if (targetDof.targetElements.size() != 1)
+      return;
+
+    // find the target dof with scaling factor 1
+    const typename targetDof_t::element_t &targetElement = targetDof.targetElements[0];
+    int coincidingDofIndex = -1;
+    for (int targetDofIndex = 0; targetDofIndex < nDofsPerTargetElement; targetDofIndex++)
+    {
+      if (fabs(targetElement.scalingFactors[targetDofIndex] - 1.0) < tolerance)
+      {
+        coincidingDofIndex = targetDofIndex;
+      }
+      else if (fabs(targetElement.scalingFactors[targetDofIndex]) > tolerance)
+      {
+        // the source dof is not at a node of the target element
+        return;
+      }
+    }
+
+    if (coincidingDofIndex == -1)
+      return;
+
+    directMappingSourceDofNos_.push_back(sourceDofNoLocal);
+    directMappingTargetDofNos_.push_back(functionSpaceTarget_->getDofNo(targetElement.elementNoLocal, coincidingDofIndex));
+  }
+
+  isDirectMapping_ = true;
+
+  LOG(DEBUG) << "mapping \"" << functionSpaceSource_->meshName() << "\" -> \"" << functionSpaceTarget_->meshName() << "\": all "
+    << directMappingSourceDofNos_.size() << " mapped source dofs coincide with target dofs, values will be copied directly.";
+}
+
 }  // namespace
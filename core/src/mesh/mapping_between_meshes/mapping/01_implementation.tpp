@@ -41,6 +41,22 @@ mapLowToHighDimension(
     VLOG(1) << "extracted source values: " << sourceValues;
   }
 
+  // if all source dofs coincide with target dofs, add the values at once, all scaling factors are 1
+  if (this->isDirectMapping_)
+  {
+    const int nValues = this->directMappingSourceDofNos_.size();
+    std::vector<double> targetValues(nValues);
+    for (int i = 0; i < nValues; i++)
+    {
+      targetValues[i] = sourceValues[this->directMappingSourceDofNos_[i]];
+    }
+    std::vector<double> scalingFactors(nValues, 1.0);
+
+    fieldVariableTarget.setValues(componentNoTarget, this->directMappingTargetDofNos_, targetValues, ADD_VALUES);
+    targetFactorSum.setValues(this->directMappingTargetDofNos_, scalingFactors, ADD_VALUES);
+    return;
+  }
+
   // loop over all local dofs of the source functionSpace
   for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal != nDofsLocalSource; sourceDofNoLocal++)
   {
@@ -106,6 +122,22 @@ mapLowToHighDimension(
     VLOG(1) << "extracted source values: " << sourceValues;
   }
 
+  // if all source dofs coincide with target dofs, add the values at once, all scaling factors are 1
+  if (this->isDirectMapping_)
+  {
+    const int nValues = this->directMappingSourceDofNos_.size();
+    std::vector<VecD<nComponents>> targetValues(nValues);
+    for (int i = 0; i < nValues; i++)
+    {
+      targetValues[i] = sourceValues[this->directMappingSourceDofNos_[i]];
+    }
+    std::vector<double> scalingFactors(nValues, 1.0);
+
+    fieldVariableTarget.setValues(this->directMappingTargetDofNos_, targetValues, ADD_VALUES);
+    targetFactorSum.setValues(this->directMappingTargetDofNos_, scalingFactors, ADD_VALUES);
+    return;
+  }
+
   // loop over all local dofs of the source functionSpace
   for (dof_no_t sourceDofNoLocal = 0; sourceDofNoLocal != nDofsLocalSource; sourceDofNoLocal++)
   {
@@ -196,6 +228,16 @@ mapHighToLowDimension(
   LOG(DEBUG) << "mapHighToLowDimension " << fieldVariableSource.name() << " (" << fieldVariableSource.functionSpace()->meshName()
       << ") -> " << fieldVariableTarget.name() << " (" << fieldVariableTarget.functionSpace()->meshName() << ")";
 
+  // if all dofs of the low dimensional mesh coincide with dofs of the high dimensional mesh, copy the values at once
+  // (note that directMappingTargetDofNos_ refers to the mesh that was the target when the mapping was initialized, i.e. the source of this method)
+  if (this->isDirectMapping_)
+  {
+    std::vector<VecD<nComponents>> values;
+    fieldVariableSource.getValues(this->directMappingTargetDofNos_, values);
+    fieldVariableTarget.setValues(this->directMappingSourceDofNos_, values, INSERT_VALUES);
+    return;
+  }
+
   // this mapping direction corresponds to simple interpolation in the source mesh
 
   // visualization for 1D-1D: s=source, t=target
@@ -295,6 +337,16 @@ mapHighToLowDimension(
     VLOG(1) << "extracted source values: " << sourceValues;
   }
 
+  // if all dofs of the low dimensional mesh coincide with dofs of the high dimensional mesh, copy the values at once
+  // (note that directMappingTargetDofNos_ refers to the mesh that was the target when the mapping was initialized, i.e. the source of this method)
+  if (this->isDirectMapping_)
+  {
+    std::vector<double> values;
+    fieldVariableSource.getValues(componentNoSource, this->directMappingTargetDofNos_, values);
+    fieldVariableTarget.setValues(componentNoTarget, this->directMappingSourceDofNos_, values, INSERT_VALUES);
+    return;
+  }
+
   // visualization for 1D-1D: s=source, t=target
   // s--t--------s-----t-----s
 
@@ -10,6 +10,7 @@
 #include "time_stepping_scheme/02_time_stepping_scheme_ode.h"
 #include "data_management/time_stepping/time_stepping.h"
 #include "control/python_config/python_config.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace ModelOrderReduction
 {
@@ -157,6 +158,9 @@ run()
 
   // do simulations
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename TimeSteppingType>
@@ -184,6 +184,9 @@ Extrae_restart();
   PAT_region_end(2);    // end region "computation", id 
   PAT_record(PAT_STATE_OFF);
 #endif
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 //! call the output writer on the data object, output files will contain currentTime, with callCountIncrement !=1 output timesteps can be skipped
@@ -0,0 +1,200 @@
+#include "output_writer/asynchronous_file_writer.h"
+
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>
+
+#include "easylogging++.h"
+
+namespace OutputWriter
+{
+
+AsynchronousFileWriter &AsynchronousFileWriter::instance()
+{
+  static AsynchronousFileWriter asynchronousFileWriter;
+  return asynchronousFileWriter;
+}
+
+AsynchronousFileWriter::AsynchronousFileWriter() :
+  thread_(nullptr), isWriting_(false), stopThread_(false), maximumQueueSize_(2), nBlockingCalls_(0)
+{
+}
+
+AsynchronousFileWriter::~AsynchronousFileWriter()
+{
+  if (thread_)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stopThread_ = true;
+    }
+    queueChanged_.notify_all();
+    thread_->join();
+  }
+}
+
+void AsynchronousFileWriter::setMaximumQueueSize(int maximumQueueSize)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  maximumQueueSize_ = std::max(1, maximumQueueSize);
+}
+
+void AsynchronousFileWriter::enqueue(std::string filename, std::string &&contents, bool append)
+{
+  Job job;
+  job.filename = filename;
+  job.contents = std::move(contents);
+  job.append = append;
+  enqueueJob(std::move(job));
+}
+
+void AsynchronousFileWriter::enqueueDeferred(std::string filename, std::function<std::string()> encodeContents, bool append)
+{
+  Job job;
+  job.filename = filename;
+  job.encodeContents = std::move(encodeContents);
+  job.append = append;
+  enqueueJob(std::move(job));
+}
+
+void AsynchronousFileWriter::enqueueJob(Job &&job)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // start the background thread at the first call
+  if (!thread_)
+  {
+    thread_ = std::make_shared<std::thread>(&AsynchronousFileWriter::run, this);
+  }
+
+  // wait until there is space in the queue
+  if ((int)queue_.size() >= maximumQueueSize_)
+  {
+    nBlockingCalls_++;
+    queueChanged_.wait(lock, [this]{return (int)queue_.size() < maximumQueueSize_;});
+  }
+
+  reportFailedFiles();
+
+  std::string filename = job.filename;
+  queue_.push_back(std::move(job));
+
+  lock.unlock();
+  queueChanged_.notify_all();
+
+  VLOG(1) << "AsynchronousFileWriter: enqueued file \"" << filename << "\".";
+}
+
+void AsynchronousFileWriter::flush()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!thread_)
+    return;
+
+  queueChanged_.wait(lock, [this]{return queue_.empty() && !isWriting_;});
+
+  reportFailedFiles();
+}
+
+void AsynchronousFileWriter::finish()
+{
+  if (!thread_)
+    return;
+
+  // the background thread writes all remaining files before it terminates
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopThread_ = true;
+  }
+  queueChanged_.notify_all();
+  thread_->join();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  thread_ = nullptr;
+  stopThread_ = false;
+
+  reportFailedFiles();
+}
+
+int AsynchronousFileWriter::nBlockingCalls()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  return nBlockingCalls_;
+}
+
+void AsynchronousFileWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;)
+  {
+    queueChanged_.wait(lock, [this]{return !queue_.empty() || stopThread_;});
+
+    if (queue_.empty())
+      break;
+
+    Job job = std::move(queue_.front());
+    queue_.pop_front();
+    isWriting_ = true;
+
+    // encode and write the file without holding the lock, such that the main thread can enqueue the next file
+    lock.unlock();
+    queueChanged_.notify_all();
+
+    if (job.encodeContents)
+    {
+      job.contents = job.encodeContents();
+      job.encodeContents = nullptr;
+    }
+
+    bool success = writeFile(job.filename, job.contents, job.append);
+
+    lock.lock();
+    isWriting_ = false;
+    if (!success)
+      failedFilenames_.push_back(job.filename);
+    queueChanged_.notify_all();
+  }
+}
+
+bool AsynchronousFileWriter::writeFile(const std::string &filename, const std::string &contents, bool append)
+{
+  std::ios::openmode openMode = std::ios::out | std::ios::binary;
+  if (append)
+    openMode |= std::ios::app;
+
+  std::ofstream file(filename.c_str(), openMode);
+
+  if (!file.is_open())
+  {
+    // try to create directories, the same as Generic::openFile but without logging
+    std::size_t pos = filename.rfind("/");
+    if (pos != std::string::npos && pos != 0)
+    {
+      std::string path = filename.substr(0, pos);
+      int ret = system((std::string("mkdir -p ")+path).c_str());
+      if (ret != 0)
+        return false;
+
+      file.clear();
+      file.open(filename.c_str(), openMode);
+    }
+  }
+
+  if (!file.is_open())
+    return false;
+
+  file.write(contents.data(), contents.size());
+  file.close();
+  return !file.fail();
+}
+
+void AsynchronousFileWriter::reportFailedFiles()
+{
+  for (const std::string &filename : failedFilenames_)
+  {
+    LOG(WARNING) << "Could not write file \"" << filename << "\" (asynchronous output).";
+  }
+  failedFilenames_.clear();
+}
+
+}  // namespace
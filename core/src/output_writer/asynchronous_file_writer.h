@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace OutputWriter
+{
+
+/** Writes already encoded output files on a dedicated background thread, such that the compute thread does not block on file I/O.
+ *  The output writers copy the field values from Petsc on the main thread (Petsc is not thread-safe) and hand over either the
+ *  finished file contents by enqueue() or a function that encodes the copied values by enqueueDeferred(). The background thread then
+ *  runs the encoding (e.g. base64 or ascii conversion), creates the directory if needed and writes the file.
+ *  If the queue already contains maximumQueueSize files, enqueue() blocks until the background thread has written one file (back-pressure).
+ *  With the default of 2 this is a double-buffering scheme: one output is written to disk while the next one is being prepared.
+ *
+ *  The background thread does not call MPI, Petsc or the logger, errors are collected and reported on the main thread at the next call to enqueue() or flush().
+ */
+class AsynchronousFileWriter
+{
+public:
+  //! get the global instance
+  static AsynchronousFileWriter &instance();
+
+  //! destructor, writes all remaining files and stops the background thread
+  ~AsynchronousFileWriter();
+
+  //! set the maximum number of files that can be queued before enqueue blocks
+  void setMaximumQueueSize(int maximumQueueSize);
+
+  //! add a file with the given contents to the queue, the contents are moved, blocks if the queue is full
+  void enqueue(std::string filename, std::string &&contents, bool append=false);
+
+  //! add a file to the queue whose contents are computed by encodeContents on the background thread, blocks if the queue is full
+  //! encodeContents must not access Petsc, MPI or the logger and must own all data that it uses
+  void enqueueDeferred(std::string filename, std::function<std::string()> encodeContents, bool append=false);
+
+  //! wait until all queued files have been written, this has to be called before the program ends and before files are read again
+  void flush();
+
+  //! wait until all queued files have been written and stop the background thread, it is started again by the next enqueue,
+  //! this is called at the end of run() of the solvers, such that all files are complete when run() returns
+  void finish();
+
+  //! number of calls to enqueue that had to wait because the queue was full
+  int nBlockingCalls();
+
+private:
+  //! private constructor, use instance()
+  AsynchronousFileWriter();
+
+  struct Job;
+
+  //! add the job to the queue, blocks if the queue is full
+  void enqueueJob(Job &&job);
+
+  //! main loop of the background thread
+  void run();
+
+  //! write the file of the given job, return false if it failed, this is executed on the background thread
+  bool writeFile(const std::string &filename, const std::string &contents, bool append);
+
+  //! log the names of the files that could not be written, has to be called from the main thread with the mutex locked
+  void reportFailedFiles();
+
+  struct Job
+  {
+    std::string filename;   //< the name of the file to write
+    std::string contents;   //< the full contents of the file
+    std::function<std::string()> encodeContents;   //< if set, this function computes the contents on the background thread
+    bool append;            //< if the contents should be appended to an existing file
+  };
+
+  std::deque<Job> queue_;                   //< the files that are not yet written
+  std::mutex mutex_;                        //< mutex for queue_, isWriting_, stopThread_ and failedFilenames_
+  std::condition_variable queueChanged_;    //< condition variable that is notified when jobs are added or have been completed
+  std::shared_ptr<std::thread> thread_;     //< the background thread, started at the first call to enqueue
+  bool isWriting_;                          //< if the background thread is currently writing a file that was already removed from the queue
+  bool stopThread_;                         //< if the background thread should terminate after the queue is empty
+  int maximumQueueSize_;                    //< maximum number of files in the queue
+  int nBlockingCalls_;                      //< number of times that enqueue had to wait for the background thread
+  std::vector<std::string> failedFilenames_;   //< filenames that could not be written, to be reported by the main thread
+};
+
+} // namespace
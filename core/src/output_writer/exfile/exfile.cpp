@@ -18,6 +18,7 @@
 #include <mesh/structured_deformable.h>
 #include <mesh/unstructured_deformable.h>
 #include <mesh/mesh.h>
+#include "output_writer/output_file_stream.h"
 
 namespace OutputWriter
 {
@@ -28,8 +29,7 @@ void Exfile::outputComFile()
   s <<filenameBase_<< ".com";
   std::string filenameCom = s.str();
   // open file
-  std::ofstream file;
-  openFile(file, filenameCom);
+  OutputFileStream file(filenameCom, asynchronous_);
 
   // filename without path
   std::string basename = filenameBase_;
@@ -18,6 +18,7 @@
 #include "output_writer/exfile/exfile_writer.h"
 #include "output_writer/exfile/loop_output_exelem.h"
 #include "output_writer/exfile/loop_output_exnode.h"
+#include "output_writer/output_file_stream.h"
 
 namespace OutputWriter
 {
@@ -61,12 +62,11 @@ void Exfile::write(DataType& data, int timeStepNo, double currentTime, int callC
     
 
     // open file
-    std::ofstream file;
-    openFile(file, filenameExelem);
+    OutputFileStream exelemFile(filenameExelem, asynchronous_);
     // output the exelem file for all field variables that are defined on the specified meshName
     std::shared_ptr<Mesh::Mesh> mesh = nullptr;
-    ExfileLoopOverTuple::loopOutputExelem(data.getFieldVariablesForOutputWriter(), data.getFieldVariablesForOutputWriter(), meshName, file, mesh);
-    file.close();
+    ExfileLoopOverTuple::loopOutputExelem(data.getFieldVariablesForOutputWriter(), data.getFieldVariablesForOutputWriter(), meshName, exelemFile, mesh);
+    exelemFile.close();
 
     // exnode file
     s.str("");
@@ -74,10 +74,10 @@ void Exfile::write(DataType& data, int timeStepNo, double currentTime, int callC
     std::string filenameExnode = s.str();
 
     // open file
-    openFile(file, filenameExnode);
+    OutputFileStream exnodeFile(filenameExnode, asynchronous_);
     // output the exnode file for all field variables that are defined on the specified meshName
-    ExfileLoopOverTuple::loopOutputExnode(data.getFieldVariablesForOutputWriter(), data.getFieldVariablesForOutputWriter(), meshName, file);
-    file.close();
+    ExfileLoopOverTuple::loopOutputExnode(data.getFieldVariablesForOutputWriter(), data.getFieldVariablesForOutputWriter(), meshName, exnodeFile);
+    exnodeFile.close();
 
     // store created filename
     FilenameWithElementAndNodeCount item;
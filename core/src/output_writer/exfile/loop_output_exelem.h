@@ -25,7 +25,7 @@ namespace ExfileLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, typename AllFieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i == std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutputExelem(const FieldVariablesForOutputWriterType &fieldVariables, const AllFieldVariablesForOutputWriterType &allFieldVariables, std::string meshName,
-                 std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh
+                 std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh
 )
 {}
 
@@ -35,21 +35,21 @@ loopOutputExelem(const FieldVariablesForOutputWriterType &fieldVariables, const
 template<typename FieldVariablesForOutputWriterType, typename AllFieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutputExelem(const FieldVariablesForOutputWriterType &fieldVariables, const AllFieldVariablesForOutputWriterType &allFieldVariables, std::string meshName, 
-                 std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh);
+                 std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh);
 
 /** Loop body for a vector element
  */
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 outputExelem(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh);
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh);
 
 /** Loop body for a tuple element
  */
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isTuple<VectorType>::value, bool>::type
 outputExelem(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh);
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh);
 
  /**  Loop body for a pointer element
  */
@@ -57,14 +57,14 @@ template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWrit
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value
   && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputExelem(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh);
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh);
 
 /** Loop body for a field variables with Mesh::CompositeOfDimension<D>
  */
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputExelem(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh);
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh);
 
 }  // namespace ExfileLoopOverTuple
 
@@ -17,7 +17,7 @@ namespace ExfileLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, typename AllFieldVariablesForOutputWriterType, int i>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutputExelem(const FieldVariablesForOutputWriterType &fieldVariables, const AllFieldVariablesForOutputWriterType &allFieldVariables,
-                 std::string meshName, std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh
+                 std::string meshName, std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh
 )
 {
   // call what to do in the loop body
@@ -33,7 +33,7 @@ loopOutputExelem(const FieldVariablesForOutputWriterType &fieldVariables, const
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputExelem(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh)
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh)
 {
   // if mesh name is the specified meshName
   if (currentFieldVariable->functionSpace()->meshName() == meshName)
@@ -59,7 +59,7 @@ outputExelem(CurrentFieldVariableType currentFieldVariable, const FieldVariables
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 outputExelem(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh)
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh)
 {
   for (auto& currentFieldVariable : currentFieldVariableGradient)
   {
@@ -74,7 +74,7 @@ outputExelem(VectorType currentFieldVariableGradient, const FieldVariablesForOut
 template<typename TupleType, typename AllFieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
 outputExelem(TupleType currentFieldVariableTuple, const AllFieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh)
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh)
 {
   // call for tuple element
   loopOutputExelem<TupleType, AllFieldVariablesForOutputWriterType>(currentFieldVariableTuple, fieldVariables, meshName, file, mesh);
@@ -86,7 +86,7 @@ outputExelem(TupleType currentFieldVariableTuple, const AllFieldVariablesForOutp
 template<typename CurrentFieldVariableType, typename AllFieldVariablesForOutputWriterType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputExelem(CurrentFieldVariableType currentFieldVariable, const AllFieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-             std::ofstream &file, std::shared_ptr<Mesh::Mesh> &mesh)
+             std::ostream &file, std::shared_ptr<Mesh::Mesh> &mesh)
 {
   const int D = CurrentFieldVariableType::element_type::FunctionSpace::dim();
   typedef typename CurrentFieldVariableType::element_type::FunctionSpace::BasisFunction BasisFunctionType;
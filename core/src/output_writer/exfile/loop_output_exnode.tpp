@@ -17,7 +17,7 @@ namespace ExfileLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, typename AllFieldVariablesForOutputWriterType, int i>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutputExnode(const FieldVariablesForOutputWriterType &fieldVariables, const AllFieldVariablesForOutputWriterType &allFieldVariables, std::string meshName, 
-                 std::ofstream &file
+                 std::ostream &file
 )
 {
   // call what to do in the loop body
@@ -33,7 +33,7 @@ loopOutputExnode(const FieldVariablesForOutputWriterType &fieldVariables, const
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputExnode(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file)
+             std::ostream &file)
 {
   // if mesh name is the specified meshName
   if (currentFieldVariable->functionSpace()->meshName() == meshName)
@@ -58,7 +58,7 @@ outputExnode(CurrentFieldVariableType currentFieldVariable, const FieldVariables
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 outputExnode(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file)
+             std::ostream &file)
 {
   for (auto& currentFieldVariable : currentFieldVariableGradient)
   {
@@ -73,7 +73,7 @@ outputExnode(VectorType currentFieldVariableGradient, const FieldVariablesForOut
 template<typename TupleType, typename AllFieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
 outputExnode(TupleType currentFieldVariableTuple, const AllFieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-             std::ofstream &file)
+             std::ostream &file)
 {
   // call for tuple element
   loopOutputExnode<TupleType, AllFieldVariablesForOutputWriterType>(currentFieldVariableTuple, fieldVariables, meshName, file);
@@ -85,7 +85,7 @@ outputExnode(TupleType currentFieldVariableTuple, const AllFieldVariablesForOutp
 template<typename CurrentFieldVariableType, typename AllFieldVariablesForOutputWriterType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputExnode(CurrentFieldVariableType currentFieldVariable, const AllFieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-             std::ofstream &file)
+             std::ostream &file)
 {
   const int D = CurrentFieldVariableType::element_type::FunctionSpace::dim();
   typedef typename CurrentFieldVariableType::element_type::FunctionSpace::BasisFunction BasisFunctionType;
@@ -1,5 +1,7 @@
 #include "output_writer/generic.h"
 
+#include "output_writer/asynchronous_file_writer.h"
+
 #include <chrono>
 #include <thread>
 
@@ -21,6 +23,14 @@ Generic::Generic(DihuContext context, PythonConfig specificSettings, std::shared
   formatString_ = specificSettings_.getOptionString("format", "none");
   std::string fileNumbering = specificSettings_.getOptionString("fileNumbering", "incremental");
 
+  // asynchronous output: files are encoded in memory and written by a background thread
+  asynchronous_ = specificSettings_.getOptionBool("asynchronous", false);
+  if (asynchronous_)
+  {
+    int queueSize = specificSettings_.getOptionInt("asynchronousQueueSize", 2, PythonUtility::Positive);
+    AsynchronousFileWriter::instance().setMaximumQueueSize(queueSize);
+  }
+
   // determine filename base
   if (formatString_ != "PythonCallback")
   {
@@ -113,4 +123,17 @@ void Generic::setOutputFileNo(int outputFileNo)
   outputFileNo_ = outputFileNo;
 }
 
+bool Generic::willWrite(int callCountIncrement) const
+{
+  // initial values are always written
+  if (callCountIncrement == 0)
+    return true;
+
+  // same condition as in prepareWrite, evaluated for the call count after the next call
+  int writeCallCount = writeCallCount_ + callCountIncrement;
+  int lastCallCountToWrite = writeCallCount - (writeCallCount%outputInterval_);
+
+  return writeCallCount_ < lastCallCountToWrite && lastCallCountToWrite <= writeCallCount;
+}
+
 }  // namespace
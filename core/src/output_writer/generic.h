@@ -38,6 +38,9 @@ public:
   //! set the current output file no counter
   void setOutputFileNo(int outputFileNo);
 
+  //! check if the next call to write with the given callCountIncrement will actually write a file, this does not change the state of the output writer
+  bool willWrite(int callCountIncrement = 1) const;
+
 protected:
 
   //! check if output should be written in this timestep and prepare filename, i.e. set filename_ from config
@@ -55,6 +58,7 @@ protected:
   int writeCallCount_ = 0;      //< counter of calls to write
   int outputFileNo_ = 0;        //< counter of calls to write when actually a file was written
   int outputInterval_ = 0;      //< the interval in which calls to write actually write data
+  bool asynchronous_ = false;   //< if the output files are written by the AsynchronousFileWriter on a background thread
 
   std::shared_ptr<Partition::RankSubset> rankSubset_; //< the ranks that collectively call Paraview::write
 
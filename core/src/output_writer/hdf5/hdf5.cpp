@@ -0,0 +1,567 @@
+#include "output_writer/hdf5/hdf5.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>  // remove
+#include <algorithm>
+#include <array>
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+
+namespace OutputWriter
+{
+
+#ifdef HAVE_HDF5
+
+HDF5::HDF5(DihuContext context, PythonConfig settings, std::shared_ptr<Partition::RankSubset> rankSubset) :
+  Generic(context, settings, rankSubset), fileCreated_(false), fileId_(-1), xdmfClosingTagsPosition_(0)
+{
+  chunkSize_ = specificSettings_.getOptionInt("chunkSize", 65536, PythonUtility::Positive);
+  reuseUnchangedGeometry_ = specificSettings_.getOptionBool("reuseUnchangedGeometry", true);
+  compressionLevel_ = specificSettings_.getOptionInt("compressionLevel", 0, PythonUtility::NonNegative);
+
+  if (compressionLevel_ > 9)
+  {
+    LOG(WARNING) << specificSettings_ << "[\"compressionLevel\"] is " << compressionLevel_ << ", but it has to be in [0,9]. Using 9.";
+    compressionLevel_ = 9;
+  }
+}
+
+HDF5::~HDF5()
+{
+  if (fileId_ >= 0)
+  {
+    H5Fclose(fileId_);
+    fileId_ = -1;
+  }
+}
+
+void HDF5::initializeMeshes(const std::map<std::string,PolyDataPropertiesForMesh> &meshProperties)
+{
+  MPI_Comm mpiCommunicator = this->rankSubset_->mpiCommunicator();
+  int nRanks = this->rankSubset_->size();
+
+  // serialize the local mesh names and field variables, one line per mesh: "meshName\tdimensionality\tname:nComponents\t..."
+  std::stringstream localDescription;
+  for (const std::pair<const std::string,PolyDataPropertiesForMesh> &meshProperty : meshProperties)
+  {
+    localDescription << meshProperty.first << "\t" << meshProperty.second.dimensionality;
+    for (const PolyDataPropertiesForMesh::DataArrayName &dataArray : meshProperty.second.pointDataArrays)
+    {
+      localDescription << "\t" << dataArray.name << ":" << dataArray.nComponents;
+    }
+    localDescription << "\n";
+  }
+  std::string localDescriptionString = localDescription.str();
+
+  // exchange the descriptions of all ranks
+  int localLength = localDescriptionString.length();
+  std::vector<int> lengths(nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(&localLength, 1, MPI_INT, lengths.data(), 1, MPI_INT, mpiCommunicator), "MPI_Allgather");
+
+  std::vector<int> displacements(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+    displacements[rankNo] = displacements[rankNo-1] + lengths[rankNo-1];
+
+  std::vector<char> globalDescription(displacements[nRanks-1] + lengths[nRanks-1] + 1, char(0));
+  MPIUtility::handleReturnValue(MPI_Allgatherv(localDescriptionString.c_str(), localLength, MPI_CHAR,
+                                               globalDescription.data(), lengths.data(), displacements.data(), MPI_CHAR, mpiCommunicator), "MPI_Allgatherv");
+
+  // parse the descriptions in rank order, such that all ranks get the same order of field variables
+  std::stringstream globalDescriptionStream(std::string(globalDescription.data()));
+  std::string line;
+  while (std::getline(globalDescriptionStream, line))
+  {
+    std::vector<std::string> items;
+    std::stringstream lineStream(line);
+    std::string item;
+    while (std::getline(lineStream, item, '\t'))
+      items.push_back(item);
+
+    if (items.size() < 2)
+      continue;
+
+    MeshInfo &meshInfo = meshInfo_[items[0]];
+    meshInfo.dimensionality = atoi(items[1].c_str());
+    meshInfo.nNodesPerCell = 1 << meshInfo.dimensionality;
+
+    for (int i = 2; i < items.size(); i++)
+    {
+      std::size_t pos = items[i].rfind(":");
+      std::string name = items[i].substr(0, pos);
+      int nComponents = atoi(items[i].substr(pos+1).c_str());
+
+      bool isAlreadyPresent = false;
+      for (const std::pair<std::string,int> &fieldVariable : meshInfo.fieldVariables)
+      {
+        if (fieldVariable.first == name)
+          isAlreadyPresent = true;
+      }
+      if (!isAlreadyPresent)
+        meshInfo.fieldVariables.push_back(std::make_pair(name, nComponents));
+    }
+  }
+
+  // set local sizes and connectivity values
+  std::vector<long long> localSizes;
+  for (std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    std::map<std::string,PolyDataPropertiesForMesh>::const_iterator meshPropertiesIter = meshProperties.find(meshInfo.first);
+    if (meshPropertiesIter != meshProperties.end())
+    {
+      const PolyDataPropertiesForMesh &properties = meshPropertiesIter->second;
+      meshInfo.second.nPointsLocal = properties.nPointsLocal;
+      meshInfo.second.nCellsLocal = properties.nCellsLocal;
+
+      std::vector<long long> &connectivityValues = meshInfo.second.connectivityValues;
+
+      // unstructured meshes have explicit connectivity values
+      if (!properties.unstructuredMeshConnectivityValues.empty())
+      {
+        connectivityValues.assign(properties.unstructuredMeshConnectivityValues.begin(), properties.unstructuredMeshConnectivityValues.end());
+      }
+      else
+      {
+        // structured meshes, create connectivity from the number of nodes in every coordinate direction, the same as in the combined Paraview files
+        std::array<long long,3> nNodes({1,1,1});
+        for (int dimensionNo = 0; dimensionNo < properties.nNodesLocalWithGhosts.size(); dimensionNo++)
+          nNodes[dimensionNo] = properties.nNodesLocalWithGhosts[dimensionNo];
+
+        std::array<long long,3> nCells({std::max(1LL,nNodes[0]-1), std::max(1LL,nNodes[1]-1), std::max(1LL,nNodes[2]-1)});
+        if (meshInfo.second.dimensionality < 3)
+          nCells[2] = 1;
+        if (meshInfo.second.dimensionality < 2)
+          nCells[1] = 1;
+
+        for (long long indexZ = 0; indexZ < nCells[2]; indexZ++)
+        {
+          for (long long indexY = 0; indexY < nCells[1]; indexY++)
+          {
+            for (long long indexX = 0; indexX < nCells[0]; indexX++)
+            {
+              long long node0 = indexZ*nNodes[0]*nNodes[1] + indexY*nNodes[0] + indexX;
+              if (meshInfo.second.dimensionality == 1)
+              {
+                connectivityValues.insert(connectivityValues.end(), {node0, node0+1});
+              }
+              else if (meshInfo.second.dimensionality == 2)
+              {
+                connectivityValues.insert(connectivityValues.end(), {node0, node0+1, node0+nNodes[0]+1, node0+nNodes[0]});
+              }
+              else
+              {
+                long long node4 = node0 + nNodes[0]*nNodes[1];
+                connectivityValues.insert(connectivityValues.end(), {node0, node0+1, node0+nNodes[0]+1, node0+nNodes[0],
+                                                                     node4, node4+1, node4+nNodes[0]+1, node4+nNodes[0]});
+              }
+            }
+          }
+        }
+      }
+
+      if (connectivityValues.size() != meshInfo.second.nCellsLocal*meshInfo.second.nNodesPerCell)
+      {
+        LOG(WARNING) << "HDF5 output: mesh \"" << meshInfo.first << "\" has " << connectivityValues.size() << " connectivity values, but "
+          << meshInfo.second.nCellsLocal << " cells with " << meshInfo.second.nNodesPerCell << " nodes each were expected.";
+        meshInfo.second.nCellsLocal = connectivityValues.size() / meshInfo.second.nNodesPerCell;
+        connectivityValues.resize(meshInfo.second.nCellsLocal*meshInfo.second.nNodesPerCell);
+      }
+    }
+
+    localSizes.push_back(meshInfo.second.nPointsLocal);
+    localSizes.push_back(meshInfo.second.nCellsLocal);
+  }
+
+  // compute offsets and global sizes for all meshes at once
+  std::vector<long long> previousSizes(localSizes.size(), 0);
+  std::vector<long long> globalSizes(localSizes.size(), 0);
+  MPIUtility::handleReturnValue(MPI_Exscan(localSizes.data(), previousSizes.data(), localSizes.size(), MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Exscan");
+  MPIUtility::handleReturnValue(MPI_Allreduce(localSizes.data(), globalSizes.data(), localSizes.size(), MPI_LONG_LONG, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+
+  // the result of MPI_Exscan is undefined on rank 0
+  if (this->rankSubset_->ownRankNo() == 0)
+    std::fill(previousSizes.begin(), previousSizes.end(), 0);
+
+  int meshNo = 0;
+  for (std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    meshInfo.second.nPointsPreviousRanks = previousSizes[2*meshNo + 0];
+    meshInfo.second.nCellsPreviousRanks = previousSizes[2*meshNo + 1];
+    meshInfo.second.nPointsGlobal = globalSizes[2*meshNo + 0];
+    meshInfo.second.nCellsGlobal = globalSizes[2*meshNo + 1];
+
+    // convert local point numbers to global point numbers
+    for (long long &value : meshInfo.second.connectivityValues)
+      value += meshInfo.second.nPointsPreviousRanks;
+
+    LOG(DEBUG) << "HDF5 output: mesh \"" << meshInfo.first << "\", " << meshInfo.second.nPointsGlobal << " points, "
+      << meshInfo.second.nCellsGlobal << " cells, " << meshInfo.second.fieldVariables.size() << " field variables";
+    meshNo++;
+  }
+}
+
+void HDF5::createFile()
+{
+  // the filename base can be changed after construction, by Manager::setFilename
+  hdf5Filename_ = filenameBase_ + ".h5";
+
+  // create the directory on rank 0 and remove an existing file
+  if (this->rankSubset_->ownRankNo() == 0)
+  {
+    std::ofstream file;
+    Generic::openFile(file, hdf5Filename_);
+    file.close();
+    std::remove(hdf5Filename_.c_str());
+  }
+  MPIUtility::handleReturnValue(MPI_Barrier(this->rankSubset_->mpiCommunicator()), "MPI_Barrier");
+
+  hid_t fileAccessPropertyList = H5Pcreate(H5P_FILE_ACCESS);
+  H5Pset_fapl_mpio(fileAccessPropertyList, this->rankSubset_->mpiCommunicator(), MPI_INFO_NULL);
+  fileId_ = H5Fcreate(hdf5Filename_.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fileAccessPropertyList);
+  H5Pclose(fileAccessPropertyList);
+
+  hid_t fileId = fileId_;
+  if (fileId < 0)
+  {
+    LOG(ERROR) << "Could not create HDF5 file \"" << hdf5Filename_ << "\".";
+    return;
+  }
+
+  // dataset for the simulation times
+  hid_t datasetId = createDataset(fileId, "time", H5T_NATIVE_DOUBLE, {0}, {H5S_UNLIMITED}, {1024});
+  H5Dclose(datasetId);
+
+  for (std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    if (meshInfo.second.nPointsGlobal == 0)
+      continue;
+
+    hid_t groupId = H5Gcreate2(fileId, datasetName(meshInfo.first).c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+    // the connectivity does not change, write it now
+    if (meshInfo.second.nCellsGlobal > 0)
+    {
+      hsize_t nNodesPerCell = meshInfo.second.nNodesPerCell;
+      hsize_t nChunkCells = std::max(hsize_t(1), std::min(hsize_t(meshInfo.second.nCellsGlobal), hsize_t(chunkSize_)));
+      datasetId = createDataset(groupId, "connectivity", H5T_NATIVE_LLONG, {meshInfo.second.nCellsGlobal, nNodesPerCell},
+                                {meshInfo.second.nCellsGlobal, nNodesPerCell}, {nChunkCells, nNodesPerCell});
+
+      writeHyperslab(datasetId, H5T_NATIVE_LLONG, {meshInfo.second.nCellsPreviousRanks, 0}, {meshInfo.second.nCellsLocal, nNodesPerCell},
+                     meshInfo.second.connectivityValues.data());
+      H5Dclose(datasetId);
+    }
+    meshInfo.second.connectivityValues.clear();
+    meshInfo.second.connectivityValues.shrink_to_fit();
+
+    // datasets for the field variables, their first dimension is the time and grows with every output
+    hsize_t nChunkPoints = std::min(hsize_t(meshInfo.second.nPointsGlobal), hsize_t(chunkSize_));
+    for (const std::pair<std::string,int> &fieldVariable : meshInfo.second.fieldVariables)
+    {
+      hsize_t nComponents = fieldVariable.second;
+      datasetId = createDataset(groupId, datasetName(fieldVariable.first), H5T_NATIVE_DOUBLE, {0, meshInfo.second.nPointsGlobal, nComponents},
+                                {H5S_UNLIMITED, meshInfo.second.nPointsGlobal, nComponents}, {1, nChunkPoints, nComponents});
+      H5Dclose(datasetId);
+    }
+
+    H5Gclose(groupId);
+  }
+
+  fileCreated_ = true;
+
+  LOG(INFO) << "Created HDF5 file \"" << hdf5Filename_ << "\".";
+}
+
+void HDF5::writeTime(hid_t fileId, double currentTime)
+{
+  times_.push_back(currentTime);
+  hsize_t nTimeSteps = times_.size();
+
+  hid_t datasetId = H5Dopen2(fileId, "time", H5P_DEFAULT);
+  H5Dset_extent(datasetId, &nTimeSteps);
+
+  // only rank 0 writes the value
+  hsize_t count = (this->rankSubset_->ownRankNo() == 0? 1 : 0);
+  writeHyperslab(datasetId, H5T_NATIVE_DOUBLE, {nTimeSteps-1}, {count}, &currentTime);
+  H5Dclose(datasetId);
+}
+
+std::vector<int> HDF5::determineChangedGeometries(const std::map<std::string,std::vector<int>> &geometryVersions)
+{
+  // compare the versions of the local geometry fields with the ones at the last output
+  std::vector<int> localHasChanged;
+  for (std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    std::vector<int> versions;
+    std::map<std::string,std::vector<int>>::const_iterator iter = geometryVersions.find(meshInfo.first);
+    if (iter != geometryVersions.end())
+      versions = iter->second;
+
+    bool hasChanged = meshInfo.second.nGeometryVersions == 0 || !reuseUnchangedGeometry_ || versions != meshInfo.second.lastGeometryVersions;
+    localHasChanged.push_back(hasChanged? 1 : 0);
+    meshInfo.second.lastGeometryVersions = versions;
+  }
+
+  // a geometry has changed if it has changed on any rank
+  std::vector<int> hasChanged(localHasChanged.size(), 0);
+  MPIUtility::handleReturnValue(MPI_Allreduce(localHasChanged.data(), hasChanged.data(), localHasChanged.size(), MPI_INT, MPI_MAX,
+                                              this->rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+  return hasChanged;
+}
+
+void HDF5::writeGeometry(hid_t fileId, const std::map<std::string,std::vector<double>> &geometryValues, const std::vector<int> &geometryHasChanged)
+{
+  // write new geometry datasets for the meshes with changed geometry
+  int meshNo = 0;
+  for (std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    if (meshInfo.second.nPointsGlobal > 0 && geometryHasChanged[meshNo])
+    {
+      std::vector<double> values;
+      std::map<std::string,std::vector<double>>::const_iterator iter = geometryValues.find(meshInfo.first);
+      if (iter != geometryValues.end())
+        values = iter->second;
+
+      // the geometry field may have been collected multiple times if it is contained multiple times in the output data
+      values.resize(3*meshInfo.second.nPointsLocal, 0.0);
+
+      std::stringstream name;
+      name << datasetName(meshInfo.first) << "/geometry_" << meshInfo.second.nGeometryVersions;
+
+      hsize_t nChunkPoints = std::min(hsize_t(meshInfo.second.nPointsGlobal), hsize_t(chunkSize_));
+      hid_t datasetId = createDataset(fileId, name.str(), H5T_NATIVE_DOUBLE, {meshInfo.second.nPointsGlobal, 3},
+                                      {meshInfo.second.nPointsGlobal, 3}, {nChunkPoints, 3});
+
+      writeHyperslab(datasetId, H5T_NATIVE_DOUBLE, {meshInfo.second.nPointsPreviousRanks, 0}, {meshInfo.second.nPointsLocal, 3},
+                     values.data());
+      H5Dclose(datasetId);
+
+      meshInfo.second.nGeometryVersions++;
+    }
+
+    meshInfo.second.geometryVersionOfTimeStep.push_back(meshInfo.second.nGeometryVersions-1);
+    meshNo++;
+  }
+}
+
+void HDF5::writeFieldVariables(hid_t fileId, std::string meshName, std::map<std::string,std::vector<double>> &values)
+{
+  MeshInfo &meshInfo = meshInfo_[meshName];
+  if (meshInfo.nPointsGlobal == 0)
+    return;
+
+  hsize_t timeStepNo = times_.size()-1;
+  hid_t groupId = H5Gopen2(fileId, datasetName(meshName).c_str(), H5P_DEFAULT);
+
+  for (const std::pair<std::string,int> &fieldVariable : meshInfo.fieldVariables)
+  {
+    hsize_t nComponents = fieldVariable.second;
+
+    // ranks that do not have this field variable write zeros, a field variable that was collected multiple times is truncated
+    std::vector<double> &fieldVariableValues = values[fieldVariable.first];
+    fieldVariableValues.resize(meshInfo.nPointsLocal*nComponents, 0.0);
+
+    hid_t datasetId = H5Dopen2(groupId, datasetName(fieldVariable.first).c_str(), H5P_DEFAULT);
+
+    std::array<hsize_t,3> dimensions({timeStepNo+1, meshInfo.nPointsGlobal, nComponents});
+    H5Dset_extent(datasetId, dimensions.data());
+
+    writeHyperslab(datasetId, H5T_NATIVE_DOUBLE, {timeStepNo, meshInfo.nPointsPreviousRanks, 0}, {1, meshInfo.nPointsLocal, nComponents},
+                   fieldVariableValues.data());
+    H5Dclose(datasetId);
+  }
+
+  H5Gclose(groupId);
+}
+
+void HDF5::writeHyperslab(hid_t datasetId, hid_t memoryType, const std::vector<hsize_t> &offset, const std::vector<hsize_t> &count, const void *buffer)
+{
+  hsize_t nValues = 1;
+  for (hsize_t value : count)
+    nValues *= value;
+
+  hid_t fileSpace = H5Dget_space(datasetId);
+  hid_t memorySpace;
+
+  // ranks without data have to participate in the collective write with an empty selection
+  static double dummyBuffer = 0;
+  if (nValues == 0)
+  {
+    H5Sselect_none(fileSpace);
+    memorySpace = H5Scopy(fileSpace);
+    H5Sselect_none(memorySpace);
+    buffer = &dummyBuffer;
+  }
+  else
+  {
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset.data(), NULL, count.data(), NULL);
+    memorySpace = H5Screate_simple(count.size(), count.data(), NULL);
+  }
+
+  hid_t transferPropertyList = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(transferPropertyList, H5FD_MPIO_COLLECTIVE);
+
+  herr_t status = H5Dwrite(datasetId, memoryType, memorySpace, fileSpace, transferPropertyList, buffer);
+  if (status < 0)
+  {
+    LOG(ERROR) << "Writing to HDF5 file \"" << hdf5Filename_ << "\" failed.";
+  }
+
+  H5Pclose(transferPropertyList);
+  H5Sclose(memorySpace);
+  H5Sclose(fileSpace);
+}
+
+hid_t HDF5::createDataset(hid_t locationId, std::string name, hid_t type, const std::vector<hsize_t> &dimensions,
+                          const std::vector<hsize_t> &maximumDimensions, const std::vector<hsize_t> &chunkDimensions)
+{
+  hid_t dataspaceId = H5Screate_simple(dimensions.size(), dimensions.data(), maximumDimensions.data());
+
+  hid_t creationPropertyList = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_chunk(creationPropertyList, chunkDimensions.size(), chunkDimensions.data());
+  if (compressionLevel_ > 0)
+  {
+    H5Pset_deflate(creationPropertyList, compressionLevel_);
+  }
+
+  hid_t datasetId = H5Dcreate2(locationId, name.c_str(), type, dataspaceId, H5P_DEFAULT, creationPropertyList, H5P_DEFAULT);
+  if (datasetId < 0)
+  {
+    LOG(ERROR) << "Could not create dataset \"" << name << "\" in HDF5 file \"" << hdf5Filename_ << "\".";
+  }
+
+  H5Pclose(creationPropertyList);
+  H5Sclose(dataspaceId);
+  return datasetId;
+}
+
+void HDF5::writeXdmfFile()
+{
+  if (this->rankSubset_->ownRankNo() != 0)
+    return;
+
+  // filename of the HDF5 file relative to the XDMF file
+  std::string hdf5Filename = hdf5Filename_;
+  if (hdf5Filename.rfind("/") != std::string::npos)
+    hdf5Filename = hdf5Filename.substr(hdf5Filename.rfind("/")+1);
+
+  // only the grid of the new time step is added to the file, it references the datasets in the state of this time step
+  const int timeStepNo = times_.size()-1;
+
+  std::stringstream file;
+  if (timeStepNo == 0)
+  {
+    file << "<?xml version=\"1.0\" ?>" << std::endl
+      << "<!-- " << DihuContext::versionText() << " " << DihuContext::metaText() << "-->" << std::endl
+      << "<Xdmf Version=\"3.0\">" << std::endl
+      << std::string(1, '\t') << "<Domain>" << std::endl
+      << std::string(2, '\t') << "<Grid Name=\"TimeSeries\" GridType=\"Collection\" CollectionType=\"Temporal\">" << std::endl;
+  }
+
+  file << std::string(3, '\t') << "<Grid Name=\"timeStep" << timeStepNo << "\" GridType=\"Collection\" CollectionType=\"Spatial\">" << std::endl
+    << std::string(4, '\t') << "<Time Value=\"" << std::setprecision(16) << times_[timeStepNo] << "\" />" << std::endl;
+
+  for (std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    const MeshInfo &mesh = meshInfo.second;
+    if (mesh.nPointsGlobal == 0 || mesh.nCellsGlobal == 0)
+      continue;
+
+    std::string groupName = std::string("/") + datasetName(meshInfo.first);
+
+    std::string topologyType = "Polyline\" NodesPerElement=\"2";
+    if (mesh.dimensionality == 2)
+      topologyType = "Quadrilateral";
+    else if (mesh.dimensionality == 3)
+      topologyType = "Hexahedron";
+
+    file << std::string(4, '\t') << "<Grid Name=\"" << meshInfo.first << "\" GridType=\"Uniform\">" << std::endl
+      << std::string(5, '\t') << "<Topology TopologyType=\"" << topologyType << "\" NumberOfElements=\"" << mesh.nCellsGlobal << "\">" << std::endl
+      << std::string(6, '\t') << "<DataItem Dimensions=\"" << mesh.nCellsGlobal << " " << mesh.nNodesPerCell << "\" NumberType=\"Int\" Precision=\"8\" Format=\"HDF\">"
+      << hdf5Filename << ":" << groupName << "/connectivity</DataItem>" << std::endl
+      << std::string(5, '\t') << "</Topology>" << std::endl
+      << std::string(5, '\t') << "<Geometry GeometryType=\"XYZ\">" << std::endl
+      << std::string(6, '\t') << "<DataItem Dimensions=\"" << mesh.nPointsGlobal << " 3\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+      << hdf5Filename << ":" << groupName << "/geometry_" << mesh.geometryVersionOfTimeStep[timeStepNo] << "</DataItem>" << std::endl
+      << std::string(5, '\t') << "</Geometry>" << std::endl;
+
+    for (const std::pair<std::string,int> &fieldVariable : mesh.fieldVariables)
+    {
+      int nComponents = fieldVariable.second;
+      std::string attributeType = "Matrix";
+      if (nComponents == 1)
+        attributeType = "Scalar";
+      else if (nComponents == 3)
+        attributeType = "Vector";
+      else if (nComponents == 6)
+        attributeType = "Tensor6";
+      else if (nComponents == 9)
+        attributeType = "Tensor";
+
+      // select the current time step from the dataset with dimensions (nTimeSteps, nPoints, nComponents)
+      file << std::string(5, '\t') << "<Attribute Name=\"" << fieldVariable.first << "\" AttributeType=\"" << attributeType << "\" Center=\"Node\">" << std::endl
+        << std::string(6, '\t') << "<DataItem ItemType=\"HyperSlab\" Dimensions=\"" << mesh.nPointsGlobal << " " << nComponents << "\">" << std::endl
+        << std::string(7, '\t') << "<DataItem Dimensions=\"3 3\" Format=\"XML\">"
+        << timeStepNo << " 0 0 1 1 1 1 " << mesh.nPointsGlobal << " " << nComponents << "</DataItem>" << std::endl
+        << std::string(7, '\t') << "<DataItem Dimensions=\"" << timeStepNo+1 << " " << mesh.nPointsGlobal << " " << nComponents
+        << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+        << hdf5Filename << ":" << groupName << "/" << datasetName(fieldVariable.first) << "</DataItem>" << std::endl
+        << std::string(6, '\t') << "</DataItem>" << std::endl
+        << std::string(5, '\t') << "</Attribute>" << std::endl;
+    }
+
+    file << std::string(4, '\t') << "</Grid>" << std::endl;
+  }
+
+  file << std::string(3, '\t') << "</Grid>" << std::endl;
+
+  std::stringstream closingTags;
+  closingTags << std::string(2, '\t') << "</Grid>" << std::endl
+    << std::string(1, '\t') << "</Domain>" << std::endl
+    << "</Xdmf>" << std::endl;
+
+  // at the first output create the file (and the directory), truncate an existing file
+  std::string xdmfFilename = filenameBase_ + ".xdmf";
+  if (timeStepNo == 0)
+  {
+    std::ofstream newFile;
+    Generic::openFile(newFile, xdmfFilename);
+    newFile.close();
+    xdmfClosingTagsPosition_ = 0;
+  }
+
+  std::fstream xdmfFile(xdmfFilename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+  if (!xdmfFile.is_open())
+  {
+    LOG(ERROR) << "Could not open XDMF file \"" << xdmfFilename << "\".";
+    return;
+  }
+
+  // overwrite the closing tags of the last output by the new time step, which is longer, and append the closing tags again
+  xdmfFile.seekp(xdmfClosingTagsPosition_);
+  xdmfFile << file.str();
+  xdmfClosingTagsPosition_ = xdmfFile.tellp();
+  xdmfFile << closingTags.str();
+  xdmfFile.close();
+}
+
+std::string HDF5::datasetName(std::string name)
+{
+  std::replace(name.begin(), name.end(), '/', '_');
+  if (name.empty() || name == ".")
+    name = "_";
+  return name;
+}
+
+#else
+
+HDF5::HDF5(DihuContext context, PythonConfig settings, std::shared_ptr<Partition::RankSubset> rankSubset) :
+  Generic(context, settings, rankSubset)
+{
+}
+
+#endif
+
+}  // namespace
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <iostream>
+#include <vector>
+#include <map>
+#include <set>
+
+#ifdef HAVE_HDF5
+#include <hdf5.h>
+#endif
+
+#include "control/types.h"
+#include "output_writer/generic.h"
+#include "output_writer/paraview/poly_data_properties_for_mesh.h"
+
+namespace OutputWriter
+{
+
+/** Output writer that collectively writes all field variables of all meshes into a single HDF5 file per run (<filename>.h5),
+ *  using parallel HDF5 (MPI-IO). Every field variable is stored as a dataset with dimensions (nTimeSteps, nPoints, nComponents),
+ *  where the time dimension grows with every output. The simulation times are stored in the dataset "/time".
+ *  The mesh connectivity is written once, the geometry only when it has changed since the last output, which is detected by the values versions of the geometry fields.
+ *  The file stays open until the writer is destroyed.
+ *  Additionally, an XDMF file (<filename>.xdmf) is written that references the datasets and can be opened directly with ParaView.
+ *  The XDMF file is extended by the new time step at every output, only the closing tags are rewritten.
+ *
+ *  The points of a mesh are the local nodes with ghosts of every rank, concatenated in rank order, like in the combined Paraview files.
+ */
+class HDF5 : public Generic
+{
+public:
+
+  //! constructor
+  HDF5(DihuContext context, PythonConfig specificSettings, std::shared_ptr<Partition::RankSubset> rankSubset = nullptr);
+
+  //! destructor, closes the HDF5 file
+  virtual ~HDF5();
+
+  //! write out the current values of all field variables as a new time step
+  template<typename DataType>
+  void write(DataType &data, int timeStepNo = -1, double currentTime = -1, int callCountIncrement = 1);
+
+#ifdef HAVE_HDF5
+protected:
+
+  /** information of one mesh in the output file. All ranks have an entry for all meshes, also if they do not own a part of the mesh.
+   */
+  struct MeshInfo
+  {
+    int dimensionality = 0;                 //< dimensionality of the mesh, 1, 2 or 3
+    int nNodesPerCell = 0;                  //< 2 for lines, 4 for quadrilaterals and 8 for hexahedra
+    std::vector<std::pair<std::string,int>> fieldVariables;   //< name and number of components of the (non-geometry) field variables
+
+    global_no_t nPointsLocal = 0;           //< number of points that this rank writes, i.e. local nodes with ghosts
+    global_no_t nCellsLocal = 0;            //< number of cells that this rank writes
+    global_no_t nPointsPreviousRanks = 0;   //< sum of nPointsLocal of all ranks with lower rank no
+    global_no_t nCellsPreviousRanks = 0;    //< sum of nCellsLocal of all ranks with lower rank no
+    global_no_t nPointsGlobal = 0;          //< sum of nPointsLocal of all ranks
+    global_no_t nCellsGlobal = 0;           //< sum of nCellsLocal of all ranks
+
+    std::vector<long long> connectivityValues;  //< the global point numbers of the local cells, only needed until it is written
+    std::vector<int> lastGeometryVersions;      //< the values versions of the local geometry fields at the last output, to detect changes
+    int nGeometryVersions = 0;                  //< number of geometry datasets in the file, they are named "geometry_0", "geometry_1", ...
+    std::vector<int> geometryVersionOfTimeStep; //< for every written time step the geometry dataset to use, this is needed for the XDMF file
+  };
+
+  //! initialize meshInfo_ from the local mesh properties, this exchanges mesh names and sizes between all ranks
+  void initializeMeshes(const std::map<std::string,PolyDataPropertiesForMesh> &meshProperties);
+
+  //! create the file and the datasets, write the connectivity values, the file stays open in fileId_
+  void createFile();
+
+  //! determine for every mesh in meshInfo_ if the geometry has changed on any rank, by comparing the given local geometry field versions to the ones of the last output
+  std::vector<int> determineChangedGeometries(const std::map<std::string,std::vector<int>> &geometryVersions);
+
+  //! write the geometry of the meshes with geometryHasChanged set (in the order of meshInfo_), geometryValues[meshName] contains the local values
+  void writeGeometry(hid_t fileId, const std::map<std::string,std::vector<double>> &geometryValues, const std::vector<int> &geometryHasChanged);
+
+  //! write the values of the field variables of the given mesh as the next time step
+  void writeFieldVariables(hid_t fileId, std::string meshName, std::map<std::string,std::vector<double>> &values);
+
+  //! append the current time to the "/time" dataset
+  void writeTime(hid_t fileId, double currentTime);
+
+  //! add the last time step to the XDMF file, only on rank 0
+  void writeXdmfFile();
+
+  //! collectively write a block of a dataset that starts at offset with the given count, if the count is zero, nothing is selected on this rank
+  void writeHyperslab(hid_t datasetId, hid_t memoryType, const std::vector<hsize_t> &offset, const std::vector<hsize_t> &count, const void *buffer);
+
+  //! create a chunked dataset with the given dimensions, maximumDimensions may contain H5S_UNLIMITED, uses compression if compressionLevel_ is set
+  hid_t createDataset(hid_t locationId, std::string name, hid_t type, const std::vector<hsize_t> &dimensions,
+                      const std::vector<hsize_t> &maximumDimensions, const std::vector<hsize_t> &chunkDimensions);
+
+  //! get the name of a dataset or group from a field variable or mesh name, this replaces characters that are not allowed
+  static std::string datasetName(std::string name);
+
+  std::map<std::string,MeshInfo> meshInfo_;   //< information about all meshes, key is the mesh name
+  std::vector<double> times_;                 //< the simulation times of all written time steps
+  bool fileCreated_;                          //< if the HDF5 file was already created
+  hid_t fileId_;                              //< the open HDF5 file, or -1
+  std::string hdf5Filename_;                  //< the name of the HDF5 file, <filename>.h5
+  std::streampos xdmfClosingTagsPosition_;    //< position in the XDMF file where the closing tags start, the next time step is written there
+  bool reuseUnchangedGeometry_;               //< if the geometry should only be written when the versions of the geometry fields have changed
+
+  int chunkSize_;                             //< maximum number of points per chunk of the datasets
+  int compressionLevel_;                      //< gzip compression level 1-9, or 0 for no compression
+#endif
+};
+
+} // namespace
+
+#include "output_writer/hdf5/hdf5.tpp"
@@ -0,0 +1,105 @@
+#include "output_writer/hdf5/hdf5.h"
+
+#include <iostream>
+
+#include "easylogging++.h"
+
+#include "output_writer/paraview/loop_collect_mesh_properties.h"
+#include "output_writer/paraview/loop_get_nodal_values.h"
+#include "output_writer/paraview/loop_get_geometry_field_nodal_values.h"
+#include "output_writer/paraview/loop_get_geometry_field_versions.h"
+#include "control/diagnostic_tool/performance_measurement.h"
+
+namespace OutputWriter
+{
+
+template<typename DataType>
+void HDF5::write(DataType& data, int timeStepNo, double currentTime, int callCountIncrement)
+{
+  // check if output should be written in this timestep and prepare filename
+  if (!Generic::prepareWrite(data, timeStepNo, currentTime, callCountIncrement))
+  {
+    return;
+  }
+
+#ifdef HAVE_HDF5
+  Control::PerformanceMeasurement::start("durationHDF5Output");
+
+  typedef typename DataType::FieldVariablesForOutputWriter FieldVariablesForOutputWriterType;
+  FieldVariablesForOutputWriterType fieldVariables = data.getFieldVariablesForOutputWriter();
+
+  // at the first call, collect the meshes and their sizes and create the file with all datasets
+  if (!fileCreated_)
+  {
+    std::map<std::string,PolyDataPropertiesForMesh> meshProperties;
+    std::vector<std::string> meshNamesVector;
+    ParaviewLoopOverTuple::loopCollectMeshProperties<FieldVariablesForOutputWriterType>(fieldVariables, meshProperties, meshNamesVector);
+
+    initializeMeshes(meshProperties);
+    createFile();
+  }
+
+  if (fileId_ < 0)
+  {
+    Control::PerformanceMeasurement::stop("durationHDF5Output");
+    return;
+  }
+
+  // determine which geometries have changed since the last output, by the values versions of the geometry fields
+  std::map<std::string,std::vector<int>> geometryVersions;
+  for (const std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    // skip meshes that are not present on the own rank
+    if (meshInfo.second.nPointsLocal == 0)
+      continue;
+
+    std::set<std::string> meshNames;
+    meshNames.insert(meshInfo.first);
+    ParaviewLoopOverTuple::loopGetGeometryFieldVersions<FieldVariablesForOutputWriterType>(fieldVariables, meshNames, geometryVersions[meshInfo.first]);
+  }
+
+  std::vector<int> geometryHasChanged = determineChangedGeometries(geometryVersions);
+
+  // get the local field variable values of all meshes and the geometry values of the changed meshes
+  std::map<std::string,std::vector<double>> geometryValues;
+  std::map<std::string,std::map<std::string,std::vector<double>>> fieldVariableValues;
+
+  int meshNo = 0;
+  for (const std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    // skip meshes that are not present on the own rank
+    if (meshInfo.second.nPointsLocal == 0)
+    {
+      meshNo++;
+      continue;
+    }
+
+    std::set<std::string> meshNames;
+    meshNames.insert(meshInfo.first);
+
+    if (geometryHasChanged[meshNo])
+      ParaviewLoopOverTuple::loopGetGeometryFieldNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, meshNames, geometryValues[meshInfo.first]);
+    ParaviewLoopOverTuple::loopGetNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, meshNames, fieldVariableValues[meshInfo.first]);
+    meshNo++;
+  }
+
+  // write all data collectively
+  writeTime(fileId_, currentTime);
+  writeGeometry(fileId_, geometryValues, geometryHasChanged);
+
+  for (const std::pair<const std::string,MeshInfo> &meshInfo : meshInfo_)
+  {
+    writeFieldVariables(fileId_, meshInfo.first, fieldVariableValues[meshInfo.first]);
+  }
+
+  // make the new time step visible to readers, the file stays open for the next output
+  H5Fflush(fileId_, H5F_SCOPE_GLOBAL);
+
+  // update the XDMF file such that it contains the new time step
+  writeXdmfFile();
+
+  Control::PerformanceMeasurement::stop("durationHDF5Output");
+#endif
+}
+
+}  // namespace
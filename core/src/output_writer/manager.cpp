@@ -8,6 +8,7 @@
 #include "output_writer/paraview/paraview.h"
 #include "output_writer/exfile/exfile.h"
 #include "output_writer/megamol/megamol.h"
+#include "output_writer/hdf5/hdf5.h"
 
 namespace OutputWriter
 {
@@ -110,12 +111,20 @@ void Manager::createOutputWriterFromSettings(DihuContext context, PythonConfig s
       outputWriter_.push_back(std::make_shared<MegaMol>(context, settings, rankSubset));
 #else
       LOG(ERROR) << "Not compiled with ADIOS, but a \"MegaMol\" output writer was specified. Ignoring this output writer.";
+#endif
+    }
+    else if (typeString == "HDF5")
+    {
+#ifdef HAVE_HDF5
+      outputWriter_.push_back(std::make_shared<HDF5>(context, settings, rankSubset));
+#else
+      LOG(ERROR) << "Not compiled with HDF5, but a \"HDF5\" output writer was specified. Ignoring this output writer.";
 #endif
     }
     else
     {
       LOG(WARNING) << "Unknown output writer type \"" << typeString<< "\". "
-        << "Valid options are: \"Paraview\", \"PythonCallback\", \"PythonFile\", \"Exfile\", \"MegaMol\"";
+        << "Valid options are: \"Paraview\", \"PythonCallback\", \"PythonFile\", \"Exfile\", \"MegaMol\", \"HDF5\"";
     }
   }
 }
@@ -125,6 +134,16 @@ bool Manager::hasOutputWriters()
   return !outputWriter_.empty();
 }
 
+bool Manager::willWriteOutput(int callCountIncrement) const
+{
+  for (const std::shared_ptr<Generic> &outputWriter : outputWriter_)
+  {
+    if (outputWriter->willWrite(callCountIncrement))
+      return true;
+  }
+  return false;
+}
+
 //! get the filename of the first output writer
 std::string Manager::filename()
 {
@@ -7,6 +7,7 @@
 #include "control/types.h"
 #include "data_management/data.h"
 #include "output_writer/generic.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace OutputWriter
 {
@@ -30,6 +31,9 @@ public:
   //! if this manager contains any output writers
   bool hasOutputWriters();
 
+  //! if any of the output writers will write a file in the next call to writeOutput with the given callCountIncrement, can be used to skip computations that are only needed for output
+  bool willWriteOutput(int callCountIncrement = 1) const;
+
   //! get the filename of the first output writer
   std::string filename();
 
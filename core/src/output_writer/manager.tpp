@@ -5,6 +5,7 @@
 #include "output_writer/paraview/paraview.h"
 #include "output_writer/exfile/exfile.h"
 #include "output_writer/megamol/megamol.h"
+#include "output_writer/hdf5/hdf5.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 
 namespace OutputWriter
@@ -68,6 +69,16 @@ void Manager::writeOutput(DataType &problemData, int timeStepNo, double currentT
 
       Control::PerformanceMeasurement::stop("durationWriteOutputMegamol");
     }
+    else if (std::dynamic_pointer_cast<HDF5>(outputWriter) != nullptr)
+    {
+      LogScope s ("WriteOutputHDF5");
+      Control::PerformanceMeasurement::start("durationWriteOutputHDF5");
+
+      std::shared_ptr<HDF5> writer = std::static_pointer_cast<HDF5>(outputWriter);
+      writer->write<DataType>(problemData, timeStepNo, currentTime, callCountIncrement);
+
+      Control::PerformanceMeasurement::stop("durationWriteOutputHDF5");
+    }
   }
 
   // stop duration measurement
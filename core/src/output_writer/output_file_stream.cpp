@@ -0,0 +1,90 @@
+#include "output_writer/output_file_stream.h"
+
+#include "output_writer/generic.h"
+#include "output_writer/asynchronous_file_writer.h"
+
+namespace OutputWriter
+{
+
+OutputFileStream::OutputFileStream(std::string filename, bool asynchronous, bool append) :
+  std::ostream(nullptr), filename_(filename), asynchronous_(asynchronous), append_(append), isOpen_(false)
+{
+  if (asynchronous_)
+  {
+    rdbuf(&buffer_);
+    isOpen_ = true;
+  }
+  else
+  {
+    Generic::openFile(file_, filename_, append_);
+    rdbuf(file_.rdbuf());
+    isOpen_ = file_.is_open();
+  }
+}
+
+OutputFileStream::~OutputFileStream()
+{
+  close();
+}
+
+bool OutputFileStream::is_open()
+{
+  return isOpen_;
+}
+
+void OutputFileStream::close()
+{
+  if (!isOpen_)
+    return;
+
+  isOpen_ = false;
+  if (asynchronous_)
+  {
+    if (deferredParts_.empty())
+    {
+      AsynchronousFileWriter::instance().enqueue(filename_, buffer_.str(), append_);
+    }
+    else
+    {
+      // concatenate all parts on the background thread
+      AsynchronousFileWriter::instance().enqueueDeferred(filename_, [parts = std::move(deferredParts_), remainder = buffer_.str()]()
+      {
+        std::string contents;
+        for (const std::function<std::string()> &part : parts)
+        {
+          contents += part();
+        }
+        contents += remainder;
+        return contents;
+      }, append_);
+      deferredParts_.clear();
+    }
+    buffer_.str("");
+  }
+  else
+  {
+    file_.close();
+  }
+}
+
+void OutputFileStream::writeEncoded(std::ostream &stream, std::function<std::string()> encode)
+{
+  OutputFileStream *outputFileStream = dynamic_cast<OutputFileStream *>(&stream);
+
+  if (outputFileStream && outputFileStream->asynchronous_ && outputFileStream->isOpen_)
+  {
+    // store the text that was written so far and the encode function, both are concatenated by the background thread
+    outputFileStream->deferredParts_.push_back([text = outputFileStream->buffer_.str()]()
+    {
+      return text;
+    });
+    outputFileStream->buffer_.str("");
+    outputFileStream->deferredParts_.push_back(std::move(encode));
+  }
+  else
+  {
+    stream << encode();
+  }
+}
+
+}  // namespace
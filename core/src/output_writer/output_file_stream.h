@@ -0,0 +1,48 @@
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace OutputWriter
+{
+
+/** An output stream for a single output file. If asynchronous is false, it directly writes to the file like a std::ofstream.
+ *  If asynchronous is true, the contents are collected in memory and are handed to the AsynchronousFileWriter on close(),
+ *  which writes the file on a background thread.
+ *  This way, the output writers can use the same code for both cases, they only need to take a std::ostream.
+ *  Expensive encodings of data arrays can be passed to writeEncoded(), in asynchronous mode they are then executed on the background thread.
+ */
+class OutputFileStream : public std::ostream
+{
+public:
+  //! constructor, opens the file (synchronous mode) or prepares the memory buffer (asynchronous mode)
+  OutputFileStream(std::string filename, bool asynchronous, bool append=false);
+
+  //! destructor, closes the file if this was not yet done
+  ~OutputFileStream();
+
+  //! if the stream can be written to
+  bool is_open();
+
+  //! close the file, in asynchronous mode this enqueues the buffered contents at the AsynchronousFileWriter
+  void close();
+
+  //! write the string returned by encode to the stream. If stream is an asynchronous OutputFileStream, encode is called later on the background thread,
+  //! then it must own all data that it uses (capture by value) and must not access Petsc, MPI or the logger. Otherwise, it is called immediately.
+  static void writeEncoded(std::ostream &stream, std::function<std::string()> encode);
+
+private:
+  std::string filename_;     //< the name of the file
+  bool asynchronous_;        //< if the file is written on the background thread
+  bool append_;              //< if the contents are appended to an existing file
+  bool isOpen_;              //< if the stream is open and close() has not yet been called
+  std::ofstream file_;       //< the file, used in synchronous mode
+  std::stringbuf buffer_;    //< the memory buffer, used in asynchronous mode
+  std::vector<std::function<std::string()>> deferredParts_;   //< in asynchronous mode, the parts of the file that precede the current buffer_, they are evaluated on the background thread
+};
+
+} // namespace
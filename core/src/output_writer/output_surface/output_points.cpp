@@ -9,7 +9,8 @@ namespace OutputWriter
 {
 
 void OutputPoints::
-writeCsvFile(std::string filename, double currentTime, const std::vector<double> &geometry, const std::vector<double> &values, bool writeGeometry)
+writeCsvFile(std::string filename, double currentTime, const std::vector<double> &geometry, const std::vector<double> &values,
+             bool writeGeometry, bool writeHeaderAtFirstTimestep)
 {
   std::ofstream file;
   Generic::openFile(file, filename, true);  // append to file
@@ -17,38 +18,9 @@ writeCsvFile(std::string filename, double currentTime, const std::vector<double>
   int nPointsGlobal = geometry.size()/3;
 
   // in first timestep, write header
-  if (currentTime <= 1e-5)
+  if (writeHeaderAtFirstTimestep && currentTime <= 1e-5)
   {
-    if (!writeGeometry)
-    {
-      file << "#electrode positions (x0,y0,z0,x1,y1,z1,...);\n#; ";
-      for (int i = 0; i < nPointsGlobal; i++)
-      {
-        file << ";" << geometry[3*i+0]
-          << ";" << geometry[3*i+1]
-          << ";" << geometry[3*i+2];
-      }
-      file << std::endl;
-    }
-
-    file << "#timestamp;t;n_points";
-
-    if (writeGeometry)
-    {
-      for (int pointNo = 0; pointNo < nPointsGlobal; pointNo++)
-      {
-        file << ";p" << pointNo << "_x;p" << pointNo << "_y;p" << pointNo << "_z";
-      }
-    }
-
-    if (!values.empty())
-    {
-      for (int pointNo = 0; pointNo < nPointsGlobal; pointNo++)
-      {
-        file << ";p" << pointNo << "_value";
-      }
-    }
-    file << std::endl;
+    writeCsvHeader(file, geometry, !values.empty(), writeGeometry);
   }
 
   // write timestamp and time
@@ -81,6 +53,53 @@ writeCsvFile(std::string filename, double currentTime, const std::vector<double>
   file.close();
 }
 
+void OutputPoints::
+writeCsvHeader(std::string filename, const std::vector<double> &geometry, bool hasValues, bool writeGeometry)
+{
+  std::ofstream file;
+  Generic::openFile(file, filename, false);  // do not append to existing file
+
+  writeCsvHeader(file, geometry, hasValues, writeGeometry);
+  file.close();
+}
+
+void OutputPoints::
+writeCsvHeader(std::ostream &file, const std::vector<double> &geometry, bool hasValues, bool writeGeometry)
+{
+  int nPointsGlobal = geometry.size()/3;
+
+  if (!writeGeometry)
+  {
+    file << "#electrode positions (x0,y0,z0,x1,y1,z1,...);\n#; ";
+    for (int i = 0; i < nPointsGlobal; i++)
+    {
+      file << ";" << geometry[3*i+0]
+        << ";" << geometry[3*i+1]
+        << ";" << geometry[3*i+2];
+    }
+    file << std::endl;
+  }
+
+  file << "#timestamp;t;n_points";
+
+  if (writeGeometry)
+  {
+    for (int pointNo = 0; pointNo < nPointsGlobal; pointNo++)
+    {
+      file << ";p" << pointNo << "_x;p" << pointNo << "_y;p" << pointNo << "_z";
+    }
+  }
+
+  if (hasValues)
+  {
+    for (int pointNo = 0; pointNo < nPointsGlobal; pointNo++)
+    {
+      file << ";p" << pointNo << "_value";
+    }
+  }
+  file << std::endl;
+}
+
 void OutputPoints::
 writeVtpFile(std::string filename, double currentTime, const std::vector<double> &geometry,
              const std::vector<double> &values, int nComponents,
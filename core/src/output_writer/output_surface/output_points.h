@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Python.h>  // has to be the first included header
+#include <iostream>
 
 #include "control/types.h"
 #include "partition/rank_subset.h"
@@ -32,10 +33,18 @@ public:
                            const std::vector<double> &values, int nComponents, const std::vector<int> &partitioning, std::string fieldVariableName);
 
   //! write a csv file with geometry and optionally values
-  static void writeCsvFile(std::string filename, double currentTime, const std::vector<double> &geometry, const std::vector<double> &values, bool writeGeometry=true);
+  //! @param writeHeaderAtFirstTimestep if the header is written when currentTime is 0, set to false if the header was written by writeCsvHeader
+  static void writeCsvFile(std::string filename, double currentTime, const std::vector<double> &geometry, const std::vector<double> &values,
+                           bool writeGeometry=true, bool writeHeaderAtFirstTimestep=true);
+
+  //! create a new csv file that only contains the header for the lines written by writeCsvFile, an existing file is overwritten
+  static void writeCsvHeader(std::string filename, const std::vector<double> &geometry, bool hasValues, bool writeGeometry=true);
 
 protected:
 
+  //! write the header of a csv file to the given stream
+  static void writeCsvHeader(std::ostream &file, const std::vector<double> &geometry, bool hasValues, bool writeGeometry);
+
   std::vector<int> nPointsOnRanks_;           //< how many points there are on every rank
 
   std::vector<double> valuesLocal_;           //< buffer for local value
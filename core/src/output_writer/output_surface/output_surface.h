@@ -4,6 +4,7 @@
 
 #include "function_space/function_space.h"
 #include "data_management/output_surface/output_surface.h"
+#include "output_writer/output_surface/point_time_series_writer.h"
 
 namespace OutputWriter
 {
@@ -97,6 +98,9 @@ protected:
   bool enableVtpFile_;                //< if the vtp file should be written
   bool enableGeometryInCsvFile_;      //< if the csv file should contain geometry data
   bool enableGeometryFiles_;          //< if the found and not found electrodes should be written
+  bool enableBinaryFile_;             //< if the values at the sampled points should be written to the binary time series file
+
+  std::shared_ptr<PointTimeSeriesWriter> binaryFileWriter_;   //< on rank 0, the writer that buffers the sampled values and appends them in chunks to the binary file
 
   SeriesWriter seriesWriter_;         //< the series writer object that collects all VTK filenames and creates a collection file that can be loaded by ParaView, for the files that have the EMG values
   SeriesWriter seriesWriterFoundPoints_;      //< the series writer object that collects all VTK filenames and creates a collection file that can be loaded by ParaView, for the files that have the found electrode points
@@ -10,7 +10,8 @@ OutputSurface<Solver>::
 OutputSurface(DihuContext context) :
   context_(context["OutputSurface"]), solver_(context_),
   data_(context_), ownRankInvolvedInOutput_(true), timeStepNo_(0), currentTime_(0.0), updatePointPositions_(false),
-  enableCsvFile_(false), enableVtpFile_(false), enableGeometryInCsvFile_(false)
+  enableCsvFile_(false), enableVtpFile_(false), enableGeometryInCsvFile_(false),
+  enableGeometryFiles_(false), enableBinaryFile_(false)
 {
 
 }
@@ -44,6 +45,7 @@ initialize()
     enableVtpFile_ = specificSettings.getOptionBool("enableVtpFile", true);
     enableGeometryInCsvFile_ = specificSettings.getOptionBool("enableGeometryInCsvFile", true);
     enableGeometryFiles_ = specificSettings.getOptionBool("enableGeometryFiles", true);
+    enableBinaryFile_ = specificSettings.getOptionBool("enableBinaryFile", false);
   }
 
   LOG(DEBUG) << "OutputSurface: initialize output writers";
@@ -62,6 +64,17 @@ initialize()
       file.close();
     }
 
+    // create the writer for the binary time series file, only rank 0 writes the sampled values
+    if (!sampledPointsRequestedPositions_.empty() && enableBinaryFile_ && rankSubset_->ownRankNo() == 0)
+    {
+      std::string defaultBinaryFilename = filename_.substr(0, filename_.rfind(".")) + ".bin";
+      std::string binaryFilename = specificSettings.getOptionString("binaryFilename", defaultBinaryFilename);
+      int binaryFileBufferSize = specificSettings.getOptionInt("binaryFileBufferSize", 1000, PythonUtility::Positive);
+      bool asynchronousBinaryFile = specificSettings.getOptionBool("asynchronousBinaryFile", true);
+
+      binaryFileWriter_ = std::make_shared<PointTimeSeriesWriter>(binaryFilename, binaryFileBufferSize, asynchronousBinaryFile);
+    }
+
     initializeSampledPoints();
 
     // write positions of found sampling points
@@ -190,6 +203,9 @@ run()
   {
     outputWriterManager_.writeOutput(data_);
   }
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename Solver>
@@ -213,6 +213,7 @@ writeSampledPointValues()
     sampledPointsPositionGlobal_.reserve(nPointsGlobal*3);
     valuesGlobal_.reserve(nPointsGlobal);
     partitioningGlobal_.reserve(nPointsGlobal);
+    std::vector<int> pointNosFound;
 
     int lastI = -1;
     for (int i = 0; i < nPointsGlobal; i++)
@@ -230,6 +231,7 @@ writeSampledPointValues()
       sampledPointsPositionGlobal_.push_back(entries[i].geometry[2]);
       valuesGlobal_.push_back(entries[i].value);
       partitioningGlobal_.push_back(entries[i].partition);
+      pointNosFound.push_back(entries[i].pointNo);
       lastI = i;
     }
 
@@ -253,6 +255,23 @@ writeSampledPointValues()
     if (enableVtpFile_)
       OutputPoints::writeVtpFile(vtpFile.str(), currentTime_, sampledPointsPositionGlobal_, valuesGlobal_, 1, partitioningGlobal_, "EMG");
 
+    if (binaryFileWriter_)
+    {
+      // use the requested positions, they stay constant also if updatePointPositions is set, then a new points block is only written if the set of found points changes
+      std::vector<double> requestedPositions;
+      std::vector<std::string> pointNames;
+      requestedPositions.reserve(pointNosFound.size()*3);
+      for (int pointNo : pointNosFound)
+      {
+        const Vec3 &position = sampledPointsRequestedPositions_[pointNo];
+        requestedPositions.insert(requestedPositions.end(), position.begin(), position.end());
+        pointNames.push_back(std::string("p") + std::to_string(pointNo));
+      }
+
+      binaryFileWriter_->setPoints(requestedPositions, pointNames);
+      binaryFileWriter_->addSample(currentTime_, valuesGlobal_);
+    }
+
     seriesWriter_.registerNewFile(vtpFile.str(), currentTime_);
   }
 }
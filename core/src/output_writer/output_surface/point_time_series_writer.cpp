@@ -0,0 +1,137 @@
+#include "output_writer/output_surface/point_time_series_writer.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+#include "easylogging++.h"
+#include "output_writer/generic.h"
+#include "output_writer/asynchronous_file_writer.h"
+
+namespace OutputWriter
+{
+
+PointTimeSeriesWriter::PointTimeSeriesWriter(std::string filename, int bufferSize, bool asynchronous) :
+  filename_(filename), bufferSize_(bufferSize), asynchronous_(asynchronous), fileCreated_(false), pointsSet_(false), nSamples_(0)
+{
+  if (bufferSize_ < 1)
+    bufferSize_ = 1;
+
+  // file header
+  pendingData_ = std::string("DIHUPTS", 8);   // including the terminating zero
+  appendToBuffer(pendingData_, (int32_t)1);
+}
+
+PointTimeSeriesWriter::~PointTimeSeriesWriter()
+{
+  flush();
+}
+
+template<typename T>
+void PointTimeSeriesWriter::appendToBuffer(std::string &buffer, const T &value)
+{
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void PointTimeSeriesWriter::setPoints(const std::vector<double> &geometry, const std::vector<std::string> &names)
+{
+  if (pointsSet_ && geometry == geometry_)
+    return;
+
+  // the buffered samples refer to the previous points
+  if (nSamples_ > 0)
+    flush();
+
+  geometry_ = geometry;
+  pointsSet_ = true;
+  int nPoints = geometry.size() / 3;
+
+  // add points block
+  pendingData_ += 'P';
+  appendToBuffer(pendingData_, (int32_t)nPoints);
+  pendingData_.append(reinterpret_cast<const char *>(geometry.data()), geometry.size()*sizeof(double));
+
+  for (int pointNo = 0; pointNo < nPoints; pointNo++)
+  {
+    std::string name;
+    if (pointNo < names.size())
+    {
+      name = names[pointNo];
+    }
+    else
+    {
+      std::stringstream s;
+      s << "p" << pointNo;
+      name = s.str();
+    }
+    appendToBuffer(pendingData_, (int32_t)name.length());
+    pendingData_ += name;
+  }
+}
+
+void PointTimeSeriesWriter::addSample(double time, const std::vector<double> &values)
+{
+  int nPoints = geometry_.size() / 3;
+  if (values.size() != nPoints)
+  {
+    LOG(ERROR) << "PointTimeSeriesWriter \"" << filename_ << "\": sample at t=" << time << " has " << values.size()
+      << " values, but there are " << nPoints << " points. The sample is not written.";
+    return;
+  }
+
+  samples_.push_back(time);
+  samples_.insert(samples_.end(), values.begin(), values.end());
+  nSamples_++;
+
+  if (nSamples_ >= bufferSize_)
+    flush();
+}
+
+void PointTimeSeriesWriter::flush()
+{
+  if (nSamples_ == 0 && pendingData_.empty())
+    return;
+
+  std::string contents;
+  std::swap(contents, pendingData_);
+
+  // add samples block
+  if (nSamples_ > 0)
+  {
+    contents.reserve(contents.size() + 1 + sizeof(int32_t) + samples_.size()*sizeof(double));
+    contents += 'S';
+    appendToBuffer(contents, (int32_t)nSamples_);
+    contents.append(reinterpret_cast<const char *>(samples_.data()), samples_.size()*sizeof(double));
+
+    samples_.clear();
+    nSamples_ = 0;
+  }
+
+  writeToFile(std::move(contents));
+}
+
+void PointTimeSeriesWriter::writeToFile(std::string &&contents)
+{
+  // the first write creates the file, all further writes append to it
+  bool append = fileCreated_;
+  fileCreated_ = true;
+
+  if (asynchronous_)
+  {
+    AsynchronousFileWriter::instance().enqueue(filename_, std::move(contents), append);
+  }
+  else
+  {
+    std::ofstream file;
+    Generic::openFile(file, filename_, append);
+    file.write(contents.data(), contents.size());
+    file.close();
+  }
+}
+
+std::string PointTimeSeriesWriter::filename() const
+{
+  return filename_;
+}
+
+} // namespace
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace OutputWriter
+{
+
+/** Writes the values at a fixed set of points (e.g., EMG electrodes) for many points in time into a single binary file.
+ *  In contrast to the csv and vtp files of OutputPoints, which are formatted and written in every time step, the samples are
+ *  collected in memory and appended to the file in chunks of bufferSize samples. The chunks can be written by the
+ *  AsynchronousFileWriter on a background thread. This class is serial, it is used on rank 0 which has the values of all points.
+ *
+ *  File format (all numbers in native byte order, i.e. little endian on x86):
+ *    header:          8 bytes "DIHUPTS\0", int32 version (=1)
+ *    followed by a sequence of blocks, each starting with a char for the block type:
+ *    'P' points block: int32 nPoints, nPoints*3 float64 positions (x0,y0,z0,x1,...), for every point: int32 length of the name, characters of the name
+ *    'S' samples block: int32 nSamples, for every sample: float64 time, nPoints float64 values
+ *  A points block is written at the beginning and whenever the points change, the samples blocks refer to the last points block.
+ *  The script scripts/point_time_series_reader.py can be used to read the files.
+ */
+class PointTimeSeriesWriter
+{
+public:
+  //! constructor, @param bufferSize number of samples that are collected before they are written to the file
+  PointTimeSeriesWriter(std::string filename, int bufferSize=1000, bool asynchronous=true);
+
+  //! destructor, writes the remaining samples
+  ~PointTimeSeriesWriter();
+
+  //! set the positions of the points, if they differ from the previous positions, a new points block is written, @param geometry positions in array of struct representation with 3 components
+  void setPoints(const std::vector<double> &geometry, const std::vector<std::string> &names = std::vector<std::string>());
+
+  //! add the values of all points for the given time, the number of values has to match the number of points
+  void addSample(double time, const std::vector<double> &values);
+
+  //! write all buffered samples to the file
+  void flush();
+
+  //! the filename of the output file
+  std::string filename() const;
+
+protected:
+
+  //! append the binary representation of the value to buffer
+  template<typename T>
+  static void appendToBuffer(std::string &buffer, const T &value);
+
+  //! write the given contents to the file, either directly or by the AsynchronousFileWriter
+  void writeToFile(std::string &&contents);
+
+  std::string filename_;                //< the filename of the binary file
+  int bufferSize_;                      //< number of samples after which the buffer is written to the file
+  bool asynchronous_;                   //< if the file is written by the background thread of the AsynchronousFileWriter
+  bool fileCreated_;                    //< if the file was already created, then further contents are appended
+  bool pointsSet_;                      //< if setPoints was called and a points block was added
+
+  std::vector<double> geometry_;        //< positions of the current points
+  std::string pendingData_;             //< binary data that has not yet been written, i.e. the header and points blocks
+  std::vector<double> samples_;         //< the buffered samples, (time, values) for every sample
+  int nSamples_;                        //< number of samples in samples_
+};
+
+} // namespace
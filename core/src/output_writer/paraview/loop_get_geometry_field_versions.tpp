@@ -0,0 +1,96 @@
+#include "output_writer/paraview/loop_get_geometry_field_versions.h"
+
+#include "easylogging++.h"
+#include <cstdlib>
+#include "field_variable/field_variable.h"
+
+namespace OutputWriter
+{
+
+namespace ParaviewLoopOverTuple
+{
+
+ /** Static recursive loop from 0 to number of entries in the tuple
+ * Loop body
+ */
+template<typename FieldVariablesForOutputWriterType, int i>
+inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
+loopGetGeometryFieldVersions(const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                             std::vector<int> &versions
+)
+{
+  // call what to do in the loop body
+  if (getGeometryFieldVersions<typename std::tuple_element<i,FieldVariablesForOutputWriterType>::type, FieldVariablesForOutputWriterType>(
+        std::get<i>(fieldVariables), fieldVariables, meshNames, versions))
+    return;
+
+  // advance iteration to next tuple element
+  loopGetGeometryFieldVersions<FieldVariablesForOutputWriterType, i+1>(fieldVariables, meshNames, versions);
+}
+
+// current element is of pointer type (not vector)
+template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
+getGeometryFieldVersions(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                         std::vector<int> &versions)
+{
+  // if mesh name is one of the specified meshNames and it is the geometry field
+  if (meshNames.find(currentFieldVariable->functionSpace()->meshName()) != meshNames.end()
+    && currentFieldVariable->isGeometryField())
+  {
+    versions.push_back(currentFieldVariable->valuesVersion());
+  }
+
+  return false;  // do not break iteration
+}
+
+// element i is of vector type
+template<typename VectorType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
+getGeometryFieldVersions(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                         std::vector<int> &versions)
+{
+  for (auto& currentFieldVariable : currentFieldVariableGradient)
+  {
+    // call function on all vector entries
+    if (getGeometryFieldVersions<typename VectorType::value_type,FieldVariablesForOutputWriterType>(currentFieldVariable, fieldVariables, meshNames, versions))
+      return true; // break iteration
+  }
+  return false;  // do not break iteration
+}
+
+// element i is of tuple type
+template<typename TupleType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
+getGeometryFieldVersions(TupleType currentFieldVariableTuple, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                         std::vector<int> &versions)
+{
+  // call for tuple element
+  loopGetGeometryFieldVersions<TupleType>(currentFieldVariableTuple, meshNames, versions);
+
+  return false;  // do not break iteration
+}
+
+// element i is a field variables with Mesh::CompositeOfDimension<D>
+template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
+typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
+getGeometryFieldVersions(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::set<std::string> meshNames,
+                         std::vector<int> &versions)
+{
+  // the sub field variables get their values copied from the composite field variable, therefore use the version of the composite field variable
+  // for every sub mesh that is part of the output, this avoids updating the sub field variables
+  if (!currentFieldVariable->isGeometryField())
+    return false;
+
+  for (auto &subFunctionSpace : currentFieldVariable->functionSpace()->subFunctionSpaces())
+  {
+    if (meshNames.find(subFunctionSpace->meshName()) != meshNames.end())
+    {
+      versions.push_back(currentFieldVariable->valuesVersion());
+    }
+  }
+
+  return false;  // do not break iteration
+}
+}  // namespace ParaviewLoopOverTuple
+}  // namespace OutputWriter
@@ -25,7 +25,7 @@ namespace ParaviewLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, typename AllFieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i == std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutput(const FieldVariablesForOutputWriterType &fieldVariables, const AllFieldVariablesForOutputWriterType &allFieldVariables, std::string meshName,
-           std::string filename, PythonConfig specificSettings, double currentTime
+           std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous
 )
 {}
 
@@ -35,7 +35,7 @@ loopOutput(const FieldVariablesForOutputWriterType &fieldVariables, const AllFie
 template<typename FieldVariablesForOutputWriterType, typename AllFieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutput(const FieldVariablesForOutputWriterType &fieldVariables, const AllFieldVariablesForOutputWriterType &allFieldVariables, std::string meshName, 
-           std::string filename, PythonConfig specificSettings, double currentTime);
+           std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous);
 
 
 /** Loop body for a vector element
@@ -43,14 +43,14 @@ loopOutput(const FieldVariablesForOutputWriterType &fieldVariables, const AllFie
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 output(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings, double currentTime);
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous);
 
 /** Loop body for a tuple element
  */
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isTuple<VectorType>::value, bool>::type
 output(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings, double currentTime);
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous);
 
  /**  Loop body for a pointer element
  */
@@ -58,14 +58,14 @@ template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWrit
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value
   && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 output(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings, double currentTime);
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous);
 
 /** Loop body for a field variables with Mesh::CompositeOfDimension<D>
  */
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 output(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-       std::string filename, PythonConfig specificSettings, double currentTime);
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous);
 
 }  // namespace ParaviewLoopOverTuple
 
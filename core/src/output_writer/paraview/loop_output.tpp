@@ -18,23 +18,23 @@ namespace ParaviewLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, typename AllFieldVariablesForOutputWriterType, int i>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutput(const FieldVariablesForOutputWriterType &fieldVariables, const AllFieldVariablesForOutputWriterType &allFieldVariables,
-           std::string meshName, std::string filename, PythonConfig specificSettings, double currentTime
+           std::string meshName, std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous
 )
 {
   // call what to do in the loop body
   if (output<typename std::tuple_element<i,FieldVariablesForOutputWriterType>::type, AllFieldVariablesForOutputWriterType>(
-        std::get<i>(fieldVariables), allFieldVariables, meshName, filename, specificSettings, currentTime))
+        std::get<i>(fieldVariables), allFieldVariables, meshName, filename, specificSettings, currentTime, asynchronous))
     return;
   
   // advance iteration to next tuple element
-  loopOutput<FieldVariablesForOutputWriterType, AllFieldVariablesForOutputWriterType, i+1>(fieldVariables, allFieldVariables, meshName, filename, specificSettings, currentTime);
+  loopOutput<FieldVariablesForOutputWriterType, AllFieldVariablesForOutputWriterType, i+1>(fieldVariables, allFieldVariables, meshName, filename, specificSettings, currentTime, asynchronous);
 }
  
 // current element is of pointer type (not vector)
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 output(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings, double currentTime)
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous)
 {
   // if mesh name is the specified meshName
   if (currentFieldVariable->functionSpace()->meshName() == meshName)
@@ -46,7 +46,7 @@ output(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOut
     LoopOverTuple::loopCountNFieldVariablesOfMesh(fieldVariables, meshName, nFieldVariablesInMesh);
     
     // call exfile writer to output all field variables with the meshName
-    ParaviewWriter<FunctionSpace, FieldVariablesForOutputWriterType>::outputFile(filename, fieldVariables, meshName, currentFieldVariable->functionSpace(), nFieldVariablesInMesh, specificSettings, currentTime);
+    ParaviewWriter<FunctionSpace, FieldVariablesForOutputWriterType>::outputFile(filename, fieldVariables, meshName, currentFieldVariable->functionSpace(), nFieldVariablesInMesh, specificSettings, currentTime, asynchronous);
    
     return true;  // break iteration
   }
@@ -58,12 +58,12 @@ output(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOut
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 output(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings, double currentTime)
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous)
 {
   for (auto& currentFieldVariable : currentFieldVariableGradient)
   {
     // call function on all vector entries
-    if (output<typename VectorType::value_type,FieldVariablesForOutputWriterType>(currentFieldVariable, fieldVariables, meshName, filename, specificSettings, currentTime))
+    if (output<typename VectorType::value_type,FieldVariablesForOutputWriterType>(currentFieldVariable, fieldVariables, meshName, filename, specificSettings, currentTime, asynchronous))
       return true; // break iteration
   }
   return false;  // do not break iteration 
@@ -73,10 +73,10 @@ output(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWri
 template<typename TupleType, typename AllFieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
 output(TupleType currentFieldVariableTuple, const AllFieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-       std::string filename, PythonConfig specificSettings, double currentTime)
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous)
 {
   // call for tuple element
-  loopOutput<TupleType, AllFieldVariablesForOutputWriterType>(currentFieldVariableTuple, fieldVariables, meshName, filename, specificSettings, currentTime);
+  loopOutput<TupleType, AllFieldVariablesForOutputWriterType>(currentFieldVariableTuple, fieldVariables, meshName, filename, specificSettings, currentTime, asynchronous);
   
   return false;  // do not break iteration 
 }
@@ -85,7 +85,7 @@ output(TupleType currentFieldVariableTuple, const AllFieldVariablesForOutputWrit
 template<typename CurrentFieldVariableType, typename AllFieldVariablesForOutputWriterType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 output(CurrentFieldVariableType currentFieldVariable, const AllFieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-       std::string filename, PythonConfig specificSettings, double currentTime)
+       std::string filename, PythonConfig specificSettings, double currentTime, bool asynchronous)
 {
   const int D = CurrentFieldVariableType::element_type::FunctionSpace::dim();
   typedef typename CurrentFieldVariableType::element_type::FunctionSpace::BasisFunction BasisFunctionType;
@@ -100,7 +100,7 @@ output(CurrentFieldVariableType currentFieldVariable, const AllFieldVariablesFor
   for (auto& currentSubFieldVariable : subFieldVariables)
   {
     // call function on all vector entries
-    if (output<std::shared_ptr<SubFieldVariableType>,AllFieldVariablesForOutputWriterType>(currentSubFieldVariable, fieldVariables, meshName, filename, specificSettings, currentTime))
+    if (output<std::shared_ptr<SubFieldVariableType>,AllFieldVariablesForOutputWriterType>(currentSubFieldVariable, fieldVariables, meshName, filename, specificSettings, currentTime, asynchronous))
       return true;
   }
 
@@ -25,7 +25,7 @@ namespace ParaviewLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i == std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutputPointData(const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-                    std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement
+                    std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement
 )
 {}
 
@@ -35,21 +35,21 @@ loopOutputPointData(const FieldVariablesForOutputWriterType &fieldVariables, std
 template<typename FieldVariablesForOutputWriterType, int i=0>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutputPointData(const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                    std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
+                    std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
 
 /** Loop body for a vector element
  */
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 outputPointData(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
 
 /** Loop body for a tuple element
  */
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isTuple<VectorType>::value, bool>::type
 outputPointData(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
 
  /**  Loop body for a pointer element
  */
@@ -57,14 +57,14 @@ template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWrit
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value
   && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputPointData(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
 
 /** Loop body for a field variables with Mesh::CompositeOfDimension<D>
  */
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputPointData(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement);
 
 }  // namespace ParaviewLoopOverTuple
 
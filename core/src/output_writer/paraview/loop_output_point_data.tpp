@@ -20,7 +20,7 @@ namespace ParaviewLoopOverTuple
 template<typename FieldVariablesForOutputWriterType, int i>
 inline typename std::enable_if<i < std::tuple_size<FieldVariablesForOutputWriterType>::value, void>::type
 loopOutputPointData(const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                    std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement
+                    std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement
 )
 {
   // call what to do in the loop body
@@ -36,7 +36,7 @@ loopOutputPointData(const FieldVariablesForOutputWriterType &fieldVariables, std
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<!TypeUtility::isTuple<CurrentFieldVariableType>::value && !TypeUtility::isVector<CurrentFieldVariableType>::value && !Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputPointData(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
 {
   // if mesh name is the specified meshName
   if (currentFieldVariable->functionSpace()->meshName() == meshName && !currentFieldVariable->isGeometryField())
@@ -51,7 +51,7 @@ outputPointData(CurrentFieldVariableType currentFieldVariable, const FieldVariab
 template<typename VectorType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isVector<VectorType>::value, bool>::type
 outputPointData(VectorType currentFieldVariableGradient, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
 {
   for (auto& currentFieldVariable : currentFieldVariableGradient)
   {
@@ -66,7 +66,7 @@ outputPointData(VectorType currentFieldVariableGradient, const FieldVariablesFor
 template<typename TupleType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<TypeUtility::isTuple<TupleType>::value, bool>::type
 outputPointData(TupleType currentFieldVariableTuple, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName, 
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
 {
   // call for tuple element
   loopOutputPointData<TupleType>(currentFieldVariableTuple, meshName, file, binaryOutput, fixedFormat, onlyParallelDatasetElement);
@@ -78,7 +78,7 @@ outputPointData(TupleType currentFieldVariableTuple, const FieldVariablesForOutp
 template<typename CurrentFieldVariableType, typename FieldVariablesForOutputWriterType>
 typename std::enable_if<Mesh::isComposite<CurrentFieldVariableType>::value, bool>::type
 outputPointData(CurrentFieldVariableType currentFieldVariable, const FieldVariablesForOutputWriterType &fieldVariables, std::string meshName,
-                std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
+                std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
 {
   const int D = CurrentFieldVariableType::element_type::FunctionSpace::dim();
   typedef typename CurrentFieldVariableType::element_type::FunctionSpace::BasisFunction BasisFunctionType;
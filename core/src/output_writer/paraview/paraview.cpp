@@ -27,6 +27,15 @@ Paraview::Paraview(DihuContext context, PythonConfig settings, std::shared_ptr<P
   binaryOutput_ = settings.getOptionBool("binary", true);
   fixedFormat_ = settings.getOptionBool("fixedFormat", true);
   combineFiles_ = settings.getOptionBool("combineFiles", false);
+  reuseUnchangedGeometry_ = settings.getOptionBool("reuseUnchangedGeometry", true);
+  appendedData_ = settings.getOptionBool("appendedData", false);
+  compressAppendedData_ = settings.getOptionBool("compressAppendedData", false);
+
+  if (appendedData_ && !combineFiles_)
+  {
+    LOG(WARNING) << settings << "[\"appendedData\"] is only used for combined files (\"combineFiles\": True), "
+      << "the individual files of the ranks will contain inline data.";
+  }
 }
 
 std::string Paraview::encodeBase64Vec(const Vec &vector, bool withEncodedSizePrefix)
@@ -8,6 +8,7 @@
 #include "output_writer/generic.h"
 #include "output_writer/paraview/poly_data_properties_for_mesh.h"
 #include "output_writer/paraview/series_writer.h"
+#include "output_writer/paraview/vtk_appended_data.h"
 
 namespace OutputWriter
 {
@@ -25,13 +26,13 @@ public:
 
   //! write the given field variable as VTK <DataArray> element to file, if onlyParallelDatasetElement write the <PDataArray> element
   template<typename FieldVariableType>
-  static void writeParaviewFieldVariable(FieldVariableType &fieldVariable, std::ofstream &file,
+  static void writeParaviewFieldVariable(FieldVariableType &fieldVariable, std::ostream &file,
                                          bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement=false);
 
 
   //! write the a field variable indicating which ranks own which portion of the domain as VTK <DataArray> element to file, if onlyParallelDatasetElement write the <PDataArray> element
   template<typename FieldVariableType>
-  static void writeParaviewPartitionFieldVariable(FieldVariableType &geometryField, std::ofstream &file,
+  static void writeParaviewPartitionFieldVariable(FieldVariableType &geometryField, std::ostream &file,
                                                   bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement=false);
   
   //! write a single *.vtp file that contains all data of all 1D field variables. This is uses MPI IO. It can be enabled with the "combineFiles" option.
@@ -108,9 +109,33 @@ protected:
   template<typename T>
   void writeCombinedValuesVector(MPI_File fileHandle, int ownRankNo, const std::vector<T> &values, int identifier, bool writeFloatsAsInt=false);
 
+  //! encode the local part of the values vector such that the buffers of all ranks written in rank order give the combined data, this is a collective call, identifier is an id to access cached values
+  template<typename T>
+  std::string encodeCombinedValuesVector(int ownRankNo, const std::vector<T> &values, int identifier, bool writeFloatsAsInt=false);
+
+  //! write the already encoded local part of a combined vector to the file, collective call
+  void writeCombinedBuffer(MPI_File fileHandle, const std::string &writeBuffer);
+
   //! write a vector containing nValues "12" (if output3DMeshes) or "9" (if !output3DMeshes) values for the types for an unstructured grid
   void writeCombinedTypesVector(MPI_File fileHandle, int ownRankNo, int nValues, bool output3DMeshes, int identifier);
 
+  //! encode the types vector that is written by writeCombinedTypesVector, the result is only non-empty on rank 0
+  std::string encodeCombinedTypesVector(int ownRankNo, int nValues, bool output3DMeshes);
+
+  //! check if the geometry fields of the given meshes are unchanged on all ranks since the encoded geometry was stored in geometryCache_[cacheKey], collective call.
+  //! If the geometry changed, the stored buffers are cleared and the current versions are saved, such that the caller can store the new buffers.
+  template<typename FieldVariablesForOutputWriterType>
+  bool isGeometryUnchanged(const FieldVariablesForOutputWriterType &fieldVariables, const std::set<std::string> &meshNames, std::string cacheKey);
+
+  /** the encoded points, connectivity, offsets (and types) data of a combined file, which is reused for the next output files as long as the geometry does not change
+   */
+  struct GeometryCache
+  {
+    std::vector<int> geometryVersions;     //< the values versions of the geometry fields at the time the buffers were encoded
+    std::vector<std::string> writeBuffers; //< the encoded local data, in the order in which it is written to the file
+    std::vector<VTKAppendedData::Array> appendedArrays;   //< the encoded data arrays if appendedData_ is set, in the order in which they are written to the file
+  };
+
   //! helper method that writes the unstructured grid file
   template<typename FieldVariablesForOutputWriterType>
   void writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWriterType &fieldVariables, PolyDataPropertiesForMesh &polyDataPropertiesForMesh,
@@ -121,10 +146,14 @@ protected:
   bool binaryOutput_;   //< if the data output should be binary encoded using base64
   bool fixedFormat_;    //< if non-binary output is selected, if the ascii values should be written with a fixed precision, like 1.000000e5
 
+  bool appendedData_;  //< if the data of combined files should be written as raw binary data in the <AppendedData> section instead of inline
+  bool compressAppendedData_;   //< if the appended data should be compressed with zlib
+  bool reuseUnchangedGeometry_;   //< if the encoded geometry and connectivity of combined files should be reused as long as the geometry fields do not change
   bool combineFiles_;   //< if the output data should be combined for 1D meshes into a single PolyData output file (*.vtp) and for 2D and 3D meshes to normal *.vtu,*.vts or *.vtr files. This is needed when the number of output files should be reduced.
 
   std::vector<int> globalValuesSize_;   //< cached values used in writeCombinedValuesVector
   std::vector<int> nPreviousValues_;    //< cached values used in writeCombinedValuesVector
+  std::map<std::string, GeometryCache> geometryCache_;   //< cached encoded geometry data of the combined files, key is "1D" or the dimensionality and mesh names of the 2D/3D file
 
   std::map<std::string, PolyDataPropertiesForMesh> meshPropertiesUnstructuredGridFile2D_;    //< mesh information for a combined unstructured grid file (*.vtu), for 2D data
   std::map<std::string, PolyDataPropertiesForMesh> meshPropertiesUnstructuredGridFile3D_;    //< mesh information for a combined unstructured grid file (*.vtu), for 3D data
@@ -9,6 +9,7 @@
 #include "base64.h"
 
 #include "output_writer/paraview/loop_output.h"
+#include "output_writer/output_file_stream.h"
 #include "output_writer/paraview/loop_collect_mesh_properties.h"
 #include "output_writer/paraview/poly_data_properties_for_mesh.h"
 #include "control/diagnostic_tool/performance_measurement.h"
@@ -87,7 +88,7 @@ void Paraview::write(DataType& data, int timeStepNo, double currentTime, int cal
       filenameStart << this->filename_ << "_" << meshName;
 
     // loop over all field variables and output those that are associated with the mesh given by meshName
-    ParaviewLoopOverTuple::loopOutput(data.getFieldVariablesForOutputWriter(), data.getFieldVariablesForOutputWriter(), meshName, filenameStart.str(), specificSettings_, currentTime);
+    ParaviewLoopOverTuple::loopOutput(data.getFieldVariablesForOutputWriter(), data.getFieldVariablesForOutputWriter(), meshName, filenameStart.str(), specificSettings_, currentTime, asynchronous_);
   }
 
   Control::PerformanceMeasurement::stop("durationParaviewOutput");
@@ -95,7 +96,7 @@ void Paraview::write(DataType& data, int timeStepNo, double currentTime, int cal
 
 template<typename FieldVariableType>
 void Paraview::writeParaviewFieldVariable(FieldVariableType &fieldVariable,
-                                          std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
+                                          std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
 {
   LOG(DEBUG) << "Paraview write field variable " << fieldVariable.name();
   VLOG(1) << fieldVariable;
@@ -135,7 +136,6 @@ void Paraview::writeParaviewFieldVariable(FieldVariableType &fieldVariable,
         << "NumberOfComponents=\"" << nComponentsParaview << "\" ";
 
     const int nComponents = FieldVariableType::nComponents();
-    std::string stringData;
 
     std::vector<double> values;
     std::array<std::vector<double>, nComponents> componentValues;
@@ -191,22 +191,30 @@ void Paraview::writeParaviewFieldVariable(FieldVariableType &fieldVariable,
 
     if (binaryOutput)
     {
-      stringData = Paraview::encodeBase64Float(values.begin(), values.end());
       file << "format=\"binary\" >" << std::endl;
     }
     else
     {
-      stringData = Paraview::convertToAscii(values, fixedFormat);
       file << "format=\"ascii\" >" << std::endl;
     }
-    file << std::string(5, '\t') << stringData << std::endl
+    file << std::string(5, '\t');
+
+    // encode the values, for asynchronous output this is done on the background thread
+    OutputFileStream::writeEncoded(file, [values = std::move(values), binaryOutput, fixedFormat]()
+    {
+      if (binaryOutput)
+        return Paraview::encodeBase64Float(values.begin(), values.end());
+      return Paraview::convertToAscii(values, fixedFormat);
+    });
+
+    file << std::endl
       << std::string(4, '\t') << "</DataArray>" << std::endl;
   }
 }
 
 template<typename FieldVariableType>
 void Paraview::writeParaviewPartitionFieldVariable(FieldVariableType &geometryField,
-                                                   std::ofstream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
+                                                   std::ostream &file, bool binaryOutput, bool fixedFormat, bool onlyParallelDatasetElement)
 {
   // if only the "parallel dataset element" stub which is needed in the master files, should be written
   if (onlyParallelDatasetElement)
@@ -31,10 +31,21 @@ void Paraview::writeAsciiDataShared(MPI_File fileHandle, int ownRankNo, std::str
   }
 }
 
-void Paraview::writeCombinedTypesVector(MPI_File fileHandle, int ownRankNo, int nValues, bool output3DMeshes, int identifier)
+void Paraview::writeCombinedBuffer(MPI_File fileHandle, const std::string &writeBuffer)
+{
+  // collective blocking write, the buffers of all ranks are written in the order of the ranks
+  MPI_Status status;
+  MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, &status), "MPI_File_write_ordered", &status);
+}
+
+std::string Paraview::encodeCombinedTypesVector(int ownRankNo, int nValues, bool output3DMeshes)
 {
   std::string writeBuffer;
 
+  // only rank 0 writes the types, the other ranks write empty data
+  if (ownRankNo != 0)
+    return writeBuffer;
+
   if (binaryOutput_)
   {
     if (output3DMeshes)
@@ -62,19 +73,13 @@ void Paraview::writeCombinedTypesVector(MPI_File fileHandle, int ownRankNo, int
       }
     }
   }
+  return writeBuffer;
+}
 
+void Paraview::writeCombinedTypesVector(MPI_File fileHandle, int ownRankNo, int nValues, bool output3DMeshes, int identifier)
+{
   // collective blocking write, only rank 0 writes, but afterwards all have the same shared file pointer position
-  if (ownRankNo == 0)
-  {
-    MPI_Status status;
-    MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, &status), "MPI_File_write_ordered", &status);
-  }
-  else
-  {
-    char b[1];
-    MPI_Status status;
-    MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, b, 0, MPI_BYTE, &status), "MPI_File_write_ordered", &status);
-  }
+  writeCombinedBuffer(fileHandle, encodeCombinedTypesVector(ownRankNo, nValues, output3DMeshes));
 }
 
 //! constructor, initialize nPoints and nCells to 0
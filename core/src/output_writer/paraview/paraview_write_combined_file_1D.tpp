@@ -14,6 +14,7 @@
 #include "output_writer/paraview/loop_get_nodal_values.h"
 #include "output_writer/paraview/loop_get_geometry_field_nodal_values.h"
 #include "output_writer/paraview/poly_data_properties_for_mesh.h"
+#include "output_writer/paraview/vtk_appended_data.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 
 namespace OutputWriter
@@ -225,22 +226,9 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     MPIUtility::handleReturnValue(MPI_Reduce(&vtkPiece1D_.properties.nCellsLocal, &nLinesGlobal1D_, 1, MPI_INT, MPI_SUM, 0, this->rankSubset_->mpiCommunicator()), "MPI_Reduce");
     Control::PerformanceMeasurement::stop("durationParaview1DReduction");
     Control::PerformanceMeasurement::stop("durationParaview1DInit");
-  }
-
-  // get local data values
-  // setup connectivity array
-  std::vector<int> connectivityValues(2*vtkPiece1D_.properties.nCellsLocal);
-  for (int i = 0; i < vtkPiece1D_.properties.nCellsLocal; i++)
-  {
-    connectivityValues[2*i + 0] = nPointsPreviousRanks1D_ + i;
-    connectivityValues[2*i + 1] = nPointsPreviousRanks1D_ + i+1;
-  }
 
-  // setup offset array
-  std::vector<int> offsetValues(vtkPiece1D_.properties.nCellsLocal);
-  for (int i = 0; i < vtkPiece1D_.properties.nCellsLocal; i++)
-  {
-    offsetValues[i] = 2*nCellsPreviousRanks1D_ + 2*i + 1;
+    // the meshes have been (re-)initialized, do not reuse previously encoded geometry
+    geometryCache_.erase("1D");
   }
 
   // collect all data for the field variables, organized by field variable names
@@ -297,9 +285,73 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     }
   }
 
-  // collect all data for the geometry field variable
+  // if the geometry of the fibers has not changed since the last output, the encoded points, connectivity and offsets can be reused
+  bool geometryUnchanged = isGeometryUnchanged(fieldVariables, vtkPiece1D_.meshNamesCombinedMeshes, "1D");
+
+  std::vector<int> connectivityValues;
+  std::vector<int> offsetValues;
   std::vector<double> geometryFieldValues;
-  ParaviewLoopOverTuple::loopGetGeometryFieldNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, vtkPiece1D_.meshNamesCombinedMeshes, geometryFieldValues);
+  if (!geometryUnchanged)
+  {
+    // get local data values
+    // setup connectivity array
+    connectivityValues.resize(2*vtkPiece1D_.properties.nCellsLocal);
+    for (int i = 0; i < vtkPiece1D_.properties.nCellsLocal; i++)
+    {
+      connectivityValues[2*i + 0] = nPointsPreviousRanks1D_ + i;
+      connectivityValues[2*i + 1] = nPointsPreviousRanks1D_ + i+1;
+    }
+
+    // setup offset array
+    offsetValues.resize(vtkPiece1D_.properties.nCellsLocal);
+    for (int i = 0; i < vtkPiece1D_.properties.nCellsLocal; i++)
+    {
+      offsetValues[i] = 2*nCellsPreviousRanks1D_ + 2*i + 1;
+    }
+
+    // collect all data for the geometry field variable
+    ParaviewLoopOverTuple::loopGetGeometryFieldNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, vtkPiece1D_.meshNamesCombinedMeshes, geometryFieldValues);
+  }
+
+  // in appended data mode, encode all data arrays before the xml structure is created, because it contains the offsets of the arrays
+  VTKAppendedData appendedData(this->rankSubset_, compressAppendedData_);
+  if (appendedData_)
+  {
+    Control::PerformanceMeasurement::start("durationParaview1DEncode");
+    for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = vtkPiece1D_.properties.pointDataArrays.begin();
+         pointDataArrayIter != vtkPiece1D_.properties.pointDataArrays.end(); pointDataArrayIter++)
+    {
+      const std::vector<double> &values = fieldVariableValues[pointDataArrayIter->name];
+      if (pointDataArrayIter->name == "partitioning")
+        appendedData.addArray(appendedData.encodeInt32(values));
+      else
+        appendedData.addArray(appendedData.encodeFloat32(values));
+    }
+
+    // encode geometry field data, connectivity and offset values, if they are not unchanged since the last output
+    GeometryCache &geometryCache = geometryCache_["1D"];
+    if (!geometryUnchanged)
+    {
+      geometryCache.appendedArrays.push_back(appendedData.encodeFloat32(geometryFieldValues));
+      geometryCache.appendedArrays.push_back(appendedData.encodeInt32(connectivityValues));
+      geometryCache.appendedArrays.push_back(appendedData.encodeInt32(offsetValues));
+    }
+
+    for (const VTKAppendedData::Array &array : geometryCache.appendedArrays)
+      appendedData.addArray(array);
+
+    appendedData.computeOffsets();
+    Control::PerformanceMeasurement::stop("durationParaview1DEncode");
+  }
+
+  // get the format attributes of the DataArray element with the given number
+  auto dataArrayFormat = [this, &appendedData](int dataArrayNo) -> std::string
+  {
+    if (appendedData_)
+      return appendedData.formatAttributes(dataArrayNo);
+    return (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"");
+  };
+  int dataArrayNo = 0;
 
   // only continue if there is data to reduce
   if (vtkPiece1D_.meshNamesCombinedMeshes.empty())
@@ -314,7 +366,11 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
   // transform current time to string
   std::vector<double> time(1, this->currentTime_);
   std::string stringTime;
-  if (binaryOutput_)
+
+  // with appended data, the VTKFile element declares a UInt64 header type and possibly a compressor that would also apply to inline binary arrays,
+  // therefore the time is written in ascii format in this case
+  const bool binaryTime = binaryOutput_ && !appendedData_;
+  if (binaryTime)
   {
     stringTime = Paraview::encodeBase64Float(time.begin(), time.end());
   }
@@ -329,10 +385,11 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
   outputFileParts[outputFilePartNo] << "<?xml version=\"1.0\"?>" << std::endl
     << "<!-- " << DihuContext::versionText() << " " << DihuContext::metaText()
     << ", currentTime: " << this->currentTime_ << ", timeStepNo: " << this->timeStepNo_ << " -->" << std::endl
-    << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\">" << std::endl    // intel cpus are LittleEndian
+    << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\""
+    << (appendedData_? appendedData.vtkFileAttributes() : std::string("")) << ">" << std::endl    // intel cpus are LittleEndian
     << std::string(1, '\t') << "<PolyData>" << std::endl
     << std::string(2, '\t') << "<FieldData>" << std::endl
-    << std::string(3, '\t') << "<DataArray type=\"Float32\" Name=\"Time\" NumberOfTuples=\"1\" format=\"" << (binaryOutput_? "binary" : "ascii")
+    << std::string(3, '\t') << "<DataArray type=\"Float32\" Name=\"Time\" NumberOfTuples=\"1\" format=\"" << (binaryTime? "binary" : "ascii")
     << "\" >" << std::endl
     << std::string(4, '\t') << stringTime << std::endl
     << std::string(3, '\t') << "</DataArray>" << std::endl
@@ -383,8 +440,8 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
         << "type=\"" << (pointDataArrayIter->name == "partitioning"? "Int32" : "Float32") << "\" "
         << "NumberOfComponents=\"" << pointDataArrayIter->nComponents << "\" "
         << componentNames.str()
-        << "format=\"" << (binaryOutput_? "binary" : "ascii")
-        << "\" >" << std::endl << std::string(5, '\t');
+        << dataArrayFormat(dataArrayNo++)
+        << " >" << std::endl << std::string(5, '\t');
 
     // at this point the data of the field variable is missing
     outputFilePartNo++;
@@ -396,8 +453,8 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     << std::string(3, '\t') << "<CellData>" << std::endl
     << std::string(3, '\t') << "</CellData>" << std::endl
     << std::string(3, '\t') << "<Points>" << std::endl
-    << std::string(4, '\t') << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"" << (binaryOutput_? "binary" : "ascii")
-    << "\" >" << std::endl << std::string(5, '\t');
+    << std::string(4, '\t') << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" " << dataArrayFormat(dataArrayNo++)
+    << " >" << std::endl << std::string(5, '\t');
 
   // at this point the data of points (geometry field) is missing
   outputFilePartNo++;
@@ -407,7 +464,7 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     << std::string(3, '\t') << "<Verts></Verts>" << std::endl
     << std::string(3, '\t') << "<Lines>" << std::endl
     << std::string(4, '\t') << "<DataArray Name=\"connectivity\" type=\"Int32\" "
-    << (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"") << ">" << std::endl << std::string(5, '\t');
+    << dataArrayFormat(dataArrayNo++) << ">" << std::endl << std::string(5, '\t');
 
   // at this point the the structural information of the lines (connectivity) is missing
   outputFilePartNo++;
@@ -415,7 +472,7 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
   outputFileParts[outputFilePartNo]
     << std::endl << std::string(4, '\t') << "</DataArray>" << std::endl
     << std::string(4, '\t') << "<DataArray Name=\"offsets\" type=\"Int32\" "
-    << (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"") << ">" << std::endl << std::string(5, '\t');
+    << dataArrayFormat(dataArrayNo++) << ">" << std::endl << std::string(5, '\t');
 
   // at this point the offset array will be written to the file
   outputFilePartNo++;
@@ -426,8 +483,11 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
     << std::string(3, '\t') << "<Strips></Strips>" << std::endl
     << std::string(3, '\t') << "<Polys></Polys>" << std::endl
     << std::string(2, '\t') << "</Piece>" << std::endl
-    << std::string(1, '\t') << "</PolyData>" << std::endl
-    << "</VTKFile>" << std::endl;
+    << std::string(1, '\t') << "</PolyData>" << std::endl;
+
+  // in appended data mode, the closing tag follows after the appended data
+  if (!appendedData_)
+    outputFileParts[outputFilePartNo] << "</VTKFile>" << std::endl;
 
   assert(outputFilePartNo+1 == nOutputFileParts);
 
@@ -451,55 +511,80 @@ void Paraview::writePolyDataFile(const FieldVariablesForOutputWriterType &fieldV
 
   Control::PerformanceMeasurement::start("durationParaview1DWrite");
 
-  // write beginning of file on rank 0
-  outputFilePartNo = 0;
+  if (appendedData_)
+  {
+    // write the xml structure and all data arrays at their precomputed offsets
+    std::stringstream xml;
+    if (ownRankNo == 0)
+    {
+      for (std::vector<std::stringstream>::iterator iter = outputFileParts.begin(); iter != outputFileParts.end(); iter++)
+        xml << iter->str();
+    }
+    appendedData.writeFile(fileHandle, xml.str());
+  }
+  else
+  {
+    // write beginning of file on rank 0
+    outputFilePartNo = 0;
 
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
 
-  VLOG(1) << "get current shared file position";
+    VLOG(1) << "get current shared file position";
 
-  // get current file position
-  MPI_Offset currentFilePosition = 0;
-  MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
-  LOG(DEBUG) << "current shared file position: " << currentFilePosition;
+    // get current file position
+    MPI_Offset currentFilePosition = 0;
+    MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
+    LOG(DEBUG) << "current shared file position: " << currentFilePosition;
 
-  // write field variables
-  // loop over field variables
-  int fieldVariableNo = 0;
-  for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = vtkPiece1D_.properties.pointDataArrays.begin();
-       pointDataArrayIter != vtkPiece1D_.properties.pointDataArrays.end(); pointDataArrayIter++, fieldVariableNo++)
-  {
-    assert(fieldVariableValues.find(pointDataArrayIter->name) != fieldVariableValues.end());
+    // write field variables
+    // loop over field variables
+    int fieldVariableNo = 0;
+    for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = vtkPiece1D_.properties.pointDataArrays.begin();
+         pointDataArrayIter != vtkPiece1D_.properties.pointDataArrays.end(); pointDataArrayIter++, fieldVariableNo++)
+    {
+      assert(fieldVariableValues.find(pointDataArrayIter->name) != fieldVariableValues.end());
 
-    // write values
-    bool writeFloatsAsInt = pointDataArrayIter->name == "partitioning";    // for partitioning, convert float values to integer values for output
-    writeCombinedValuesVector(fileHandle, ownRankNo, fieldVariableValues[pointDataArrayIter->name], fieldVariableNo, writeFloatsAsInt);
+      // write values
+      bool writeFloatsAsInt = pointDataArrayIter->name == "partitioning";    // for partitioning, convert float values to integer values for output
+      writeCombinedValuesVector(fileHandle, ownRankNo, fieldVariableValues[pointDataArrayIter->name], fieldVariableNo, writeFloatsAsInt);
+
+      // write next xml constructs
+      writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+      outputFilePartNo++;
+    }
+
+    // encode geometry field data, connectivity and offset values, if they are not unchanged since the last output
+    GeometryCache &geometryCache = geometryCache_["1D"];
+    if (!geometryUnchanged)
+    {
+      geometryCache.writeBuffers.resize(3);
+      geometryCache.writeBuffers[0] = encodeCombinedValuesVector(ownRankNo, geometryFieldValues, fieldVariableNo);
+      geometryCache.writeBuffers[1] = encodeCombinedValuesVector(ownRankNo, connectivityValues, fieldVariableNo+1);
+      geometryCache.writeBuffers[2] = encodeCombinedValuesVector(ownRankNo, offsetValues, fieldVariableNo+2);
+    }
+    fieldVariableNo += 3;
+
+    // write geometry field data
+    writeCombinedBuffer(fileHandle, geometryCache.writeBuffers[0]);
 
     // write next xml constructs
     writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
     outputFilePartNo++;
-  }
-
-  // write geometry field data
-  writeCombinedValuesVector(fileHandle, ownRankNo, geometryFieldValues, fieldVariableNo++);
-
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
 
-  // write connectivity values
-  writeCombinedValuesVector(fileHandle, ownRankNo, connectivityValues, fieldVariableNo++);
+    // write connectivity values
+    writeCombinedBuffer(fileHandle, geometryCache.writeBuffers[1]);
 
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
 
-  // write offset values
-  writeCombinedValuesVector(fileHandle, ownRankNo, offsetValues, fieldVariableNo++);
+    // write offset values
+    writeCombinedBuffer(fileHandle, geometryCache.writeBuffers[2]);
 
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+  }
 
   /*
     int array_of_sizes[1];
@@ -14,6 +14,7 @@
 #include "output_writer/paraview/loop_get_nodal_values.h"
 #include "output_writer/paraview/loop_get_geometry_field_nodal_values.h"
 #include "output_writer/paraview/poly_data_properties_for_mesh.h"
+#include "output_writer/paraview/vtk_appended_data.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 
 namespace OutputWriter
@@ -567,22 +568,78 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
     }
   }
 
+  // if the geometry of the meshes has not changed since the last output, the encoded points, connectivity, offsets and types can be reused
+  std::stringstream geometryCacheKey;
+  geometryCacheKey << targetDimensionality << "D";
+  for (std::string meshName : meshNames)
+    geometryCacheKey << "_" << meshName;
+  bool geometryUnchanged = isGeometryUnchanged(fieldVariables, meshNamesSet, geometryCacheKey.str());
+
   // collect all data for the geometry field variable
   std::vector<double> geometryFieldValues;
-  ParaviewLoopOverTuple::loopGetGeometryFieldNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, meshNamesSet, geometryFieldValues);
+  if (!geometryUnchanged)
+  {
+    ParaviewLoopOverTuple::loopGetGeometryFieldNodalValues<FieldVariablesForOutputWriterType>(fieldVariables, meshNamesSet, geometryFieldValues);
+
+    VLOG(1) << "meshNames: " << meshNames << ", rank " << this->rankSubset_->ownRankNo() << ", n geometryFieldValues: " << geometryFieldValues.size();
+    if (geometryFieldValues.size() == 0)
+    {
+      LOG(FATAL) << "There is no geometry field. You have to provide a geomteryField in the field variables returned by getFieldVariablesForOutputWriter!";
+    }
+  }
 
-  VLOG(1) << "meshNames: " << meshNames << ", rank " << this->rankSubset_->ownRankNo() << ", n geometryFieldValues: " << geometryFieldValues.size();
-  if (geometryFieldValues.size() == 0)
+  // in appended data mode, encode all data arrays before the xml structure is created, because it contains the offsets of the arrays
+  VTKAppendedData appendedData(this->rankSubset_, compressAppendedData_);
+  if (appendedData_)
   {
-    LOG(FATAL) << "There is no geometry field. You have to provide a geomteryField in the field variables returned by getFieldVariablesForOutputWriter!";
+    Control::PerformanceMeasurement::start("durationParaview3DEncode");
+    for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = polyDataPropertiesForMesh.pointDataArrays.begin();
+         pointDataArrayIter != polyDataPropertiesForMesh.pointDataArrays.end(); pointDataArrayIter++)
+    {
+      const std::vector<double> &values = fieldVariableValues[pointDataArrayIter->name];
+      if (pointDataArrayIter->name == "partitioning")
+        appendedData.addArray(appendedData.encodeInt32(values));
+      else
+        appendedData.addArray(appendedData.encodeFloat32(values));
+    }
+
+    // encode geometry field data, connectivity, offset and types values, if they are not unchanged since the last output
+    // every rank writes the types of its own cells
+    GeometryCache &geometryCache = geometryCache_[geometryCacheKey.str()];
+    if (!geometryUnchanged)
+    {
+      geometryCache.appendedArrays.push_back(appendedData.encodeFloat32(geometryFieldValues));
+      geometryCache.appendedArrays.push_back(appendedData.encodeInt32(connectivityValues));
+      geometryCache.appendedArrays.push_back(appendedData.encodeInt32(offsetValues));
+      geometryCache.appendedArrays.push_back(appendedData.encodeUInt8(polyDataPropertiesForMesh.nCellsLocal, output3DMeshes? 12 : 9));
+    }
+
+    for (const VTKAppendedData::Array &array : geometryCache.appendedArrays)
+      appendedData.addArray(array);
+
+    appendedData.computeOffsets();
+    Control::PerformanceMeasurement::stop("durationParaview3DEncode");
   }
 
+  // get the format attributes of the DataArray element with the given number
+  auto dataArrayFormat = [this, &appendedData](int dataArrayNo) -> std::string
+  {
+    if (appendedData_)
+      return appendedData.formatAttributes(dataArrayNo);
+    return (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"");
+  };
+  int dataArrayNo = 0;
+
   int nOutputFileParts = 5 + polyDataPropertiesForMesh.pointDataArrays.size();
 
   // transform current time to string
   std::vector<double> time(1, this->currentTime_);
   std::string stringTime;
-  if (binaryOutput_)
+
+  // with appended data, the VTKFile element declares a UInt64 header type and possibly a compressor that would also apply to inline binary arrays,
+  // therefore the time is written in ascii format in this case
+  const bool binaryTime = binaryOutput_ && !appendedData_;
+  if (binaryTime)
   {
     stringTime = Paraview::encodeBase64Float(time.begin(), time.end());
   }
@@ -597,10 +654,11 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
   outputFileParts[outputFilePartNo] << "<?xml version=\"1.0\"?>" << std::endl
     << "<!-- " << DihuContext::versionText() << " " << DihuContext::metaText()
     << ", currentTime: " << this->currentTime_ << ", timeStepNo: " << this->timeStepNo_ << " -->" << std::endl
-    << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\">" << std::endl    // intel cpus are LittleEndian
+    << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\""
+    << (appendedData_? appendedData.vtkFileAttributes() : std::string("")) << ">" << std::endl    // intel cpus are LittleEndian
     << std::string(1, '\t') << "<UnstructuredGrid>" << std::endl
     << std::string(2, '\t') << "<FieldData>" << std::endl
-    << std::string(3, '\t') << "<DataArray type=\"Float32\" Name=\"Time\" NumberOfTuples=\"1\" format=\"" << (binaryOutput_? "binary" : "ascii")
+    << std::string(3, '\t') << "<DataArray type=\"Float32\" Name=\"Time\" NumberOfTuples=\"1\" format=\"" << (binaryTime? "binary" : "ascii")
     << "\" >" << std::endl
     << std::string(4, '\t') << stringTime << std::endl
     << std::string(3, '\t') << "</DataArray>" << std::endl
@@ -656,8 +714,8 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
         << "type=\"" << (pointDataArrayIter->name == "partitioning"? "Int32" : "Float32") << "\" "
         << "NumberOfComponents=\"" << nComponentsParaview << "\" "
         << componentNames.str()
-        << " format=\"" << (binaryOutput_? "binary" : "ascii")
-        << "\" >" << std::endl << std::string(5, '\t');
+        << " " << dataArrayFormat(dataArrayNo++)
+        << " >" << std::endl << std::string(5, '\t');
 
     // at this point the data of the field variable is missing
     outputFilePartNo++;
@@ -669,8 +727,8 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
     << std::string(3, '\t') << "<CellData>" << std::endl
     << std::string(3, '\t') << "</CellData>" << std::endl
     << std::string(3, '\t') << "<Points>" << std::endl
-    << std::string(4, '\t') << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"" << (binaryOutput_? "binary" : "ascii")
-    << "\" >" << std::endl << std::string(5, '\t');
+    << std::string(4, '\t') << "<DataArray type=\"Float32\" NumberOfComponents=\"3\" " << dataArrayFormat(dataArrayNo++)
+    << " >" << std::endl << std::string(5, '\t');
 
   // at this point the data of points (geometry field) is missing
   outputFilePartNo++;
@@ -679,7 +737,7 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
     << std::string(3, '\t') << "</Points>" << std::endl
     << std::string(3, '\t') << "<Cells>" << std::endl
     << std::string(4, '\t') << "<DataArray Name=\"connectivity\" type=\"Int32\" "
-    << (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"") << ">" << std::endl << std::string(5, '\t');
+    << dataArrayFormat(dataArrayNo++) << ">" << std::endl << std::string(5, '\t');
 
   // at this point the the structural information of the lines (connectivity) is missing
   outputFilePartNo++;
@@ -687,7 +745,7 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
   outputFileParts[outputFilePartNo]
     << std::endl << std::string(4, '\t') << "</DataArray>" << std::endl
     << std::string(4, '\t') << "<DataArray Name=\"offsets\" type=\"Int32\" "
-    << (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"") << ">" << std::endl << std::string(5, '\t');
+    << dataArrayFormat(dataArrayNo++) << ">" << std::endl << std::string(5, '\t');
 
   // at this point the offset array will be written to the file
   outputFilePartNo++;
@@ -695,7 +753,7 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
   outputFileParts[outputFilePartNo]
     << std::endl << std::string(4, '\t') << "</DataArray>" << std::endl
     << std::string(4, '\t') << "<DataArray Name=\"types\" type=\"UInt8\" "
-    << (binaryOutput_? "format=\"binary\"" : "format=\"ascii\"") << ">" << std::endl << std::string(5, '\t');
+    << dataArrayFormat(dataArrayNo++) << ">" << std::endl << std::string(5, '\t');
 
   // at this point the types array will be written to the file
   outputFilePartNo++;
@@ -704,8 +762,11 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
     << std::endl << std::string(4, '\t') << "</DataArray>" << std::endl
     << std::string(3, '\t') << "</Cells>" << std::endl
     << std::string(2, '\t') << "</Piece>" << std::endl
-    << std::string(1, '\t') << "</UnstructuredGrid>" << std::endl
-    << "</VTKFile>" << std::endl;
+    << std::string(1, '\t') << "</UnstructuredGrid>" << std::endl;
+
+  // in appended data mode, the closing tag follows after the appended data
+  if (!appendedData_)
+    outputFileParts[outputFilePartNo] << "</VTKFile>" << std::endl;
 
   assert(outputFilePartNo+1 == nOutputFileParts);
 
@@ -735,65 +796,94 @@ void Paraview::writeCombinedUnstructuredGridFile(const FieldVariablesForOutputWr
 
   Control::PerformanceMeasurement::start("durationParaview3DWrite");
 
-  // write beginning of file on rank 0
-  outputFilePartNo = 0;
+  if (appendedData_)
+  {
+    // write the xml structure and all data arrays at their precomputed offsets
+    std::stringstream xml;
+    if (ownRankNo == 0)
+    {
+      for (std::vector<std::stringstream>::iterator iter = outputFileParts.begin(); iter != outputFileParts.end(); iter++)
+        xml << iter->str();
+    }
+    appendedData.writeFile(fileHandle, xml.str());
 
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    // advance the identifier in the same way as for the data arrays written in the other modes
+    callIdentifier += polyDataPropertiesForMesh.pointDataArrays.size() + 4;
+  }
+  else
+  {
+    // write beginning of file on rank 0
+    outputFilePartNo = 0;
+
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
 
-  VLOG(1) << "get current shared file position";
+    VLOG(1) << "get current shared file position";
 
-  // get current file position
-  MPI_Offset currentFilePosition = 0;
-  MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
-  LOG(DEBUG) << "current shared file position: " << currentFilePosition;
+    // get current file position
+    MPI_Offset currentFilePosition = 0;
+    MPIUtility::handleReturnValue(MPI_File_get_position_shared(fileHandle, &currentFilePosition), "MPI_File_get_position_shared");
+    LOG(DEBUG) << "current shared file position: " << currentFilePosition;
 
-  // write field variables
-  // loop over field variables
-  for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = polyDataPropertiesForMesh.pointDataArrays.begin();
-      pointDataArrayIter != polyDataPropertiesForMesh.pointDataArrays.end(); pointDataArrayIter++)
-  {
-    assert(fieldVariableValues.find(pointDataArrayIter->name) != fieldVariableValues.end());
+    // write field variables
+    // loop over field variables
+    for (std::vector<PolyDataPropertiesForMesh::DataArrayName>::iterator pointDataArrayIter = polyDataPropertiesForMesh.pointDataArrays.begin();
+        pointDataArrayIter != polyDataPropertiesForMesh.pointDataArrays.end(); pointDataArrayIter++)
+    {
+      assert(fieldVariableValues.find(pointDataArrayIter->name) != fieldVariableValues.end());
 
-    VLOG(1) << "write vector for field variable \"" << pointDataArrayIter->name << "\".";
+      VLOG(1) << "write vector for field variable \"" << pointDataArrayIter->name << "\".";
 
-    // write values
-    bool writeFloatsAsInt = pointDataArrayIter->name == "partitioning";    // for partitioning, convert float values to integer values for output
-    writeCombinedValuesVector(fileHandle, ownRankNo, fieldVariableValues[pointDataArrayIter->name], callIdentifier++, writeFloatsAsInt);
+      // write values
+      bool writeFloatsAsInt = pointDataArrayIter->name == "partitioning";    // for partitioning, convert float values to integer values for output
+      writeCombinedValuesVector(fileHandle, ownRankNo, fieldVariableValues[pointDataArrayIter->name], callIdentifier++, writeFloatsAsInt);
 
-    // write next xml constructs
-    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-    outputFilePartNo++;
-  }
+      // write next xml constructs
+      writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+      outputFilePartNo++;
+    }
 
-  VLOG(1) << "write vector for geometry data";
+    VLOG(1) << "write vector for geometry data";
 
-  // write geometry field data
-  writeCombinedValuesVector(fileHandle, ownRankNo, geometryFieldValues, callIdentifier++);
+    // encode geometry field data, connectivity, offset and types values, if they are not unchanged since the last output
+    GeometryCache &geometryCache = geometryCache_[geometryCacheKey.str()];
+    if (!geometryUnchanged)
+    {
+      geometryCache.writeBuffers.resize(4);
+      geometryCache.writeBuffers[0] = encodeCombinedValuesVector(ownRankNo, geometryFieldValues, callIdentifier);
+      geometryCache.writeBuffers[1] = encodeCombinedValuesVector(ownRankNo, connectivityValues, callIdentifier+1);
+      geometryCache.writeBuffers[2] = encodeCombinedValuesVector(ownRankNo, offsetValues, callIdentifier+2);
+      geometryCache.writeBuffers[3] = encodeCombinedTypesVector(ownRankNo, polyDataPropertiesForMesh.nCellsGlobal, output3DMeshes);
+    }
+    callIdentifier += 4;
 
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    // write geometry field data
+    writeCombinedBuffer(fileHandle, geometryCache.writeBuffers[0]);
 
-  // write connectivity values
-  writeCombinedValuesVector(fileHandle, ownRankNo, connectivityValues, callIdentifier++);
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
 
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    // write connectivity values
+    writeCombinedBuffer(fileHandle, geometryCache.writeBuffers[1]);
 
-  // write offset values
-  writeCombinedValuesVector(fileHandle, ownRankNo, offsetValues, callIdentifier++);
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
 
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
-  outputFilePartNo++;
+    // write offset values
+    writeCombinedBuffer(fileHandle, geometryCache.writeBuffers[2]);
 
-  // write types values
-  writeCombinedTypesVector(fileHandle, ownRankNo, polyDataPropertiesForMesh.nCellsGlobal, output3DMeshes, callIdentifier++);
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    outputFilePartNo++;
+
+    // write types values
+    writeCombinedBuffer(fileHandle, geometryCache.writeBuffers[3]);
 
-  // write next xml constructs
-  writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+    // write next xml constructs
+    writeAsciiDataShared(fileHandle, ownRankNo, outputFileParts[outputFilePartNo].str());
+  }
 
   /*
     int array_of_sizes[1];
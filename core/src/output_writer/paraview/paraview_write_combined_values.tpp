@@ -13,6 +13,7 @@
 #include "output_writer/paraview/loop_collect_mesh_properties.h"
 #include "output_writer/paraview/loop_get_nodal_values.h"
 #include "output_writer/paraview/loop_get_geometry_field_nodal_values.h"
+#include "output_writer/paraview/loop_get_geometry_field_versions.h"
 #include "output_writer/paraview/poly_data_properties_for_mesh.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 
@@ -21,6 +22,12 @@ namespace OutputWriter
 
 template<typename T>
 void Paraview::writeCombinedValuesVector(MPI_File fileHandle, int ownRankNo, const std::vector<T> &values, int identifier, bool writeFloatsAsInt)
+{
+  writeCombinedBuffer(fileHandle, encodeCombinedValuesVector(ownRankNo, values, identifier, writeFloatsAsInt));
+}
+
+template<typename T>
+std::string Paraview::encodeCombinedValuesVector(int ownRankNo, const std::vector<T> &values, int identifier, bool writeFloatsAsInt)
 {
   // fill the write buffer with the local values
   std::string writeBuffer;
@@ -270,7 +277,36 @@ void Paraview::writeCombinedValuesVector(MPI_File fileHandle, int ownRankNo, con
     writeBuffer += std::string(5,'\t');
   }
 
-  MPIUtility::handleReturnValue(MPI_File_write_ordered(fileHandle, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, MPI_STATUS_IGNORE), "MPI_File_write_ordered");
+  return writeBuffer;
+}
+
+template<typename FieldVariablesForOutputWriterType>
+bool Paraview::isGeometryUnchanged(const FieldVariablesForOutputWriterType &fieldVariables, const std::set<std::string> &meshNames, std::string cacheKey)
+{
+  if (!reuseUnchangedGeometry_)
+    return false;
+
+  // get the current versions of the geometry fields, this does not access the values
+  std::vector<int> geometryVersions;
+  ParaviewLoopOverTuple::loopGetGeometryFieldVersions<FieldVariablesForOutputWriterType>(fieldVariables, meshNames, geometryVersions);
+
+  GeometryCache &geometryCache = geometryCache_[cacheKey];
+  bool isCacheFilled = !geometryCache.writeBuffers.empty() || !geometryCache.appendedArrays.empty();
+  int geometryUnchangedLocal = (isCacheFilled && geometryCache.geometryVersions == geometryVersions? 1 : 0);
+
+  // the encoding of the own data depends on the data of the neighbouring ranks, therefore the cached data can only be used if no rank has a changed geometry
+  int geometryUnchanged = 0;
+  MPIUtility::handleReturnValue(MPI_Allreduce(&geometryUnchangedLocal, &geometryUnchanged, 1, MPI_INT, MPI_MIN, this->rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+
+  if (!geometryUnchanged)
+  {
+    geometryCache.writeBuffers.clear();
+    geometryCache.appendedArrays.clear();
+    geometryCache.geometryVersions = geometryVersions;
+  }
+
+  VLOG(1) << "geometry of \"" << cacheKey << "\" unchanged: " << (geometryUnchanged? "yes" : "no") << ", versions: " << geometryVersions;
+  return geometryUnchanged;
 }
 
 } // namespace
@@ -7,6 +7,7 @@
 
 #include "output_writer/paraview/loop_collect_field_variables_names.h"
 #include "output_writer/paraview/loop_output_point_data.h"
+#include "output_writer/output_file_stream.h"
 #include "field_variable/field_variable.h"
 
 namespace OutputWriter
@@ -16,7 +17,7 @@ template<int D, typename BasisFunctionType, typename FieldVariablesForOutputWrit
 void ParaviewWriter<FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<D>, BasisFunctionType>, FieldVariablesForOutputWriterType>::
 outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariables, std::string meshName, 
            std::shared_ptr<FunctionSpace::FunctionSpace<Mesh::StructuredRegularFixedOfDimension<D>, BasisFunctionType>> mesh,
-           int nFieldVariablesOfMesh, PythonConfig specificSettings, double currentTime)
+           int nFieldVariablesOfMesh, PythonConfig specificSettings, double currentTime, bool asynchronous)
 {
   // write a RectilinearGrid
 
@@ -65,8 +66,7 @@ outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariable
     s << filenameBaseWithPath << ".pvtr";
 
     // open file
-    std::ofstream file;
-    Paraview::openFile(file, s.str());
+    OutputFileStream file(s.str(), asynchronous);
 
     LOG(DEBUG) << "Write PRectilinearGrid, file \"" << s.str() << "\".";
 
@@ -168,8 +168,7 @@ outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariable
 
 
   // open file
-  std::ofstream file;
-  Paraview::openFile(file, s.str());
+  OutputFileStream file(s.str(), asynchronous);
 
   LOG(DEBUG) << "Write RectilinearGrid, file \"" << s.str() << "\".";
 
@@ -244,46 +243,23 @@ outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariable
     << std::string(3, '\t') << "</CellData>" << std::endl
     << std::string(3, '\t') << "<Coordinates>" << std::endl;
 
-  if (binaryOutput)
+  for (int coordinateNo = 0; coordinateNo < 3; coordinateNo++)
   {
     file << std::string(4, '\t') << "<DataArray "
         << "type=\"Float32\" "
         << "NumberOfComponents=\"1\" "
-        << "format=\"binary\" >" << std::endl
-      << std::string(5, '\t') << Paraview::encodeBase64Float(coordinates[0].begin(), coordinates[0].end()) << std::endl
-      << std::string(4, '\t') << "</DataArray>" << std::endl
-      << std::string(4, '\t') << "<DataArray "
-        << "type=\"Float32\" "
-        << "NumberOfComponents=\"1\" "
-        << "format=\"binary\" >" << std::endl
-      << std::string(5, '\t') << Paraview::encodeBase64Float(coordinates[1].begin(), coordinates[1].end()) << std::endl
-      << std::string(4, '\t') << "</DataArray>" << std::endl
-      << std::string(4, '\t') << "<DataArray "
-        << "type=\"Float32\" "
-        << "NumberOfComponents=\"1\" "
-        << "format=\"binary\" >" << std::endl
-      << std::string(5, '\t') << Paraview::encodeBase64Float(coordinates[2].begin(), coordinates[2].end()) << std::endl
-      << std::string(4, '\t') << "</DataArray>" << std::endl;
-  }
-  else
-  {
-    file << std::string(4, '\t') << "<DataArray "
-        << "type=\"Float32\" "
-        << "NumberOfComponents=\"1\" "
-        << "format=\"ascii\" >" << std::endl
-      << std::string(5, '\t') << Paraview::convertToAscii(coordinates[0], fixedFormat) << std::endl
-      << std::string(4, '\t') << "</DataArray>" << std::endl
-      << std::string(4, '\t') << "<DataArray "
-        << "type=\"Float32\" "
-        << "NumberOfComponents=\"1\" "
-        << "format=\"ascii\" >" << std::endl
-      << std::string(5, '\t') << Paraview::convertToAscii(coordinates[1], fixedFormat) << std::endl
-      << std::string(4, '\t') << "</DataArray>" << std::endl
-      << std::string(4, '\t') << "<DataArray "
-        << "type=\"Float32\" "
-        << "NumberOfComponents=\"1\" "
-        << "format=\"ascii\" >" << std::endl
-      << std::string(5, '\t') << Paraview::convertToAscii(coordinates[2], fixedFormat) << std::endl
+        << "format=\"" << (binaryOutput? "binary" : "ascii") << "\" >" << std::endl
+      << std::string(5, '\t');
+
+    // encode the coordinates, for asynchronous output this is done on the background thread
+    OutputFileStream::writeEncoded(file, [values = coordinates[coordinateNo], binaryOutput, fixedFormat]()
+    {
+      if (binaryOutput)
+        return Paraview::encodeBase64Float(values.begin(), values.end());
+      return Paraview::convertToAscii(values, fixedFormat);
+    });
+
+    file << std::endl
       << std::string(4, '\t') << "</DataArray>" << std::endl;
   }
   file << std::string(3, '\t') << "</Coordinates>" << std::endl
@@ -298,7 +274,7 @@ template<int D, typename BasisFunctionType, typename FieldVariablesForOutputWrit
 void ParaviewWriter<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>, BasisFunctionType>, FieldVariablesForOutputWriterType>::
 outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariables, std::string meshName, 
            std::shared_ptr<FunctionSpace::FunctionSpace<Mesh::StructuredDeformableOfDimension<D>, BasisFunctionType>> mesh,
-           int nFieldVariablesOfMesh, PythonConfig specificSettings, double currentTime)
+           int nFieldVariablesOfMesh, PythonConfig specificSettings, double currentTime, bool asynchronous)
 {
   // write a StructuredGrid
 
@@ -347,8 +323,7 @@ outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariable
     s << filenameBaseWithPath << ".pvts";
 
     // open file
-    std::ofstream file;
-    Paraview::openFile(file, s.str());
+    OutputFileStream file(s.str(), asynchronous);
 
     LOG(DEBUG) << "Write PStructuredGrid, file \"" << s.str() << "\".";
 
@@ -439,8 +414,7 @@ outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariable
   }
 
   // open file
-  std::ofstream file;
-  Paraview::openFile(file, s.str());
+  OutputFileStream file(s.str(), asynchronous);
 
   LOG(DEBUG) << "Write StructuredGrid, file \"" << s.str() << "\".";
 
@@ -508,7 +482,7 @@ template<int D, typename BasisFunctionType, typename FieldVariablesForOutputWrit
 void ParaviewWriter<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>, FieldVariablesForOutputWriterType>::
 outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariables, std::string meshName, 
            std::shared_ptr<FunctionSpace::FunctionSpace<Mesh::UnstructuredDeformableOfDimension<D>, BasisFunctionType>> mesh,
-           int nFieldVariablesOfMesh, PythonConfig specificSettings, double currentTime)
+           int nFieldVariablesOfMesh, PythonConfig specificSettings, double currentTime, bool asynchronous)
 {
   // write an UnstructuredGrid
   // determine file name
@@ -516,8 +490,7 @@ outputFile(std::string filename, FieldVariablesForOutputWriterType fieldVariable
   s << filename << ".vtu";
 
   // open file
-  std::ofstream file;
-  Paraview::openFile(file, s.str());
+  OutputFileStream file(s.str(), asynchronous);
 
   LOG(DEBUG) << "Write UnstructuredGrid, file \"" << s.str() << "\".";
 
@@ -0,0 +1,282 @@
+#include "output_writer/paraview/vtk_appended_data.h"
+
+#include <cstring>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "easylogging++.h"
+#include "utility/mpi_utility.h"
+
+namespace OutputWriter
+{
+
+VTKAppendedData::VTKAppendedData(std::shared_ptr<Partition::RankSubset> rankSubset, bool compression) :
+  rankSubset_(rankSubset), compression_(compression)
+{
+#ifndef HAVE_ZLIB
+  if (compression_)
+  {
+    LOG(WARNING) << "Compression of the appended VTK data was requested, but opendihu was not compiled with zlib. The data will not be compressed.";
+    compression_ = false;
+  }
+#endif
+}
+
+VTKAppendedData::Array VTKAppendedData::encodeFloat32(const std::vector<double> &values)
+{
+  std::string localBytes(values.size()*sizeof(float), '\0');
+  for (int i = 0; i < values.size(); i++)
+  {
+    float value = (float)values[i];
+    memcpy(&localBytes[i*sizeof(float)], &value, sizeof(float));
+  }
+  return encodeBytes(std::move(localBytes));
+}
+
+VTKAppendedData::Array VTKAppendedData::encodeInt32(const std::vector<int> &values)
+{
+  std::string localBytes(values.size()*sizeof(int32_t), '\0');
+  for (int i = 0; i < values.size(); i++)
+  {
+    int32_t value = (int32_t)values[i];
+    memcpy(&localBytes[i*sizeof(int32_t)], &value, sizeof(int32_t));
+  }
+  return encodeBytes(std::move(localBytes));
+}
+
+VTKAppendedData::Array VTKAppendedData::encodeInt32(const std::vector<double> &values)
+{
+  std::string localBytes(values.size()*sizeof(int32_t), '\0');
+  for (int i = 0; i < values.size(); i++)
+  {
+    int32_t value = (int32_t)(round(values[i]));
+    memcpy(&localBytes[i*sizeof(int32_t)], &value, sizeof(int32_t));
+  }
+  return encodeBytes(std::move(localBytes));
+}
+
+VTKAppendedData::Array VTKAppendedData::encodeUInt8(int nValues, uint8_t value)
+{
+  return encodeBytes(std::string(nValues, (char)value));
+}
+
+VTKAppendedData::Array VTKAppendedData::encodeBytes(std::string &&localBytes)
+{
+  if (compression_)
+    return compressBytes(localBytes);
+
+  Array array;
+  array.headerSize = sizeof(uint64_t);
+  array.localData = std::move(localBytes);
+
+  // the header is the total number of bytes of the array
+  long long nBytesLocal = array.localData.size();
+  long long nBytesGlobal = 0;
+  MPIUtility::handleReturnValue(MPI_Reduce(&nBytesLocal, &nBytesGlobal, 1, MPI_LONG_LONG, MPI_SUM, 0, rankSubset_->mpiCommunicator()), "MPI_Reduce");
+
+  if (rankSubset_->ownRankNo() == 0)
+  {
+    uint64_t header = nBytesGlobal;
+    array.header.assign((const char *)&header, sizeof(uint64_t));
+  }
+  return array;
+}
+
+VTKAppendedData::Array VTKAppendedData::compressBytes(const std::string &localBytes)
+{
+  Array array;
+#ifdef HAVE_ZLIB
+  const int nRanks = rankSubset_->size();
+  const int ownRankNo = rankSubset_->ownRankNo();
+
+  // gather the number of bytes on all ranks
+  long long nBytesLocal = localBytes.size();
+  std::vector<long long> nBytesOnRanks(nRanks);
+  MPIUtility::handleReturnValue(MPI_Allgather(&nBytesLocal, 1, MPI_LONG_LONG, nBytesOnRanks.data(), 1, MPI_LONG_LONG,
+                                              rankSubset_->mpiCommunicator()), "MPI_Allgather");
+
+  // determine the start of the data of every rank in the global array, the start of the range of complete blocks that every rank compresses
+  std::vector<long long> dataBegin(nRanks+1, 0);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    dataBegin[rankNo+1] = dataBegin[rankNo] + nBytesOnRanks[rankNo];
+
+  const long long nBytesGlobal = dataBegin[nRanks];
+  std::vector<long long> blocksBegin(nRanks+1, nBytesGlobal);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+    blocksBegin[rankNo] = std::min(nBytesGlobal, (dataBegin[rankNo] + blockSize_ - 1) / blockSize_ * blockSize_);
+
+  // determine the number of bytes to send to and receive from every rank, such that afterwards every rank owns the range [blocksBegin[ownRankNo], blocksBegin[ownRankNo+1])
+  auto overlap = [](long long begin0, long long end0, long long begin1, long long end1) -> int
+  {
+    return (int)std::max(0LL, std::min(end0, end1) - std::max(begin0, begin1));
+  };
+
+  std::vector<int> sendCounts(nRanks), sendDisplacements(nRanks), receiveCounts(nRanks), receiveDisplacements(nRanks);
+  for (int rankNo = 0; rankNo < nRanks; rankNo++)
+  {
+    sendCounts[rankNo] = overlap(dataBegin[ownRankNo], dataBegin[ownRankNo+1], blocksBegin[rankNo], blocksBegin[rankNo+1]);
+    receiveCounts[rankNo] = overlap(dataBegin[rankNo], dataBegin[rankNo+1], blocksBegin[ownRankNo], blocksBegin[ownRankNo+1]);
+    if (rankNo > 0)
+    {
+      sendDisplacements[rankNo] = sendDisplacements[rankNo-1] + sendCounts[rankNo-1];
+      receiveDisplacements[rankNo] = receiveDisplacements[rankNo-1] + receiveCounts[rankNo-1];
+    }
+  }
+
+  std::string blocksData(blocksBegin[ownRankNo+1] - blocksBegin[ownRankNo], '\0');
+  MPIUtility::handleReturnValue(MPI_Alltoallv(localBytes.data(), sendCounts.data(), sendDisplacements.data(), MPI_BYTE,
+                                              &blocksData[0], receiveCounts.data(), receiveDisplacements.data(), MPI_BYTE,
+                                              rankSubset_->mpiCommunicator()), "MPI_Alltoallv");
+
+  // compress the own blocks
+  std::vector<unsigned long long> compressedBlockSizes;
+  std::vector<char> compressedBlock;
+  for (long long blockBegin = 0; blockBegin < blocksData.size(); blockBegin += blockSize_)
+  {
+    uLong uncompressedSize = std::min(blockSize_, (long long)blocksData.size() - blockBegin);
+    uLongf compressedSize = compressBound(uncompressedSize);
+    compressedBlock.resize(compressedSize);
+
+    int returnValue = compress2((Bytef *)compressedBlock.data(), &compressedSize, (const Bytef *)blocksData.data() + blockBegin, uncompressedSize, Z_DEFAULT_COMPRESSION);
+    if (returnValue != Z_OK)
+    {
+      LOG(FATAL) << "Compression of VTK data with zlib failed with error code " << returnValue << ".";
+    }
+
+    compressedBlockSizes.push_back(compressedSize);
+    array.localData.append(compressedBlock.data(), compressedSize);
+  }
+
+  // collect the compressed sizes of all blocks on rank 0
+  int nBlocksLocal = compressedBlockSizes.size();
+  std::vector<int> nBlocksOnRanks(nRanks);
+  MPIUtility::handleReturnValue(MPI_Gather(&nBlocksLocal, 1, MPI_INT, nBlocksOnRanks.data(), 1, MPI_INT, 0, rankSubset_->mpiCommunicator()), "MPI_Gather");
+
+  const long long nBlocksGlobal = (nBytesGlobal + blockSize_ - 1) / blockSize_;
+  std::vector<unsigned long long> header(3 + (ownRankNo == 0? nBlocksGlobal : 0));
+  std::vector<int> blockDisplacements(nRanks, 0);
+  for (int rankNo = 1; rankNo < nRanks; rankNo++)
+    blockDisplacements[rankNo] = blockDisplacements[rankNo-1] + nBlocksOnRanks[rankNo-1];
+
+  MPIUtility::handleReturnValue(MPI_Gatherv(compressedBlockSizes.data(), nBlocksLocal, MPI_UNSIGNED_LONG_LONG,
+                                            header.data() + 3, nBlocksOnRanks.data(), blockDisplacements.data(), MPI_UNSIGNED_LONG_LONG,
+                                            0, rankSubset_->mpiCommunicator()), "MPI_Gatherv");
+
+  // header: number of blocks, block size, size of the last partial block, compressed block sizes
+  array.headerSize = (3 + nBlocksGlobal) * sizeof(uint64_t);
+  if (ownRankNo == 0)
+  {
+    header[0] = nBlocksGlobal;
+    header[1] = blockSize_;
+    header[2] = nBytesGlobal % blockSize_;
+
+    array.header.resize(array.headerSize);
+    for (int i = 0; i < header.size(); i++)
+    {
+      uint64_t value = header[i];
+      memcpy(&array.header[i*sizeof(uint64_t)], &value, sizeof(uint64_t));
+    }
+  }
+#endif
+  return array;
+}
+
+void VTKAppendedData::addArray(const Array &array)
+{
+  arrays_.push_back(array);
+}
+
+void VTKAppendedData::computeOffsets()
+{
+  const int nArrays = arrays_.size();
+
+  // determine the offsets of the local data in all arrays and the total sizes with one reduction each
+  std::vector<long long> nBytesLocal(nArrays);
+  for (int arrayNo = 0; arrayNo < nArrays; arrayNo++)
+    nBytesLocal[arrayNo] = arrays_[arrayNo].localData.size();
+
+  localDataOffsets_.assign(nArrays, 0);
+  std::vector<long long> nBytesGlobal(nArrays, 0);
+  MPIUtility::handleReturnValue(MPI_Exscan(nBytesLocal.data(), localDataOffsets_.data(), nArrays, MPI_LONG_LONG, MPI_SUM, rankSubset_->mpiCommunicator()), "MPI_Exscan");
+  MPIUtility::handleReturnValue(MPI_Allreduce(nBytesLocal.data(), nBytesGlobal.data(), nArrays, MPI_LONG_LONG, MPI_SUM, rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+
+  // the result of MPI_Exscan is undefined on rank 0
+  if (rankSubset_->ownRankNo() == 0)
+    localDataOffsets_.assign(nArrays, 0);
+
+  arrayOffsets_.resize(nArrays+1);
+  arrayOffsets_[0] = 0;
+  for (int arrayNo = 0; arrayNo < nArrays; arrayNo++)
+  {
+    arrayOffsets_[arrayNo+1] = arrayOffsets_[arrayNo] + arrays_[arrayNo].headerSize + nBytesGlobal[arrayNo];
+  }
+}
+
+std::string VTKAppendedData::formatAttributes(int arrayNo) const
+{
+  assert(arrayNo < arrayOffsets_.size());
+
+  std::stringstream s;
+  s << "format=\"appended\" offset=\"" << arrayOffsets_[arrayNo] << "\"";
+  return s.str();
+}
+
+std::string VTKAppendedData::vtkFileAttributes() const
+{
+  if (compression_)
+    return std::string(" header_type=\"UInt64\" compressor=\"vtkZLibDataCompressor\"");
+  return std::string(" header_type=\"UInt64\"");
+}
+
+void VTKAppendedData::writeFile(MPI_File fileHandle, const std::string &xml)
+{
+  const int ownRankNo = rankSubset_->ownRankNo();
+  const std::string appendedDataBegin = std::string(1, '\t') + "<AppendedData encoding=\"raw\">\n" + std::string(1, '\t') + "_";
+  const std::string appendedDataEnd = std::string("\n") + std::string(1, '\t') + "</AppendedData>\n</VTKFile>\n";
+
+  // the xml structure is only given on rank 0, determine the offset of the appended data on all ranks
+  long long appendedDataOffset = xml.size() + appendedDataBegin.size();
+  MPIUtility::handleReturnValue(MPI_Bcast(&appendedDataOffset, 1, MPI_LONG_LONG, 0, rankSubset_->mpiCommunicator()), "MPI_Bcast");
+
+  // write xml structure
+  if (ownRankNo == 0)
+  {
+    std::string writeBuffer = xml + appendedDataBegin;
+    MPI_Status status;
+    MPIUtility::handleReturnValue(MPI_File_write_at(fileHandle, 0, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, &status), "MPI_File_write_at", &status);
+  }
+
+  // write data arrays, the header is written by rank 0 directly before its own data
+  for (int arrayNo = 0; arrayNo < arrays_.size(); arrayNo++)
+  {
+    const Array &array = arrays_[arrayNo];
+    MPI_Offset offset = appendedDataOffset + arrayOffsets_[arrayNo] + array.headerSize + localDataOffsets_[arrayNo];
+    MPI_Status status;
+
+    if (ownRankNo == 0)
+    {
+      std::string writeBuffer = array.header + array.localData;
+      offset -= array.headerSize;
+      MPIUtility::handleReturnValue(MPI_File_write_at_all(fileHandle, offset, writeBuffer.c_str(), writeBuffer.length(), MPI_BYTE, &status), "MPI_File_write_at_all", &status);
+    }
+    else
+    {
+      MPIUtility::handleReturnValue(MPI_File_write_at_all(fileHandle, offset, array.localData.c_str(), array.localData.length(), MPI_BYTE, &status), "MPI_File_write_at_all", &status);
+    }
+  }
+
+  // write closing tags
+  if (ownRankNo == 0)
+  {
+    MPI_Status status;
+    MPIUtility::handleReturnValue(MPI_File_write_at(fileHandle, appendedDataOffset + arrayOffsets_.back(), appendedDataEnd.c_str(), appendedDataEnd.length(), MPI_BYTE, &status), "MPI_File_write_at", &status);
+  }
+}
+
+}  // namespace
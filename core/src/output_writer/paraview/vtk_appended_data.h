@@ -0,0 +1,88 @@
+#pragma once
+
+#include <Python.h>  // has to be the first included header
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <mpi.h>
+
+#include "partition/rank_subset.h"
+
+namespace OutputWriter
+{
+
+/** Raw binary data in the <AppendedData encoding="raw"> section of a VTK XML file, which is written collectively by all ranks with MPI IO.
+ *  This is used by the Paraview writer for combined files with the option "appendedData", instead of base64 encoded inline data.
+ *
+ *  Every data array consists of a header, which is written by rank 0, followed by the local data of all ranks in the order of the ranks.
+ *  Without compression, the header is the total number of bytes as UInt64.
+ *  With compression, the data is split into blocks of equal size that are compressed separately with zlib, as expected by vtkZLibDataCompressor.
+ *  Then the header consists of the number of blocks, the uncompressed block size, the uncompressed size of the last block (0 if it is full)
+ *  and the compressed sizes of all blocks. Because the block boundaries do not coincide with the boundaries of the local data of the ranks,
+ *  the data is redistributed such that every rank compresses full blocks.
+ *
+ *  Usage: encode all arrays and add them with addArray, call computeOffsets, write the xml structure with the offset attributes
+ *  obtained by formatAttributes and finally call writeFile.
+ */
+class VTKAppendedData
+{
+public:
+
+  //! the encoded data of one data array
+  struct Array
+  {
+    std::string header;         //< the header of the data array, only set on rank 0
+    long long headerSize = 0;   //< the number of bytes of the header, set on all ranks
+    std::string localData;      //< the raw or compressed data of the own rank
+  };
+
+  //! constructor
+  VTKAppendedData(std::shared_ptr<Partition::RankSubset> rankSubset, bool compression);
+
+  //! encode local double values as Float32, this is a collective call
+  Array encodeFloat32(const std::vector<double> &values);
+
+  //! encode local integer values as Int32, this is a collective call
+  Array encodeInt32(const std::vector<int> &values);
+
+  //! encode local double values that are rounded to integers as Int32, e.g. for the partitioning field, this is a collective call
+  Array encodeInt32(const std::vector<double> &values);
+
+  //! encode nValues times the given value as UInt8, e.g. for the cell types, this is a collective call
+  Array encodeUInt8(int nValues, uint8_t value);
+
+  //! add an encoded data array, the arrays are written in the order in which they are added
+  void addArray(const Array &array);
+
+  //! determine the offsets of all data arrays in the appended data section and of the local data of the own rank, this is a collective call
+  void computeOffsets();
+
+  //! get the format and offset attributes for the DataArray element of the array with the given number, computeOffsets has to be called before
+  std::string formatAttributes(int arrayNo) const;
+
+  //! get the additional attributes for the VTKFile element, that specify the header type and the compressor
+  std::string vtkFileAttributes() const;
+
+  //! write the given xml structure (only needed on rank 0), the appended data and the closing tags to the opened file, this is a collective call
+  //! all data arrays are written with one MPI_File_write_at_all call each at the precomputed offsets
+  void writeFile(MPI_File fileHandle, const std::string &xml);
+
+protected:
+
+  //! add the header to the given array and compress the data if enabled
+  Array encodeBytes(std::string &&localBytes);
+
+  //! redistribute the local bytes such that every rank owns complete blocks and compress them
+  Array compressBytes(const std::string &localBytes);
+
+  std::shared_ptr<Partition::RankSubset> rankSubset_;   //< the ranks that write the file
+  bool compression_;                                     //< if the data arrays are compressed with zlib
+  const long long blockSize_ = 32768;                   //< the uncompressed size of a compression block in bytes, this is the default of VTK
+
+  std::vector<Array> arrays_;                  //< the data arrays that will be written
+  std::vector<long long> arrayOffsets_;        //< for every array the offset relative to the start of the appended data
+  std::vector<long long> localDataOffsets_;    //< for every array the offset of the local data of the own rank relative to the start of the array data after the header
+};
+
+}  // namespace
@@ -84,4 +84,64 @@ void PythonFile::outputPyObject(PyObject *file, PyObject *pyData)
 #endif
 }
 
+bool PythonFile::serializePyObject(PyObject *pyData, bool usePickle, std::string &contents)
+{
+#if PY_MAJOR_VERSION >= 3
+  // load module if it was not loaded in an earlier call
+  static PyObject *pickleModule = NULL;
+  static PyObject *jsonModule = NULL;
+
+  PyObject *serializedData = NULL;
+  if (usePickle)
+  {
+    if (pickleModule == NULL)
+      pickleModule = PyImport_ImportModule("pickle");
+    if (pickleModule == NULL)
+    {
+      LOG(ERROR) << "Could not import pickle module";
+      return false;
+    }
+    serializedData = PyObject_CallMethod(pickleModule, "dumps", "(O i)", pyData, 1);
+  }
+  else
+  {
+    if (jsonModule == NULL)
+      jsonModule = PyImport_ImportModule("json");
+    if (jsonModule == NULL)
+    {
+      LOG(ERROR) << "Could not import json module";
+      return false;
+    }
+    serializedData = PyObject_CallMethod(jsonModule, "dumps", "(O)", pyData);
+  }
+
+  if (serializedData == NULL)
+  {
+    LOG(ERROR) << "Could not serialize python object for output.";
+    PythonUtility::checkForError();
+    return false;
+  }
+
+  // pickle.dumps returns bytes, json.dumps returns str
+  char *buffer = NULL;
+  Py_ssize_t size = 0;
+  if (PyBytes_Check(serializedData))
+  {
+    PyBytes_AsStringAndSize(serializedData, &buffer, &size);
+    contents.assign(buffer, size);
+  }
+  else
+  {
+    const char *utf8Buffer = PyUnicode_AsUTF8AndSize(serializedData, &size);
+    if (utf8Buffer)
+      contents.assign(utf8Buffer, size);
+  }
+  Py_XDECREF(serializedData);
+  return true;
+#else
+  LOG(ERROR) << "Asynchronous output of python files is only available with python 3.";
+  return false;
+#endif
+}
+
 }  // namespace
@@ -29,6 +29,9 @@ private:
   //! write a python object to an already opened python file stream
   void outputPyObject(PyObject *file, PyObject *pyData);
 
+  //! serialize a python object to a string using pickle.dumps (if usePickle) or json.dumps, this is used for asynchronous output, returns false on error
+  bool serializePyObject(PyObject *pyData, bool usePickle, std::string &contents);
+
   bool onlyNodalValues_;  //< if only nodal values should be output, this omits the derivative values for Hermite ansatz functions, for Lagrange functions it has no effect
 };
 
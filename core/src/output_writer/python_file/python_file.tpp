@@ -7,6 +7,7 @@
 #include "easylogging++.h"
 #include "output_writer/python/python.h"
 #include "output_writer/python_file/python_stiffness_matrix_writer.h"
+#include "output_writer/output_file_stream.h"
 
 namespace OutputWriter
 {
@@ -62,15 +63,29 @@ void PythonFile::write(DataType& data, int timeStepNo, double currentTime, int c
       PythonUtility::printDict(pyData);
     }
 
+    // pickle is the python library to serialize objects
+    bool usePickle = specificSettings_.getOptionBool("binary", false);
+
+    if (asynchronous_)
+    {
+      // serialize the python object to memory, the file is written by the background thread of the AsynchronousFileWriter
+      std::string contents;
+      if (serializePyObject(pyData, usePickle, contents))
+      {
+        OutputFileStream file(filename, true);
+        file.write(contents.data(), contents.size());
+        file.close();
+      }
+      Py_XDECREF(pyData);
+      continue;
+    }
+
     // open file, to see if directory needs to be created
     std::ofstream ofile;
     openFile(ofile, filename);
     if (ofile.is_open())
       ofile.close();
 
-    // pickle is the python library to serialize objects
-    bool usePickle = specificSettings_.getOptionBool("binary", false);
-
     std::string writeFlag = (usePickle? "wb" : "w");
 
     PyObject *file = openPythonFileStream(filename, writeFlag);
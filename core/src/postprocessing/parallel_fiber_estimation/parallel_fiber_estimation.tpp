@@ -159,6 +159,9 @@ run()
 
   // output
   outputWriterManager_.writeOutput(data_);
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename BasisFunctionType>
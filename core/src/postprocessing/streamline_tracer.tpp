@@ -74,6 +74,9 @@ run()
 
   // output data
   outputWriterManager_.writeOutput(data_);
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename DiscretizableInTimeType>
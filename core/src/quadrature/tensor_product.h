@@ -62,6 +62,9 @@ public:
 
   //! get the sampling points, i.e. points where the function needs to be evaluated
   static std::array<Vec3, TensorProductBase<3,Quadrature>::numberEvaluations()> samplingPoints();
+
+  //! get the quadrature weights of the sampling points, in the same order as samplingPoints()
+  static std::array<double, TensorProductBase<3,Quadrature>::numberEvaluations()> quadratureWeights();
 };
 
 } // namespace
@@ -68,6 +68,28 @@ samplingPoints()
   return samplingPoints;
 }
 
+// 3D quadrature weights
+template<typename Quadrature>
+std::array<double,TensorProductBase<3,Quadrature>::numberEvaluations()> TensorProduct<3,Quadrature>::
+quadratureWeights()
+{
+  std::array<double,TensorProductBase<3,Quadrature>::numberEvaluations()> quadratureWeights;
+  const std::array<double,Quadrature::numberEvaluations()> weights = Quadrature::quadratureWeights();
+
+  int samplingPointNo = 0;
+  for (int k = 0; k < Quadrature::numberEvaluations(); k++)
+  {
+    for (int j = 0; j < Quadrature::numberEvaluations(); j++)
+    {
+      for (int i = 0; i < Quadrature::numberEvaluations(); i++, samplingPointNo++)
+      {
+        quadratureWeights[samplingPointNo] = weights[k]*weights[j]*weights[i];
+      }
+    }
+  }
+  return quadratureWeights;
+}
+
 // 1D integration
 template<typename Quadrature>
 template<typename ValueType>
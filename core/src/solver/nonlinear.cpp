@@ -13,6 +13,8 @@ Nonlinear::Nonlinear(PythonConfig specificSettings, MPI_Comm mpiCommunicator, st
   snesMaxIterations_ = this->specificSettings_.getOptionDouble("snesMaxIterations", 50, PythonUtility::Positive);
   snesMaxFunctionEvaluations_ = this->specificSettings_.getOptionDouble("snesMaxFunctionEvaluations", 1000, PythonUtility::Positive);
   snesRebuildJacobianFrequency_ = this->specificSettings_.getOptionDouble("snesRebuildJacobianFrequency", 5);
+  snesRebuildPreconditionerFrequency_ = this->specificSettings_.getOptionInt("snesRebuildPreconditionerFrequency", 1);
+  snesRebuildFrequencyPersists_ = this->specificSettings_.getOptionBool("snesRebuildFrequencyPersists", false);
   snesLineSearchType_ = this->specificSettings_.getOptionString("snesLineSearchType", "l2");
 
   // assert that snesLineSearchType_ has a valid type: https://www.mcs.anl.gov/petsc/petsc-current/docs/manualpages/SNES/SNESLineSearchType.html#SNESLineSearchType
@@ -33,6 +35,11 @@ Nonlinear::Nonlinear(PythonConfig specificSettings, MPI_Comm mpiCommunicator, st
 
   // set option how often jacobian will be recomputed
   ierr = SNESSetLagJacobian(*snes_, snesRebuildJacobianFrequency_); CHKERRV(ierr);
+  ierr = SNESSetLagPreconditioner(*snes_, snesRebuildPreconditionerFrequency_); CHKERRV(ierr);
+
+  // set if the jacobian and preconditioner from the previous solve can be reused, e.g. in the next timestep
+  ierr = SNESSetLagJacobianPersists(*snes_, snesRebuildFrequencyPersists_? PETSC_TRUE : PETSC_FALSE); CHKERRV(ierr);
+  ierr = SNESSetLagPreconditionerPersists(*snes_, snesRebuildFrequencyPersists_? PETSC_TRUE : PETSC_FALSE); CHKERRV(ierr);
 
   // set options from command line as specified by PETSc
   ierr = SNESSetFromOptions(*snes_); CHKERRV(ierr);
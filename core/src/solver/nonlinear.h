@@ -33,6 +33,8 @@ protected:
   long int snesMaxIterations_;           //< maximum number of iterations
   long int snesMaxFunctionEvaluations_;  //< maximum number of function evaluations
   int snesRebuildJacobianFrequency_;     //< how often the jacobian will be rebuild, -1 indicates NEVER rebuild, 1 means rebuild every time the Jacobian is computed within a single nonlinear solve, 2 means every second time the Jacobian is built etc. -2 means rebuild at next chance but then never again 
+  int snesRebuildPreconditionerFrequency_;  //< how often the preconditioner will be rebuild, same values as snesRebuildJacobianFrequency_
+  bool snesRebuildFrequencyPersists_;    //< if the counting for snesRebuildJacobianFrequency_ and snesRebuildPreconditionerFrequency_ continues over multiple nonlinear solves, such that the jacobian and preconditioner can be reused in the next solve
   std::string snesLineSearchType_;       //< linesearch type of the snes object (SNESLineSearchType)
 };
 
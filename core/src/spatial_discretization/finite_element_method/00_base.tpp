@@ -144,6 +144,9 @@ run()
   data_.print();
 
   callOutputWriter(-1, 0.0);
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename FunctionSpaceType,typename QuadratureType,int nComponents,typename Term>
@@ -184,6 +184,9 @@ run()
   initialize();
 
   advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 
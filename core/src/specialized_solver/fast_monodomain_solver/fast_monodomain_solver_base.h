@@ -2,6 +2,7 @@
 
 #include <Python.h>  // has to be the first included header
 #include <array>
+#include <map>
 #include <vc_or_std_simd.h>  // this includes <Vc/Vc> or a Vc-emulating wrapper of <experimental/simd> if available
 
 #include "control/multiple_instances.h"
@@ -157,9 +158,33 @@ protected:
   //! initialize the internal data structures, such as fiberData_
   void initializeDataStructures();
 
+  //! determine for every fiber the rank that computes it, according to the option "fiberAssignment", this initializes fiberComputingRank_
+  void initializeFiberAssignment();
+
+  //! estimate the computational cost of a fiber from its number of dofs and the expected activity of its motor unit, used by the "costModel" fiber assignment
+  double estimateFiberCost(CellmlAdapterType &cellmlAdapter, int nDofs);
+
+  //! log the ratio of maximum to mean load over all ranks, for the predicted costs and for the measured durations of computeMonodomain, collective call
+  void logLoadImbalance();
+
+  //! migrate fibers between the ranks of their rank subsets, such that the measured durations of computeMonodomain are balanced
+  void rebalanceFibers();
+
+  //! estimate the current cost of the fiber fiberData_[fiberDataNo], from the number of points that are currently computed
+  double currentFiberCost(int fiberDataNo);
+
+  //! store the stimulation state and all states of the fiber fiberData_[fiberDataNo] (and of the last checkpoint) in buffer, to be sent to another rank
+  void serializeFiberData(int fiberDataNo, std::vector<double> &buffer);
+
+  //! recreate fiberData_ and the point buffers for the fibers that are computed by the own rank according to fiberComputingRank_, from the serialized data of these fibers, key is the fiberNo
+  void rebuildFiberData(std::map<int,std::vector<double>> &serializedFibers);
+
   //! set the names of the field variables in the data connector slots
   void initializeFieldVariableNames();
 
+  //! initialize furtherValueIsTransferred_ from the option "residentFiberDataTransfer"
+  void initializeTransferredValues();
+
   //! create a source file with compute0D function from the CellML model, using the vc optimization type
   void initializeCellMLSourceFileVc();
 
@@ -229,6 +254,23 @@ protected:
   OutputWriter::Manager outputWriterManager_;     //< manager object holding all output writers
 
   std::vector<FiberData> fiberData_;  //< vector of fibers, the number of entries is the number of fibers to be computed by the own rank (nFibersToCompute_)
+  std::vector<int> fiberComputingRank_;  //< for every fiber of the nested instances, the rank no. in the rank subset of the fiber that computes the fiber
+  std::string fiberAssignment_;         //< how the fibers are assigned to the ranks that compute them, "roundRobin" or "costModel"
+  double fiberAssignmentIdleWeight_;    //< for "costModel", the cost of a fiber point that is not computed because the fiber was not yet stimulated, relative to a computed point
+  double predictedLoad_;                //< sum of the estimated costs of the fibers that are computed by the own rank
+  double computeMonodomainDuration_;    //< accumulated duration of computeMonodomain on the own rank, to compare with predictedLoad_
+  int nAdvanceTimeSpanCalls_;           //< number of calls to advanceTimeSpan, used to log the load imbalance at regular intervals
+  int fiberRebalanceInterval_;          //< number of advanceTimeSpan calls after which the fibers are rebalanced between the ranks, 0 means never
+  double fiberRebalanceThreshold_;      //< minimum ratio of maximum to mean measured duration of the ranks for which fibers are migrated
+  double durationSinceLastRebalance_;   //< duration of computeMonodomain on the own rank since the last rebalancing
+  bool hasFiberDataCheckpoint_;         //< if saveFiberDataCheckpoint was called, then fiberPointBuffersLastCheckpoint_ also has to be migrated
+
+  bool residentFiberData_;                                  //< option if the states stay in fiberPointBuffers_ between calls to advanceTimeSpan, then Vm is not gathered again and element lengths are only gathered when the geometry changes
+  bool residentFiberDataIsValid_;                           //< if fiberData_ contains the element lengths and the Vm values from a previous call to fetchFiberData, is false initially and after fibers were migrated
+  std::vector<std::string> residentFiberDataTransferNames_; //< option "residentFiberDataTransfer", names of the states and algebraics for transfer that are sent back to the fibers in residentFiberData mode, empty means all
+  std::vector<bool> furtherValueIsTransferred_;             //< for every entry in furtherStatesAndAlgebraicsValues, if it is sent back to the fibers in updateFiberData
+  std::vector<std::vector<double>> elementLengthsLocal_;    //< the local element lengths of every fiber at the last fetchFiberData, elementLengthsLocal_[fiberNo][elementNoLocal]
+  std::vector<int> elementLengthsGeometryVersions_;         //< the values versions of the geometry fields of the fibers for which elementLengthsLocal_ were computed, to only recompute the lengths of fibers that moved
 
   int nFibersToCompute_;              //< number of fibers where own rank is involved (>= n.fibers that are computed by own rank)
   int nInstancesToCompute_;           //< number of instances of the Hodgkin-Huxley (or other CellML) problem to compute on this rank
@@ -302,4 +344,5 @@ protected:
 #include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_communication.tpp"
 #include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_compute.tpp"
 #include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_initialization.tpp"
-#include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_gpu.tpp"
\ No newline at end of file
+#include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_gpu.tpp"
+#include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_rebalancing.tpp"
\ No newline at end of file
@@ -18,23 +18,34 @@ fetchFiberData()
   int nParametersPerInstance;
   cellmlAdapter.getNumbers(nInstancesLocalCellml, nAlgebraicsLocalCellml, nParametersPerInstance);
 
-  // loop over fibers and communicate element lengths and initial values to the ranks that participate in computing
-  int fiberNo = 0;
-  int fiberDataNo = 0;
+  // compute the lengths of the local elements of all fibers,
+  // the lengths of fibers whose geometry field did not change since the last call are reused,
+  // this is independent of residentFiberDataIsValid_, because rebalanceFibers only migrates fiberData_ and not the local fibers.
+  // The slot connector data transfer writes the fiber geometry through copies of the geometry field,
+  // these share the values version counter with the geometry field of the function space, therefore the change is seen here.
+  std::vector<std::vector<double>> elementLengthsLocal;
+  std::vector<int> elementLengthsGeometryVersions;
   for (int i = 0; i < instances.size(); i++)
   {
     std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
       = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
 
-    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    for (int j = 0; j < innerInstances.size(); j++)
     {
       std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
-      LOG(DEBUG) << "instance (inner,outer)=(" << i << "," << j << "), fiberNo: " << fiberNo
-        << ", functionSpace " << fiberFunctionSpace->meshName()
-        << "," << fiberFunctionSpace->meshPartition()->rankSubset()->size() << " ranks (" << *fiberFunctionSpace->meshPartition()->rankSubset() << ")"
-        << ", " << innerInstances.size() << " inner instances";
 
-      // communicate element lengths
+      const int fiberIndex = elementLengthsLocal.size();
+      const int geometryVersion = fiberFunctionSpace->geometryField().valuesVersion();
+      elementLengthsGeometryVersions.push_back(geometryVersion);
+
+      if (fiberIndex < elementLengthsGeometryVersions_.size()
+        && elementLengthsGeometryVersions_[fiberIndex] == geometryVersion
+        && elementLengthsLocal_[fiberIndex].size() == fiberFunctionSpace->nElementsLocal())
+      {
+        elementLengthsLocal.push_back(elementLengthsLocal_[fiberIndex]);
+        continue;
+      }
+
       std::vector<double> localLengths(fiberFunctionSpace->nElementsLocal());
 
       // loop over local elements and compute element lengths
@@ -45,16 +56,59 @@ fetchFiberData()
         double elementLength = MathUtility::distance<3>(geometryElementValues[0], geometryElementValues[1]);
         localLengths[elementNoLocal] = elementLength;
       }
+      elementLengthsLocal.push_back(localLengths);
+    }
+  }
+
+  // with residentFiberData, Vm stays in fiberPointBuffers_ and the element lengths are only gathered again if the geometry changed on any rank
+  bool gatherVmValues = true;
+  bool gatherElementLengths = true;
+  if (residentFiberData_)
+  {
+    // the decision has to be the same on all ranks, because the gather operations are collective
+    // (the data is not valid on ranks that received migrated fibers in rebalanceFibers)
+    std::array<int,2> gatherData = {(elementLengthsLocal != elementLengthsLocal_)? 1 : 0, residentFiberDataIsValid_? 0 : 1};
+
+    std::shared_ptr<Partition::RankSubset> rankSubset = nestedSolvers_.data().functionSpace()->meshPartition()->rankSubset();
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, gatherData.data(), 2, MPI_INT, MPI_LOR, rankSubset->mpiCommunicator()), "MPI_Allreduce");
+
+    gatherElementLengths = gatherData[0] || gatherData[1];
+    gatherVmValues = gatherData[1];
+  }
+  elementLengthsLocal_ = std::move(elementLengthsLocal);
+  elementLengthsGeometryVersions_ = std::move(elementLengthsGeometryVersions);
+
+  VLOG(1) << "gatherVmValues: " << gatherVmValues << ", gatherElementLengths: " << gatherElementLengths;
+
+  // loop over fibers and communicate element lengths and initial values to the ranks that participate in computing
+  int fiberNo = 0;
+  int fiberDataNo = 0;
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    {
+      std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
+      LOG(DEBUG) << "instance (inner,outer)=(" << i << "," << j << "), fiberNo: " << fiberNo
+        << ", functionSpace " << fiberFunctionSpace->meshName()
+        << "," << fiberFunctionSpace->meshPartition()->rankSubset()->size() << " ranks (" << *fiberFunctionSpace->meshPartition()->rankSubset() << ")"
+        << ", " << innerInstances.size() << " inner instances";
+
+      // local element lengths that were computed above
+      const std::vector<double> &localLengths = elementLengthsLocal_[fiberNo];
 
       std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
       MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
-      int computingRank = fiberNo % rankSubset->size();
+      int computingRank = fiberComputingRank_[fiberNo];
 
-      std::vector<int> nElementsOnRanks(rankSubset->size());
-      std::vector<int> nDofsOnRanks(rankSubset->size());
-      std::vector<int> offsetsOnRanks(rankSubset->size());
-      std::vector<int> nParametersOnRanks(rankSubset->size());
-      std::vector<int> parameterOffsetsOnRanks(rankSubset->size());
+      const int nRanks = rankSubset->size();
+      std::vector<int> nElementsOnRanks(nRanks);
+      std::vector<int> nDofsOnRanks(nRanks);
+      std::vector<int> offsetsOnRanks(nRanks);
+      std::vector<int> nPackedValuesOnRanks(nRanks);
+      std::vector<int> packedOffsetsOnRanks(nRanks);
 
       double *elementLengthsReceiveBuffer = nullptr;
       double *vmValuesReceiveBuffer = nullptr;
@@ -79,37 +133,18 @@ fetchFiberData()
         vmValuesReceiveBuffer = fiberData_[fiberDataNo].vmValues.data();
       }
 
-      for (int rankNo = 0; rankNo < rankSubset->size(); rankNo++)
+      for (int rankNo = 0; rankNo < nRanks; rankNo++)
       {
         nElementsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithGhosts(0, rankNo) - 1;
         offsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo);
         nDofsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo);
-        parameterOffsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo) * nParametersPerInstance;
-        nParametersOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo) * nParametersPerInstance;
       }
 
-      // int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
-      //          void *recvbuf, const int *recvcounts, const int *displs,
-      //          MPI_Datatype recvtype, int root, MPI_Comm comm)
-      //
-      VLOG(1) << "Gatherv of element lengths to rank " << computingRank << ", values " << localLengths << ", sizes: " << nElementsOnRanks << ", offsets: " << offsetsOnRanks;
-
-      MPI_Gatherv(localLengths.data(), fiberFunctionSpace->nElementsLocal(), MPI_DOUBLE,
-                  elementLengthsReceiveBuffer, nElementsOnRanks.data(), offsetsOnRanks.data(),
-                  MPI_DOUBLE, computingRank, mpiCommunicator);
-
       // get own vm values
       std::vector<double> vmValuesLocal;
-      innerInstances[j].data().solution()->getValuesWithoutGhosts(0, vmValuesLocal);
-
-      // communicate Vm values
-      LOG(DEBUG) << "Gatherv of values to rank " << computingRank << ", sizes: " << nDofsOnRanks << ", offsets: " << offsetsOnRanks << ", local values " << vmValuesLocal;
+      if (gatherVmValues)
+        innerInstances[j].data().solution()->getValuesWithoutGhosts(0, vmValuesLocal);
 
-      MPI_Gatherv(vmValuesLocal.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts(), MPI_DOUBLE,
-                  vmValuesReceiveBuffer, nDofsOnRanks.data(), offsetsOnRanks.data(),
-                  MPI_DOUBLE, computingRank, mpiCommunicator);
-
-      // communicate parameter values
       // get own parameter values
 
       // get the data_.parameters() raw pointer
@@ -119,32 +154,84 @@ fetchFiberData()
       // size of this array is fiberFunctionSpace->nDofsLocalWithoutGhosts() * nAlgebraics
       // parameterValuesLocal has struct of array memory layout with space for a total of nAlgebraics_ parameters [i0p0, i1p0, i2p0, ... i0p1, i1p1, i2p1, ...]
 
-      // only the actual parameter values should be sent, not the rest of the parameters buffer
-      // therefore allocate a send buffer with the according size
-      int nParametersLocal = nParametersPerInstance * fiberFunctionSpace->nDofsLocalWithoutGhosts();
-      std::vector<double> parametersSendBuffer(nParametersLocal);
+      // Element lengths, Vm values and parameters are gathered to the computing rank by a single MPI_Gatherv.
+      // The send buffer of every rank contains [element lengths, Vm values, parameters (array of struct)],
+      // element lengths and Vm values are only included if they are gathered in this call.
+      // Only the actual parameter values are sent, not the rest of the parameters buffer.
+      const int nDofsLocal = fiberFunctionSpace->nDofsLocalWithoutGhosts();
+      const int nElementLengthsPerElement = (gatherElementLengths? 1 : 0);
+      const int nValuesPerDof = (gatherVmValues? 1 : 0) + nParametersPerInstance;
+
+      for (int rankNo = 0; rankNo < nRanks; rankNo++)
+      {
+        nPackedValuesOnRanks[rankNo] = nElementsOnRanks[rankNo]*nElementLengthsPerElement + nDofsOnRanks[rankNo]*nValuesPerDof;
+        packedOffsetsOnRanks[rankNo] = (rankNo == 0? 0 : packedOffsetsOnRanks[rankNo-1] + nPackedValuesOnRanks[rankNo-1]);
+      }
+
+      std::vector<double> packedSendBuffer;
+      packedSendBuffer.reserve(nPackedValuesOnRanks[rankSubset->ownRankNo()]);
+
+      if (gatherElementLengths)
+        packedSendBuffer.insert(packedSendBuffer.end(), localLengths.begin(), localLengths.end());
+
+      if (gatherVmValues)
+        packedSendBuffer.insert(packedSendBuffer.end(), vmValuesLocal.begin(), vmValuesLocal.end());
 
       // loop over the actual parameter values for every dof
-      for (int dofNoLocal = 0; dofNoLocal < fiberFunctionSpace->nDofsLocalWithoutGhosts(); dofNoLocal++)
+      for (int dofNoLocal = 0; dofNoLocal < nDofsLocal; dofNoLocal++)
       {
         for (int parameterNo = 0; parameterNo < nParametersPerInstance; parameterNo++)
         {
           // store parameter values to send buffer
-          parametersSendBuffer[dofNoLocal*nParametersPerInstance + parameterNo] = parameterValuesLocal[parameterNo*fiberFunctionSpace->nDofsLocalWithoutGhosts() + dofNoLocal];
+          packedSendBuffer.push_back(parameterValuesLocal[parameterNo*nDofsLocal + dofNoLocal]);
         }
       }
 
+      std::vector<double> packedReceiveBuffer;
+      if (computingRank == rankSubset->ownRankNo())
+        packedReceiveBuffer.resize(packedOffsetsOnRanks[nRanks-1] + nPackedValuesOnRanks[nRanks-1]);
+
       if (VLOG_IS_ON(1))
       {
-        VLOG(1) << "Gatherv of parameters to rank " << computingRank << ", send buffer: " << parametersSendBuffer << " contains " << nParametersLocal << " parameters "
-          << " " << nParametersPerInstance << " per instances with " << fiberFunctionSpace->nDofsLocalWithoutGhosts() << " local instances.";
+        VLOG(1) << "Gatherv of element lengths, Vm values and parameters to rank " << computingRank << ", send buffer: " << packedSendBuffer
+          << ", sizes: " << nPackedValuesOnRanks << ", offsets: " << packedOffsetsOnRanks
+          << ", gatherElementLengths: " << gatherElementLengths << ", gatherVmValues: " << gatherVmValues
+          << ", " << nParametersPerInstance << " parameters per instance with " << nDofsLocal << " local instances.";
       }
 
-      // receive data
-      MPI_Gatherv(parametersSendBuffer.data(), nParametersLocal, MPI_DOUBLE,
-                  parametersReceiveBuffer.data(), nParametersOnRanks.data(), parameterOffsetsOnRanks.data(),
+      // int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+      //          void *recvbuf, const int *recvcounts, const int *displs,
+      //          MPI_Datatype recvtype, int root, MPI_Comm comm)
+      //
+      assert(packedSendBuffer.size() == nPackedValuesOnRanks[rankSubset->ownRankNo()]);
+      MPI_Gatherv(packedSendBuffer.data(), packedSendBuffer.size(), MPI_DOUBLE,
+                  packedReceiveBuffer.data(), nPackedValuesOnRanks.data(), packedOffsetsOnRanks.data(),
                   MPI_DOUBLE, computingRank, mpiCommunicator);
 
+      // unpack the received data on the computing rank
+      if (computingRank == rankSubset->ownRankNo())
+      {
+        for (int rankNo = 0; rankNo < nRanks; rankNo++)
+        {
+          const double *packedValues = packedReceiveBuffer.data() + packedOffsetsOnRanks[rankNo];
+
+          if (gatherElementLengths)
+          {
+            std::copy(packedValues, packedValues + nElementsOnRanks[rankNo], elementLengthsReceiveBuffer + offsetsOnRanks[rankNo]);
+            packedValues += nElementsOnRanks[rankNo];
+          }
+
+          if (gatherVmValues)
+          {
+            std::copy(packedValues, packedValues + nDofsOnRanks[rankNo], vmValuesReceiveBuffer + offsetsOnRanks[rankNo]);
+            packedValues += nDofsOnRanks[rankNo];
+          }
+
+          std::copy(packedValues, packedValues + nDofsOnRanks[rankNo]*nParametersPerInstance,
+                    parametersReceiveBuffer.begin() + offsetsOnRanks[rankNo]*nParametersPerInstance);
+        }
+      }
+
       // store result from parametersReceiveBuffer (for current fiber) to fiberPointBuffersParameters_ (for a vc vector)
       // loop over number of instances of the problem on the current fiber
       if (computingRank == rankSubset->ownRankNo())
@@ -209,7 +296,8 @@ fetchFiberData()
     }
   }
 
-  if (useVc_)
+  // with residentFiberData, the Vm values in the compute buffers are still valid from the last call
+  if (useVc_ && gatherVmValues)
   {
     // copy Vm values to compute buffers
     for (int fiberDataNo = 0; fiberDataNo < fiberData_.size(); fiberDataNo++)
@@ -227,6 +315,8 @@ fetchFiberData()
       }
     }
   }
+
+  residentFiberDataIsValid_ = true;
 }
 
 //! send vmValues data from fiberData_ back to the fibers where it belongs to and set in the respective field variable
@@ -261,6 +351,9 @@ updateFiberData()
         int furtherDataIndex = 0;
         for (int i = 1; i < statesForTransferIndices_.size(); i++, furtherDataIndex++)
         {
+          if (!furtherValueIsTransferred_[furtherDataIndex])
+            continue;
+
           const int stateToTransfer = statesForTransferIndices_[i];
 
           // store further states to transfer under furtherStatesAndAlgebraicsValues
@@ -271,13 +364,16 @@ updateFiberData()
         // loop over algebraics to transfer
         for (int i = 0; i < algebraicsForTransferIndices_.size(); i++, furtherDataIndex++)
         {
+          if (!furtherValueIsTransferred_[furtherDataIndex])
+            continue;
+
           // store further algebraics to transfer under furtherStatesAndAlgebraicsValues
           fiberData_[fiberDataNo].furtherStatesAndAlgebraicsValues[furtherDataIndex*nValues + valueNo]
             = fiberPointBuffersAlgebraicsForTransfer_[pointBuffersNo][i][entryNo];
         }
 
         // add the information about whether the point is constant or not_constant or neighbour_not_constant
-        if (setComputeStateInformation_)
+        if (setComputeStateInformation_ && furtherValueIsTransferred_[furtherDataIndex])
         {
           // also store under furtherStatesAndAlgebraicsValues
           fiberData_[fiberDataNo].furtherStatesAndAlgebraicsValues[furtherDataIndex*nValues + valueNo]
@@ -316,92 +412,102 @@ updateFiberData()
       // prepare helper variables for Scatterv
       std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
       MPI_Comm mpiCommunicator = rankSubset->mpiCommunicator();
-      int computingRank = fiberNo % rankSubset->size();     // rank which computes the current fiber
+      int computingRank = fiberComputingRank_[fiberNo];     // rank which computes the current fiber
+      const int nRanks = rankSubset->size();
 
-      std::vector<int> nDofsOnRanks(rankSubset->size());
-      std::vector<int> offsetsOnRanks(rankSubset->size());
+      std::vector<int> nDofsOnRanks(nRanks);
+      std::vector<int> offsetsOnRanks(nRanks);
 
-      for (int rankNo = 0; rankNo < rankSubset->size(); rankNo++)
+      for (int rankNo = 0; rankNo < nRanks; rankNo++)
       {
         offsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo);
         nDofsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo);
       }
 
-      double *sendBufferVmValues = nullptr;
+      // determine the further states and algebraics that are selected by the options "statesForTransfer" and "algebraicsForTransfer"
+      // and, with residentFiberData, are used by other solvers
+      int nStatesAndAlgebraicsValues = statesForTransferIndices_.size() + algebraicsForTransferIndices_.size() - 1;
+      
+      // if also the computeStateInformation should be communicated, the buffer has entry more per node
+      if (setComputeStateInformation_)
+        nStatesAndAlgebraicsValues++;
+
+      std::vector<int> transferredVariableNos;
+      for (int variableNo = 0; variableNo < nStatesAndAlgebraicsValues; variableNo++)
+      {
+        if (furtherValueIsTransferred_[variableNo])
+          transferredVariableNos.push_back(variableNo);
+      }
+
+      // Vm and the further values are sent by a single MPI_Scatterv,
+      // the packed buffer contains for every rank [Vm values, values of 1st transferred variable, values of 2nd transferred variable, ...]
+      const int nVariables = 1 + transferredVariableNos.size();
+      std::vector<int> nPackedValuesOnRanks(nRanks);
+      std::vector<int> packedOffsetsOnRanks(nRanks);
+      for (int rankNo = 0; rankNo < nRanks; rankNo++)
+      {
+        nPackedValuesOnRanks[rankNo] = nDofsOnRanks[rankNo] * nVariables;
+        packedOffsetsOnRanks[rankNo] = offsetsOnRanks[rankNo] * nVariables;
+      }
+
+      std::vector<double> packedSendBuffer;
       if (computingRank == rankSubset->ownRankNo())
       {
-        sendBufferVmValues = fiberData_[fiberDataNo].vmValues.data();
+        const FiberData &fiberData = fiberData_[fiberDataNo];
+        const int nDofsGlobal = fiberFunctionSpace->nDofsGlobal();
+        packedSendBuffer.resize(nDofsGlobal * nVariables);
+
+        for (int rankNo = 0; rankNo < nRanks; rankNo++)
+        {
+          double *packedValues = packedSendBuffer.data() + packedOffsetsOnRanks[rankNo];
+          const int beginValueNo = offsetsOnRanks[rankNo];
+          const int endValueNo = beginValueNo + nDofsOnRanks[rankNo];
+
+          packedValues = std::copy(fiberData.vmValues.begin() + beginValueNo, fiberData.vmValues.begin() + endValueNo, packedValues);
+
+          for (int variableNo : transferredVariableNos)
+          {
+            std::vector<double>::const_iterator values = fiberData.furtherStatesAndAlgebraicsValues.begin() + variableNo*nDofsGlobal;
+            packedValues = std::copy(values + beginValueNo, values + endValueNo, packedValues);
+          }
+        }
       }
 
       //  int MPI_Scatterv(const void *sendbuf, const int *sendcounts, const int *displs, MPI_Datatype sendtype,
       //                  void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm)
-      // communicate Vm values
-      std::vector<double> vmValuesLocal(fiberFunctionSpace->nDofsLocalWithoutGhosts());
-      MPI_Scatterv(sendBufferVmValues, nDofsOnRanks.data(), offsetsOnRanks.data(), MPI_DOUBLE,
-                   vmValuesLocal.data(), fiberFunctionSpace->nDofsLocalWithoutGhosts(), MPI_DOUBLE,
+      const int nDofsLocal = fiberFunctionSpace->nDofsLocalWithoutGhosts();
+      std::vector<double> packedReceiveBuffer(nDofsLocal * nVariables);
+      MPI_Scatterv(packedSendBuffer.data(), nPackedValuesOnRanks.data(), packedOffsetsOnRanks.data(), MPI_DOUBLE,
+                   packedReceiveBuffer.data(), nDofsLocal * nVariables, MPI_DOUBLE,
                    computingRank, mpiCommunicator);
 
-      VLOG(1) << "Scatterv from rank " << computingRank << ", sizes: " << nDofsOnRanks << ", offsets: " << offsetsOnRanks << ", received local values " << vmValuesLocal;
+      VLOG(1) << "Scatterv from rank " << computingRank << ", sizes: " << nPackedValuesOnRanks << ", offsets: " << packedOffsetsOnRanks
+        << ", transferred variables: " << transferredVariableNos << ", received local values " << packedReceiveBuffer;
 
       // store Vm values in CellmlAdapter and diffusion FiniteElementMethod
+      std::vector<double> vmValuesLocal(packedReceiveBuffer.begin(), packedReceiveBuffer.begin() + nDofsLocal);
       VLOG(1) << "fiber " << fiberDataNo << ", set values " << vmValuesLocal;
       innerInstances[j].data().solution()->setValuesWithoutGhosts(0, vmValuesLocal);
       instances[i].timeStepping2().instancesLocal()[j].data().solution()->setValuesWithoutGhosts(0, vmValuesLocal);
 
       // ----------------------
-      // communicate further states and algebraics that are selected by the options "statesForTransfer" and "algebraicsForTransfer"
-
-      std::vector<int> nValuesOnRanks(rankSubset->size());
-      int nStatesAndAlgebraicsValues = statesForTransferIndices_.size() + algebraicsForTransferIndices_.size() - 1;
-      
-      // if also the computeStateInformation should be communicated, the buffer has entry more per node
-      if (setComputeStateInformation_)
-        nStatesAndAlgebraicsValues++;
-
-      // fill offset and size helper variables for MPI_Scatterv
-      for (int rankNo = 0; rankNo < rankSubset->size(); rankNo++)
+      // unpack further states and algebraics to valuesLocal[furtherDataIndex * nValues + valueNo]
+      std::vector<double> valuesLocal(nDofsLocal * nStatesAndAlgebraicsValues);
+      for (int transferredVariableIndex = 0; transferredVariableIndex < transferredVariableNos.size(); transferredVariableIndex++)
       {
-        offsetsOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->beginNodeGlobalNatural(0, rankNo);
-        nValuesOnRanks[rankNo] = fiberFunctionSpace->meshPartition()->nNodesLocalWithoutGhosts(0, rankNo);
+        std::vector<double>::const_iterator values = packedReceiveBuffer.begin() + (1 + transferredVariableIndex)*nDofsLocal;
+        std::copy(values, values + nDofsLocal, valuesLocal.begin() + transferredVariableNos[transferredVariableIndex]*nDofsLocal);
       }
 
-      // receive buffer valuesLocal[furtherDataIndex * nValues + valueNo]
-      std::vector<double> valuesLocal(fiberFunctionSpace->nDofsLocalWithoutGhosts() * nStatesAndAlgebraicsValues);
-      std::vector<MPI_Request> scatterRequests(nStatesAndAlgebraicsValues);
-      
-      // loop over variable to transfer, because of the memory layout it is not possible to do this with a single MPI_Scatterv
-      for (int variableNo = 0; variableNo < nStatesAndAlgebraicsValues; variableNo++)
-      {
-        // get send buffer for MPI_Scatterv
-        double *sendBuffer = nullptr;
-        if (computingRank == rankSubset->ownRankNo())
-        {
-          sendBuffer = fiberData_[fiberDataNo].furtherStatesAndAlgebraicsValues.data() + variableNo*fiberFunctionSpace->nDofsGlobal();
-        }
-        double *receiveBuffer = valuesLocal.data() + variableNo*fiberFunctionSpace->nDofsLocalWithoutGhosts();
-
-        MPI_Iscatterv(sendBuffer, nValuesOnRanks.data(), offsetsOnRanks.data(), MPI_DOUBLE,
-                      receiveBuffer, fiberFunctionSpace->nDofsLocalWithoutGhosts(), MPI_DOUBLE,
-                      computingRank, mpiCommunicator, &scatterRequests[variableNo]);
-              
-        // debugging output
-        if (VLOG_IS_ON(1))
-        {
-          std::stringstream s;
-          for (int i = 0; i < fiberFunctionSpace->nDofsLocalWithoutGhosts(); i++)
-            s << "," << valuesLocal[variableNo*fiberFunctionSpace->nDofsLocalWithoutGhosts()+i];
-          VLOG(1) << "Scatterv furtherStatesAndAlgebraicsValues from rank " << computingRank << ", sizes: " << nValuesOnRanks << ", offsets: " << offsetsOnRanks
-            << ", variableNo: " << variableNo << " sendBuffer: " << sendBuffer << ", received local values: (" << s.str() << ")";
-        }
-      }
-      MPI_Waitall(nStatesAndAlgebraicsValues, scatterRequests.data(), MPI_STATUSES_IGNORE);
-
           
       // store received states and algebraics values in diffusion slotConnectorData
       // loop over further states to transfer
       int furtherDataIndex = 0;
       for (int stateIndex = 1; stateIndex < statesForTransferIndices_.size(); stateIndex++, furtherDataIndex++)
       {
+        if (!furtherValueIsTransferred_[furtherDataIndex])
+          continue;
+
         // store in diffusion
 
         // get field variable
@@ -436,6 +542,9 @@ updateFiberData()
       // loop over algebraics to transfer
       for (int algebraicIndex = 0; algebraicIndex < algebraicsForTransferIndices_.size(); algebraicIndex++, furtherDataIndex++)
       {
+        if (!furtherValueIsTransferred_[furtherDataIndex])
+          continue;
+
         // store in diffusion
 
         // get field variable
@@ -470,7 +579,7 @@ updateFiberData()
       }
 
       // store the information about whether the point is constant or not_constant or neighbour_not_constant
-      if (setComputeStateInformation_)
+      if (setComputeStateInformation_ && furtherValueIsTransferred_[furtherDataIndex])
       {
         // get field variable
         std::vector<::Data::ComponentOfFieldVariable<FiberFunctionSpace,1>> &variable2
@@ -507,4 +616,5 @@ void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 saveFiberDataCheckpoint()
 {
   fiberPointBuffersLastCheckpoint_ = fiberPointBuffers_;
+  hasFiberDataCheckpoint_ = true;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
@@ -9,6 +10,13 @@ run()
 {
   initialize();
   advanceTimeSpan();
+
+  // log the predicted and measured load imbalance, if this was not just done in advanceTimeSpan
+  if (nAdvanceTimeSpanCalls_ % 100 != 0)
+    logLoadImbalance();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -25,7 +33,11 @@ advanceTimeSpan(bool withOutputWritersEnabled)
   //Control::PerformanceMeasurement::startFlops();
 
   // do computation of own fibers, stimulation from parsed MU and firing_times files
+  double computeMonodomainStartTime = MPI_Wtime();
   computeMonodomain();
+  double computeMonodomainDuration = MPI_Wtime() - computeMonodomainStartTime;
+  computeMonodomainDuration_ += computeMonodomainDuration;
+  durationSinceLastRebalance_ += computeMonodomainDuration;
 
   //Control::PerformanceMeasurement::endFlops();
 
@@ -43,6 +55,54 @@ advanceTimeSpan(bool withOutputWritersEnabled)
       instances[i].timeStepping2().writeOwnOutput(0, currentTime_, nTimeStepsSplitting_);
     }
   }
+
+  // regularly log the measured load imbalance of the ranks
+  nAdvanceTimeSpanCalls_++;
+  if (nAdvanceTimeSpanCalls_ % 100 == 0)
+    logLoadImbalance();
+
+  // regularly migrate fibers between the ranks, according to the measured durations
+  if (fiberRebalanceInterval_ > 0 && nAdvanceTimeSpanCalls_ % fiberRebalanceInterval_ == 0)
+    rebalanceFibers();
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+logLoadImbalance()
+{
+  std::shared_ptr<Partition::RankSubset> rankSubset = nestedSolvers_.data().functionSpace()->meshPartition()->rankSubset();
+
+  // reduce the predicted loads and the measured durations of all ranks
+  std::array<double,2> loadsLocal = {predictedLoad_, computeMonodomainDuration_};
+  std::array<double,2> loadsMaximum = {0.0, 0.0};
+  std::array<double,2> loadsSum = {0.0, 0.0};
+  MPIUtility::handleReturnValue(MPI_Reduce(loadsLocal.data(), loadsMaximum.data(), 2, MPI_DOUBLE, MPI_MAX, 0, rankSubset->mpiCommunicator()), "MPI_Reduce");
+  MPIUtility::handleReturnValue(MPI_Reduce(loadsLocal.data(), loadsSum.data(), 2, MPI_DOUBLE, MPI_SUM, 0, rankSubset->mpiCommunicator()), "MPI_Reduce");
+
+  LOG(DEBUG) << "Rank " << rankSubset->ownRankNo() << ": predicted load " << predictedLoad_ << ", measured duration of computeMonodomain: " << computeMonodomainDuration_ << " s";
+
+  if (rankSubset->ownRankNo() == 0)
+  {
+    // the imbalance is the ratio of the maximum to the mean load, 1 means perfect balance
+    std::array<double,2> imbalance = {1.0, 1.0};
+    for (int i = 0; i < 2; i++)
+    {
+      if (loadsSum[i] > 0)
+        imbalance[i] = loadsMaximum[i] / (loadsSum[i] / rankSubset->size());
+    }
+
+    if (nAdvanceTimeSpanCalls_ == 0)
+    {
+      LOG(INFO) << "FastMonodomainSolver, fiberAssignment \"" << fiberAssignment_ << "\": predicted load imbalance (max/mean) on "
+        << rankSubset->size() << " ranks: " << imbalance[0];
+    }
+    else
+    {
+      LOG(INFO) << "FastMonodomainSolver, fiberAssignment \"" << fiberAssignment_ << "\": load imbalance (max/mean) on "
+        << rankSubset->size() << " ranks, predicted: " << imbalance[0] << ", measured after " << nAdvanceTimeSpanCalls_
+        << " calls of advanceTimeSpan: " << imbalance[1] << " (max. " << loadsMaximum[1] << " s)";
+    }
+  }
 }
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
@@ -113,10 +113,17 @@ initializeCellMLSourceFileGpu()
       postCompileCommand = std::string("; ") + specificSettings_.getOptionString("postCompileCommand", "");
     }
 
+    // for the host-only code of optimizationType "openmp", no offloading flags are needed
+    std::string additionalCompileFlags = cellmlSourceCodeGenerator.additionalCompileFlags();
+    if (optimizationType_ == "openmp")
+    {
+      additionalCompileFlags = "-fopenmp";
+    }
+
     // compose compile command
     s.str("");
     s << cellmlSourceCodeGenerator.compilerCommand() << " " << sourceToCompileFilename << " "
-      << compilerFlags << " " << cellmlSourceCodeGenerator.additionalCompileFlags() << " ";
+      << compilerFlags << " " << additionalCompileFlags << " ";
 
     std::string compileCommandOptions = s.str();
 
@@ -149,12 +156,18 @@ initializeCellMLSourceFileGpu()
       std::string newCompileCommand = compileCommand.str();
       std::string strToReplace = "-fopenmp";
       std::size_t pos = newCompileCommand.find(strToReplace);
-      newCompileCommand.replace(pos, strToReplace.length(), "");
+      if (pos != std::string::npos)
+      {
+        newCompileCommand.replace(pos, strToReplace.length(), "");
+      }
 
-      // remove -foffload="..."strToReplace = "-fopenmp";
+      // remove -foffload="...", this is not present for optimizationType "openmp"
       pos = newCompileCommand.find("-foffload=\"");
-      std::size_t pos2 = newCompileCommand.find("\"", pos+11);
-      newCompileCommand.replace(pos, pos2-pos+1, "");
+      if (pos != std::string::npos)
+      {
+        std::size_t pos2 = newCompileCommand.find("\"", pos+11);
+        newCompileCommand.replace(pos, pos2-pos+1, "");
+      }
 
       LOG(INFO) << "Retry without offloading, command: \n" << newCompileCommand;
 
@@ -284,6 +297,19 @@ generateMonodomainSolverGpuSource(std::string outputFilename, std::string header
   int nFibersToCompute = NFIBERS_TO_COMPUTE;  // nFibersToCompute_
   int nInstancesToCompute = nFibersToCompute*nInstancesToComputePerFiber_;
 
+  // pragma for the loops over fibers for the host-only optimizationType "openmp", the fibers are distributed to the threads
+  std::stringstream ompParallelForPragma;
+  ompParallelForPragma << "#pragma omp parallel for schedule(static)";
+  if (optimizationType_ == "openmp")
+  {
+    // option "maximumNumberOfThreads" of the CellmlAdapter
+    int maximumNumberOfThreads = nestedSolvers_.instancesLocal()[0].timeStepping1().instancesLocal()[0].discretizableInTime().maximumNumberOfThreads_;
+    if (maximumNumberOfThreads > 0)
+    {
+      ompParallelForPragma << " num_threads(" << maximumNumberOfThreads << ")";
+    }
+  }
+
   if (optimizationType_ == "gpu")
   {
   sourceCode << R"(
@@ -311,7 +337,7 @@ const int nStatesForTransferIndices = )" << statesForTransferIndices_.size() <<
 const int nStatesForTransfer = )" << nInstancesToCompute*statesForTransferIndices_.size() << R"(;  // = nInstancesToCompute*nStatesForTransferIndices;
 )";
 
-  if (optimizationType_ == "gpu" || optimizationType_ == "simd")
+  if (optimizationType_ == "gpu" || optimizationType_ == "simd" || optimizationType_ == "openmp")
   {
     if (optimizationType_ == "gpu")
     {
@@ -527,6 +553,8 @@ void computeMonodomain(const float *parameters,
                 collapse(2))";
   else if (optimizationType_ == "gpu")
     sourceCode << "\n    #pragma omp distribute parallel for simd collapse(2)";  // teams distribute
+  else if (optimizationType_ == "openmp")
+    sourceCode << "\n    " << ompParallelForPragma.str();   // only parallelize over fibers, the stimulation variables are stored per fiber
   sourceCode << R"(
     for (int fiberNo = 0; fiberNo < nFibersToCompute; fiberNo++)
     {
@@ -633,6 +661,13 @@ void computeMonodomain(const float *parameters,
     // loop over fibers
     for (int fiberNo = 0; fiberNo < nFibersToCompute; fiberNo++)
     {
+)";
+  else if (optimizationType_ == "openmp")
+    sourceCode << R"(
+    // loop over fibers
+    )" << ompParallelForPragma.str() << R"(
+    for (int fiberNo = 0; fiberNo < nFibersToCompute; fiberNo++)
+    {
 )";
   sourceCode << R"(
       const int nValues = nInstancesPerFiber;
@@ -791,7 +826,7 @@ void computeMonodomain(const float *parameters,
 
       // perform backward substitution
       // x_n = d'_n
-      vmValues[nValues-1] = dIntermediate[nValues-1];  // state 0 of the point (nValues-1)
+      vmValues[fiberNo*nInstancesPerFiber + nValues-1] = dIntermediate[nValues-1];  // state 0 of the point (nValues-1)
 
       real previousValue = dIntermediate[nValues-1];
 
@@ -828,6 +863,12 @@ void computeMonodomain(const float *parameters,
                 collapse(2)
     for (int fiberNo = 0; fiberNo < nFibersToCompute; fiberNo++)
     {)";
+  else if (optimizationType_ == "openmp")
+    sourceCode << R"(
+    // loop over fibers that will be computed on this rank
+    )" << ompParallelForPragma.str() << R"(
+    for (int fiberNo = 0; fiberNo < nFibersToCompute; fiberNo++)
+    {)";
   sourceCode << R"(
       // loop over instances to compute here
       for (int instanceNo = 0; instanceNo < nInstancesPerFiber; instanceNo++)
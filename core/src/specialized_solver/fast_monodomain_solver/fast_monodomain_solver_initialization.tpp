@@ -4,6 +4,9 @@
 #include "partition/rank_subset.h"
 #include "control/diagnostic_tool/stimulation_logging.h"
 #include <random>
+#include <map>
+#include <set>
+#include <algorithm>
 
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
@@ -70,6 +73,26 @@ initialize()
   valueForStimulatedPoint_ = specificSettings_.getOptionDouble("valueForStimulatedPoint", 20.0);
   neuromuscularJunctionRelativeSize_ = specificSettings_.getOptionDouble("neuromuscularJunctionRelativeSize", 0.0);
   generateGpuSource_ = specificSettings_.getOptionBool("generateGPUSource", true);
+  fiberAssignment_ = specificSettings_.getOptionString("fiberAssignment", "roundRobin");
+  fiberAssignmentIdleWeight_ = specificSettings_.getOptionDouble("fiberAssignmentIdleWeight", 0.1, PythonUtility::NonNegative);
+  fiberRebalanceInterval_ = specificSettings_.getOptionInt("fiberRebalanceInterval", 0, PythonUtility::NonNegative);
+  fiberRebalanceThreshold_ = specificSettings_.getOptionDouble("fiberRebalanceThreshold", 1.1, PythonUtility::Positive);
+  residentFiberData_ = specificSettings_.getOptionBool("residentFiberData", false);
+  if (specificSettings_.hasKey("residentFiberDataTransfer"))
+    specificSettings_.template getOptionVector<std::string>("residentFiberDataTransfer", residentFiberDataTransferNames_);
+  residentFiberDataIsValid_ = false;
+  durationSinceLastRebalance_ = 0;
+  hasFiberDataCheckpoint_ = false;
+  predictedLoad_ = 0;
+  computeMonodomainDuration_ = 0;
+  nAdvanceTimeSpanCalls_ = 0;
+
+  if (fiberAssignment_ != "roundRobin" && fiberAssignment_ != "costModel")
+  {
+    LOG(ERROR) << "FastMonodomainSolver has invalid \"fiberAssignment\": \"" << fiberAssignment_
+      << "\". Valid options are \"roundRobin\" or \"costModel\". Now using \"roundRobin\".";
+    fiberAssignment_ = "roundRobin";
+  }
 
   // output warning if there are output writers
   if (this->outputWriterManager_.hasOutputWriters())
@@ -87,16 +110,34 @@ initialize()
     useVc_ = false;
   else if (optimizationType_ == "simd")
     useVc_ = false;
+  else if (optimizationType_ == "openmp")
+    useVc_ = false;
   else if (optimizationType_ == "vc")
     useVc_ = true;
   else
   {
     LOG(ERROR) << "FastMonodomainSolver is used with invalid \"optimizationType\": \"" << optimizationType_
-      << "\". Valid options are \"vc\", \"simd\" or \"gpu\". Now using \"vc\".";
+      << "\". Valid options are \"vc\", \"simd\", \"openmp\" or \"gpu\". Now using \"vc\".";
     useVc_ = true;
     optimizationType_ = "vc";
   }
 
+  // migrating fibers at runtime is only implemented for the data structures of the "vc" code
+  if (!useVc_ && fiberRebalanceInterval_ > 0)
+  {
+    LOG(WARNING) << "FastMonodomainSolver: \"fiberRebalanceInterval\" is only supported for \"optimizationType\": \"vc\", "
+      << "but optimizationType is \"" << optimizationType_ << "\". Fibers will not be rebalanced.";
+    fiberRebalanceInterval_ = 0;
+  }
+
+  // keeping the fiber data on the computing ranks is only implemented for the data structures of the "vc" code
+  if (!useVc_ && residentFiberData_)
+  {
+    LOG(WARNING) << "FastMonodomainSolver: \"residentFiberData\" is only supported for \"optimizationType\": \"vc\", "
+      << "but optimizationType is \"" << optimizationType_ << "\". The fiber data will be communicated in every time step.";
+    residentFiberData_ = false;
+  }
+
   std::shared_ptr<Partition::RankSubset> rankSubset = nestedSolvers_.data().functionSpace()->meshPartition()->rankSubset();
 
   LOG(DEBUG) << "config: " << specificSettings_;
@@ -109,6 +150,9 @@ initialize()
   // initialize all other internal data structures, also the data buffers used for GPU computations
   initializeDataStructures();
 
+  // log the predicted load imbalance of the fiber assignment
+  logLoadImbalance();
+
   if (useVc_)
   {
     // if the optimization type is "vc", create, compile, link and load the according C++-Source for CPU
@@ -139,6 +183,9 @@ initialize()
   // initialize the variable names where field variables are connector via connector slots
   initializeFieldVariableNames();
 
+  // determine which states and algebraics are sent back to the fibers in updateFiberData
+  initializeTransferredValues();
+
   initialized_ = true;
 }
 
@@ -233,6 +280,133 @@ initializeFiringTimes()
     LOG(FATAL) << "Could not parse firing times.";
 }
 
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+double FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+estimateFiberCost(CellmlAdapterType &cellmlAdapter, int nDofs)
+{
+  // the expected fraction of the time in which the fiber is computed
+  double activeFraction = 1.0;
+
+  // without firing times or motor units, the fiber is never stimulated
+  int nFiringEvents = firingEvents_.size();
+  if (nFiringEvents == 0 || motorUnitNo_.empty())
+  {
+    if (onlyComputeIfHasBeenStimulated_)
+      activeFraction = 0.0;
+    return nDofs * (fiberAssignmentIdleWeight_ + activeFraction);
+  }
+
+  int fiberNoGlobal = PythonUtility::convertFromPython<int>::get(cellmlAdapter.pySetFunctionAdditionalParameter_);
+  int motorUnitNo = motorUnitNo_[fiberNoGlobal % motorUnitNo_.size()];
+
+  // find the first row in the firing times file where the motor unit of the fiber fires, starting at setSpecificStatesCallEnableBegin,
+  // in the same way as the stimulation in isCurrentPointStimulated
+  int firingEventsIndex = round(cellmlAdapter.setSpecificStatesCallEnableBegin_ * cellmlAdapter.setSpecificStatesCallFrequency_);
+  if (firingEventsIndex < 0)
+    firingEventsIndex = 0;
+  firingEventsIndex %= nFiringEvents;
+
+  int firstFiringEventIndex = -1;
+  for (int i = firingEventsIndex; i < nFiringEvents; i++)
+  {
+    if (!firingEvents_[i].empty() && firingEvents_[i][motorUnitNo % firingEvents_[i].size()])
+    {
+      firstFiringEventIndex = i;
+      break;
+    }
+  }
+
+  if (onlyComputeIfHasBeenStimulated_)
+  {
+    if (firstFiringEventIndex == -1 || cellmlAdapter.setSpecificStatesCallFrequency_ <= 1e-12)
+      activeFraction = 0.0;
+    else
+      activeFraction = double(nFiringEvents - firstFiringEventIndex) / nFiringEvents;
+  }
+
+  return nDofs * (fiberAssignmentIdleWeight_ + activeFraction);
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+initializeFiberAssignment()
+{
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
+
+  // collect the fibers grouped by their rank subsets, all ranks of a rank subset have the same fibers in the same order
+  std::map<std::set<int>, std::vector<int>> fibersOfRankSubsets;    // key: ranks of the subset, value: fiberNos
+  std::vector<int> rankSubsetSize;
+  std::vector<double> fiberCost;
+
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++)
+    {
+      std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
+      std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
+
+      int fiberNo = fiberCost.size();
+      fibersOfRankSubsets[std::set<int>(rankSubset->begin(), rankSubset->end())].push_back(fiberNo);
+      rankSubsetSize.push_back(rankSubset->size());
+      fiberCost.push_back(estimateFiberCost(innerInstances[j].discretizableInTime(), fiberFunctionSpace->nDofsGlobal()));
+    }
+  }
+
+  int nFibers = fiberCost.size();
+  fiberComputingRank_.resize(nFibers);
+
+  if (fiberAssignment_ == "costModel")
+  {
+    // assign the fibers of every rank subset by the longest processing time rule: in the order of decreasing cost, every fiber is
+    // assigned to the rank with the currently lowest load. The loads from fibers of other rank subsets are not known to all ranks and are not considered.
+    for (std::pair<const std::set<int>, std::vector<int>> &fibersOfRankSubset : fibersOfRankSubsets)
+    {
+      std::vector<int> &fiberNos = fibersOfRankSubset.second;
+      std::stable_sort(fiberNos.begin(), fiberNos.end(), [&fiberCost](int fiberNo0, int fiberNo1)
+      {
+        return fiberCost[fiberNo0] > fiberCost[fiberNo1];
+      });
+
+      std::vector<double> loadOnRanks(fibersOfRankSubset.first.size(), 0.0);
+      for (int fiberNo : fiberNos)
+      {
+        int computingRank = std::min_element(loadOnRanks.begin(), loadOnRanks.end()) - loadOnRanks.begin();
+        fiberComputingRank_[fiberNo] = computingRank;
+        loadOnRanks[computingRank] += fiberCost[fiberNo];
+      }
+    }
+  }
+  else
+  {
+    // "roundRobin": assign the fibers cyclically to the ranks
+    for (int fiberNo = 0; fiberNo < nFibers; fiberNo++)
+    {
+      fiberComputingRank_[fiberNo] = fiberNo % rankSubsetSize[fiberNo];
+    }
+  }
+
+  // sum up the estimated costs of the own fibers
+  predictedLoad_ = 0;
+  int fiberNo = 0;
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    {
+      if (fiberComputingRank_[fiberNo] == innerInstances[j].data().functionSpace()->meshPartition()->rankSubset()->ownRankNo())
+        predictedLoad_ += fiberCost[fiberNo];
+    }
+  }
+
+  LOG(DEBUG) << "fiberAssignment \"" << fiberAssignment_ << "\", fiberCost: " << fiberCost << ", fiberComputingRank_: " << fiberComputingRank_
+    << ", predictedLoad: " << predictedLoad_;
+}
+
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 initializeDataStructures()
@@ -240,6 +414,9 @@ initializeDataStructures()
   // initialize data structures
   std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
 
+  // determine the ranks that compute the fibers
+  initializeFiberAssignment();
+
   // determine number of fibers to compute on the current rank
   int nFibers = 0;
   int fiberNo = 0;
@@ -257,7 +434,7 @@ initializeDataStructures()
     {
       std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
       std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
-      int computingRank = fiberNo % rankSubset->size();
+      int computingRank = fiberComputingRank_[fiberNo];
 
       LOG(DEBUG) << "instance (inner,outer)=(i,j)=(" << i << "," << j << ")/(" << instances.size() << "," << innerInstances.size() << ")"
         << ", fiberNo " << fiberNo << ", rankSubset: " << *rankSubset << ", mesh" << fiberFunctionSpace->meshName() << ", computingRank " << computingRank << ", own rank: " << rankSubset->ownRankNo() << "/" << rankSubset->size();
@@ -303,7 +480,7 @@ initializeDataStructures()
       std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
 
       std::shared_ptr<Partition::RankSubset> rankSubset = fiberFunctionSpace->meshPartition()->rankSubset();
-      int computingRank = fiberNo % rankSubset->size();
+      int computingRank = fiberComputingRank_[fiberNo];
 
       if (computingRank == rankSubset->ownRankNo())
       {
@@ -494,6 +671,45 @@ initializeDataStructures()
     << algebraicsForTransferIndices_.size() << " algebraics for transfer";
 }
 
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+initializeTransferredValues()
+{
+  CellmlAdapterType &cellmlAdapter = nestedSolvers_.instancesLocal()[0].timeStepping1().instancesLocal()[0].discretizableInTime();
+
+  // collect the names of the further states and algebraics in the order of furtherStatesAndAlgebraicsValues
+  std::vector<std::string> names;
+  for (int stateIndex = 1; stateIndex < statesForTransferIndices_.size(); stateIndex++)
+    names.push_back(cellmlAdapter.data().states()->componentName(statesForTransferIndices_[stateIndex]));
+
+  for (int algebraicIndex = 0; algebraicIndex < algebraicsForTransferIndices_.size(); algebraicIndex++)
+    names.push_back(cellmlAdapter.data().algebraics()->componentName(algebraicsForTransferIndices_[algebraicIndex]));
+
+  if (setComputeStateInformation_)
+    names.push_back("computeStateInformation");
+
+  // without residentFiberData or if no names are given, all values are transferred
+  furtherValueIsTransferred_.resize(names.size());
+  for (int furtherDataIndex = 0; furtherDataIndex < names.size(); furtherDataIndex++)
+  {
+    furtherValueIsTransferred_[furtherDataIndex] = !residentFiberData_ || residentFiberDataTransferNames_.empty()
+      || std::find(residentFiberDataTransferNames_.begin(), residentFiberDataTransferNames_.end(), names[furtherDataIndex]) != residentFiberDataTransferNames_.end();
+
+    if (!furtherValueIsTransferred_[furtherDataIndex])
+      LOG(DEBUG) << "\"" << names[furtherDataIndex] << "\" is not in \"residentFiberDataTransfer\" and will not be transferred back to the fibers.";
+  }
+
+  // check that all given names exist
+  for (const std::string &name : residentFiberDataTransferNames_)
+  {
+    if (std::find(names.begin(), names.end(), name) == names.end())
+    {
+      LOG(WARNING) << "FastMonodomainSolver: \"" << name << "\" in \"residentFiberDataTransfer\" is not one of the states or algebraics for transfer, "
+        << "which are " << names << ".";
+    }
+  }
+}
+
 template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
 void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
 initializeFieldVariableNames()
@@ -0,0 +1,380 @@
+#include "specialized_solver/fast_monodomain_solver/fast_monodomain_solver_base.h"
+
+#include <map>
+#include <set>
+#include <algorithm>
+#include "partition/rank_subset.h"
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+double FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+currentFiberCost(int fiberDataNo)
+{
+  const FiberData &fiberData = fiberData_[fiberDataNo];
+
+  // determine the fraction of the points of the fiber that are currently computed in compute0D
+  double activeFraction = 1.0;
+  if (onlyComputeIfHasBeenStimulated_ && !fiberHasBeenStimulated_[fiberDataNo])
+  {
+    activeFraction = 0.0;
+  }
+  else if (disableComputationWhenStatesAreCloseToEquilibrium_)
+  {
+    int nActivePoints = 0;
+    for (int valueNo = 0; valueNo < fiberData.valuesLength; valueNo++)
+    {
+      global_no_t pointBuffersNo = (fiberData.valuesOffset + valueNo) / Vc::double_v::size();
+      if (fiberPointBuffersStatesAreCloseToEquilibrium_[pointBuffersNo] != inactive)
+        nActivePoints++;
+    }
+    activeFraction = double(nActivePoints) / fiberData.valuesLength;
+  }
+
+  return fiberData.valuesLength * (fiberAssignmentIdleWeight_ + activeFraction);
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+serializeFiberData(int fiberDataNo, std::vector<double> &buffer)
+{
+  const FiberData &fiberData = fiberData_[fiberDataNo];
+  const int nValues = fiberData.valuesLength;
+
+  // layout: stimulation state, then all states of all points, then the states of the checkpoint, if there is one
+  buffer.resize(6 + nStates*nValues*(hasFiberDataCheckpoint_? 2 : 1));
+  buffer[0] = fiberData.fiberStimulationPointIndex;
+  buffer[1] = fiberData.lastStimulationCheckTime;
+  buffer[2] = fiberData.currentJitter;
+  buffer[3] = fiberData.jitterIndex;
+  buffer[4] = fiberData.currentlyStimulating? 1 : 0;
+  buffer[5] = fiberHasBeenStimulated_[fiberDataNo]? 1 : 0;
+
+  for (int valueNo = 0; valueNo < nValues; valueNo++)
+  {
+    global_no_t valueIndexAllFibers = fiberData.valuesOffset + valueNo;
+    global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
+    int entryNo = valueIndexAllFibers % Vc::double_v::size();
+
+    for (int stateNo = 0; stateNo < nStates; stateNo++)
+    {
+      buffer[6 + stateNo*nValues + valueNo] = fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo];
+
+      if (hasFiberDataCheckpoint_)
+        buffer[6 + (nStates + stateNo)*nValues + valueNo] = fiberPointBuffersLastCheckpoint_[pointBuffersNo].states[stateNo][entryNo];
+    }
+  }
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+rebuildFiberData(std::map<int,std::vector<double>> &serializedFibers)
+{
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
+
+  // create new fiberData_ entries for all fibers that are now computed by the own rank
+  fiberData_.clear();
+  nInstancesToCompute_ = 0;
+  std::vector<int> fiberNos;    // fiberNo for every new fiberDataNo
+
+  int fiberNo = 0;
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++, fiberNo++)
+    {
+      std::shared_ptr<FiberFunctionSpace> fiberFunctionSpace = innerInstances[j].data().functionSpace();
+      if (fiberComputingRank_[fiberNo] != fiberFunctionSpace->meshPartition()->rankSubset()->ownRankNo())
+        continue;
+
+      assert(serializedFibers.find(fiberNo) != serializedFibers.end());
+      const std::vector<double> &buffer = serializedFibers[fiberNo];
+
+      CellmlAdapterType &cellmlAdapter = innerInstances[j].discretizableInTime();
+      int fiberNoGlobal = PythonUtility::convertFromPython<int>::get(cellmlAdapter.pySetFunctionAdditionalParameter_);
+
+      FiberData fiberData;
+      fiberData.valuesLength = fiberFunctionSpace->nDofsGlobal();
+      fiberData.valuesOffset = nInstancesToCompute_;
+      fiberData.fiberNoGlobal = fiberNoGlobal;
+      fiberData.motorUnitNo = motorUnitNo_[fiberNoGlobal % motorUnitNo_.size()];
+
+      // copy settings
+      fiberData.setSpecificStatesCallFrequency = cellmlAdapter.setSpecificStatesCallFrequency_;
+      fiberData.setSpecificStatesFrequencyJitter = cellmlAdapter.setSpecificStatesFrequencyJitter_;
+      fiberData.setSpecificStatesRepeatAfterFirstCall = cellmlAdapter.setSpecificStatesRepeatAfterFirstCall_;
+      fiberData.setSpecificStatesCallEnableBegin = cellmlAdapter.setSpecificStatesCallEnableBegin_;
+
+      // restore stimulation state
+      fiberData.fiberStimulationPointIndex = (int)buffer[0];
+      fiberData.lastStimulationCheckTime = buffer[1];
+      fiberData.currentJitter = buffer[2];
+      fiberData.jitterIndex = (int)buffer[3];
+      fiberData.currentlyStimulating = buffer[4] != 0;
+
+      fiberData_.push_back(fiberData);
+      fiberNos.push_back(fiberNo);
+      nInstancesToCompute_ += fiberData.valuesLength;
+    }
+  }
+
+  nFibersToCompute_ = fiberData_.size();
+
+  // the new fiberData_ entries have no element lengths and Vm values yet, they have to be gathered completely in the next fetchFiberData
+  residentFiberDataIsValid_ = false;
+  if (nFibersToCompute_ > 0)
+    nInstancesToComputePerFiber_ = fiberData_[0].valuesLength;
+
+  // resize the compute buffers, the parameters are set again in the next call to fetchFiberData
+  int nVcVectors = (nInstancesToCompute_ + Vc::double_v::size() - 1) / Vc::double_v::size();
+
+  fiberPointBuffers_.resize(nVcVectors);
+  fiberPointBuffersAlgebraicsForTransfer_.resize(nVcVectors);
+  fiberPointBuffersParameters_.resize(nVcVectors);
+  for (int i = 0; i < nVcVectors; i++)
+  {
+    fiberPointBuffersAlgebraicsForTransfer_[i].resize(algebraicsForTransferIndices_.size());
+    fiberPointBuffersParameters_[i].resize(nParametersPerInstance_);
+
+    // initialize all states, such that also the unused entries of the last vector have valid values
+    if (initializeStates_ != nullptr)
+      initializeStates_(fiberPointBuffers_[i].states);
+    else
+      initializeStates(fiberPointBuffers_[i].states);
+  }
+
+  if (hasFiberDataCheckpoint_)
+    fiberPointBuffersLastCheckpoint_ = fiberPointBuffers_;
+
+  // the equilibrium information cannot be kept, because the vectors now combine different points, mark all points as active
+  fiberPointBuffersStatesAreCloseToEquilibrium_.assign(nVcVectors, active);
+  nFiberPointBufferStatesCloseToEquilibrium_ = 0;
+
+  // store the serialized states
+  fiberHasBeenStimulated_.resize(nFibersToCompute_);
+  for (int fiberDataNo = 0; fiberDataNo < nFibersToCompute_; fiberDataNo++)
+  {
+    const std::vector<double> &buffer = serializedFibers[fiberNos[fiberDataNo]];
+    const FiberData &fiberData = fiberData_[fiberDataNo];
+    const int nValues = fiberData.valuesLength;
+
+    fiberHasBeenStimulated_[fiberDataNo] = buffer[5] != 0;
+
+    for (int valueNo = 0; valueNo < nValues; valueNo++)
+    {
+      global_no_t valueIndexAllFibers = fiberData.valuesOffset + valueNo;
+      global_no_t pointBuffersNo = valueIndexAllFibers / Vc::double_v::size();
+      int entryNo = valueIndexAllFibers % Vc::double_v::size();
+
+      for (int stateNo = 0; stateNo < nStates; stateNo++)
+      {
+        fiberPointBuffers_[pointBuffersNo].states[stateNo][entryNo] = buffer[6 + stateNo*nValues + valueNo];
+
+        if (hasFiberDataCheckpoint_)
+          fiberPointBuffersLastCheckpoint_[pointBuffersNo].states[stateNo][entryNo] = buffer[6 + (nStates + stateNo)*nValues + valueNo];
+      }
+    }
+  }
+}
+
+template<int nStates, int nAlgebraics, typename DiffusionTimeSteppingScheme>
+void FastMonodomainSolverBase<nStates,nAlgebraics,DiffusionTimeSteppingScheme>::
+rebalanceFibers()
+{
+  LOG_SCOPE_FUNCTION;
+
+  std::vector<typename NestedSolversType::TimeSteppingSchemeType> &instances = nestedSolvers_.instancesLocal();
+
+  // collect the fibers grouped by their rank subsets, as in initializeFiberAssignment
+  std::map<std::set<int>, std::vector<int>> fibersOfRankSubsets;    // key: ranks of the subset, value: fiberNos
+  std::vector<std::shared_ptr<Partition::RankSubset>> fiberRankSubset;
+  std::vector<int> fiberDataNoOfFiber;    // the fiberDataNo for fibers that are computed by the own rank, -1 otherwise
+
+  int fiberDataNo = 0;
+  for (int i = 0; i < instances.size(); i++)
+  {
+    std::vector<TimeSteppingScheme::Heun<CellmlAdapterType>> &innerInstances
+      = instances[i].timeStepping1().instancesLocal();  // TimeSteppingScheme::Heun<CellmlAdapter...
+
+    for (int j = 0; j < innerInstances.size(); j++)
+    {
+      std::shared_ptr<Partition::RankSubset> rankSubset = innerInstances[j].data().functionSpace()->meshPartition()->rankSubset();
+      int fiberNo = fiberRankSubset.size();
+
+      fibersOfRankSubsets[std::set<int>(rankSubset->begin(), rankSubset->end())].push_back(fiberNo);
+      fiberRankSubset.push_back(rankSubset);
+
+      if (fiberComputingRank_[fiberNo] == rankSubset->ownRankNo())
+        fiberDataNoOfFiber.push_back(fiberDataNo++);
+      else
+        fiberDataNoOfFiber.push_back(-1);
+    }
+  }
+
+  // determine the fibers to migrate, for every rank subset in the same order on all ranks
+  struct Migration
+  {
+    int fiberNo;           //< the local fiber no. that is moved
+    int fromRankNo;        //< the rank in the rank subset of the fiber that computed the fiber until now
+    int toRankNo;          //< the rank in the rank subset of the fiber that will compute the fiber
+    int tag;               //< the MPI tag for the message
+  };
+  std::vector<Migration> migrations;
+  bool ownRankIsInvolved = false;
+
+  for (std::pair<const std::set<int>, std::vector<int>> &fibersOfRankSubset : fibersOfRankSubsets)
+  {
+    const std::vector<int> &fiberNos = fibersOfRankSubset.second;
+    std::shared_ptr<Partition::RankSubset> rankSubset = fiberRankSubset[fiberNos[0]];
+    const int nRanks = rankSubset->size();
+    const int nFibers = fiberNos.size();
+
+    // get the estimated costs of all fibers of the rank subset and the measured durations of all ranks
+    std::vector<double> fiberCosts(nFibers, 0.0);
+    for (int fiberIndex = 0; fiberIndex < nFibers; fiberIndex++)
+    {
+      int fiberDataNo = fiberDataNoOfFiber[fiberNos[fiberIndex]];
+      if (fiberDataNo != -1)
+        fiberCosts[fiberIndex] = currentFiberCost(fiberDataNo);
+    }
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, fiberCosts.data(), nFibers, MPI_DOUBLE, MPI_SUM, rankSubset->mpiCommunicator()), "MPI_Allreduce");
+
+    std::vector<double> durationsOnRanks(nRanks);
+    MPIUtility::handleReturnValue(MPI_Allgather(&durationSinceLastRebalance_, 1, MPI_DOUBLE, durationsOnRanks.data(), 1, MPI_DOUBLE,
+                                                rankSubset->mpiCommunicator()), "MPI_Allgather");
+
+    // only migrate fibers if the measured imbalance is high enough
+    double durationsSum = 0;
+    for (double duration : durationsOnRanks)
+      durationsSum += duration;
+    double imbalance = 1.0;
+    if (durationsSum > 0)
+      imbalance = *std::max_element(durationsOnRanks.begin(), durationsOnRanks.end()) / (durationsSum / nRanks);
+
+    LOG(DEBUG) << "rebalanceFibers, rank subset " << *rankSubset << ": measured durations: " << durationsOnRanks << ", imbalance: " << imbalance
+      << ", fiber costs: " << fiberCosts;
+
+    if (imbalance < fiberRebalanceThreshold_)
+      continue;
+
+    // distribute the measured duration of every rank to its fibers, proportional to the estimated costs
+    std::vector<double> estimatedLoadOnRanks(nRanks, 0.0);
+    std::vector<int> nFibersOnRanks(nRanks, 0);
+    for (int fiberIndex = 0; fiberIndex < nFibers; fiberIndex++)
+    {
+      estimatedLoadOnRanks[fiberComputingRank_[fiberNos[fiberIndex]]] += fiberCosts[fiberIndex];
+      nFibersOnRanks[fiberComputingRank_[fiberNos[fiberIndex]]]++;
+    }
+
+    std::vector<double> fiberDurations(nFibers);
+    for (int fiberIndex = 0; fiberIndex < nFibers; fiberIndex++)
+    {
+      int rankNo = fiberComputingRank_[fiberNos[fiberIndex]];
+      if (estimatedLoadOnRanks[rankNo] > 0)
+        fiberDurations[fiberIndex] = durationsOnRanks[rankNo] * fiberCosts[fiberIndex] / estimatedLoadOnRanks[rankNo];
+      else
+        fiberDurations[fiberIndex] = durationsOnRanks[rankNo] / nFibersOnRanks[rankNo];
+    }
+
+    // repeatedly move the fiber from the most to the least loaded rank that brings both loads closest to each other,
+    // every fiber is moved at most once, because the data is sent by the rank that computed the fiber before this round,
+    // this also makes the tags (the fiber indices) of the messages unique
+    std::vector<double> loadOnRanks = durationsOnRanks;
+    std::vector<bool> fiberHasMoved(nFibers, false);
+    for (int migrationNo = 0; migrationNo < nFibers; migrationNo++)
+    {
+      int maximumRankNo = std::max_element(loadOnRanks.begin(), loadOnRanks.end()) - loadOnRanks.begin();
+      int minimumRankNo = std::min_element(loadOnRanks.begin(), loadOnRanks.end()) - loadOnRanks.begin();
+      double difference = loadOnRanks[maximumRankNo] - loadOnRanks[minimumRankNo];
+
+      int bestFiberIndex = -1;
+      for (int fiberIndex = 0; fiberIndex < nFibers; fiberIndex++)
+      {
+        // only fibers whose movement reduces the maximum load
+        double fiberDuration = fiberDurations[fiberIndex];
+        if (fiberHasMoved[fiberIndex] || fiberComputingRank_[fiberNos[fiberIndex]] != maximumRankNo || fiberDuration <= 0 || fiberDuration >= difference)
+          continue;
+
+        if (bestFiberIndex == -1 || fabs(difference/2 - fiberDuration) < fabs(difference/2 - fiberDurations[bestFiberIndex]))
+          bestFiberIndex = fiberIndex;
+      }
+
+      if (bestFiberIndex == -1)
+        break;
+
+      int fiberNo = fiberNos[bestFiberIndex];
+      migrations.push_back(Migration{fiberNo, maximumRankNo, minimumRankNo, bestFiberIndex});
+      if (maximumRankNo == rankSubset->ownRankNo() || minimumRankNo == rankSubset->ownRankNo())
+        ownRankIsInvolved = true;
+
+      fiberComputingRank_[fiberNo] = minimumRankNo;
+      fiberHasMoved[bestFiberIndex] = true;
+      loadOnRanks[maximumRankNo] -= fiberDurations[bestFiberIndex];
+      loadOnRanks[minimumRankNo] += fiberDurations[bestFiberIndex];
+    }
+  }
+
+  durationSinceLastRebalance_ = 0;
+
+  if (!migrations.empty())
+  {
+    LOG(DEBUG) << "rebalanceFibers: migrate " << migrations.size() << " fibers, own rank is involved: " << ownRankIsInvolved;
+  }
+
+  if (!ownRankIsInvolved)
+    return;
+
+  // serialize all fibers that were computed by the own rank, these are the fibers that are kept and the fibers that are sent
+  std::map<int,std::vector<double>> serializedFibers;
+  for (int fiberNo = 0; fiberNo < fiberDataNoOfFiber.size(); fiberNo++)
+  {
+    if (fiberDataNoOfFiber[fiberNo] != -1)
+      serializeFiberData(fiberDataNoOfFiber[fiberNo], serializedFibers[fiberNo]);
+  }
+
+  // send the fibers that the own rank no longer computes
+  std::vector<MPI_Request> sendRequests;
+  for (const Migration &migration : migrations)
+  {
+    std::shared_ptr<Partition::RankSubset> rankSubset = fiberRankSubset[migration.fiberNo];
+    if (migration.fromRankNo == rankSubset->ownRankNo())
+    {
+      std::vector<double> &buffer = serializedFibers[migration.fiberNo];
+      sendRequests.emplace_back();
+      MPIUtility::handleReturnValue(MPI_Isend(buffer.data(), buffer.size(), MPI_DOUBLE, migration.toRankNo, migration.tag,
+                                              rankSubset->mpiCommunicator(), &sendRequests.back()), "MPI_Isend");
+    }
+  }
+
+  // receive the fibers that the own rank will compute from now on
+  for (const Migration &migration : migrations)
+  {
+    std::shared_ptr<Partition::RankSubset> rankSubset = fiberRankSubset[migration.fiberNo];
+    if (migration.toRankNo == rankSubset->ownRankNo())
+    {
+      MPI_Status status;
+      MPIUtility::handleReturnValue(MPI_Probe(migration.fromRankNo, migration.tag, rankSubset->mpiCommunicator(), &status), "MPI_Probe", &status);
+
+      int bufferSize = 0;
+      MPIUtility::handleReturnValue(MPI_Get_count(&status, MPI_DOUBLE, &bufferSize), "MPI_Get_count");
+
+      std::vector<double> &buffer = serializedFibers[migration.fiberNo];
+      buffer.resize(bufferSize);
+      MPIUtility::handleReturnValue(MPI_Recv(buffer.data(), bufferSize, MPI_DOUBLE, migration.fromRankNo, migration.tag,
+                                             rankSubset->mpiCommunicator(), &status), "MPI_Recv", &status);
+    }
+  }
+
+  if (!sendRequests.empty())
+    MPIUtility::handleReturnValue(MPI_Waitall(sendRequests.size(), sendRequests.data(), MPI_STATUSES_IGNORE), "MPI_Waitall");
+
+  // create the local data structures for the new set of fibers
+  rebuildFiberData(serializedFibers);
+
+  // update the predicted load for logLoadImbalance
+  predictedLoad_ = 0;
+  for (int fiberDataNo = 0; fiberDataNo < nFibersToCompute_; fiberDataNo++)
+    predictedLoad_ += currentFiberCost(fiberDataNo);
+
+  LOG(DEBUG) << "after rebalanceFibers: " << nFibersToCompute_ << " fibers to compute, fiberComputingRank_: " << fiberComputingRank_;
+}
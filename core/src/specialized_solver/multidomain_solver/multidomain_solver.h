@@ -109,6 +109,7 @@ protected:
   Mat singlePreconditionerMatrix_;            //< non-nested Petsc Mat that contains the preconditioner matrix
   Vec singleSolution_;                        //< non-nested Petsc Vec, solution vector
   Vec singleRightHandSide_;                   //< non-nested Petsc Vec, distributed rhs
+  Vec inverseLumpedMassMatrixDiagonal_;       //< the diagonal of the inverse lumped mass matrix, M^{-1}, used as row scaling of the submatrix views
 
   std::vector<Vec> subvectorsRightHandSide_;  //< the sub vectors that are used in the nested vector nestedRightHandSide_
   std::vector<Vec> subvectorsSolution_;       //< the sub vectors that are used in the nested vector nestedSolution_
@@ -122,6 +123,7 @@ protected:
   int lastNumberOfIterations_;   //< the number of iterations that were needed the last time to solve the linear system
   double timeStepWidthOfSystemMatrix_;        //< the timestep width that was used to setup the system matrix
   bool useSymmetricPreconditionerMatrix_;     //< if the symmetric preconditioner matrix should be set up
+  bool useRowScaledCompartmentStiffnessMatrices_;  //< if the bottom row submatrices f_k*K should be approximated by views diag(f_k)*K on the shared stiffness matrix instead of assembling one stiffness matrix per compartment
   bool updateSystemMatrixEveryTimestep_;      //< if the system matrix will be rebuild every first time step, this is needed if the geometry changes
   int updateSystemMatrixInterval_;            //< interval when the system matrix should be rebuild, counting only calls to advanceTimeStep
   int recreateLinearSolverInterval_;          //< interval when linearSolver_ object gets deleted and recreated, to remedy memory leaks of the PETSc implementation of some solvers
@@ -7,7 +7,9 @@
 #include "utility/petsc_utility.h"
 #include "data_management/specialized_solver/multidomain.h"
 #include "specialized_solver/multidomain_solver/nested_mat_vec_utility.h"
+#include "specialized_solver/multidomain_solver/scaled_mat_view.h"
 #include "control/diagnostic_tool/memory_leak_finder.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 //#define MONODOMAIN
 
@@ -60,6 +62,7 @@ MultidomainSolver(DihuContext context) :
     LOG(ERROR) << this->specificSettings_ << " option \"constructPreconditionerMatrix\" has been renamed to \"useSymmetricPreconditionerMatrix\".";
   }
   useSymmetricPreconditionerMatrix_ = this->specificSettings_.getOptionBool("useSymmetricPreconditionerMatrix", true);
+  useRowScaledCompartmentStiffnessMatrices_ = this->specificSettings_.getOptionBool("useRowScaledCompartmentStiffnessMatrices", false);
 
   // create finiteElement objects for diffusion in compartments
   finiteElementMethodDiffusionCompartment_.reserve(nCompartments_);
@@ -72,6 +75,7 @@ MultidomainSolver(DihuContext context) :
   singleSolution_ = PETSC_NULL;
   singleRightHandSide_ = PETSC_NULL;
   singlePreconditionerMatrix_ = PETSC_NULL;
+  inverseLumpedMassMatrixDiagonal_ = PETSC_NULL;
   lastNumberOfIterations_ = 0;
 }
 
@@ -203,6 +207,9 @@ run()
   initialize();
 
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
@@ -298,10 +305,14 @@ initializeObjects()
   // [B^1_phie,Vm |B^2_phie,Vm | B^M_phie,Vm | B_phie,phie]   [ phi_e^(i+1) ]   [0        ]
 
   // diffusion objects with spatially varying prefactors (f_r), needed for the bottom row of the matrix eq. or the 1st multidomain eq.
-  for (int k = 0; k < nCompartments_; k++)
+  // if useRowScaledCompartmentStiffnessMatrices_ is set, the bottom row uses views on the stiffness matrix instead and these objects are not needed
+  if (!useRowScaledCompartmentStiffnessMatrices_)
   {
-    finiteElementMethodDiffusionCompartment_[k].initialize(dataMultidomain_.fiberDirection(), dataMultidomain_.compartmentRelativeFactor(k));
-    finiteElementMethodDiffusionCompartment_[k].initializeForImplicitTimeStepping(); // this performs extra initialization for implicit timestepping methods, i.e. it sets the inverse lumped mass matrix
+    for (int k = 0; k < nCompartments_; k++)
+    {
+      finiteElementMethodDiffusionCompartment_[k].initialize(dataMultidomain_.fiberDirection(), dataMultidomain_.compartmentRelativeFactor(k));
+      finiteElementMethodDiffusionCompartment_[k].initializeForImplicitTimeStepping(); // this performs extra initialization for implicit timestepping methods, i.e. it sets the inverse lumped mass matrix
+    }
   }
 
   finiteElementMethodDiffusionTotal_.initialize(dataMultidomain_.fiberDirection(), dataMultidomain_.relativeFactorTotal(), true);
@@ -556,121 +567,86 @@ setSystemMatrixSubmatrices(double timeStepWidth)
   Mat stiffnessMatrix = finiteElementMethodDiffusion_.data().stiffnessMatrix()->valuesGlobal();
   Mat inverseLumpedMassMatrix = finiteElementMethodDiffusion_.data().inverseLumpedMassMatrix()->valuesGlobal();
 
+  // The submatrices are not copies but views on the one stiffness matrix K, with per-compartment scalar factors and
+  // the diagonal of M^{-1} as row scaling. Thus, the memory for the submatrices does not grow with the number of compartments.
   PetscErrorCode ierr;
+  if (inverseLumpedMassMatrixDiagonal_ == PETSC_NULL)
+  {
+    ierr = MatCreateVecs(inverseLumpedMassMatrix, NULL, &inverseLumpedMassMatrixDiagonal_); CHKERRV(ierr);
+  }
+  ierr = MatGetDiagonal(inverseLumpedMassMatrix, inverseLumpedMassMatrixDiagonal_); CHKERRV(ierr);
+
   // set all submatricesSystemMatrix_
   for (int k = 0; k < nCompartments_; k++)
   {
-
     // right column matrix
     double prefactor = -timeStepWidth / (am_[k]*cm_[k]);
 
     VLOG(2) << "k=" << k << ", am: " << am_[k] << ", cm: " << cm_[k] << ", prefactor: " << prefactor;
 
-    // create matrix as M^{-1}*K
-    Mat matrixOnRightColumn;
-    ierr = MatMatMult(inverseLumpedMassMatrix, stiffnessMatrix, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &matrixOnRightColumn); CHKERRV(ierr);
+    // views that were created by a previous call, e.g. when the timestep width changed, are released
+    const int indexRightColumn = k*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1) - 1;
+    const int indexDiagonal = k*nColumnSubmatricesSystemMatrix_ + k;
+    const int indexBottomRow = ((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + k;
 
-    // scale matrix on right column with prefactor
-    ierr = MatScale(matrixOnRightColumn, prefactor); CHKERRV(ierr);
+    ScaledMatView::destroyIfScaledMatView(submatricesSystemMatrix_[indexRightColumn]);
+    ScaledMatView::destroyIfScaledMatView(submatricesSystemMatrix_[indexDiagonal]);
+    ScaledMatView::destroyIfScaledMatView(submatricesSystemMatrix_[indexBottomRow]);
 
-    // copy right block matrix also to diagonal matrix
-    Mat matrixOnDiagonalBlock;
-    ierr = MatConvert(matrixOnRightColumn, MATSAME, MAT_INITIAL_MATRIX, &matrixOnDiagonalBlock); CHKERRV(ierr);
+    // matrix on right column, prefactor*M^{-1}*K
+    double prefactorRightColumn = prefactor;
 
     // for debugging zero all entries
 #ifdef MONODOMAIN
-/**/    ierr = MatZeroEntries(matrixOnRightColumn); CHKERRV(ierr);
+/**/    prefactorRightColumn = 0;
 #endif
 
-    // set on right column of the system matrix
-    submatricesSystemMatrix_[k*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1) - 1] = matrixOnRightColumn;
+    std::stringstream name;
+    name << "B^" << k << "_Vm,phie";
+    ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{prefactorRightColumn}, inverseLumpedMassMatrixDiagonal_,
+                                       0.0, name.str(), submatricesSystemMatrix_[indexRightColumn]);
 
-    if (VLOG_IS_ON(2))
-    {
-      VLOG(2) << "matrixOnRightColumn: " << PetscUtility::getStringMatrix(matrixOnRightColumn);
-      VLOG(2) << "set at index " << k*nColumnSubmatricesSystemMatrix_ + (nCompartments_+1) - 1;
-    }
+    VLOG(2) << "set matrixOnRightColumn at index " << indexRightColumn;
 
     // ---
-    // diagonal matrix
-    // add identity
-    ierr = MatShift(matrixOnDiagonalBlock, 1); CHKERRV(ierr);
+    // diagonal matrix, prefactor*M^{-1}*K + I
+    name.str("");
+    name << "A^" << k << "_Vm,Vm";
+    ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{prefactor}, inverseLumpedMassMatrixDiagonal_,
+                                       1.0, name.str(), submatricesSystemMatrix_[indexDiagonal]);
 
-    // set on diagonal
-    submatricesSystemMatrix_[k*nColumnSubmatricesSystemMatrix_ + k] = matrixOnDiagonalBlock;
-
-    if (VLOG_IS_ON(2))
-    {
-      VLOG(2) << "matrixOnDiagonalBlock:" << PetscUtility::getStringMatrix(matrixOnDiagonalBlock);
-      VLOG(2) << "set at index " << k*nColumnSubmatricesSystemMatrix_ + k;
-    }
+    VLOG(2) << "set matrixOnDiagonalBlock at index " << indexDiagonal;
 
     // ---
     // bottom row matrices
-
-    // stiffnessMatrixWithPrefactor is f_k*K
-    Mat stiffnessMatrixWithPrefactor = finiteElementMethodDiffusionCompartment_[k].data().stiffnessMatrix()->valuesGlobal();
-
-    // create matrix as copy of stiffnessMatrix
-    Mat matrixOnBottomRow;
-    ierr = MatConvert(stiffnessMatrixWithPrefactor, MATSAME, MAT_INITIAL_MATRIX, &matrixOnBottomRow); CHKERRV(ierr);
-    
-#if 0
-    // debugging test, gives slightly different results due to approximation of test
-    Mat test;
-    ierr = MatConvert(stiffnessMatrix, MATSAME, MAT_INITIAL_MATRIX, &test); CHKERRV(ierr);
-
-    // get the relative factor of the compartment
-    Vec compartmentRelativeFactor = dataMultidomain_.compartmentRelativeFactor(k)->valuesGlobal();
-
-    int i = 0;double v = 0;
-    MatGetValues(test,1,&i,1,&i,&v);
-    LOG(DEBUG) << "compartmentRelativeFactor: " << PetscUtility::getStringVector(compartmentRelativeFactor);
-    LOG(DEBUG) << "test[0][0] = " << v;
-
-    // MatDiagonalScale(A,l,NULL) computes A = diag(l)*A, this scales the rows of A with the values in l (each row with one entry of l)
-    ierr = MatDiagonalScale(test, compartmentRelativeFactor, NULL); CHKERRV(ierr);
-
-    MatGetValues(test,1,&i,1,&i,&v);
-    LOG(DEBUG) << "MatdiagonalScale";
-    LOG(DEBUG) << "test[0][0] = " << v;
-
-    // test if "test" and matrixOnBottomRow yield the same matrices
-    PetscInt nRows, nColumns;
-    ierr = MatGetSize(matrixOnBottomRow,&nRows,&nColumns); CHKERRV(ierr);
-    double max_diff = 0;
-    for (int column = 0; column < nColumns; column++)
+    if (useRowScaledCompartmentStiffnessMatrices_)
     {
-      for (int row = 0; row < nRows; row++)
-      {
-        double value1, value2;
-        ierr = MatGetValues(matrixOnBottomRow,1,&row,1,&column,&value1); CHKERRV(ierr);
-        ierr = MatGetValues(test,1,&row,1,&column,&value2); CHKERRV(ierr);
-        double difference = fabs(value1-value2);
-        max_diff = std::max(max_diff, difference);
-        if (difference > 1e-5)
-        {
-          LOG(DEBUG) << "bottom matrix entry row=" << row << ", column=" << column << " is different: " << value1 << "," << value2 << ", diff: " << difference;
-
-        }
-      }
+      // approximate f_k*K by diag(f_k)*K, i.e. scale the rows of K by the nodal values of the relative factor f_k
+      name.str("");
+      name << "B^" << k << "_phie,Vm";
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{1.0},
+                                         dataMultidomain_.compartmentRelativeFactor(k)->valuesGlobal(),
+                                         0.0, name.str(), submatricesSystemMatrix_[indexBottomRow]);
     }
-    LOG(FATAL) << "max_diff:" << max_diff;
-#endif
-    if (VLOG_IS_ON(2))
+    else
     {
-      VLOG(2) << "matrixOnBottomRow: " << PetscUtility::getStringMatrix(matrixOnBottomRow);
+      // stiffnessMatrixWithPrefactor is f_k*K, it is assembled by the compartment finite element object and used directly without copy
+      submatricesSystemMatrix_[indexBottomRow] = finiteElementMethodDiffusionCompartment_[k].data().stiffnessMatrix()->valuesGlobal();
     }
 
-    // for debugging zero all entries
+    // for debugging zero all entries, the compartment stiffness matrix must not be changed, therefore use a zero view instead
 #ifdef MONODOMAIN
-/**/    ierr = MatZeroEntries(matrixOnBottomRow); CHKERRV(ierr);
+/**/    ScaledMatView::destroyIfScaledMatView(submatricesSystemMatrix_[indexBottomRow]);
+/**/    ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{0.0}, PETSC_NULL,
+/**/                                       0.0, "B_phie,Vm (zero)", submatricesSystemMatrix_[indexBottomRow]);
 #endif
 
-    // set on bottom row of the system matrix
-    submatricesSystemMatrix_[((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + k] = matrixOnBottomRow;
+    if (VLOG_IS_ON(2) && !ScaledMatView::isScaledMatView(submatricesSystemMatrix_[indexBottomRow]))
+    {
+      VLOG(2) << "matrixOnBottomRow: " << PetscUtility::getStringMatrix(submatricesSystemMatrix_[indexBottomRow]);
+    }
 
-    VLOG(2) << "set at index " << ((nCompartments_+1) - 1)*nColumnSubmatricesSystemMatrix_ + k;
+    VLOG(2) << "set matrixOnBottomRow at index " << indexBottomRow;
   }
 
   // set bottom right matrix
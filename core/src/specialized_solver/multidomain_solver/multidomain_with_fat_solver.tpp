@@ -2,6 +2,8 @@
 
 #include <Python.h>  // has to be the first included header
 
+#include "specialized_solver/multidomain_solver/scaled_mat_view.h"
+
 namespace TimeSteppingScheme
 {
 
@@ -182,16 +184,25 @@ setSystemMatrixSubmatrices(double timeStepWidth)
   Mat stiffnessMatrix = this->finiteElementMethodDiffusion_.data().stiffnessMatrix()->valuesGlobal();
   Mat massMatrix = this->finiteElementMethodDiffusion_.data().massMatrix()->valuesGlobal();
 
-  Mat minusDtMInv;   // matrix -dt*M^-1 with which to scale the matrix equations of the compartments if option useLumpedMassMatrix_ is set
+  // All submatrices and the matrices b1_, b2_ for the rhs are views on the one stiffness matrix K (and mass matrix M),
+  // with per-compartment scalar factors. If the option useLumpedMassMatrix_ is set, the rows are scaled by the diagonal of M^-1.
+  // This avoids to store 4*nCompartments copies of K.
+  Vec rowScaling = PETSC_NULL;
   if (useLumpedMassMatrix_)
   {
     Mat inverseLumpedMassMatrix = this->finiteElementMethodDiffusion_.data().inverseLumpedMassMatrix()->valuesGlobal();
     
-    // compute minusDtMInv = -dt*M^-1
-    ierr = MatConvert(inverseLumpedMassMatrix, MATSAME, MAT_INITIAL_MATRIX, &minusDtMInv); CHKERRV(ierr);
-    ierr = MatScale(minusDtMInv, -timeStepWidth); CHKERRV(ierr);
+    if (this->inverseLumpedMassMatrixDiagonal_ == PETSC_NULL)
+    {
+      ierr = MatCreateVecs(inverseLumpedMassMatrix, NULL, &this->inverseLumpedMassMatrixDiagonal_); CHKERRV(ierr);
+    }
+    ierr = MatGetDiagonal(inverseLumpedMassMatrix, this->inverseLumpedMassMatrixDiagonal_); CHKERRV(ierr);
+    rowScaling = this->inverseLumpedMassMatrixDiagonal_;
   }
 
+  b1_.resize(this->nCompartments_, PETSC_NULL);
+  b2_.resize(this->nCompartments_, PETSC_NULL);
+
   // set all submatrices
   for (int k = 0; k < this->nCompartments_; k++)
   {
@@ -200,109 +211,96 @@ setSystemMatrixSubmatrices(double timeStepWidth)
 
     VLOG(2) << "k=" << k << ", am: " << this->am_[k] << ", cm: " << this->cm_[k] << ", prefactor: " << prefactor;
 
-    // matrix B on right column
-    // create matrix as theta/(Am*Cm)*K
-    Mat matrixOnRightColumn;
-    ierr = MatConvert(stiffnessMatrix, MATSAME, MAT_INITIAL_MATRIX, &matrixOnRightColumn); CHKERRV(ierr);
+    // views that were created by a previous call, e.g. when the timestep width changed, are released
+    const int indexRightColumn = k*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_;
+    const int indexDiagonal = k*this->nColumnSubmatricesSystemMatrix_ + k;
+    const int indexBottomRow = this->nCompartments_*this->nColumnSubmatricesSystemMatrix_ + k;
 
-    // scale matrix on right column with prefactor
-    ierr = MatScale(matrixOnRightColumn, prefactor); CHKERRV(ierr);
+    ScaledMatView::destroyIfScaledMatView(this->submatricesSystemMatrix_[indexRightColumn]);
+    ScaledMatView::destroyIfScaledMatView(this->submatricesSystemMatrix_[indexDiagonal]);
+    ScaledMatView::destroyIfScaledMatView(this->submatricesSystemMatrix_[indexBottomRow]);
+    ScaledMatView::destroyIfScaledMatView(b1_[k]);
+    ScaledMatView::destroyIfScaledMatView(b2_[k]);
 
+    std::stringstream name;
     if (useLumpedMassMatrix_)
     {
       // in this formulation the matrix B is B = -dt*theta/(Am*Cm)*M^-1*K
-      Mat result;
-      ierr = MatMatMult(minusDtMInv, matrixOnRightColumn, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &result); CHKERRV(ierr);
-      matrixOnRightColumn = result;
+      name << "B^" << k << "_Vm,phie";
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{-timeStepWidth*prefactor}, rowScaling,
+                                         0.0, name.str(), this->submatricesSystemMatrix_[indexRightColumn]);
+
+      // the matrix A is A = -dt*theta/(Amk*Cmk)*M^-1*K + I, with B = -dt*theta/(Amk*Cmk)*M^-1*K this becomes A = B + I
+      name.str("");
+      name << "A^" << k << "_Vm,Vm";
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{-timeStepWidth*prefactor}, rowScaling,
+                                         1.0, name.str(), this->submatricesSystemMatrix_[indexDiagonal]);
+    }
+    else
+    {
+      // in this formulation the matrix B is B = theta/(Am*Cm)*K
+      name << "B^" << k << "_Vm,phie";
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{prefactor}, PETSC_NULL,
+                                         0.0, name.str(), this->submatricesSystemMatrix_[indexRightColumn]);
+
+      // the matrix A is A = theta/(Amk*Cmk)*K - 1/dt*M, with B = theta/(Am*Cm)*K this becomes A = B - 1/dt*M
+      name.str("");
+      name << "A^" << k << "_Vm,Vm";
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix, massMatrix}, std::vector<double>{prefactor, -1/timeStepWidth}, PETSC_NULL,
+                                         0.0, name.str(), this->submatricesSystemMatrix_[indexDiagonal]);
     }
-
-    // set on right column of the system matrix
-    this->submatricesSystemMatrix_[k*this->nColumnSubmatricesSystemMatrix_ + this->nCompartments_] = matrixOnRightColumn;
 
     // ---
-    // matrix on diagonal, A
-    // copy right block matrix also to diagonal matrix
-    Mat matrixOnDiagonalBlock;
-    ierr = MatConvert(matrixOnRightColumn, MATSAME, MAT_INITIAL_MATRIX, &matrixOnDiagonalBlock); CHKERRV(ierr);
-
-    if (useLumpedMassMatrix_)
+    // bottom row matrices, B
+    if (this->useRowScaledCompartmentStiffnessMatrices_)
     {
-      // in this formulation the matrix A is A = -dt*theta/(Amk*Cmk)*M^-1*K + I, with B = -dt*theta/(Amk*Cmk)*M^-1*K this becomes A = B + I
-      // add identity
-      ierr = MatShift(matrixOnDiagonalBlock, 1); CHKERRV(ierr);
+      // approximate f_k*K by diag(f_k)*K, i.e. scale the rows of K by the nodal values of the relative factor f_k
+      name.str("");
+      name << "B^" << k << "_phie,Vm";
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{1.0},
+                                         this->dataMultidomain_.compartmentRelativeFactor(k)->valuesGlobal(),
+                                         0.0, name.str(), this->submatricesSystemMatrix_[indexBottomRow]);
     }
-    else 
+    else
     {
-      // in this formulation the matrix A is A = theta/(Amk*Cmk)*K - 1/dt*M, with B = theta/(Am*Cm)*K this becomes A = B - 1/dt*M
-
-      // add scaled mass matrix, -1/dt*M,  AXPY: Y = a*X + Y  MatAXPY(Y,a,X,SAME_NONZERO_PATTERN)
-      prefactor = -1/timeStepWidth;
-      ierr = MatAXPY(matrixOnDiagonalBlock, prefactor, massMatrix, SAME_NONZERO_PATTERN); CHKERRV(ierr);
+      // stiffnessMatrixWithPrefactor is f_k*K, it is assembled by the compartment finite element object and used directly without copy
+      this->submatricesSystemMatrix_[indexBottomRow] = this->finiteElementMethodDiffusionCompartment_[k].data().stiffnessMatrix()->valuesGlobal();
     }
 
-    // set on diagonal
-    this->submatricesSystemMatrix_[k*this->nColumnSubmatricesSystemMatrix_ + k] = matrixOnDiagonalBlock;
-
     // ---
-    // bottom row matrices, B
-    // stiffnessMatrixWithPrefactor is f_k*K
-    Mat stiffnessMatrixWithPrefactor = this->finiteElementMethodDiffusionCompartment_[k].data().stiffnessMatrix()->valuesGlobal();
-
-    // create matrix as copy of stiffnessMatrix
-    Mat matrixOnBottomRow;
-    ierr = MatConvert(stiffnessMatrixWithPrefactor, MATSAME, MAT_INITIAL_MATRIX, &matrixOnBottomRow); CHKERRV(ierr);
-
-    // set on bottom row of the system matrix
-    this->submatricesSystemMatrix_[this->nCompartments_*this->nColumnSubmatricesSystemMatrix_ + k] = matrixOnBottomRow;
-  }
-
-  // ---
-  // matrices for rhs
-  b1_.resize(this->nCompartments_);
-  b2_.resize(this->nCompartments_);
-
-  // initialize the matrices b1, b2 to compute the rhs
-  // the final right hand side will be b_Vm^(i+1) = b1_ * Vm^(i) + b2_ * phi_e^(i)
-  for (int k = 0; k < this->nCompartments_; k++)
-  {
-    // set b1_ = (θ-1)*1/(Am^k*Cm^k)*K_sigmai^k
-    // begin with b1_ = K_sigmai^k
-    ierr = MatConvert(stiffnessMatrix, MATSAME, MAT_INITIAL_MATRIX, &b1_[k]); CHKERRV(ierr);
-    
-    double prefactor = (theta_ - 1) / (this->am_[k]*this->cm_[k]);
-    ierr = MatScale(b1_[k], prefactor); CHKERRV(ierr);
+    // matrices for rhs
+    // the final right hand side will be b_Vm^(i+1) = b1_ * Vm^(i) + b2_ * phi_e^(i)
+    prefactor = (theta_ - 1) / (this->am_[k]*this->cm_[k]);
 
+    name.str("");
+    name << "b1^" << k;
     if (useLumpedMassMatrix_)
     {
       // in this formulation we have b1_[k] = -dt*(θ-1)/(Am^k*Cm^k)*M^{-1}*K_sigmai^k + I
-      Mat result;
-      ierr = MatMatMult(minusDtMInv, b1_[k], MAT_INITIAL_MATRIX, PETSC_DEFAULT, &result); CHKERRV(ierr);
-      b1_[k] = result;
-      
-      // add identity
-      ierr = MatShift(b1_[k], 1); CHKERRV(ierr);
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{-timeStepWidth*prefactor}, rowScaling,
+                                         1.0, name.str(), b1_[k]);
     }
-    else 
+    else
     {
-      // add scaled mass matrix, -1/dt*M,  AXPY: Y = a*X + Y  MatAXPY(Y,a,X,SAME_NONZERO_PATTERN)
-      prefactor = -1/timeStepWidth;
-      ierr = MatAXPY(b1_[k], prefactor, massMatrix, SAME_NONZERO_PATTERN); CHKERRV(ierr);
+      // set b1_ = (θ-1)*1/(Am^k*Cm^k)*K_sigmai^k - 1/dt*M
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix, massMatrix}, std::vector<double>{prefactor, -1/timeStepWidth}, PETSC_NULL,
+                                         0.0, name.str(), b1_[k]);
     }
 
-    // set b2_ = (θ-1)/(Am^k*Cm^k)*K_sigmai^k
-    // begin with b2_ = K_sigmai^k
-    ierr = MatConvert(stiffnessMatrix, MATSAME, MAT_INITIAL_MATRIX, &b2_[k]); CHKERRV(ierr);
-    
+    name.str("");
+    name << "b2^" << k;
     if (useLumpedMassMatrix_)
     {
       // in this formulation we have b2_[k] = -dt*(θ-1)/(Am^k*Cm^k)*M^{-1}*K_sigmai^k
-      Mat result;
-      ierr = MatMatMult(minusDtMInv, b2_[k], MAT_INITIAL_MATRIX, PETSC_DEFAULT, &result); CHKERRV(ierr);
-      b2_[k] = result;
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{-timeStepWidth*prefactor}, rowScaling,
+                                         0.0, name.str(), b2_[k]);
+    }
+    else
+    {
+      // set b2_ = (θ-1)/(Am^k*Cm^k)*K_sigmai^k
+      ScaledMatView::createScaledMatView(std::vector<Mat>{stiffnessMatrix}, std::vector<double>{prefactor}, PETSC_NULL,
+                                         0.0, name.str(), b2_[k]);
     }
-
-    prefactor = (theta_ - 1) / (this->am_[k]*this->cm_[k]);
-    ierr = MatScale(b2_[k], prefactor); CHKERRV(ierr);
   }
 }
 
@@ -7,6 +7,7 @@
 
 #include "utility/vector_operators.h"
 #include "utility/petsc_utility.h"
+#include "specialized_solver/multidomain_solver/scaled_mat_view.h"
 #include "easylogging++.h"
 
 //#define USE_NESTED_MAT      // this disables this utility and directly uses the nested Vecs and Mats. This is faster in the handling of the Petsc variables but only GMRES solver is possible, no direct solvers.
@@ -406,22 +407,27 @@ void createMatFromNestedMat(Mat nestedMat, Mat &singleMat, std::shared_ptr<Parti
 
         PetscInt nRowsLocal = rowNoGlobalEnd - rowNoGlobalBegin;
 
-        // create index set indicating all rows of currentMat that are stored locally, in global numbering
-        IS indexSetRows[1];
-        ISCreateStride(mpiCommunicator, nRowsLocal, rowNoGlobalBegin, 1, &indexSetRows[0]);
+        // views created by ScaledMatView do not support MatCreateSubMatrices, but their MatGetRow already yields the global column indices of the local rows
+        const bool isScaledMatView = ScaledMatView::isScaledMatView(currentMat);
+        Mat *localSubMatrix = NULL;
 
-        // create index set indicating all columns of currentMat that are stored locally (which are also all global columns), in global numbering
-        IS indexSetColumns[1];
-        ISCreateStride(mpiCommunicator, nColumnsGlobalNestedMats[nestedMatColumnNo], 0, 1, &indexSetColumns[0]);
-        
-        Mat *localSubMatrix;
-        ierr = MatCreateSubMatrices(currentMat, 1, indexSetRows, indexSetColumns, MAT_INITIAL_MATRIX, &localSubMatrix); CHKERRV(ierr);
+        if (!isScaledMatView)
+        {
+          // create index set indicating all rows of currentMat that are stored locally, in global numbering
+          IS indexSetRows[1];
+          ISCreateStride(mpiCommunicator, nRowsLocal, rowNoGlobalBegin, 1, &indexSetRows[0]);
 
-        PetscInt nRowsLocalSubMatrix = 0;
-        PetscInt nColumnsLocalSubMatrix = 0;
-        ierr = MatGetSize(localSubMatrix[0], &nRowsLocalSubMatrix, &nColumnsLocalSubMatrix); CHKERRV(ierr);
-        
-        if (VLOG_IS_ON(1))
+          // create index set indicating all columns of currentMat that are stored locally (which are also all global columns), in global numbering
+          IS indexSetColumns[1];
+          ISCreateStride(mpiCommunicator, nColumnsGlobalNestedMats[nestedMatColumnNo], 0, 1, &indexSetColumns[0]);
+
+          ierr = MatCreateSubMatrices(currentMat, 1, indexSetRows, indexSetColumns, MAT_INITIAL_MATRIX, &localSubMatrix); CHKERRV(ierr);
+        }
+
+        // the matrix from which the rows are retrieved
+        Mat rowSourceMatrix = (isScaledMatView? currentMat : localSubMatrix[0]);
+
+        if (VLOG_IS_ON(1) && !isScaledMatView)
         {
           std::stringstream filename;
           filename << "out/localSubMatrix" << nestedMatRowNo << "_" << nestedMatColumnNo << "_" << ownRankNo;
@@ -438,7 +444,8 @@ void createMatFromNestedMat(Mat nestedMat, Mat &singleMat, std::shared_ptr<Parti
           PetscInt nNonzeroEntriesInRow;
           const PetscInt *columnIndices;
           const double *values;
-          ierr = MatGetRow(localSubMatrix[0], rowNoLocal, &nNonzeroEntriesInRow, &columnIndices, &values); CHKERRV(ierr);
+          PetscInt rowNoRowSourceMatrix = (isScaledMatView? rowNoGlobal : rowNoLocal);
+          ierr = MatGetRow(rowSourceMatrix, rowNoRowSourceMatrix, &nNonzeroEntriesInRow, &columnIndices, &values); CHKERRV(ierr);
 
           PetscInt singleMatRowNoGlobal = singleMatRowNoGlobalBegin + rowOffsetInSingleMatOwnDomain + rowNoLocal;
 
@@ -523,10 +530,13 @@ void createMatFromNestedMat(Mat nestedMat, Mat &singleMat, std::shared_ptr<Parti
             currentColumnIndexBegin = currentColumnIndexEnd;
           }
 
-          ierr = MatRestoreRow(localSubMatrix[0], rowNoLocal, NULL, &columnIndices, &values); CHKERRV(ierr);
+          ierr = MatRestoreRow(rowSourceMatrix, rowNoRowSourceMatrix, NULL, &columnIndices, &values); CHKERRV(ierr);
         }
 
-        ierr = MatDestroySubMatrices(1, &localSubMatrix); CHKERRV(ierr);
+        if (!isScaledMatView)
+        {
+          ierr = MatDestroySubMatrices(1, &localSubMatrix); CHKERRV(ierr);
+        }
       }
 
       for (int rankNo = 0; rankNo < nRanks; rankNo++)
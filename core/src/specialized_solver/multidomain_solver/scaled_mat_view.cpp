@@ -0,0 +1,295 @@
+#include "specialized_solver/multidomain_solver/scaled_mat_view.h"
+
+#include <Python.h>  // has to be the first included header
+#include <map>
+#include <algorithm>
+#include <cassert>
+
+#include "utility/vector_operators.h"
+#include "easylogging++.h"
+
+namespace TimeSteppingScheme
+{
+
+namespace ScaledMatView
+{
+
+namespace
+{
+
+//! the context of a shell matrix that acts as view
+struct ScaledMatViewContext
+{
+  std::vector<Mat> baseMatrices;        //< the matrices that are referenced, the view does not copy them
+  std::vector<double> factors;          //< scalar prefactor for each base matrix
+  Vec rowScaling;                       //< vector with which the rows get scaled, or PETSC_NULL
+  double shift;                         //< value that is added to the diagonal after row scaling
+  Vec temporary;                        //< temporary vector for MatMult if there are multiple base matrices
+
+  std::vector<PetscInt> rowColumnIndices;   //< buffer for the row that is returned by MatGetRow
+  std::vector<PetscScalar> rowValues;       //< buffer for the row that is returned by MatGetRow
+};
+
+//! MatMult for the view, y = diag(rowScaling) * (Σ_i factor_i * A_i) * x + shift * x
+PetscErrorCode mult(Mat view, Vec x, Vec y)
+{
+  ScaledMatViewContext *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(view, &context); CHKERRQ(ierr);
+
+  ierr = MatMult(context->baseMatrices[0], x, y); CHKERRQ(ierr);
+  ierr = VecScale(y, context->factors[0]); CHKERRQ(ierr);
+
+  for (int i = 1; i < context->baseMatrices.size(); i++)
+  {
+    if (context->temporary == PETSC_NULL)
+    {
+      ierr = VecDuplicate(y, &context->temporary); CHKERRQ(ierr);
+    }
+    ierr = MatMult(context->baseMatrices[i], x, context->temporary); CHKERRQ(ierr);
+    ierr = VecAXPY(y, context->factors[i], context->temporary); CHKERRQ(ierr);
+  }
+
+  if (context->rowScaling != PETSC_NULL)
+  {
+    ierr = VecPointwiseMult(y, y, context->rowScaling); CHKERRQ(ierr);
+  }
+
+  if (context->shift != 0.0)
+  {
+    ierr = VecAXPY(y, context->shift, x); CHKERRQ(ierr);
+  }
+  return 0;
+}
+
+//! MatGetDiagonal for the view, needed e.g. for jacobi preconditioners if the nested matrix is used directly
+PetscErrorCode getDiagonal(Mat view, Vec diagonal)
+{
+  ScaledMatViewContext *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(view, &context); CHKERRQ(ierr);
+
+  ierr = MatGetDiagonal(context->baseMatrices[0], diagonal); CHKERRQ(ierr);
+  ierr = VecScale(diagonal, context->factors[0]); CHKERRQ(ierr);
+
+  for (int i = 1; i < context->baseMatrices.size(); i++)
+  {
+    if (context->temporary == PETSC_NULL)
+    {
+      ierr = VecDuplicate(diagonal, &context->temporary); CHKERRQ(ierr);
+    }
+    ierr = MatGetDiagonal(context->baseMatrices[i], context->temporary); CHKERRQ(ierr);
+    ierr = VecAXPY(diagonal, context->factors[i], context->temporary); CHKERRQ(ierr);
+  }
+
+  if (context->rowScaling != PETSC_NULL)
+  {
+    ierr = VecPointwiseMult(diagonal, diagonal, context->rowScaling); CHKERRQ(ierr);
+  }
+
+  ierr = VecShift(diagonal, context->shift); CHKERRQ(ierr);
+  return 0;
+}
+
+//! MatGetRow for the view, only for locally owned rows, the column indices are global
+PetscErrorCode getRow(Mat view, PetscInt rowNoGlobal, PetscInt *nColumns, PetscInt **columnIndices, PetscScalar **values)
+{
+  ScaledMatViewContext *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(view, &context); CHKERRQ(ierr);
+
+  // get the scaling factor of this row
+  double rowFactor = 1.0;
+  if (context->rowScaling != PETSC_NULL)
+  {
+    PetscInt rowNoGlobalBegin = 0;
+    ierr = VecGetOwnershipRange(context->rowScaling, &rowNoGlobalBegin, NULL); CHKERRQ(ierr);
+
+    const PetscScalar *rowScalingValues;
+    ierr = VecGetArrayRead(context->rowScaling, &rowScalingValues); CHKERRQ(ierr);
+    rowFactor = rowScalingValues[rowNoGlobal - rowNoGlobalBegin];
+    ierr = VecRestoreArrayRead(context->rowScaling, &rowScalingValues); CHKERRQ(ierr);
+  }
+
+  context->rowColumnIndices.clear();
+  context->rowValues.clear();
+
+  if (context->baseMatrices.size() == 1)
+  {
+    // only one base matrix, directly copy the scaled row
+    PetscInt nEntries;
+    const PetscInt *baseColumnIndices;
+    const PetscScalar *baseValues;
+    ierr = MatGetRow(context->baseMatrices[0], rowNoGlobal, &nEntries, &baseColumnIndices, &baseValues); CHKERRQ(ierr);
+
+    context->rowColumnIndices.assign(baseColumnIndices, baseColumnIndices + nEntries);
+    context->rowValues.resize(nEntries);
+    for (PetscInt i = 0; i < nEntries; i++)
+    {
+      context->rowValues[i] = rowFactor * context->factors[0] * baseValues[i];
+    }
+    ierr = MatRestoreRow(context->baseMatrices[0], rowNoGlobal, &nEntries, &baseColumnIndices, &baseValues); CHKERRQ(ierr);
+  }
+  else
+  {
+    // merge the rows of all base matrices, the column indices are not necessarily the same
+    std::map<PetscInt,PetscScalar> mergedRow;
+    for (int matrixNo = 0; matrixNo < context->baseMatrices.size(); matrixNo++)
+    {
+      PetscInt nEntries;
+      const PetscInt *baseColumnIndices;
+      const PetscScalar *baseValues;
+      ierr = MatGetRow(context->baseMatrices[matrixNo], rowNoGlobal, &nEntries, &baseColumnIndices, &baseValues); CHKERRQ(ierr);
+
+      for (PetscInt i = 0; i < nEntries; i++)
+      {
+        mergedRow[baseColumnIndices[i]] += rowFactor * context->factors[matrixNo] * baseValues[i];
+      }
+      ierr = MatRestoreRow(context->baseMatrices[matrixNo], rowNoGlobal, &nEntries, &baseColumnIndices, &baseValues); CHKERRQ(ierr);
+    }
+
+    for (const std::pair<const PetscInt,PetscScalar> &entry : mergedRow)
+    {
+      context->rowColumnIndices.push_back(entry.first);
+      context->rowValues.push_back(entry.second);
+    }
+  }
+
+  // add shift on the diagonal entry, insert the entry if it is not yet present
+  if (context->shift != 0.0)
+  {
+    std::vector<PetscInt>::iterator iter = std::lower_bound(context->rowColumnIndices.begin(), context->rowColumnIndices.end(), rowNoGlobal);
+    int index = iter - context->rowColumnIndices.begin();
+
+    if (iter != context->rowColumnIndices.end() && *iter == rowNoGlobal)
+    {
+      context->rowValues[index] += context->shift;
+    }
+    else
+    {
+      context->rowColumnIndices.insert(iter, rowNoGlobal);
+      context->rowValues.insert(context->rowValues.begin() + index, context->shift);
+    }
+  }
+
+  if (nColumns)
+    *nColumns = context->rowColumnIndices.size();
+  if (columnIndices)
+    *columnIndices = context->rowColumnIndices.data();
+  if (values)
+    *values = context->rowValues.data();
+  return 0;
+}
+
+//! MatRestoreRow for the view, the buffers are owned by the context, nothing to do
+PetscErrorCode restoreRow(Mat view, PetscInt rowNoGlobal, PetscInt *nColumns, PetscInt **columnIndices, PetscScalar **values)
+{
+  if (nColumns)
+    *nColumns = 0;
+  if (columnIndices)
+    *columnIndices = NULL;
+  if (values)
+    *values = NULL;
+  return 0;
+}
+
+//! MatDestroy for the view, release the references to the base matrices
+PetscErrorCode destroy(Mat view)
+{
+  ScaledMatViewContext *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(view, &context); CHKERRQ(ierr);
+
+  for (Mat &baseMatrix : context->baseMatrices)
+  {
+    ierr = MatDestroy(&baseMatrix); CHKERRQ(ierr);
+  }
+  if (context->rowScaling != PETSC_NULL)
+  {
+    ierr = VecDestroy(&context->rowScaling); CHKERRQ(ierr);
+  }
+  if (context->temporary != PETSC_NULL)
+  {
+    ierr = VecDestroy(&context->temporary); CHKERRQ(ierr);
+  }
+
+  delete context;
+  return 0;
+}
+
+}  // anonymous namespace
+
+void createScaledMatView(const std::vector<Mat> &baseMatrices, const std::vector<double> &factors, Vec rowScaling, double shift, std::string name, Mat &view)
+{
+  assert(!baseMatrices.empty());
+  assert(baseMatrices.size() == factors.size());
+
+  PetscErrorCode ierr;
+
+  ScaledMatViewContext *context = new ScaledMatViewContext();
+  context->baseMatrices = baseMatrices;
+  context->factors = factors;
+  context->rowScaling = rowScaling;
+  context->shift = shift;
+  context->temporary = PETSC_NULL;
+
+  // increase the reference counters, such that the base matrices stay alive as long as the view exists
+  for (Mat baseMatrix : baseMatrices)
+  {
+    ierr = PetscObjectReference((PetscObject)baseMatrix); CHKERRV(ierr);
+  }
+  if (rowScaling != PETSC_NULL)
+  {
+    ierr = PetscObjectReference((PetscObject)rowScaling); CHKERRV(ierr);
+  }
+
+  // create the shell matrix with the same layout as the first base matrix
+  MPI_Comm mpiCommunicator;
+  ierr = PetscObjectGetComm((PetscObject)baseMatrices[0], &mpiCommunicator); CHKERRV(ierr);
+
+  PetscInt nRowsLocal, nColumnsLocal, nRowsGlobal, nColumnsGlobal;
+  ierr = MatGetLocalSize(baseMatrices[0], &nRowsLocal, &nColumnsLocal); CHKERRV(ierr);
+  ierr = MatGetSize(baseMatrices[0], &nRowsGlobal, &nColumnsGlobal); CHKERRV(ierr);
+
+  ierr = MatCreateShell(mpiCommunicator, nRowsLocal, nColumnsLocal, nRowsGlobal, nColumnsGlobal, context, &view); CHKERRV(ierr);
+  ierr = MatShellSetOperation(view, MATOP_MULT, (void(*)(void))mult); CHKERRV(ierr);
+  ierr = MatShellSetOperation(view, MATOP_GET_DIAGONAL, (void(*)(void))getDiagonal); CHKERRV(ierr);
+  ierr = MatShellSetOperation(view, MATOP_GET_ROW, (void(*)(void))getRow); CHKERRV(ierr);
+  ierr = MatShellSetOperation(view, MATOP_RESTORE_ROW, (void(*)(void))restoreRow); CHKERRV(ierr);
+  ierr = MatShellSetOperation(view, MATOP_DESTROY, (void(*)(void))destroy); CHKERRV(ierr);
+
+  ierr = PetscObjectSetName((PetscObject)view, name.c_str()); CHKERRV(ierr);
+
+  VLOG(1) << "created scaled matrix view \"" << name << "\" (" << nRowsGlobal << "x" << nColumnsGlobal << ") of " << baseMatrices.size()
+    << " base matrices, factors: " << factors << ", shift: " << shift << ", row scaling: " << (rowScaling != PETSC_NULL);
+}
+
+bool isScaledMatView(Mat matrix)
+{
+  if (matrix == PETSC_NULL)
+    return false;
+
+  PetscBool isShell = PETSC_FALSE;
+  PetscObjectTypeCompare((PetscObject)matrix, MATSHELL, &isShell);
+  if (!isShell)
+    return false;
+
+  // compare the MatMult routine to identify shell matrices that were created by createScaledMatView
+  void (*multRoutine)(void) = NULL;
+  MatShellGetOperation(matrix, MATOP_MULT, &multRoutine);
+  return multRoutine == (void(*)(void))mult;
+}
+
+void destroyIfScaledMatView(Mat &matrix)
+{
+  if (isScaledMatView(matrix))
+  {
+    PetscErrorCode ierr;
+    ierr = MatDestroy(&matrix); CHKERRV(ierr);
+  }
+  matrix = PETSC_NULL;
+}
+
+}  // namespace ScaledMatView
+
+}  // namespace
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <petsc.h>
+#include <vector>
+#include <string>
+
+namespace TimeSteppingScheme
+{
+
+/** Lightweight views on existing Petsc matrices, used for the submatrices of the multidomain system matrix.
+ *  A view represents the matrix  diag(rowScaling) * (Σ_i factor_i * baseMatrix_i) + shift * I
+ *  without copying any entries of the base matrices. This way, all compartments can share one stiffness matrix
+ *  and only store their scalar prefactors. The view is a Petsc MATSHELL that implements MatMult, MatGetDiagonal and MatGetRow,
+ *  the latter is needed by NestedMatVecUtility::createMatFromNestedMat to assemble the single system matrix.
+ *  All base matrices have to have the same parallel layout and, if there is more than one, their rows are merged.
+ */
+namespace ScaledMatView
+{
+
+//! create a new view matrix with the given base matrices and scalar factors (baseMatrices.size() == factors.size()), rowScaling may be PETSC_NULL, the name is set as Petsc object name
+void createScaledMatView(const std::vector<Mat> &baseMatrices, const std::vector<double> &factors, Vec rowScaling, double shift, std::string name, Mat &view);
+
+//! check if the given matrix is a view that was created by createScaledMatView
+bool isScaledMatView(Mat matrix);
+
+//! destroy the given matrix if it is a view, do nothing for other matrices which are owned by somebody else, set matrix to NULL in both cases
+void destroyIfScaledMatView(Mat &matrix);
+
+}  // namespace ScaledMatView
+
+}  // namespace
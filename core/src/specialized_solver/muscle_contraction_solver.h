@@ -2,6 +2,8 @@
 
 #include <Python.h>  // has to be the first included header
 
+#include <functional>
+
 #include "interfaces/runnable.h"
 #include "time_stepping_scheme/00_time_stepping_scheme.h"
 #include "data_management/specialized_solver/muscle_contraction_solver.h"
@@ -57,8 +59,11 @@ public:
   //! get a reference to the DynamicHyperelasticitySolverType
   std::shared_ptr<DynamicHyperelasticitySolverType> dynamicHyperelasticitySolver();
 
+  //! get a reference to the StaticHyperelasticitySolverType, this is only set if "dynamic" is False
+  std::shared_ptr<StaticHyperelasticitySolverType> staticHyperelasticitySolver();
+
   //! Get the data that will be transferred in the operator splitting or coupling to the other term of the splitting/coupling.
-  //! the transfer is done by the slot_connector_data_transfer class
+  //! the transfer is done by the slot_connector_data_transfer class, deferred stress fields are computed before, because the material traction is transferred
   std::shared_ptr<SlotConnectorDataType> getSlotConnectorData();
 
 protected:
@@ -69,12 +74,41 @@ protected:
   //! compute λ and λ_dot for data transfer
   void computeLambda();
 
+  //! compute the stress fields of the hyperelasticity solver if their computation was deferred, before they are written by an output writer
+  void computeDeferredStressFields();
+
+  //! get nVcComponents consecutive entries of values starting at dofNoBegin as vectorized value, entries after the end of values repeat the last value
+  static double_v_t loadValues(const std::vector<double> &values, dof_no_t dofNoBegin);
+
+  //! set nVcComponents consecutive entries of values starting at dofNoBegin from a vectorized value, entries after the end of values are discarded
+  static void storeValues(const double_v_t &value, dof_no_t dofNoBegin, std::vector<double> &values);
+
   //! update the geometry at the given meshes, map the own geometry field to the meshes
   void mapGeometryToGivenMeshes();
 
   //! create the mappings for the geometry field mapping between meshes
   void initializeMappingBetweenMeshes();
 
+  //! add the local dofs of the given mesh to batchedGeometryMapping_, this uses the mapping from the given mesh to the own mesh which has to exist
+  template<typename TargetFunctionSpaceType>
+  void addToBatchedGeometryMapping(std::shared_ptr<TargetFunctionSpaceType> functionSpaceTarget);
+
+  //! update the geometry of all meshes in meshNamesOfGeometryToMapTo_ at once with batchedGeometryMapping_, nothing is done if the own geometry did not change
+  void mapGeometryBatched();
+
+  /** The interpolation of the own geometry field to the local dofs of all meshes in meshNamesOfGeometryToMapTo_, precomputed from the mappings between meshes.
+   *  Every target dof is interpolated from the dofs of one element of the own mesh. The entries of all target meshes are stored consecutively.
+   */
+  struct BatchedGeometryMapping
+  {
+    bool isInitialized = false;                             //< if the entries of all target meshes were added
+    std::vector<dof_no_t> sourceDofNosLocal;                //< [targetDofIndex*nDofsPerElement + i] the local dof nos (including ghosts) of the own element that contains the target dof
+    std::vector<double> scalingFactors;                     //< [targetDofIndex*nDofsPerElement + i] the interpolation factors, i.e. the basis functions of the own element evaluated at the target dof
+    std::vector<std::vector<dof_no_t>> targetDofNosLocal;   //< [targetMeshNo][i] the local dof nos of the target mesh that get a value
+    std::vector<std::function<void(const std::vector<dof_no_t> &, const std::vector<Vec3> &)>> setTargetGeometry;   //< [targetMeshNo] sets the given values in the geometry field of the target mesh
+    int sourceGeometryVersion = -1;                         //< the values version of the own geometry field at the last update, used to skip the update if the geometry did not change
+  };
+
   std::shared_ptr<DynamicHyperelasticitySolverType> dynamicHyperelasticitySolver_;   //< the dynamic hyperelasticity solver that solves for the dynamic contraction
   std::shared_ptr<StaticHyperelasticitySolverType> staticHyperelasticitySolver_;     //< the static hyperelasticity solver that can be used for quasi-static solution
 
@@ -86,6 +120,8 @@ protected:
   bool enableForceLengthRelation_;              //< if the force-length relation factor f_l(λ_f) should be multiplied
   double lambdaDotScalingFactor_;               //< scaling factor for the computation of lambdaDot
   std::vector<std::string> meshNamesOfGeometryToMapTo_;   //< a list of mesh names which will get updated with the geometry
+  bool useBatchedGeometryMapping_;              //< if the geometry is mapped with the precomputed batchedGeometryMapping_ instead of separately by the mapping between meshes for every mesh
+  BatchedGeometryMapping batchedGeometryMapping_;   //< the precomputed interpolation of the geometry to all meshes in meshNamesOfGeometryToMapTo_
 
   bool initialized_;                            //< if initialize was already called
 };
@@ -39,6 +39,7 @@ MuscleContractionSolver(DihuContext context) :
   lambdaDotScalingFactor_ = this->specificSettings_.getOptionDouble("lambdaDotScalingFactor", 1.0);
 
   this->specificSettings_.template getOptionVector<std::string>("mapGeometryToMeshes", meshNamesOfGeometryToMapTo_);
+  useBatchedGeometryMapping_ = this->specificSettings_.getOptionBool("batchedGeometryMapping", true);
 }
 
 template<typename MeshType,typename Term,bool withLargeOutputFiles>
@@ -107,7 +108,12 @@ advanceTimeSpan(bool withOutputWritersEnabled)
 
     // write current output values using the output writers
     if (withOutputWritersEnabled)
+    {
+      if (this->outputWriterManager_.willWriteOutput())
+        computeDeferredStressFields();
+
       this->outputWriterManager_.writeOutput(this->data_, timeStepNo, currentTime);
+    }
 
     // start duration measurement
     if (this->durationLogKey_ != "")
@@ -224,6 +230,9 @@ run()
   initialize();
 
   advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename MeshType,typename Term,bool withLargeOutputFiles>
@@ -254,6 +263,9 @@ callOutputWriter(int timeStepNo, double currentTime, int callCountIncrement)
   }
 
   // write output of own output writers
+  if (this->outputWriterManager_.willWriteOutput(callCountIncrement))
+    computeDeferredStressFields();
+
   this->outputWriterManager_.writeOutput(this->data_, timeStepNo, currentTime, callCountIncrement);
 }
 
@@ -262,7 +274,7 @@ void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
 initializeMappingBetweenMeshes()
 {
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_+std::string("_map_geometry"));
+    Control::PerformanceMeasurement::start(this->durationLogKey_+std::string("_map_geometry"));
 
   LOG(INFO) << "initializeMappingBetweenMeshes, meshNamesOfGeometryToMapTo_=" << meshNamesOfGeometryToMapTo_;
 
@@ -270,6 +282,9 @@ initializeMappingBetweenMeshes()
   {
     bool reverseMappingOrder = this->specificSettings_.getOptionBool("reverseMappingOrder", true);
 
+    // the batched geometry mapping is created from the mappings of the target meshes to the own mesh, i.e. it needs the reverse mapping order
+    bool initializeBatchedGeometryMapping = useBatchedGeometryMapping_ && reverseMappingOrder && !batchedGeometryMapping_.isInitialized;
+
     using SourceFunctionSpaceType = typename StaticHyperelasticitySolverType::DisplacementsFunctionSpace;
     //using SourceFieldVariableType = FieldVariable::FieldVariable<SourceFunctionSpaceType,3>;
 
@@ -296,7 +311,12 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
+        {
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType1,SourceFunctionSpaceType>(functionSpaceTarget,functionSpaceSource);
+
+          if (initializeBatchedGeometryMapping)
+            addToBatchedGeometryMapping<TargetFunctionSpaceType1>(functionSpaceTarget);
+        }
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType1>(functionSpaceSource, functionSpaceTarget);
       }
@@ -316,7 +336,12 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
+        {
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType2,SourceFunctionSpaceType>(functionSpaceTarget,functionSpaceSource);
+
+          if (initializeBatchedGeometryMapping)
+            addToBatchedGeometryMapping<TargetFunctionSpaceType2>(functionSpaceTarget);
+        }
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType2>(functionSpaceSource, functionSpaceTarget);
 
@@ -337,7 +362,12 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
+        {
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType3,SourceFunctionSpaceType>(functionSpaceTarget, functionSpaceSource);
+
+          if (initializeBatchedGeometryMapping)
+            addToBatchedGeometryMapping<TargetFunctionSpaceType3>(functionSpaceTarget);
+        }
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType3>(functionSpaceSource, functionSpaceTarget);
       }
@@ -357,27 +387,141 @@ initializeMappingBetweenMeshes()
 
         // create mapping between functionSpaceSource and functionSpaceTarget
         if (reverseMappingOrder)
+        {
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType4,SourceFunctionSpaceType>(functionSpaceTarget, functionSpaceSource);
+
+          if (initializeBatchedGeometryMapping)
+            addToBatchedGeometryMapping<TargetFunctionSpaceType4>(functionSpaceTarget);
+        }
         else
           DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<SourceFunctionSpaceType,TargetFunctionSpaceType4>(functionSpaceSource, functionSpaceTarget);
       }
       else LOG(DEBUG) << "no";
     }
+
+    if (initializeBatchedGeometryMapping)
+    {
+      batchedGeometryMapping_.isInitialized = true;
+      LOG(DEBUG) << "batched geometry mapping to " << batchedGeometryMapping_.targetDofNosLocal.size() << " meshes created";
+    }
   }
 
   if (this->durationLogKey_ != "")
     Control::PerformanceMeasurement::stop(this->durationLogKey_+std::string("_map_geometry"));
 }
 
+template<typename MeshType,typename Term,bool withLargeOutputFiles>
+template<typename TargetFunctionSpaceType>
+void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
+addToBatchedGeometryMapping(std::shared_ptr<TargetFunctionSpaceType> functionSpaceTarget)
+{
+  using SourceFunctionSpaceType = typename StaticHyperelasticitySolverType::DisplacementsFunctionSpace;
+  const int nDofsPerSourceElement = SourceFunctionSpaceType::nDofsPerElement();
+
+  std::shared_ptr<SourceFunctionSpaceType> functionSpaceSource = data_.functionSpace();
+
+  // get the existing mapping from the target mesh to the own mesh, it contains for every target dof the element of the own mesh and the interpolation factors
+  std::shared_ptr<MappingBetweenMeshes::MappingBetweenMeshes<TargetFunctionSpaceType,SourceFunctionSpaceType>> mapping
+    = DihuContext::mappingBetweenMeshesManager()->template mappingBetweenMeshes<TargetFunctionSpaceType,SourceFunctionSpaceType>(functionSpaceTarget, functionSpaceSource);
+
+  const auto &targetMappingInfo = mapping->targetMappingInfo();
+  const dof_no_t nDofsLocalTarget = functionSpaceTarget->nDofsLocalWithoutGhosts();
+
+  std::vector<dof_no_t> targetDofNosLocal;
+  for (dof_no_t targetDofNoLocal = 0; targetDofNoLocal < nDofsLocalTarget; targetDofNoLocal++)
+  {
+    // skip dofs that are outside of the own mesh, like in MappingBetweenMeshesImplementation::mapHighToLowDimension
+    if (!targetMappingInfo[targetDofNoLocal].mapThisDof)
+      continue;
+
+    // the first set of surrounding nodes (targetElements[0]) is enough
+    const auto &sourceElement = targetMappingInfo[targetDofNoLocal].targetElements[0];
+    std::array<dof_no_t,nDofsPerSourceElement> sourceDofNosLocal = functionSpaceSource->getElementDofNosLocal(sourceElement.elementNoLocal);
+
+    for (int i = 0; i < nDofsPerSourceElement; i++)
+    {
+      batchedGeometryMapping_.sourceDofNosLocal.push_back(sourceDofNosLocal[i]);
+      batchedGeometryMapping_.scalingFactors.push_back(sourceElement.scalingFactors[i]);
+    }
+    targetDofNosLocal.push_back(targetDofNoLocal);
+  }
+
+  batchedGeometryMapping_.targetDofNosLocal.push_back(targetDofNosLocal);
+
+  // set the values directly in the geometry field of the function space, such that its values version is increased
+  batchedGeometryMapping_.setTargetGeometry.push_back([functionSpaceTarget](const std::vector<dof_no_t> &dofNosLocal, const std::vector<Vec3> &values)
+  {
+    functionSpaceTarget->geometryField().setValues(dofNosLocal, values, INSERT_VALUES);
+  });
+
+  LOG(DEBUG) << "added mesh \"" << functionSpaceTarget->meshName() << "\" with " << targetDofNosLocal.size() << " of " << nDofsLocalTarget
+    << " local dofs to the batched geometry mapping";
+}
+
+template<typename MeshType,typename Term,bool withLargeOutputFiles>
+void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
+mapGeometryBatched()
+{
+  using SourceFunctionSpaceType = typename StaticHyperelasticitySolverType::DisplacementsFunctionSpace;
+  const int nDofsPerSourceElement = SourceFunctionSpaceType::nDofsPerElement();
+
+  auto &geometryFieldSource = data_.functionSpace()->geometryField();
+
+  // if the own geometry did not change since the last update, the target geometry fields keep their values and values versions,
+  // then the output writers and the element lengths of the fibers do not need to be recomputed
+  if (geometryFieldSource.valuesVersion() == batchedGeometryMapping_.sourceGeometryVersion)
+  {
+    LOG(DEBUG) << "mapGeometryBatched: geometry unchanged, skip update";
+    return;
+  }
+
+  // get all local source values including ghosts at once
+  std::vector<Vec3> sourceValues;
+  geometryFieldSource.getValuesWithGhosts(sourceValues);
+
+  // interpolate the values for all target meshes in one pass
+  std::vector<Vec3> targetValues;
+  std::size_t rowNo = 0;
+  for (int targetMeshNo = 0; targetMeshNo < batchedGeometryMapping_.targetDofNosLocal.size(); targetMeshNo++)
+  {
+    const int nRows = batchedGeometryMapping_.targetDofNosLocal[targetMeshNo].size();
+    targetValues.resize(nRows);
+
+    for (int i = 0; i < nRows; i++, rowNo++)
+    {
+      Vec3 targetValue{0.0, 0.0, 0.0};
+      for (int j = 0; j < nDofsPerSourceElement; j++)
+      {
+        const std::size_t entryNo = rowNo*nDofsPerSourceElement + j;
+        const double scalingFactor = batchedGeometryMapping_.scalingFactors[entryNo];
+        const Vec3 &sourceValue = sourceValues[batchedGeometryMapping_.sourceDofNosLocal[entryNo]];
+
+        for (int componentNo = 0; componentNo < 3; componentNo++)
+          targetValue[componentNo] += scalingFactor * sourceValue[componentNo];
+      }
+      targetValues[i] = targetValue;
+    }
+
+    batchedGeometryMapping_.setTargetGeometry[targetMeshNo](batchedGeometryMapping_.targetDofNosLocal[targetMeshNo], targetValues);
+  }
+
+  batchedGeometryMapping_.sourceGeometryVersion = geometryFieldSource.valuesVersion();
+}
+
 template<typename MeshType,typename Term,bool withLargeOutputFiles>
 void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
 mapGeometryToGivenMeshes()
 {
   if (this->durationLogKey_ != "")
-    Control::PerformanceMeasurement::stop(this->durationLogKey_+std::string("_map_geometry"));
+    Control::PerformanceMeasurement::start(this->durationLogKey_+std::string("_map_geometry"));
 
   LOG(DEBUG) << "mapGeometryToGivenMeshes: meshNamesOfGeometryToMapTo: " << meshNamesOfGeometryToMapTo_;
-  if (!meshNamesOfGeometryToMapTo_.empty())
+  if (batchedGeometryMapping_.isInitialized)
+  {
+    // update the geometry of all meshes with the precomputed interpolation
+    mapGeometryBatched();
+  }
+  else if (!meshNamesOfGeometryToMapTo_.empty())
   {
     using SourceFunctionSpaceType = typename StaticHyperelasticitySolverType::DisplacementsFunctionSpace;
     using SourceFieldVariableType = FieldVariable::FieldVariable<SourceFunctionSpaceType,3>;
@@ -502,6 +646,14 @@ dynamicHyperelasticitySolver()
   return dynamicHyperelasticitySolver_;
 }
 
+//! get a reference to the StaticHyperelasticitySolverType
+template<typename MeshType,typename Term,bool withLargeOutputFiles>
+std::shared_ptr<typename MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::StaticHyperelasticitySolverType> MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
+staticHyperelasticitySolver()
+{
+  return staticHyperelasticitySolver_;
+}
+
 template<typename MeshType,typename Term,bool withLargeOutputFiles>
 typename MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::Data &MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
 data()
@@ -515,5 +667,10 @@ template<typename MeshType,typename Term,bool withLargeOutputFiles>
 std::shared_ptr<typename MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::SlotConnectorDataType> MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
 getSlotConnectorData()
 {
+  // the material traction is transferred, compute it if its computation after the last solve was deferred,
+  // it is not known here if the traction slot is connected, therefore this is done at every transfer and the deferral has no effect for a coupled solver
+  if (initialized_)
+    computeDeferredStressFields();
+
   return data_.getSlotConnectorData();
 }
@@ -40,31 +40,46 @@ computeLambda()
   std::shared_ptr<FieldVariableType> lambdaVariable = data_.lambda();
   std::shared_ptr<FieldVariableType> lambdaDotVariable = data_.lambdaDot();
 
-  // loop over local degrees of freedom
-  for (dof_no_t dofNoLocal = 0; dofNoLocal < data_.functionSpace()->nDofsLocalWithoutGhosts(); dofNoLocal++)
-  {
-    const Vec3 fiberDirection = fiberDirectionVariable->getValue(dofNoLocal);
-    //const Vec3 displacement = displacementsVariable->getValue(dofNoLocal);
-    const VecD<9> deformationGradientValues = deformationGradientVariable->getValue(dofNoLocal);
-    const VecD<9> fDotValues = fDotVariable->getValue(dofNoLocal);
+  const dof_no_t nDofsLocalWithoutGhosts = data_.functionSpace()->nDofsLocalWithoutGhosts();
+
+  // get all needed values at once, component-wise such that nVcComponents consecutive dofs can be loaded into a vectorized value
+  std::array<std::vector<double>,3> fiberDirectionValues;
+  std::array<std::vector<double>,9> deformationGradientValues;
+  std::array<std::vector<double>,9> fDotValues;
+  fiberDirectionVariable->getValuesWithoutGhosts(fiberDirectionValues);
+  deformationGradientVariable->getValuesWithoutGhosts(deformationGradientValues);
+  fDotVariable->getValuesWithoutGhosts(fDotValues);
 
-    // create matrix, deformationGradientValues are in row-major order
-    MathUtility::Matrix<3,3> deformationGradient(deformationGradientValues);
-    MathUtility::Matrix<3,3> fDot(fDotValues);
+  std::vector<double> lambdaValues(nDofsLocalWithoutGhosts);
+  std::vector<double> lambdaDotValues(nDofsLocalWithoutGhosts);
 
-    // fiberDirection is normalized
-    assert (MathUtility::norm<3>(fiberDirection) - 1.0 < 1e-10);
+  // loop over local degrees of freedom, always nVcComponents dofs at once
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal += nVcComponents)
+  {
+    // fiberDirection a0 is normalized
+    Vec3_v_t fiberDirection;
+    for (int i = 0; i < 3; i++)
+      fiberDirection[i] = loadValues(fiberDirectionValues[i], dofNoLocal);
 
     // get deformation gradient, project lambda and lambda dot
     // dx = F dX, dx^2 = C dX^2
     // λ = ||dx•a0||
-    // project displacements on normalized fiberDirection a0
-    //const double lambda = displacement[0] * fiberDirection[0] + displacement[1] * fiberDirection[1] + displacement[2] * fiberDirection[2];
 
-    // convert fiber direction from reference configuration into current configuration
-    Vec3 fiberDirectionCurrentConfiguration = deformationGradient * fiberDirection;   // F a0
-    // λ = ||F a0||
-    const double lambda = MathUtility::norm<3>(fiberDirectionCurrentConfiguration);   // stretch in current configuration
+    // convert fiber direction from reference configuration into current configuration, F a0, and compute Fdot a0
+    // deformationGradientValues and fDotValues are in row-major order
+    Vec3_v_t fiberDirectionCurrentConfiguration{};   // F a0
+    Vec3_v_t FdotA0{};                               // Fdot a0
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        fiberDirectionCurrentConfiguration[i] += loadValues(deformationGradientValues[i*3+j], dofNoLocal) * fiberDirection[j];
+        FdotA0[i] += loadValues(fDotValues[i*3+j], dofNoLocal) * fiberDirection[j];
+      }
+    }
+
+    // λ = ||F a0||, stretch in current configuration
+    const double_v_t lambda = MathUtility::norm<3>(fiberDirectionCurrentConfiguration);
 
     // exemplary derivative of λ for dim=2:
     //  λ = ||F a0|| = sqrt[(F11*a1 + F12*a2)^2 + (F21*a1 + F22*a2)^2]
@@ -74,15 +89,18 @@ computeLambda()
 
     // compute lambda dot
     // d/dt λ = d/dt ||F a0|| = (F a0) • (Fdot a0) / ||F a0||   (where Fdot = d/dt F)
-    // d/dt dx = d/dt F
-    // d/dt lambda = d/dt ||dx•a0|| = 1 / ||Fa|| (F a0 • Fdot a0) = 1/lambda (Fa • Fdot a0)
-    Vec3 FdotA0 = fDot * fiberDirection;
-    const double lambdaDot = 1 / lambda * MathUtility::dot(fiberDirectionCurrentConfiguration, FdotA0) * lambdaDotScalingFactor_;
+    double_v_t lambdaDot = 0;
+    for (int i = 0; i < 3; i++)
+      lambdaDot += fiberDirectionCurrentConfiguration[i] * FdotA0[i];
+    lambdaDot *= 1. / lambda * lambdaDotScalingFactor_;
 
-    lambdaVariable->setValue(dofNoLocal, lambda);
-    lambdaDotVariable->setValue(dofNoLocal, lambdaDot);
+    storeValues(lambda, dofNoLocal, lambdaValues);
+    storeValues(lambdaDot, dofNoLocal, lambdaDotValues);
   }
 
+  lambdaVariable->setValuesWithoutGhosts(lambdaValues);
+  lambdaDotVariable->setValuesWithoutGhosts(lambdaDotValues);
+
   lambdaVariable->zeroGhostBuffer();
   lambdaVariable->finishGhostManipulation();
   lambdaVariable->startGhostManipulation();
@@ -123,27 +141,43 @@ computeActiveStress()
 
   const double lambdaOpt = 1.2;
 
-  // loop over local degrees of freedom
-  for (dof_no_t dofNoLocal = 0; dofNoLocal < data_.functionSpace()->nDofsLocalWithoutGhosts(); dofNoLocal++)
+  const dof_no_t nDofsLocalWithoutGhosts = data_.functionSpace()->nDofsLocalWithoutGhosts();
+
+  // get all needed values at once, component-wise such that nVcComponents consecutive dofs can be loaded into a vectorized value
+  std::array<std::vector<double>,3> fiberDirectionValues;
+  std::vector<double> lambdaValues;
+  std::vector<double> gammaValues;
+  fiberDirectionVariable->getValuesWithoutGhosts(fiberDirectionValues);
+  lambdaVariable->getValuesWithoutGhosts(lambdaValues);
+  gammaVariable->getValuesWithoutGhosts(gammaValues);
+
+  std::array<std::vector<double>,6> activeStressValues;
+  for (int i = 0; i < 6; i++)
+    activeStressValues[i].resize(nDofsLocalWithoutGhosts);
+
+  // loop over local degrees of freedom, always nVcComponents dofs at once
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal += nVcComponents)
   {
-    const Vec3 fiberDirection = fiberDirectionVariable->getValue(dofNoLocal);
+    Vec3_v_t fiberDirection;
+    for (int i = 0; i < 3; i++)
+      fiberDirection[i] = loadValues(fiberDirectionValues[i], dofNoLocal);
 
-    const double lambda = lambdaVariable->getValue(dofNoLocal);
-    const double gamma = gammaVariable->getValue(dofNoLocal);
-    const double lambdaRelative = lambda / lambdaOpt;
+    const double_v_t lambda = loadValues(lambdaValues, dofNoLocal);
+    const double_v_t gamma = loadValues(gammaValues, dofNoLocal);
+    const double_v_t lambdaRelative = lambda / lambdaOpt;
 
     // compute f function
-    double f = 1.0;
+    double_v_t f = 1.0;
 
     if (enableForceLengthRelation_)
     {
-      if (0.6 <= lambdaRelative && lambdaRelative <= 1.4)
-      {
-        f = -25./4 * lambdaRelative*lambdaRelative + 25./2 * lambdaRelative - 5.25;
-      }
+      Vc::where(0.6 <= lambdaRelative && lambdaRelative <= 1.4, f) = -25./4 * lambdaRelative*lambdaRelative + 25./2 * lambdaRelative - 5.25;
     }
 
-    const double factor = 1./lambda * pmax_ * f * gamma;
+    double_v_t factor = 1./lambda * pmax_ * f * gamma;
+
+    // if lambda is not yet computed (before first computation), set active stress to zero
+    Vc::where(MathUtility::abs(lambda) < 1e-12, factor) = 0.0;
 
     // Voigt notation:
     // [0][0] -> [0];
@@ -156,28 +190,63 @@ computeActiveStress()
     // [0][2] -> [5];
     // [2][0] -> [5];
 
-    VecD<6> activeStress;
-    activeStress[0] = factor * fiberDirection[0] * fiberDirection[0];
-    activeStress[1] = factor * fiberDirection[1] * fiberDirection[1];
-    activeStress[2] = factor * fiberDirection[2] * fiberDirection[2];
-    activeStress[3] = factor * fiberDirection[0] * fiberDirection[1];
-    activeStress[4] = factor * fiberDirection[1] * fiberDirection[2];
-    activeStress[5] = factor * fiberDirection[0] * fiberDirection[2];
+    storeValues(factor * fiberDirection[0] * fiberDirection[0], dofNoLocal, activeStressValues[0]);
+    storeValues(factor * fiberDirection[1] * fiberDirection[1], dofNoLocal, activeStressValues[1]);
+    storeValues(factor * fiberDirection[2] * fiberDirection[2], dofNoLocal, activeStressValues[2]);
+    storeValues(factor * fiberDirection[0] * fiberDirection[1], dofNoLocal, activeStressValues[3]);
+    storeValues(factor * fiberDirection[1] * fiberDirection[2], dofNoLocal, activeStressValues[4]);
+    storeValues(factor * fiberDirection[0] * fiberDirection[2], dofNoLocal, activeStressValues[5]);
 
     LOG(DEBUG) << "dof " << dofNoLocal << ", lambda: " << lambda << ", lambdaRelative: " << lambdaRelative
       << ", pmax_: " << pmax_ << ", f: " << f << ", gamma: " << gamma << ", => factor: " << factor << ", fiberDirection: " << fiberDirection;
-
-    // if lambda is not yet computed (before first computation), set active stress to zero
-    if (fabs(lambda)  < 1e-12)
-    {
-      activeStress = VecD<6>{0.0};
-    }
-
-    LOG(DEBUG) << "set active stress to " << activeStress;
-    activePK2StressVariable->setValue(dofNoLocal, activeStress, INSERT_VALUES);
   }
 
+  for (int i = 0; i < 6; i++)
+    activePK2StressVariable->setValuesWithoutGhosts(i, activeStressValues[i]);
+
   activePK2StressVariable->zeroGhostBuffer();
   activePK2StressVariable->finishGhostManipulation();
   activePK2StressVariable->startGhostManipulation();
 }
+
+template<typename MeshType,typename Term,bool withLargeOutputFiles>
+double_v_t MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
+loadValues(const std::vector<double> &values, dof_no_t dofNoBegin)
+{
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+  const dof_no_t nValues = values.size();
+
+  // entries after the end of values repeat the last value, such that no division by zero occurs for them
+  return double_v_t([&values, dofNoBegin, nValues](int i)
+  {
+    return values[std::min(dofNoBegin+i, nValues-1)];
+  });
+#else
+  return values[dofNoBegin];
+#endif
+}
+
+template<typename MeshType,typename Term,bool withLargeOutputFiles>
+void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
+storeValues(const double_v_t &value, dof_no_t dofNoBegin, std::vector<double> &values)
+{
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+  const dof_no_t nValues = values.size();
+  for (int i = 0; i < nVcComponents && dofNoBegin+i < nValues; i++)
+  {
+    values[dofNoBegin+i] = value[i];
+  }
+#else
+  values[dofNoBegin] = value;
+#endif
+}
+
+template<typename MeshType,typename Term,bool withLargeOutputFiles>
+void MuscleContractionSolver<MeshType,Term,withLargeOutputFiles>::
+computeDeferredStressFields()
+{
+  if (isDynamic_)
+    dynamicHyperelasticitySolver_->hyperelasticitySolver().computeDeferredStressFields();
+  else
+    staticHyperelasticitySolver_->computeDeferredStressFields();
+}
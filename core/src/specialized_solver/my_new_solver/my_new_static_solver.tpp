@@ -100,6 +100,9 @@ run()
 
   // write current output values using the output writers
   this->outputWriterManager_.writeOutput(this->data_);
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename NestedSolver>
@@ -297,6 +297,9 @@ run()
   initialize();
 
   advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename FunctionSpaceType, int nComponents1, int nComponents2>
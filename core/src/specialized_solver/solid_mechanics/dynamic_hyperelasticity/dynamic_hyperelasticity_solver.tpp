@@ -6,6 +6,7 @@
 #include "partition/partitioned_petsc_vec/02_partitioned_petsc_vec_for_hyperelasticity.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
 #include "spatial_discretization/neumann_boundary_conditions/01_neumann_boundary_conditions.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace TimeSteppingScheme
 {
@@ -460,6 +461,9 @@ run()
   initialize();
 
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 //! call the output writer on the data object, output files will contain currentTime, with callCountIncrement !=1 output timesteps can be skipped
@@ -43,6 +43,9 @@ public:
   //! constructor
   HyperelasticityInitialize(DihuContext context, std::string settingsKey = "HyperelasticitySolver");
 
+  //! destructor, frees the PETSc objects that are not owned by a PartitionedPetscVec or PartitionedPetscMat
+  virtual ~HyperelasticityInitialize();
+
   //! initialize components of the simulation
   void initialize();
 
@@ -112,6 +115,9 @@ public:
   //! get the Petsc Vec of the current state (uvp vector), this is needed to save and restore checkpoints from the PreciceAdapter
   Vec currentState();
 
+  //! get the Petsc Mat of the assembled analytic jacobian, this is PETSC_NULL for the matrix-free jacobian with "block" or "jacobi" preconditioner
+  Mat jacobianMatrix();
+
   //! Get the data that will be transferred in the operator splitting or coupling to the other term of the splitting/coupling.
   //! the transfer is done by the slot_connector_data_transfer class
   std::shared_ptr<SlotConnectorDataType> getSlotConnectorData();
@@ -121,6 +127,9 @@ protected:
   //! initialize all Petsc Vec's and Mat's that will be used in the computation
   void initializePetscVariables();
 
+  //! destroy the temporary vectors that are created in initializePetscVariables, zeros_, lastSolution_, bestSolution_ and the load step solutions
+  void destroyTemporaryVectors();
+
   //! initialize the field variable which stores directions of fibers
   void initializeFiberDirections();
 
@@ -141,6 +150,9 @@ protected:
   //! compute δW_ext,dead = int_Ω B^L * phi^L * phi^M * δu^M dx + int_∂Ω T^L * phi^L * phi^M * δu^M dS
   virtual void materialComputeExternalVirtualWorkDead() = 0;
 
+  //! set all entries of the jacobian that can be nonzero to zero, this allocates the nonzero structure of the matrix
+  virtual void materialSetJacobianNonzeroStructure(std::shared_ptr<MatHyperelasticity> jacobianMatrix) = 0;
+
   DihuContext context_;                                     //< object that contains the python config for the current context and the global singletons meshManager and solverManager
 
   OutputWriter::Manager outputWriterManager_;               //< manager object holding all output writer for displacements based variables
@@ -156,17 +168,23 @@ protected:
 
   Mat solverMatrixJacobian_;                                //< the jacobian matrix for the Newton solver, which in case of nonlinear elasticity is the tangent stiffness matrix
   Mat solverMatrixAdditionalNumericJacobian_;               //< only used when both analytic and numeric jacobians are computed, then this holds the numeric jacobian
+  Mat solverMatrixMatrixFreeJacobian_;                      //< only used for useMatrixFreeJacobian_, a shell matrix that applies the jacobian element by element without assembling it
+  Mat solverMatrixMatrixFreePreconditioner_;                //< only used for useMatrixFreeJacobian_ with "block" preconditioner, a shell matrix whose diagonal is the block diagonal preconditioner
   Vec solverVariableResidual_;                              //< PETSc Vec to store the residual, equal to combinedVecResidual_->valuesGlobal()
   Vec solverVariableSolution_;                              //< PETSc Vec to store the solution, equal to combinedVecSolution_->valuesGlobal()
   Vec zeros_;                                               //< a solver that contains all zeros, needed to zero the diagonal of the jacobian matrix
   Vec lastSolution_;                                        //< a temporary variable to hold the previous solution in the nonlinear solver, to be used to reset the nonlinear scheme if it diverged
   Vec bestSolution_;                                        //< a temporary variable to hold the best solution so, the one with the lowest residual norm
+  Vec loadStepSolution_;                                    //< the solution of the last converged load step, only used for extrapolateLoadStepInitialGuess_
+  Vec previousLoadStepSolution_;                            //< the solution of the second last converged load step, only used for extrapolateLoadStepInitialGuess_
 
   std::shared_ptr<VecHyperelasticity> combinedVecResidual_; //< the Vec for the residual and result of the nonlinear function
   std::shared_ptr<VecHyperelasticity> combinedVecSolution_; //< the Vec for the solution, combined means that ux,uy,uz and p components are combined in one vector
   std::shared_ptr<VecHyperelasticity> combinedVecExternalVirtualWorkDead_;      //< the Vec for the external virtual work part that does not change with u, δW_ext,dead
   std::shared_ptr<MatHyperelasticity> combinedMatrixJacobian_;                  //< single jacobian matrix
   std::shared_ptr<MatHyperelasticity> combinedMatrixAdditionalNumericJacobian_; //< only used when both analytic and numeric jacobians are computed, then this holds the numeric jacobian
+  std::shared_ptr<VecHyperelasticity> matrixFreeInput_;     //< only used for useMatrixFreeJacobian_, the input vector of the matrix-free jacobian, to get the ghost values
+  std::shared_ptr<VecHyperelasticity> matrixFreeOutput_;    //< only used for useMatrixFreeJacobian_, the output vector of the matrix-free jacobian, to add up the contributions to ghost dofs
 
   Vec externalVirtualWorkDead_;                             // the external virtual work resulting from the traction, this is a dead load, i.e. it does not change during deformation
 
@@ -201,8 +219,33 @@ protected:
 
   bool useAnalyticJacobian_;                                //< if the analytically computed Jacobian of the Newton scheme should be used. Theoretically if it is correct, this is the fastest option.
   bool useNumericJacobian_;                                 //< if a numerically computed Jacobian should be used, approximated by finite differences
+  bool useColoringForNumericJacobian_;                      //< if the numeric jacobian should be computed with a coloring of the nonzero structure given by the mesh, instead of perturbing every unknown separately
+  MatFDColoring numericJacobianColoring_;                   //< the coloring context that is used to compute the numeric jacobian, if useColoringForNumericJacobian_ is set
+  double rebuildLaggedJacobianThreshold_;                   //< if the residual norm decreases by less than this factor in one nonlinear iteration, the lagged jacobian and preconditioner are rebuilt in the next iteration, 0 means disabled
+  PetscInt jacobianLag_;                                    //< the configured lag of the jacobian in the SNES object, i.e., how often it is rebuilt, to restore it after a forced rebuild
+  PetscInt preconditionerLag_;                              //< the configured lag of the preconditioner in the SNES object, to restore it after a forced rebuild
+  bool jacobianRebuildRequested_;                           //< if a rebuild of the lagged jacobian was requested by the monitor function because the convergence degraded
+  int nJacobianComputations_;                               //< number of computations of the jacobian in the current nonlinear solve
+  int nJacobianComputationsTotal_;                          //< total number of computations of the jacobian in all nonlinear solves, to report how many were skipped by lagging
+  int nJacobianRequestsTotal_;                              //< total number of nonlinear iterations in all nonlinear solves, each of which would compute the jacobian without lagging
+  int nResidualEvaluationsTotal_;                           //< total number of evaluations of the nonlinear function, including the evaluations for the finite differences jacobian
+  int nReusedElementJacobiansTotal_;                        //< total number of element chunks whose jacobian contributions were reused because of jacobianReassemblyTolerance_
+  bool useMatrixFreeJacobian_;                              //< if the jacobian in the linear solver is applied element by element from the analytic element contributions, without assembling the jacobian matrix
+  std::string matrixFreePreconditionerType_;                //< for useMatrixFreeJacobian_, "block" if the preconditioner uses the diagonal of the jacobian and of the approximated Schur complement for the pressure, "jacobi" if it uses the diagonal of the jacobian, "assembled" if the assembled analytic jacobian is used as preconditioner matrix
+  bool cacheQuadraturePointValues_;                         //< if the quantities at the quadrature points of the last residual evaluation should be stored and reused by the analytic jacobian at the same state
+  double jacobianReassemblyTolerance_;                      //< elements whose displacements and pressure changed less than this tolerance since their last jacobian computation are not recomputed, 0 means all elements are always recomputed
   bool extrapolateInitialGuess_;                            //< if the initial values for the dynamic nonlinear problem should be computed by extrapolating the previous displacements and velocities
   bool scaleInitialGuess_;                                  //< when load stepping is used, scale initial guess between load steps a and b by sqrt(a*b)/a
+  bool extrapolateLoadStepInitialGuess_;                    //< when load stepping is used, compute the initial guess of the next load step by linear extrapolation of the solutions of the last two load steps
+  bool adaptiveLoadStepping_;                               //< if the load factors after the first one should be determined from the number of nonlinear iterations of the previous load step
+  int adaptiveLoadSteppingNIterations_;                     //< the desired number of nonlinear iterations per load step for adaptiveLoadStepping_
+  bool explicitTimeIntegration_;                            //< if the dynamic problem is advanced by the explicit central difference scheme with a lumped mass matrix instead of the implicit nonlinear solve, only for compressible materials
+  double explicitTimeStepSafetyFactor_;                     //< factor with which the estimated critical time step width of the explicit scheme is scaled
+  double explicitTimeStepWidth_;                            //< time step width of the explicit scheme, if 0 it is determined from the estimated critical time step width
+  std::array<std::vector<double>,3> lumpedMass_;            //< [componentNo][dofNoLocal] diagonal entries of the lumped mass matrix for the non-ghost displacements dofs, for the explicit scheme
+  std::array<std::vector<bool>,nDisplacementComponents> isDirichletDofLocal_;  //< [componentNo][dofNoLocal] if the non-ghost dof is prescribed by a Dirichlet boundary condition, for the explicit scheme
+  bool deferStressFieldComputation_;                        //< if the PK2 stress and traction fields are only computed when they are written by an output writer or needed for the bearing forces, after every solve only F and Fdot are computed
+  bool stressFieldsUpToDate_;                               //< if the PK2 stress and traction fields correspond to the current solution, false if their computation was deferred
 };
 
 }  // namespace
@@ -32,16 +32,63 @@ HyperelasticityInitialize(DihuContext context, std::string settingsKey) :
   // parse options concerning jacobian
   useAnalyticJacobian_  = this->specificSettings_.getOptionBool("useAnalyticJacobian", true);
   useNumericJacobian_   = this->specificSettings_.getOptionBool("useNumericJacobian", true);
+  useColoringForNumericJacobian_ = this->specificSettings_.getOptionBool("useColoringForNumericJacobian", true);
+  numericJacobianColoring_ = PETSC_NULL;
+  useMatrixFreeJacobian_ = this->specificSettings_.getOptionBool("useMatrixFreeJacobian", false);
+  matrixFreePreconditionerType_ = this->specificSettings_.getOptionString("matrixFreePreconditionerType", "block");
+  rebuildLaggedJacobianThreshold_ = this->specificSettings_.getOptionDouble("rebuildLaggedJacobianThreshold", 0.0, PythonUtility::NonNegative);
+  jacobianLag_ = 1;
+  preconditionerLag_ = 1;
+  jacobianRebuildRequested_ = false;
+  nJacobianComputations_ = 0;
+  nJacobianComputationsTotal_ = 0;
+  nJacobianRequestsTotal_ = 0;
+  nResidualEvaluationsTotal_ = 0;
+  nReusedElementJacobiansTotal_ = 0;
+  solverMatrixMatrixFreeJacobian_ = PETSC_NULL;
+  solverMatrixMatrixFreePreconditioner_ = PETSC_NULL;
+  zeros_ = PETSC_NULL;
+  lastSolution_ = PETSC_NULL;
+  bestSolution_ = PETSC_NULL;
+  loadStepSolution_ = PETSC_NULL;
+  previousLoadStepSolution_ = PETSC_NULL;
+  cacheQuadraturePointValues_ = this->specificSettings_.getOptionBool("cacheQuadraturePointValues", false);
+  jacobianReassemblyTolerance_ = this->specificSettings_.getOptionDouble("jacobianReassemblyTolerance", 0.0, PythonUtility::NonNegative);
   nNonlinearSolveCalls_ = this->specificSettings_.getOptionInt("nNonlinearSolveCalls", 1, PythonUtility::Positive);
   loadFactorGiveUpThreshold_ = this->specificSettings_.getOptionDouble("loadFactorGiveUpThreshold", 1e-5, PythonUtility::Positive);
+  deferStressFieldComputation_ = this->specificSettings_.getOptionBool("deferStressFieldComputation", false);
+  stressFieldsUpToDate_ = false;
 
   scaleInitialGuess_ = false;
   if (this->specificSettings_.hasKey("scaleInitialGuess"))
     scaleInitialGuess_ = this->specificSettings_.getOptionBool("scaleInitialGuess", false);
 
+  // parse options for load stepping
+  extrapolateLoadStepInitialGuess_ = this->specificSettings_.getOptionBool("extrapolateLoadStepInitialGuess", false);
+  adaptiveLoadStepping_ = this->specificSettings_.getOptionBool("adaptiveLoadStepping", false);
+  adaptiveLoadSteppingNIterations_ = this->specificSettings_.getOptionInt("adaptiveLoadSteppingNIterations", 5, PythonUtility::Positive);
+
   // parse constant body force, a value of "None" yields the default value, (0,0,0)
   constantBodyForce_ = this->specificSettings_.template getOptionArray<double,3>("constantBodyForce", Vec3{0.0,0.0,0.0});
 
+  // the matrix-free jacobian is applied with the element contributions of the analytic jacobian, a numeric jacobian cannot be used
+  if (useMatrixFreeJacobian_)
+  {
+    if (!useAnalyticJacobian_ || (this->specificSettings_.hasKey("useNumericJacobian") && useNumericJacobian_))
+    {
+      LOG(FATAL) << "The matrix-free jacobian (\"useMatrixFreeJacobian\": True) is computed from the analytic element contributions "
+        << "and needs \"useAnalyticJacobian\": True and \"useNumericJacobian\": False.";
+    }
+    useNumericJacobian_ = false;
+
+    if (matrixFreePreconditionerType_ != "block" && matrixFreePreconditionerType_ != "jacobi" && matrixFreePreconditionerType_ != "assembled")
+    {
+      LOG(ERROR) << "Unknown \"matrixFreePreconditionerType\": \"" << matrixFreePreconditionerType_ << "\", "
+        << "possible values are \"block\", \"jacobi\" and \"assembled\". Using \"block\".";
+      matrixFreePreconditionerType_ = "block";
+    }
+  }
+
   if (!useAnalyticJacobian_ && !useNumericJacobian_)
   {
     LOG(WARNING) << "Cannot set both \"useAnalyticJacobian\" and \"useNumericJacobian\" to False, now using numeric jacobian.";
@@ -67,6 +114,7 @@ HyperelasticityInitialize(DihuContext context, std::string settingsKey) :
   displacementsScalingFactor_ = specificSettings_.getOptionDouble("displacementsScalingFactor", 1.0);
   dumpDenseMatlabVariables_ = specificSettings_.getOptionBool("dumpDenseMatlabVariables", false);
   dampingFactor_ = 0;
+  explicitTimeIntegration_ = false;
 
   // for the dynamic equation
   if (nDisplacementComponents == 6)
@@ -77,6 +125,28 @@ HyperelasticityInitialize(DihuContext context, std::string settingsKey) :
 
     if (specificSettings_.hasKey("dampingFactor"))
       dampingFactor_         = specificSettings_.getOptionDouble("dampingFactor", 0.0, PythonUtility::NonNegative);
+
+    std::string timeIntegrationScheme = specificSettings_.getOptionString("timeIntegrationScheme", "implicit");
+    if (timeIntegrationScheme == "explicit")
+    {
+      if (Term::isIncompressible)
+      {
+        LOG(ERROR) << "The explicit time integration scheme (\"timeIntegrationScheme\": \"explicit\") is only possible for compressible materials, "
+          << "because the incompressibility constraint needs an implicit solve. Using the implicit scheme instead.";
+      }
+      else
+      {
+        explicitTimeIntegration_ = true;
+      }
+    }
+    else if (timeIntegrationScheme != "implicit")
+    {
+      LOG(ERROR) << "Option \"timeIntegrationScheme\" is \"" << timeIntegrationScheme << "\", allowed values are \"implicit\" and \"explicit\". "
+        << "Using the implicit scheme.";
+    }
+
+    explicitTimeStepSafetyFactor_ = specificSettings_.getOptionDouble("explicitTimeStepSafetyFactor", 0.8, PythonUtility::Positive);
+    explicitTimeStepWidth_        = specificSettings_.getOptionDouble("explicitTimeStepWidth", 0.0, PythonUtility::NonNegative);
   }
 
   // initialize output writers
@@ -85,6 +155,51 @@ HyperelasticityInitialize(DihuContext context, std::string settingsKey) :
   this->outputWriterManagerLoadIncrements_.initialize(this->context_["LoadIncrements"], this->context_["LoadIncrements"].getPythonConfig());
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+~HyperelasticityInitialize()
+{
+  // do not call PETSc functions if PETSc was already finalized
+  PetscBool isFinalized = PETSC_FALSE;
+  PetscFinalized(&isFinalized);
+  if (isFinalized)
+    return;
+
+  // free the coloring context of the numeric jacobian
+  PetscErrorCode ierr;
+  if (numericJacobianColoring_ != PETSC_NULL)
+  {
+    ierr = MatFDColoringDestroy(&numericJacobianColoring_); CHKERRV(ierr);
+  }
+
+  // free the shell matrices of the matrix-free jacobian
+  if (solverMatrixMatrixFreeJacobian_ != PETSC_NULL)
+  {
+    ierr = MatDestroy(&solverMatrixMatrixFreeJacobian_); CHKERRV(ierr);
+  }
+  if (solverMatrixMatrixFreePreconditioner_ != PETSC_NULL)
+  {
+    ierr = MatDestroy(&solverMatrixMatrixFreePreconditioner_); CHKERRV(ierr);
+  }
+
+  // free the temporary vectors of the nonlinear solver
+  destroyTemporaryVectors();
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+destroyTemporaryVectors()
+{
+  for (Vec *vector : {&zeros_, &lastSolution_, &bestSolution_, &loadStepSolution_, &previousLoadStepSolution_})
+  {
+    if (*vector != PETSC_NULL)
+    {
+      PetscErrorCode ierr;
+      ierr = VecDestroy(vector); CHKERRV(ierr);
+    }
+  }
+}
+
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 initialize()
@@ -520,7 +635,21 @@ initializePetscVariables()
   // create matrix with same dof mapping as vectors
   //std::shared_ptr<::FunctionSpace::Generic> genericFunctionSpace = context_.meshManager()->createGenericFunctionSpace(nMatrixRowsLocal, displacementsFunctionSpace_->meshPartition(), "genericMesh");
 
-  combinedMatrixJacobian_ = createPartitionedPetscMat("combinedJacobian");
+  // for the matrix-free jacobian with block or jacobi preconditioner, the jacobian matrix is not needed, it is applied element by element
+  combinedMatrixJacobian_ = nullptr;
+  solverMatrixJacobian_ = PETSC_NULL;
+  if (!useMatrixFreeJacobian_ || matrixFreePreconditionerType_ == "assembled")
+  {
+    combinedMatrixJacobian_ = createPartitionedPetscMat("combinedJacobian");
+    solverMatrixJacobian_ = combinedMatrixJacobian_->valuesGlobal();
+  }
+
+  // create the vectors that are needed for the ghost values in the matrix-free jacobian
+  if (useMatrixFreeJacobian_)
+  {
+    matrixFreeInput_ = createPartitionedPetscVec("matrixFreeInput");
+    matrixFreeOutput_ = createPartitionedPetscVec("matrixFreeOutput");
+  }
 
   solverMatrixAdditionalNumericJacobian_ = PETSC_NULL;
 
@@ -534,11 +663,13 @@ initializePetscVariables()
 
   // extract the Petsc Vec's of the PartitionedPetscVecForHyperelasticity objects
   LOG(DEBUG) << "get the internal vectors";
-  solverMatrixJacobian_ = combinedMatrixJacobian_->valuesGlobal();
   solverVariableSolution_ = combinedVecSolution_->valuesGlobal();
   solverVariableResidual_ = combinedVecResidual_->valuesGlobal();
   externalVirtualWorkDead_ = combinedVecExternalVirtualWorkDead_->valuesGlobal();
 
+  // destroy the vectors of a previous initialization, e.g. before the Dirichlet boundary conditions are updated
+  destroyTemporaryVectors();
+
   // create vector with all zeros in it, this is needed for zeroing the diagonal of the stiffness matrix for initialization in evaluateAnalyticJacobian
   PetscErrorCode ierr;
   ierr = VecDuplicate(solverVariableResidual_, &zeros_); CHKERRV(ierr);
@@ -546,6 +677,13 @@ initializePetscVariables()
   ierr = VecDuplicate(solverVariableResidual_, &lastSolution_); CHKERRV(ierr);
   ierr = VecDuplicate(solverVariableResidual_, &bestSolution_); CHKERRV(ierr);
 
+  // create vectors for the solutions of the last two load steps, needed for the extrapolation of the initial guess
+  if (extrapolateLoadStepInitialGuess_)
+  {
+    ierr = VecDuplicate(solverVariableResidual_, &loadStepSolution_); CHKERRV(ierr);
+    ierr = VecDuplicate(solverVariableResidual_, &previousLoadStepSolution_); CHKERRV(ierr);
+  }
+
   LOG(DEBUG) << "for debugging: " << combinedVecSolution_->getString();
 
   // compute the external virtual work, because it is constant throughout the solution process
@@ -563,22 +701,25 @@ initializePetscVariables()
   // depending on if also the analytic jacobian will be computed, the storage for the numeric jacobian is either combinedMatrixJacobian_ or combinedMatrixAdditionalNumericJacobian_
   if (useNumericJacobian_)
   {
+    std::shared_ptr<MatHyperelasticity> numericJacobian = combinedMatrixJacobian_;
     if (useAnalyticJacobian_)
-    {
-      // assemble matrix, new nonzeros are allocated later
-      combinedMatrixAdditionalNumericJacobian_->assembly(MAT_FINAL_ASSEMBLY);
-    }
-    else
-    {
-      // assemble matrix, new nonzeros are allocated later
-      combinedMatrixJacobian_->assembly(MAT_FINAL_ASSEMBLY);
-    }
+      numericJacobian = combinedMatrixAdditionalNumericJacobian_;
+
+    // for the computation with coloring, the nonzero structure has to be known beforehand, it is given by the element connectivity
+    if (useColoringForNumericJacobian_)
+      materialSetJacobianNonzeroStructure(numericJacobian);
+
+    // assemble matrix, without coloring new nonzeros are allocated later
+    numericJacobian->assembly(MAT_FINAL_ASSEMBLY);
   }
 
   if (useAnalyticJacobian_)
   {
     // jacobian matrix is already preallocated, but there might be even more entries required
-    ierr = MatSetOption(solverMatrixJacobian_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE); CHKERRV(ierr);
+    if (solverMatrixJacobian_ != PETSC_NULL)
+    {
+      ierr = MatSetOption(solverMatrixJacobian_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE); CHKERRV(ierr);
+    }
 
     // assemble matrix and nonzeros structure
     evaluateAnalyticJacobian(solverVariableSolution_, solverMatrixJacobian_);
@@ -862,7 +1003,8 @@ template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementC
 void HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 dumpJacobianMatrix(Mat jac)
 {
-  if (!dumpDenseMatlabVariables_)
+  // the jacobian matrix is not assembled for the matrix-free jacobian
+  if (!dumpDenseMatlabVariables_ || jac == PETSC_NULL || jac == solverMatrixMatrixFreeJacobian_ || jac == solverMatrixMatrixFreePreconditioner_)
     return;
 
   static int evaluationNo = 0;  // counter how often this function was called
@@ -1116,6 +1258,13 @@ currentState()
   return solverVariableSolution_;
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+Mat HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+jacobianMatrix()
+{
+  return solverMatrixJacobian_;
+}
+
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 std::string HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 getString(Vec x)
@@ -2,12 +2,46 @@
 
 #include <Python.h>  // has to be the first included header
 
+#include <tuple>
+
 #include "specialized_solver/solid_mechanics/hyperelasticity/expression_helper.h"
 #include "specialized_solver/solid_mechanics/hyperelasticity/00_initialize.h"
 
 namespace SpatialDiscretization
 {
 
+/** The quantities at a quadrature point that are computed in materialComputeInternalVirtualWork and can be reused by materialComputeJacobian
+ *  when the jacobian is evaluated at the same state, i.e., the same displacements and pressure (option "cacheQuadraturePointValues").
+ *  This uses double_v_t, i.e. it contains the values for nVcComponents elements at once.
+ */
+struct HyperelasticityQuadraturePointValues
+{
+  Tensor2_v_t<3> deformationGradient;             //< F
+  double_v_t deformationGradientDeterminant;      //< J = det(F)
+  Tensor2_v_t<3> rightCauchyGreen;                //< C
+  Tensor2_v_t<3> inverseRightCauchyGreen;         //< C^{-1}
+  double_v_t rightCauchyGreenDeterminant;         //< det(C) = J^2
+  std::array<double_v_t,5> invariants;            //< the strain invariants I_1, ..., I_5
+  std::array<double_v_t,5> reducedInvariants;     //< the reduced invariants Ibar_1, ..., Ibar_5
+  Vec3_v_t fiberDirection;                        //< a0, the normalized direction of fibers
+  double_v_t pressure;                            //< the pressure p as computed by computePK2Stress
+  Tensor2_v_t<3> pK2Stress;                       //< S, the 2nd Piola-Kirchhoff stress tensor without active stress contribution
+  Tensor2_v_t<3> fictitiousPK2Stress;             //< Sbar, the fictitious 2nd Piola-Kirchhoff stress tensor
+  Tensor2_v_t<3> pk2StressIsochoric;              //< S_iso, the isochoric part of the 2nd Piola-Kirchhoff stress tensor
+};
+
+/** The quantities at a quadrature point that are stored by materialComputeJacobian for the matrix-free jacobian (option "useMatrixFreeJacobian").
+ *  The product of the jacobian with a vector is computed from these values at every application, no element matrices are stored.
+ *  This uses double_v_t, i.e. it contains the values for nVcComponents elements at once.
+ */
+struct HyperelasticityMatrixFreeQuadraturePointValues
+{
+  std::array<double_v_t,81> tangent;              //< k_abBD = δ_ab S_BD + F_aA F_bC C_ABCD at index ((a*3 + b)*3 + B)*3 + D, from the PK2 stress S and the elasticity tensor C
+  Tensor2_v_t<3> inverseJacobianMaterial;         //< dxi/dX, to transform the gradients of the basis functions to the reference configuration
+  Tensor2_v_t<3> scaledInverseDeformationGradient;//< J*F^{-1}, for the submatrices up and pu of the incompressible formulation
+  double_v_t integrationFactor;                   //< the quadrature weight times the determinant of dX/dxi
+};
+
 /** This class contains all formulas for computation of physical quantities.
   */
 template<typename Term = Equation::SolidMechanics::MooneyRivlinIncompressible3D, bool withLargeOutput=true, typename MeshType = Mesh::StructuredDeformableOfDimension<3>, int nDisplacementComponents = 3>
@@ -51,7 +85,7 @@ public:
     std::shared_ptr<VecHyperelasticity> internalVirtualWork
   );
 
-  //! solve the dynamic hyperelastic problem, using a load stepping
+  //! solve the dynamic hyperelastic problem, using a load stepping, or advance it by the explicit central difference scheme if "timeIntegrationScheme" is "explicit"
   //! output internalVirtualWork, externalVirtualWorkDead and accelerationTerm which is the acceleration contribution to δW
   void solveDynamicProblem(std::shared_ptr<VecHyperelasticity> displacementsVelocitiesPressure, bool isFirstTimeStep,
                            Vec internalVirtualWork, Vec &externalVirtualWorkDead, Vec accelerationTerm, bool withOutputWritersEnabled = true);
@@ -68,6 +102,19 @@ public:
   void computeBearingForceAndMoment(const std::vector<std::tuple<element_no_t,bool>> &elements,
                                     Vec3 &bearingForceBottom, Vec3 &bearingMomentBottom, Vec3 &bearingForceTop, Vec3 &bearingMomentTop);
 
+  //! compute the PK2 stress and traction fields if their computation after the last solve was deferred (option "deferStressFieldComputation"), call this before the fields are used
+  void computeDeferredStressFields();
+
+  //! compute y = J*x for the matrix-free jacobian (option "useMatrixFreeJacobian"), element by element from the quadrature point values of the last jacobian computation, without an assembled matrix
+  void applyMatrixFreeJacobian(Vec x, Vec y);
+
+  //! compute the diagonal of the matrix-free jacobian from the quadrature point values of the last jacobian computation, this is needed for the jacobi preconditioner
+  void getMatrixFreeJacobianDiagonal(Vec diagonal);
+
+  //! compute the diagonal of the block preconditioner of the matrix-free jacobian ("matrixFreePreconditionerType": "block"), which is the diagonal of the jacobian for the
+  //! displacements and velocities and the diagonal of the approximated Schur complement B diag(A)^{-1} B^T for the pressure
+  void getMatrixFreeBlockPreconditionerDiagonal(Vec diagonal);
+
 protected:
 
   typedef HyperelasticityInitialize<Term,withLargeOutput,MeshType,nDisplacementComponents> Parent;
@@ -90,10 +137,34 @@ protected:
   //! @param communicateGhosts if startGhostManipulation() and finishGhostManipulation() will be called on combinedVecResidual_ inside this method, if set to false, you have to do it manually before and after this method
   void materialAddAccelerationTermAndVelocityEquation(bool communicateGhosts=true);
 
+  //! assemble the diagonal lumped mass matrix m^L = int_Ω rho_0 phi^L dV in lumpedMass_ and determine the Dirichlet dofs in isDirichletDofLocal_, for the explicit time integration
+  void materialComputeLumpedMass();
+
+  //! compute δW_int - δW_ext,dead for the values in solverVariableSolution_ and get the local values of the displacement components
+  //! @return true if computation was successful (i.e. no negative jacobian)
+  bool materialComputeExplicitForces(std::array<std::vector<double>,3> &forces);
+
+  //! set the local values of three components of solverVariableSolution_, starting at componentNoBegin (0 for displacements, 3 for velocities), Dirichlet dofs are not changed
+  void setSolutionComponentValues(int componentNoBegin, const std::array<std::vector<double>,3> &values);
+
+  //! estimate the critical time step width of the explicit scheme, dt_crit = 2/sqrt(λ_max) where λ_max is the largest eigenvalue of M_L^-1 K,
+  //! it is computed by a power iteration with finite differences of δW_int at the current displacements
+  double estimateCriticalTimeStepWidth();
+
+  //! advance the displacements and velocities in solverVariableSolution_ by timeStepWidth_ with the explicit central difference scheme and the lumped mass matrix,
+  //! the time step is split into substeps such that every substep is below the critical time step width,
+  //! the velocities are the leapfrog values at the half time steps, i.e. half a substep behind the displacements
+  //! @return true if computation was successful (i.e. no negative jacobian)
+  bool explicitTimeStep();
+
   //! compute the jacobian of the Newton scheme
   //! @return true if computation was successful (i.e. no negative jacobian)
   bool materialComputeJacobian();
 
+  //! set all entries of the jacobian that can be nonzero, given by the element connectivity, to zero (or to their constant value in the dynamic case)
+  //! this allocates the nonzero structure of the matrix, which is needed for the computation of the numeric jacobian with coloring
+  void materialSetJacobianNonzeroStructure(std::shared_ptr<MatHyperelasticity> jacobianMatrix);
+
   //! compute the deformation gradient, F inside the current element at position xi, the value of F is still with respect to the reference configuration,
   //! the formula is F_ij = x_i,j = δ_ij + u_i,j
   template<typename double_v_t>
@@ -137,7 +208,8 @@ protected:
                   );
 
   //! compute the PK2 stress and the deformation gradient at every node and set value in data, for output
-  void computePK2StressField();
+  //! @param onlyDeformationGradient if only F and Fdot should be computed, but not the PK2 stress, traction and material traction
+  void computePK2StressField(bool onlyDeformationGradient = false);
 
   //! compute the material elasticity tensor
   template<typename double_v_t>
@@ -156,6 +228,24 @@ protected:
   template<typename double_v_t>
   double computeSbarC(const Tensor2<3,double_v_t> &Sbar, const Tensor2<3,double_v_t> &C);
 
+  //! get the values of an element that determine the computed quantities at the quadrature points, i.e. displacements, pressure and fiber direction,
+  //! this is used to check if the element changed since the cached values were computed
+  void getElementState(const std::array<Vec3_v_t,DisplacementsFunctionSpace::nDofsPerElement()> &displacementsValues,
+                       const std::array<double_v_t,PressureFunctionSpace::nDofsPerElement()> &pressureValues,
+                       const std::array<Vec3_v_t,DisplacementsFunctionSpace::nDofsPerElement()> &fiberDirectionValues,
+                       std::vector<double_v_t> &elementState);
+
+  //! get the stored quadrature point values of the matrix-free jacobian of the single element elementNoLocal from matrixFreeQuadraturePointValues_
+  void getMatrixFreeQuadraturePointValues(int elementNoLocal, int samplingPointIndex, std::array<double,81> &tangent,
+                                          Tensor2<3> &inverseJacobianMaterial, Tensor2<3> &scaledInverseDeformationGradient, double &integrationFactor);
+
+  //! compute the diagonal of the submatrix uu of the matrix-free jacobian and the constant diagonal of the dynamic problem, store it in the global values of matrixFreeOutput_
+  void computeMatrixFreeDisplacementsDiagonal();
+
+  //! check if any value of the given element state differs by more than tolerance from the stored element state of the element chunk elementChunkNo in elementStates
+  //! with tolerance 0, this checks if the states are not exactly equal
+  bool elementStateChanged(const std::vector<double_v_t> &elementState, const std::vector<double_v_t> &elementStates, int elementChunkNo, double tolerance);
+
   //! use Petsc to solve the nonlinear equation using the SNES solver
   virtual void nonlinearSolve() = 0;
 
@@ -179,13 +269,59 @@ protected:
   using Parent::externalVirtualWorkDead_;             //< the external virtual work resulting from the traction, this is a dead load, i.e. it does not change during deformation
   using Parent::getString;                            //< function to get a string representation of the values for debugging output
   using Parent::setUVP;                               //< function to copy the values of the vector x which contains (u and p) or (u,v and p) values to this->data_.displacements(), this->data_.velocities() and this->data_.pressure();
+
+  std::vector<HyperelasticityQuadraturePointValues> quadraturePointValues_;   //< [elementChunkNo*nQuadraturePoints + samplingPointIndex] values of the last evaluation of materialComputeInternalVirtualWork, if "cacheQuadraturePointValues" is set
+  std::vector<double_v_t> quadraturePointValuesElementStates_;               //< [elementChunkNo*nElementStateValues + i] the element states (displacements, pressure, fiber direction) for which quadraturePointValues_ were computed
+  std::vector<bool> quadraturePointValuesValid_;                              //< [elementChunkNo] if quadraturePointValues_ of the element chunk have been computed
+
+  std::vector<double_v_t> elementJacobianStates_;                             //< [elementChunkNo*nElementStateValues + i] the element states for which the element contributions in elementJacobianValues_ were computed, if "jacobianReassemblyTolerance" is set
+  std::vector<double_v_t> elementJacobianValues_;                             //< [elementChunkNo*nElementJacobianValues + i] the integrated element contributions to the jacobian (submatrices uu, up and uv) of the last computation, if "jacobianReassemblyTolerance" is set and the jacobian matrix is assembled
+  std::vector<bool> elementJacobianValid_;                                    //< [elementChunkNo] if the element contributions of the element chunk have been computed
+
+  std::vector<HyperelasticityMatrixFreeQuadraturePointValues> matrixFreeQuadraturePointValues_;  //< [elementChunkNo*nQuadraturePoints + samplingPointIndex] values of the last jacobian computation, if "useMatrixFreeJacobian" is set
+
+  std::tuple<ExpressionVariables<double>,ExpressionVariables<Vc::double_v>> expressionVariables_;   //< storage of the variables of the SEMT expressions in computePK2Stress and computeElasticityTensor for scalar and vectorized evaluation, reused at every quadrature point
 };
 
 }  // namespace
 
+#ifndef HAVE_STDSIMD      // only if we are using Vc, it is not necessary for std::simd
+
+/** Specialize the default allocator for the HyperelasticityQuadraturePointValues and HyperelasticityMatrixFreeQuadraturePointValues structs to use the aligned allocated provided by Vc.
+ */
+namespace std
+{
+template<>
+class allocator<SpatialDiscretization::HyperelasticityQuadraturePointValues> :
+  public ::Vc::Allocator<SpatialDiscretization::HyperelasticityQuadraturePointValues>
+{
+public:
+  template <typename U>
+  struct rebind
+  {
+    typedef ::std::allocator<U> other;
+  };
+};
+
+template<>
+class allocator<SpatialDiscretization::HyperelasticityMatrixFreeQuadraturePointValues> :
+  public ::Vc::Allocator<SpatialDiscretization::HyperelasticityMatrixFreeQuadraturePointValues>
+{
+public:
+  template <typename U>
+  struct rebind
+  {
+    typedef ::std::allocator<U> other;
+  };
+};
+}
+#endif
+
 #include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations.tpp"
 #include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations_auxiliary.tpp"
 #include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations_elasticity_tensor.tpp"
 #include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations_stress.tpp"
+#include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations_explicit.tpp"
+#include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations_matrix_free.tpp"
 #include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations_wrappers.tpp"
 #include "specialized_solver/solid_mechanics/hyperelasticity/01_material_testing.tpp"
@@ -63,6 +63,17 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
   // setup arrays used for integration
   std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
 
+  // prepare the storage for the quantities at the quadrature points that can be reused by the jacobian
+  const int nElementChunks = (nElementsLocal + nVcComponents - 1) / nVcComponents;
+  const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+  std::vector<double_v_t> elementState;
+  if (this->cacheQuadraturePointValues_ && quadraturePointValues_.size() != nElementChunks*nQuadraturePoints)
+  {
+    quadraturePointValues_.resize(nElementChunks*nQuadraturePoints);
+    quadraturePointValuesElementStates_.clear();
+    quadraturePointValuesValid_.assign(nElementChunks, false);
+  }
+
   // set values to zero
   if (communicateGhosts)
   {
@@ -133,6 +144,9 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
       this->data_.activePK2Stress()->getElementValues(elementNoLocalv, activePK2StressValues);
     }
 
+    // the index of the current set of nVcComponents elements, used for the storage of the quadrature point values
+    const int elementChunkNo = elementNoLocal / nVcComponents;
+
     // loop over integration points (e.g. gauss points) for displacements field
     for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
     {
@@ -199,6 +213,24 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
                                                         deformationGradientDeterminant, fiberDirection, elementNoLocalv,
                                                         fictitiousPK2Stress, pk2StressIsochoric);
 
+      // store the computed quantities such that they can be reused by the jacobian, the active stress is not part of the analytic jacobian
+      if (this->cacheQuadraturePointValues_)
+      {
+        HyperelasticityQuadraturePointValues &values = quadraturePointValues_[elementChunkNo*nQuadraturePoints + samplingPointIndex];
+        values.deformationGradient            = deformationGradient;
+        values.deformationGradientDeterminant = deformationGradientDeterminant;
+        values.rightCauchyGreen               = rightCauchyGreen;
+        values.inverseRightCauchyGreen        = inverseRightCauchyGreen;
+        values.rightCauchyGreenDeterminant    = rightCauchyGreenDeterminant;
+        values.invariants                     = invariants;
+        values.reducedInvariants              = reducedInvariants;
+        values.fiberDirection                 = fiberDirection;
+        values.pressure                       = pressure;
+        values.pK2Stress                      = pK2Stress;
+        values.fictitiousPK2Stress            = fictitiousPK2Stress;
+        values.pk2StressIsochoric             = pk2StressIsochoric;
+      }
+
       // add active stress contribution if this material has this
       if (Term::usesActiveStress)
       {
@@ -340,6 +372,17 @@ materialComputeInternalVirtualWork(bool communicateGhosts)
 
     }  // function evaluations
 
+    // store the element state for which the quadrature point values were computed
+    if (this->cacheQuadraturePointValues_)
+    {
+      getElementState(displacementsValues, pressureValuesCurrentElement, elementalDirectionValues, elementState);
+      const int nElementStateValues = elementState.size();
+
+      quadraturePointValuesElementStates_.resize(nElementChunks*nElementStateValues);
+      std::copy(elementState.begin(), elementState.end(), quadraturePointValuesElementStates_.begin() + elementChunkNo*nElementStateValues);
+      quadraturePointValuesValid_[elementChunkNo] = true;
+    }
+
     // integrate all values for result vector entries at once
     EvaluationsDisplacementsType integratedValuesDisplacements = QuadratureDD::computeIntegral(evaluationsArrayDisplacements);
 
@@ -908,20 +951,9 @@ materialAddAccelerationTermAndVelocityEquation(bool communicateGhosts)
 }
 
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
-bool HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
-materialComputeJacobian()
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+materialSetJacobianNonzeroStructure(std::shared_ptr<MatHyperelasticity> jacobianMatrix)
 {
-  // analytic jacobian combinedMatrixJacobian_
-  //  output is combinedMatrixJacobian_, a PartitionedMatHyperelasticity or solverMatrixJacobian_, the normal Mat, contains no Dirichlet BC dofs
-  //  input is solverVariableSolution_, a normal Vec, the same values have already been assigned to this->data_.displacements() and this->data_.pressure()
-
-  const bool outputValues = false;
-  if (outputValues)
-    LOG(DEBUG) << "input: " << getString(solverVariableSolution_);
-
-  // assert that data representation is global
-  assert(combinedVecSolution_->currentRepresentation() == Partition::values_representation_t::representationCombinedGlobal);
-
   // get pointer to function space
   std::shared_ptr<DisplacementsFunctionSpace> displacementsFunctionSpace = this->data_.displacementsFunctionSpace();
   std::shared_ptr<PressureFunctionSpace> pressureFunctionSpace = this->data_.pressureFunctionSpace();
@@ -930,23 +962,6 @@ materialComputeJacobian()
   const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
   const int nPressureDofsPerElement = PressureFunctionSpace::nDofsPerElement();
   const int nElementsLocal = displacementsFunctionSpace->nElementsLocal();
-  const int nUnknowsPerElement = nDisplacementsDofsPerElement*D;    // D directions for displacements per dof
-
-  // define shortcuts for quadrature
-  typedef Quadrature::TensorProduct<D,Quadrature::Gauss<3>> QuadratureDD;   // quadratic*quadratic = 4th order polynomial, 3 gauss points = 2*3-1 = 5th order exact
-
-  // define types to hold evaluations of integrand
-  typedef std::array<double_v_t, nUnknowsPerElement*nUnknowsPerElement> EvaluationsDisplacementsType;
-  std::array<EvaluationsDisplacementsType, QuadratureDD::numberEvaluations()> evaluationsArrayDisplacements{};
-
-  typedef std::array<double_v_t, nPressureDofsPerElement*nUnknowsPerElement> EvaluationsPressureType;
-  std::array<EvaluationsPressureType, QuadratureDD::numberEvaluations()> evaluationsArrayPressure{};
-
-  typedef std::array<double_v_t, nDisplacementsDofsPerElement*nDisplacementsDofsPerElement> EvaluationsUVType;
-  std::array<EvaluationsUVType, QuadratureDD::numberEvaluations()> evaluationsArrayUV{};
-
-  // setup arrays used for integration
-  std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
 
   // loop over elements, always 4 elements at once using the vectorized functions
   for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
@@ -989,14 +1004,14 @@ materialComputeJacobian()
             dof_no_v_t dofANoLocal = dofNosLocal[aDof];
             dof_no_v_t dofBNoLocal = dofNosLocal[bDof];
 
-            combinedMatrixJacobian_->setValue(aComponent, dofANoLocal, bComponent, dofBNoLocal, 0.0, INSERT_VALUES);
+            jacobianMatrix->setValue(aComponent, dofANoLocal, bComponent, dofBNoLocal, 0.0, INSERT_VALUES);
 
             // for dynamic case also initialize center-left, top-center and center-center sub matrices
             if (nDisplacementComponents == 6)
             {
               // set entry of top-center (0,1) sub matrix, l_δu,Δv
               // this entry will be computed by an integral
-              combinedMatrixJacobian_->setValue(aComponent, dofANoLocal, 3+bComponent, dofBNoLocal, 0.0, INSERT_VALUES);
+              jacobianMatrix->setValue(aComponent, dofANoLocal, 3+bComponent, dofBNoLocal, 0.0, INSERT_VALUES);
 
               // set entry of center-left (1,0) sub matrix, l_δv,Δu
               // this entry can directly be computed
@@ -1004,12 +1019,12 @@ materialComputeJacobian()
               const int delta_LM = (aDof == bDof? 1 : 0);
 
               const double entryVU = 1./this->timeStepWidth_ * delta_ab * delta_LM;
-              combinedMatrixJacobian_->setValue(3+aComponent, dofANoLocal, bComponent, dofBNoLocal, entryVU, INSERT_VALUES);
+              jacobianMatrix->setValue(3+aComponent, dofANoLocal, bComponent, dofBNoLocal, entryVU, INSERT_VALUES);
 
               // set entry of center-center (1,1) sub matrix, l_δv,Δv
               // this entry can directly be computed
               const double entryVV = -delta_ab * delta_LM;
-              combinedMatrixJacobian_->setValue(3+aComponent, dofANoLocal, 3+bComponent, dofBNoLocal, entryVV, INSERT_VALUES);
+              jacobianMatrix->setValue(3+aComponent, dofANoLocal, 3+bComponent, dofBNoLocal, entryVV, INSERT_VALUES);
             }
           }  // b
         }  // M
@@ -1034,10 +1049,10 @@ materialComputeJacobian()
 
             // set entry in lower left submatrix
             // parameters: componentNoRow, dofNoLocalRow, componentNoColumn, dofNoLocalColumn, value
-            combinedMatrixJacobian_->setValue(pressureDofNo, dofLNoLocal, aComponent, dofMNoLocal, 0.0, INSERT_VALUES);
+            jacobianMatrix->setValue(pressureDofNo, dofLNoLocal, aComponent, dofMNoLocal, 0.0, INSERT_VALUES);
 
             // set entry in upper right submatrix
-            combinedMatrixJacobian_->setValue(aComponent, dofMNoLocal, pressureDofNo, dofLNoLocal, 0.0, INSERT_VALUES);
+            jacobianMatrix->setValue(aComponent, dofMNoLocal, pressureDofNo, dofLNoLocal, 0.0, INSERT_VALUES);
 
           }  // aComponent
         }  // aDof
@@ -1058,7 +1073,7 @@ materialComputeJacobian()
         const int pressureDofNo = nDisplacementComponents;  // 3 or 6, depending if static or dynamic problem
 
         dof_no_v_t dofLNoLocal = dofNosLocalPressure[lDof];     // dof with respect to pressure function space
-        combinedMatrixJacobian_->setValue(pressureDofNo, dofLNoLocal, pressureDofNo, dofLNoLocal, epsilon, INSERT_VALUES);
+        jacobianMatrix->setValue(pressureDofNo, dofLNoLocal, pressureDofNo, dofLNoLocal, epsilon, INSERT_VALUES);
       }
     }  // elementNoLocal
 
@@ -1067,9 +1082,83 @@ materialComputeJacobian()
     //ierr = MatDiagonalSet(combinedMatrixJacobian_->valuesGlobal(), zeros_, INSERT_VALUES); CHKERRQ(ierr);
 
   }  // if Term::isIncompressible
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+bool HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+materialComputeJacobian()
+{
+  // analytic jacobian combinedMatrixJacobian_
+  //  output is combinedMatrixJacobian_, a PartitionedMatHyperelasticity or solverMatrixJacobian_, the normal Mat, contains no Dirichlet BC dofs
+  //  input is solverVariableSolution_, a normal Vec, the same values have already been assigned to this->data_.displacements() and this->data_.pressure()
 
-  // allow switching between stiffnessMatrix->setValue(... INSERT_VALUES) and ADD_VALUES
-  combinedMatrixJacobian_->assembly(MAT_FLUSH_ASSEMBLY);
+  const bool outputValues = false;
+  if (outputValues)
+    LOG(DEBUG) << "input: " << getString(solverVariableSolution_);
+
+  // assert that data representation is global
+  assert(combinedVecSolution_->currentRepresentation() == Partition::values_representation_t::representationCombinedGlobal);
+
+  // get pointer to function space
+  std::shared_ptr<DisplacementsFunctionSpace> displacementsFunctionSpace = this->data_.displacementsFunctionSpace();
+  std::shared_ptr<PressureFunctionSpace> pressureFunctionSpace = this->data_.pressureFunctionSpace();
+
+  const int D = 3;  // dimension
+  const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
+  const int nPressureDofsPerElement = PressureFunctionSpace::nDofsPerElement();
+  const int nElementsLocal = displacementsFunctionSpace->nElementsLocal();
+  const int nUnknowsPerElement = nDisplacementsDofsPerElement*D;    // D directions for displacements per dof
+
+  // define shortcuts for quadrature
+  typedef Quadrature::TensorProduct<D,Quadrature::Gauss<3>> QuadratureDD;   // quadratic*quadratic = 4th order polynomial, 3 gauss points = 2*3-1 = 5th order exact
+
+  // define types to hold evaluations of integrand
+  typedef std::array<double_v_t, nUnknowsPerElement*nUnknowsPerElement> EvaluationsDisplacementsType;
+  std::array<EvaluationsDisplacementsType, QuadratureDD::numberEvaluations()> evaluationsArrayDisplacements{};
+
+  typedef std::array<double_v_t, nPressureDofsPerElement*nUnknowsPerElement> EvaluationsPressureType;
+  std::array<EvaluationsPressureType, QuadratureDD::numberEvaluations()> evaluationsArrayPressure{};
+
+  typedef std::array<double_v_t, nDisplacementsDofsPerElement*nDisplacementsDofsPerElement> EvaluationsUVType;
+  std::array<EvaluationsUVType, QuadratureDD::numberEvaluations()> evaluationsArrayUV{};
+
+  // setup arrays used for integration
+  std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
+
+  // prepare the storage of the quadrature point values and element contributions for the options "cacheQuadraturePointValues" and "jacobianReassemblyTolerance"
+  const int nElementChunks = (nElementsLocal + nVcComponents - 1) / nVcComponents;
+  const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+  const int nElementJacobianValues = std::tuple_size<EvaluationsDisplacementsType>::value
+    + std::tuple_size<EvaluationsPressureType>::value + std::tuple_size<EvaluationsUVType>::value;
+  std::vector<double_v_t> elementState;
+
+  // for the matrix-free jacobian with jacobi or block preconditioner, the jacobian matrix is not assembled at all and no element matrices are computed,
+  // only the values at the quadrature points are stored from which the matrix-free jacobian is applied
+  const bool assembleJacobianMatrix = combinedMatrixJacobian_ != nullptr;
+  const bool storeElementJacobianValues = this->jacobianReassemblyTolerance_ > 0;
+  const std::array<double,QuadratureDD::numberEvaluations()> quadratureWeights = QuadratureDD::quadratureWeights();
+
+  if (storeElementJacobianValues && elementJacobianValid_.size() != nElementChunks)
+  {
+    if (assembleJacobianMatrix)
+      elementJacobianValues_.resize(nElementChunks*nElementJacobianValues);
+    elementJacobianStates_.clear();
+    elementJacobianValid_.assign(nElementChunks, false);
+  }
+
+  if (this->useMatrixFreeJacobian_)
+    matrixFreeQuadraturePointValues_.resize(nElementChunks*nQuadraturePoints);
+
+  int nReusedElementChunks = 0;
+
+  if (assembleJacobianMatrix)
+  {
+    // set the entries of the nonzero structure to zero, in the dynamic case also set the constant entries
+    materialSetJacobianNonzeroStructure(combinedMatrixJacobian_);
+
+    // allow switching between stiffnessMatrix->setValue(... INSERT_VALUES) and ADD_VALUES
+    combinedMatrixJacobian_->assembly(MAT_FLUSH_ASSEMBLY);
+  }
 
   // loop over elements, always 4 elements at once using the vectorized functions
   for (int elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal += nVcComponents)
@@ -1110,292 +1199,432 @@ materialComputeJacobian()
     std::array<Vec3_v_t,nDisplacementsDofsPerElement> elementalDirectionValues;
     this->data_.fiberDirection()->getElementValues(elementNoLocalv, elementalDirectionValues);
 
-    // loop over integration points (e.g. gauss points) for displacements field
-    for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+    // the index of the current set of nVcComponents elements, used for the stored values
+    const int elementChunkNo = elementNoLocal / nVcComponents;
+
+    // the quadrature point values of the last residual evaluation can be used if the element state is exactly the same,
+    // the element contributions of the last jacobian computation are reused if the element state changed less than the tolerance
+    bool useCachedQuadraturePointValues = false;
+    bool reuseElementJacobian = false;
+    if (this->cacheQuadraturePointValues_ || this->jacobianReassemblyTolerance_ > 0)
     {
-      // get parameter values of current sampling point
-      Vec3 xi = samplingPoints[samplingPointIndex];
+      getElementState(displacementsValues, pressureValuesCurrentElement, elementalDirectionValues, elementState);
 
-      // compute the 3x3 jacobian of the parameter space to world space mapping
-      Tensor2_v_t<D> jacobianMaterial = DisplacementsFunctionSpace::computeJacobian(geometryReferenceValues, xi);
-      double_v_t jacobianDeterminant;
-      Tensor2_v_t<D> inverseJacobianMaterial = MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminant);
+      if (this->cacheQuadraturePointValues_ && elementChunkNo < quadraturePointValuesValid_.size() && quadraturePointValuesValid_[elementChunkNo])
+        useCachedQuadraturePointValues = !elementStateChanged(elementState, quadraturePointValuesElementStates_, elementChunkNo, 0.0);
 
-      // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
-      // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
+      if (this->jacobianReassemblyTolerance_ > 0 && elementJacobianValid_[elementChunkNo])
+        reuseElementJacobian = !elementStateChanged(elementState, elementJacobianStates_, elementChunkNo, this->jacobianReassemblyTolerance_);
+    }
 
-      // get the factor in the integral that arises from the change in integration domain from world to parameter space
-      double_v_t integrationFactor = MathUtility::abs(jacobianDeterminant);   //MathUtility::computeIntegrationFactor(jacobianMaterial);
+    EvaluationsDisplacementsType integratedValuesDisplacements{};
+    EvaluationsPressureType integratedValuesPressure{};
+    EvaluationsUVType integratedValuesUV{};
 
-      Tensor2_v_t<D> deformationGradient = this->computeDeformationGradient(displacementsValues, inverseJacobianMaterial, xi);    // F
-      double_v_t deformationGradientDeterminant;    // J
-      Tensor2_v_t<D> inverseDeformationGradient = MathUtility::computeInverse(deformationGradient, approximateMeshWidth, deformationGradientDeterminant);  // F^-1
-#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
-        for (int i = 0; i < Vc::double_v::size(); i++)
+    if (reuseElementJacobian)
+    {
+      // the element contributions (and the quadrature point values of the matrix-free jacobian) were computed for a state that differs less than the tolerance, reuse them
+      nReusedElementChunks++;
+      if (!assembleJacobianMatrix)
+        continue;
+
+      typename std::vector<double_v_t>::const_iterator elementJacobianValuesIter = elementJacobianValues_.begin() + elementChunkNo*nElementJacobianValues;
+      std::copy(elementJacobianValuesIter, elementJacobianValuesIter + integratedValuesDisplacements.size(), integratedValuesDisplacements.begin());
+      elementJacobianValuesIter += integratedValuesDisplacements.size();
+      std::copy(elementJacobianValuesIter, elementJacobianValuesIter + integratedValuesPressure.size(), integratedValuesPressure.begin());
+      elementJacobianValuesIter += integratedValuesPressure.size();
+      std::copy(elementJacobianValuesIter, elementJacobianValuesIter + integratedValuesUV.size(), integratedValuesUV.begin());
+    }
+    else
+    {
+      // loop over integration points (e.g. gauss points) for displacements field
+      for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+      {
+        // get parameter values of current sampling point
+        Vec3 xi = samplingPoints[samplingPointIndex];
+
+        // compute the 3x3 jacobian of the parameter space to world space mapping
+        Tensor2_v_t<D> jacobianMaterial = DisplacementsFunctionSpace::computeJacobian(geometryReferenceValues, xi);
+        double_v_t jacobianDeterminant;
+        Tensor2_v_t<D> inverseJacobianMaterial = MathUtility::computeInverse(jacobianMaterial, approximateMeshWidth, jacobianDeterminant);
+
+        // jacobianMaterial[columnIdx][rowIdx] = dX_rowIdx/dxi_columnIdx
+        // inverseJacobianMaterial[columnIdx][rowIdx] = dxi_rowIdx/dX_columnIdx because of inverse function theorem
+
+        // get the factor in the integral that arises from the change in integration domain from world to parameter space
+        double_v_t integrationFactor = MathUtility::abs(jacobianDeterminant);   //MathUtility::computeIntegrationFactor(jacobianMaterial);
+
+        // quantities at the quadrature point, either computed or taken from the last residual evaluation at the same state
+        Tensor2_v_t<D> deformationGradient;           // F
+        double_v_t deformationGradientDeterminant;    // J
+        Tensor2_v_t<D> inverseDeformationGradient;    // F^-1
+        Tensor2_v_t<D> rightCauchyGreen;              // C
+        double_v_t rightCauchyGreenDeterminant;       // J^2
+        Tensor2_v_t<D> inverseRightCauchyGreen;       // C^-1
+        Vec3_v_t fiberDirection;                      // a0
+        std::array<double_v_t,5> invariants;          // I_1, ..., I_5
+        std::array<double_v_t,5> reducedInvariants;   // Ibar_1, ..., Ibar_5
+        double_v_t pressure;                          // p
+
+        // Pk2 stress tensor S = S_vol + S_iso (p.234)
+        Tensor2_v_t<D> pK2Stress;             // S
+        Tensor2_v_t<D> fictitiousPK2Stress;   // Sbar
+        Tensor2_v_t<D> pk2StressIsochoric;    // S_iso
+
+        if (useCachedQuadraturePointValues)
         {
-          if (elementNoLocalv[i] == -1)
-            deformationGradientDeterminant[i] = 1;
-        } 
+          const HyperelasticityQuadraturePointValues &values = quadraturePointValues_[elementChunkNo*nQuadraturePoints + samplingPointIndex];
+          deformationGradient            = values.deformationGradient;
+          deformationGradientDeterminant = values.deformationGradientDeterminant;
+          rightCauchyGreen               = values.rightCauchyGreen;
+          rightCauchyGreenDeterminant    = values.rightCauchyGreenDeterminant;
+          inverseRightCauchyGreen        = values.inverseRightCauchyGreen;
+          fiberDirection                 = values.fiberDirection;
+          invariants                     = values.invariants;
+          reducedInvariants              = values.reducedInvariants;
+          pressure                       = values.pressure;
+          pK2Stress                      = values.pK2Stress;
+          fictitiousPK2Stress            = values.fictitiousPK2Stress;
+          pk2StressIsochoric             = values.pk2StressIsochoric;
+
+          // F^-1 is not needed for the residual and therefore not stored
+          double_v_t determinant;
+          inverseDeformationGradient = MathUtility::computeInverse(deformationGradient, approximateMeshWidth, determinant);
+        }
+        else
+        {
+          deformationGradient = this->computeDeformationGradient(displacementsValues, inverseJacobianMaterial, xi);    // F
+          inverseDeformationGradient = MathUtility::computeInverse(deformationGradient, approximateMeshWidth, deformationGradientDeterminant);  // F^-1
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+            for (int i = 0; i < Vc::double_v::size(); i++)
+            {
+              if (elementNoLocalv[i] == -1)
+                deformationGradientDeterminant[i] = 1;
+            } 
 #endif        
 
-      Tensor2_v_t<D> rightCauchyGreen = this->computeRightCauchyGreenTensor(deformationGradient);  // C = F^T*F
+          rightCauchyGreen = this->computeRightCauchyGreenTensor(deformationGradient);  // C = F^T*F
 
-      double_v_t rightCauchyGreenDeterminant;   // J^2
-      Tensor2_v_t<D> inverseRightCauchyGreen = MathUtility::computeSymmetricInverse(rightCauchyGreen, approximateMeshWidth, rightCauchyGreenDeterminant);  // C^-1
+          inverseRightCauchyGreen = MathUtility::computeSymmetricInverse(rightCauchyGreen, approximateMeshWidth, rightCauchyGreenDeterminant);  // C^-1
 
-      // fiber direction
-      Vec3_v_t fiberDirection = displacementsFunctionSpace->template interpolateValueInElement<3>(elementalDirectionValues, xi);
+          // fiber direction
+          fiberDirection = displacementsFunctionSpace->template interpolateValueInElement<3>(elementalDirectionValues, xi);
 
-      // fiberDirection is not automatically normalized because of the interpolation inside the element, normalize again
-      if (Term::usesFiberDirection)
-      {
-        MathUtility::normalize<3>(fiberDirection);
-      }
+          // fiberDirection is not automatically normalized because of the interpolation inside the element, normalize again
+          if (Term::usesFiberDirection)
+          {
+            MathUtility::normalize<3>(fiberDirection);
+          }
 
 #ifndef NDEBUG
-      if (Term::usesFiberDirection)
-      {
-        if (Vc::any_of(MathUtility::abs(MathUtility::norm<3>(fiberDirection) - 1) > 1e-3))
-          LOG(FATAL) << "fiberDirecton " << fiberDirection << " is not normalized (b)(norm: " << MathUtility::norm<3>(fiberDirection)
-            << ", difference to 1: " << MathUtility::norm<3>(fiberDirection) - 1 << ") elementalDirectionValues:" << elementalDirectionValues;
-      }
+          if (Term::usesFiberDirection)
+          {
+            if (Vc::any_of(MathUtility::abs(MathUtility::norm<3>(fiberDirection) - 1) > 1e-3))
+              LOG(FATAL) << "fiberDirecton " << fiberDirection << " is not normalized (b)(norm: " << MathUtility::norm<3>(fiberDirection)
+                << ", difference to 1: " << MathUtility::norm<3>(fiberDirection) - 1 << ") elementalDirectionValues:" << elementalDirectionValues;
+          }
 #endif
 
-      // invariants
-      std::array<double_v_t,5> invariants = this->computeInvariants(rightCauchyGreen, rightCauchyGreenDeterminant, fiberDirection);  // I_1, I_2, I_3
-      std::array<double_v_t,5> reducedInvariants = this->computeReducedInvariants(invariants, deformationGradientDeterminant); // Ibar_1, ..., Ibar_5
+          // invariants
+          invariants = this->computeInvariants(rightCauchyGreen, rightCauchyGreenDeterminant, fiberDirection);  // I_1, I_2, I_3
+          reducedInvariants = this->computeReducedInvariants(invariants, deformationGradientDeterminant); // Ibar_1, ..., Ibar_5
 
-      // pressure is the separately interpolated pressure for mixed formulation
-      double_v_t pressure = 0;
-      if (Term::isIncompressible)
-        pressure = pressureFunctionSpace->interpolateValueInElement(pressureValuesCurrentElement, xi);
+          // pressure is the separately interpolated pressure for mixed formulation
+          pressure = 0;
+          if (Term::isIncompressible)
+            pressure = pressureFunctionSpace->interpolateValueInElement(pressureValuesCurrentElement, xi);
 
-      // Pk2 stress tensor S = S_vol + S_iso (p.234)
-      //! compute 2nd Piola-Kirchhoff stress tensor S = 2*dPsi/dC and the fictitious PK2 Stress Sbar
-      Tensor2_v_t<D> fictitiousPK2Stress;   // Sbar
-      Tensor2_v_t<D> pk2StressIsochoric;    // S_iso
-      Tensor2_v_t<D> pK2Stress = this->computePK2Stress(pressure, rightCauchyGreen, inverseRightCauchyGreen, invariants, reducedInvariants,
-                                                        deformationGradientDeterminant, fiberDirection, elementNoLocalv,
-                                                        fictitiousPK2Stress, pk2StressIsochoric);
+          //! compute 2nd Piola-Kirchhoff stress tensor S = 2*dPsi/dC and the fictitious PK2 Stress Sbar
+          pK2Stress = this->computePK2Stress(pressure, rightCauchyGreen, inverseRightCauchyGreen, invariants, reducedInvariants,
+                                             deformationGradientDeterminant, fiberDirection, elementNoLocalv,
+                                             fictitiousPK2Stress, pk2StressIsochoric);
+        }
 
-      std::array<Vec3,nDisplacementsDofsPerElement> gradPhi = displacementsFunctionSpace->getGradPhi(xi);
-      // (column-major storage) gradPhi[L][a] = dphi_L / dxi_a
-      // gradPhi[column][row] = gradPhi[dofIndex][i] = dphi_dofIndex/dxi_i, columnIdx = dofIndex, rowIdx = which direction
+        std::array<Vec3,nDisplacementsDofsPerElement> gradPhi = displacementsFunctionSpace->getGradPhi(xi);
+        // (column-major storage) gradPhi[L][a] = dphi_L / dxi_a
+        // gradPhi[column][row] = gradPhi[dofIndex][i] = dphi_dofIndex/dxi_i, columnIdx = dofIndex, rowIdx = which direction
 
 
-      Tensor4_v_t<D> elasticityTensor;
-      Tensor4_v_t<D> fictitiousElasticityTensor;
-      Tensor4_v_t<3> elasticityTensorIso;
-      computeElasticityTensor(rightCauchyGreen, inverseRightCauchyGreen, deformationGradientDeterminant, pressure, invariants, reducedInvariants, fictitiousPK2Stress, pk2StressIsochoric, fiberDirection,
-                              fictitiousElasticityTensor, elasticityTensorIso, elasticityTensor);
-
-      // test if implementation of S is correct
-      this->materialTesting(pressure, rightCauchyGreen, inverseRightCauchyGreen, reducedInvariants, deformationGradientDeterminant, fiberDirection, fictitiousPK2Stress, pk2StressIsochoric);
-
-      VLOG(2) << "";
-      VLOG(2) << "element " << elementNoLocal << " xi: " << xi;
-      VLOG(2) << "  geometryReferenceValues: " << geometryReferenceValues;
-      VLOG(2) << "  displacementsValues: " << displacementsValues;
-      VLOG(2) << "  Jacobian: J_phi=" << jacobianMaterial;
-      VLOG(2) << "  jacobianDeterminant: J=" << jacobianDeterminant;
-      VLOG(2) << "  inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
-      VLOG(2) << "  deformationGradient: F=" << deformationGradient;
-      VLOG(2) << "  deformationGradientDeterminant: det F=" << deformationGradientDeterminant;
-      VLOG(2) << "  rightCauchyGreen: C=" << rightCauchyGreen;
-      VLOG(2) << "  rightCauchyGreenDeterminant: det C=" << rightCauchyGreenDeterminant;
-      VLOG(2) << "  inverseRightCauchyGreen: C^-1=" << inverseRightCauchyGreen;
-      VLOG(2) << "  invariants: I1,I2,I3: " << invariants;
-      VLOG(2) << "  reducedInvariants: Ibar1, Ibar2: " << reducedInvariants;
-      VLOG(2) << "  pressure/artificialPressure: " << pressure;
-      //VLOG(2) << "  artificialPressure: p=" << artificialPressure << ", artificialPressureTilde: pTilde=" << artificialPressureTilde;
-      VLOG(2) << "  pK2Stress: S=" << pK2Stress;
-      VLOG(2) << "  gradPhi: " << gradPhi;
+        Tensor4_v_t<D> elasticityTensor;
+        Tensor4_v_t<D> fictitiousElasticityTensor;
+        Tensor4_v_t<3> elasticityTensorIso;
+        computeElasticityTensor(rightCauchyGreen, inverseRightCauchyGreen, deformationGradientDeterminant, pressure, invariants, reducedInvariants, fictitiousPK2Stress, pk2StressIsochoric, fiberDirection,
+                                fictitiousElasticityTensor, elasticityTensorIso, elasticityTensor);
 
-      VLOG(1) << "  sampling point " << samplingPointIndex << "/" << samplingPoints.size() << ", xi: " << xi << ", J: " << deformationGradientDeterminant << ", p: " << pressure << ", S11: " << pK2Stress[0][0];
+        // test if implementation of S is correct
+        this->materialTesting(pressure, rightCauchyGreen, inverseRightCauchyGreen, reducedInvariants, deformationGradientDeterminant, fiberDirection, fictitiousPK2Stress, pk2StressIsochoric);
 
-      if (Vc::any_of(deformationGradientDeterminant < 1e-12))   // if any entry of the deformation gradient is negative
-      {
+        VLOG(2) << "";
+        VLOG(2) << "element " << elementNoLocal << " xi: " << xi;
+        VLOG(2) << "  geometryReferenceValues: " << geometryReferenceValues;
+        VLOG(2) << "  displacementsValues: " << displacementsValues;
+        VLOG(2) << "  Jacobian: J_phi=" << jacobianMaterial;
+        VLOG(2) << "  jacobianDeterminant: J=" << jacobianDeterminant;
+        VLOG(2) << "  inverseJacobianMaterial: J_phi^-1=" << inverseJacobianMaterial;
+        VLOG(2) << "  deformationGradient: F=" << deformationGradient;
+        VLOG(2) << "  deformationGradientDeterminant: det F=" << deformationGradientDeterminant;
+        VLOG(2) << "  rightCauchyGreen: C=" << rightCauchyGreen;
+        VLOG(2) << "  rightCauchyGreenDeterminant: det C=" << rightCauchyGreenDeterminant;
+        VLOG(2) << "  inverseRightCauchyGreen: C^-1=" << inverseRightCauchyGreen;
+        VLOG(2) << "  invariants: I1,I2,I3: " << invariants;
+        VLOG(2) << "  reducedInvariants: Ibar1, Ibar2: " << reducedInvariants;
+        VLOG(2) << "  pressure/artificialPressure: " << pressure;
+        //VLOG(2) << "  artificialPressure: p=" << artificialPressure << ", artificialPressureTilde: pTilde=" << artificialPressureTilde;
+        VLOG(2) << "  pK2Stress: S=" << pK2Stress;
+        VLOG(2) << "  gradPhi: " << gradPhi;
+
+        VLOG(1) << "  sampling point " << samplingPointIndex << "/" << samplingPoints.size() << ", xi: " << xi << ", J: " << deformationGradientDeterminant << ", p: " << pressure << ", S11: " << pK2Stress[0][0];
+
+        if (Vc::any_of(deformationGradientDeterminant < 1e-12))   // if any entry of the deformation gradient is negative
+        {
 #ifndef HAVE_STDSIMD
-        LOG(WARNING) << "Deformation gradient " << deformationGradient << " has zero or negative determinant " << deformationGradientDeterminant
-          << std::endl << "Geometry values in element " << elementNoLocal << ": " << geometryReferenceValues << std::endl
-          << "Displacements at xi " << xi << ": " << displacementsValues;
+          LOG(WARNING) << "Deformation gradient " << deformationGradient << " has zero or negative determinant " << deformationGradientDeterminant
+            << std::endl << "Geometry values in element " << elementNoLocal << ": " << geometryReferenceValues << std::endl
+            << "Displacements at xi " << xi << ": " << displacementsValues;
 #else
-        LOG(WARNING) << "Deformation gradient has zero or negative determinant";
+          LOG(WARNING) << "Deformation gradient has zero or negative determinant";
 #endif
 
-        this->lastSolveSucceeded_ = false;
-      }
-
-      // add contributions of submatrix uu (upper left)
+          this->lastSolveSucceeded_ = false;
+        }
 
-      // loop over pairs basis functions and evaluate integrand at xi
-      for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)    // index over dofs, each dof has D components, L in derivation
-      {
-        for (int aComponent = 0; aComponent < D; aComponent++)     // lower-case a in derivation, index over displacements components
+        // store the quadrature point values for the matrix-free jacobian, the tangent k_abBD is the same as in the integrand of submatrix uu
+        if (this->useMatrixFreeJacobian_)
         {
+          HyperelasticityMatrixFreeQuadraturePointValues &matrixFreeValues = matrixFreeQuadraturePointValues_[elementChunkNo*nQuadraturePoints + samplingPointIndex];
 
-          for (int bDof = 0; bDof < nDisplacementsDofsPerElement; bDof++)  // index over dofs, each dof has D components, M in derivation
+          for (int aComponent = 0; aComponent < D; aComponent++)
           {
-            for (int bComponent = 0; bComponent < D; bComponent++)     // lower-case b in derivation, index over displacements components
+            for (int bComponent = 0; bComponent < D; bComponent++)
             {
-              double_v_t integrand = 0.0;
-
-              for (int bInternal = 0; bInternal < D; bInternal++)     // capital B in derivation
+              for (int bInternal = 0; bInternal < D; bInternal++)
               {
-                for (int dInternal = 0; dInternal < D; dInternal++)     // capital D in derivation
+                for (int dInternal = 0; dInternal < D; dInternal++)
                 {
-                  // compute integrand phi_La,B * tilde{k}_abBD * phi_Mb,D
+                  const int delta_ab = (aComponent == bComponent? 1 : 0);
+                  double_v_t k_abBD = delta_ab * pK2Stress[dInternal][bInternal];
 
-                  // ----------------------------
-                  // compute derivatives of phi
-                  double_v_t dphiL_dXB = 0.0;
-                  double_v_t dphiM_dXD = 0.0;
+                  for (int cInternal = 0; cInternal < D; cInternal++)
+                  {
+                    for (int aInternal = 0; aInternal < D; aInternal++)
+                    {
+                      k_abBD += deformationGradient[aInternal][aComponent] * deformationGradient[cInternal][bComponent]
+                        * elasticityTensor[dInternal][cInternal][bInternal][aInternal];
+                    }
+                  }
+                  matrixFreeValues.tangent[((aComponent*D + bComponent)*D + bInternal)*D + dInternal] = k_abBD;
+                }
+              }
+            }
+          }
 
-                  // helper index k for multiplication with inverse Jacobian
-                  for (int k = 0; k < D; k++)
+          matrixFreeValues.inverseJacobianMaterial = inverseJacobianMaterial;
+          for (int i = 0; i < D; i++)
+          {
+            for (int j = 0; j < D; j++)
+            {
+              matrixFreeValues.scaledInverseDeformationGradient[i][j] = deformationGradientDeterminant * inverseDeformationGradient[i][j];
+            }
+          }
+          matrixFreeValues.integrationFactor = quadratureWeights[samplingPointIndex] * integrationFactor;
+        }
+
+        // the element matrices are only needed for the assembled jacobian
+        if (!assembleJacobianMatrix)
+          continue;
+
+        // add contributions of submatrix uu (upper left)
+
+        // loop over pairs basis functions and evaluate integrand at xi
+        for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)    // index over dofs, each dof has D components, L in derivation
+        {
+          for (int aComponent = 0; aComponent < D; aComponent++)     // lower-case a in derivation, index over displacements components
+          {
+
+            for (int bDof = 0; bDof < nDisplacementsDofsPerElement; bDof++)  // index over dofs, each dof has D components, M in derivation
+            {
+              for (int bComponent = 0; bComponent < D; bComponent++)     // lower-case b in derivation, index over displacements components
+              {
+                double_v_t integrand = 0.0;
+
+                for (int bInternal = 0; bInternal < D; bInternal++)     // capital B in derivation
+                {
+                  for (int dInternal = 0; dInternal < D; dInternal++)     // capital D in derivation
                   {
-                    // (column-major storage) gradPhi[L][k] = dphi_L / dxi_k
-                    // gradPhi[column][row] = gradPhi[dofIndex][k] = dphi_dofIndex/dxi_k, columnIdx = dofIndex, rowIdx = which direction
+                    // compute integrand phi_La,B * tilde{k}_abBD * phi_Mb,D
 
-                    // compute dphiL/dXB from dphiL/dxik and dxik/dXB
-                    const double dphiL_dxik = gradPhi[aDof][k];    // dphi_L/dxik
-                    const double_v_t dxik_dXB = inverseJacobianMaterial[bInternal][k];  // inverseJacobianMaterial[B][k] = J^{-1}_kB = dxi_k/dX_B
+                    // ----------------------------
+                    // compute derivatives of phi
+                    double_v_t dphiL_dXB = 0.0;
+                    double_v_t dphiM_dXD = 0.0;
 
-                    dphiL_dXB += dphiL_dxik * dxik_dXB;
+                    // helper index k for multiplication with inverse Jacobian
+                    for (int k = 0; k < D; k++)
+                    {
+                      // (column-major storage) gradPhi[L][k] = dphi_L / dxi_k
+                      // gradPhi[column][row] = gradPhi[dofIndex][k] = dphi_dofIndex/dxi_k, columnIdx = dofIndex, rowIdx = which direction
 
-                    // compute dphiM/dXD from dphiM/dxik and dxik/dXD
-                    const double dphiM_dxik = gradPhi[bDof][k];    // dphi_M/dxik
-                    const double_v_t dxik_dXD = inverseJacobianMaterial[dInternal][k];  // inverseJacobianMaterial[D][k] = J^{-1}_kD = dxi_k/dX_D
+                      // compute dphiL/dXB from dphiL/dxik and dxik/dXB
+                      const double dphiL_dxik = gradPhi[aDof][k];    // dphi_L/dxik
+                      const double_v_t dxik_dXB = inverseJacobianMaterial[bInternal][k];  // inverseJacobianMaterial[B][k] = J^{-1}_kB = dxi_k/dX_B
 
-                    dphiM_dXD += dphiM_dxik * dxik_dXD;
-                  }   // k
+                      dphiL_dXB += dphiL_dxik * dxik_dXB;
 
-                  const double_v_t sBD = pK2Stress[dInternal][bInternal];
-                  const int delta_ab = (aComponent == bComponent? 1 : 0);
+                      // compute dphiM/dXD from dphiM/dxik and dxik/dXD
+                      const double dphiM_dxik = gradPhi[bDof][k];    // dphi_M/dxik
+                      const double_v_t dxik_dXD = inverseJacobianMaterial[dInternal][k];  // inverseJacobianMaterial[D][k] = J^{-1}_kD = dxi_k/dX_D
 
-                  double_v_t k_abBD = delta_ab * sBD;
+                      dphiM_dXD += dphiM_dxik * dxik_dXD;
+                    }   // k
 
-                  for (int cInternal = 0; cInternal < D; cInternal++)     // capital C in derivation
-                  {
-                    for (int aInternal = 0; aInternal < D; aInternal++)     // capital A in derivation
+                    const double_v_t sBD = pK2Stress[dInternal][bInternal];
+                    const int delta_ab = (aComponent == bComponent? 1 : 0);
+
+                    double_v_t k_abBD = delta_ab * sBD;
+
+                    for (int cInternal = 0; cInternal < D; cInternal++)     // capital C in derivation
                     {
-                      const double_v_t faA = deformationGradient[aInternal][aComponent];
-                      const double_v_t fbC = deformationGradient[cInternal][bComponent];
+                      for (int aInternal = 0; aInternal < D; aInternal++)     // capital A in derivation
+                      {
+                        const double_v_t faA = deformationGradient[aInternal][aComponent];
+                        const double_v_t fbC = deformationGradient[cInternal][bComponent];
 
-                      const double_v_t cABCD = elasticityTensor[dInternal][cInternal][bInternal][aInternal];  // get c_{ABCD}
+                        const double_v_t cABCD = elasticityTensor[dInternal][cInternal][bInternal][aInternal];  // get c_{ABCD}
 
-                      k_abBD += faA * fbC * cABCD;
-                    }   // A
-                  }   // C
+                        k_abBD += faA * fbC * cABCD;
+                      }   // A
+                    }   // C
 
-                  integrand += dphiL_dXB * k_abBD * dphiM_dXD;
+                    integrand += dphiL_dXB * k_abBD * dphiM_dXD;
 
-                }  // D
-              }  // B
+                  }  // D
+                }  // B
 
-              VLOG(2) << "   (L,a)=(" << aDof << "," << aComponent << "), integrand: " << integrand;
+                VLOG(2) << "   (L,a)=(" << aDof << "," << aComponent << "), integrand: " << integrand;
 
-              // compute index of degree of freedom and component (result vector index)
-              const int j = aDof*D + aComponent;
-              const int i = bDof*D + bComponent;
-              const int index = j*nUnknowsPerElement + i;
+                // compute index of degree of freedom and component (result vector index)
+                const int j = aDof*D + aComponent;
+                const int i = bDof*D + bComponent;
+                const int index = j*nUnknowsPerElement + i;
 
-              // store integrand in evaluations array
-              evaluationsArrayDisplacements[samplingPointIndex][index] = integrand * integrationFactor;
+                // store integrand in evaluations array
+                evaluationsArrayDisplacements[samplingPointIndex][index] = integrand * integrationFactor;
 
-            }  // b, bComponent
-          }   // M, bDof
-        }  // a, aComponent
-      }  // L, aDof
+              }  // b, bComponent
+            }   // M, bDof
+          }  // a, aComponent
+        }  // L, aDof
 
-      // add contributions of submatrix up and pu (lower left and upper right), only for incompressible formulation
-      if (Term::isIncompressible)
-      {
-        // loop over indices of unknows aDof,(bDof,bComponent) or L,(M,b)
-        for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)           // L
+        // add contributions of submatrix up and pu (lower left and upper right), only for incompressible formulation
+        if (Term::isIncompressible)
         {
-          for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)    // M
+          // loop over indices of unknows aDof,(bDof,bComponent) or L,(M,b)
+          for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)           // L
           {
-            for (int aComponent = 0; aComponent < D; aComponent++)           // a
+            for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)    // M
             {
-              double_v_t fInv_Ba_dphiM_dXB = 0.0;
-
-              for (int bInternal = 0; bInternal < D; bInternal++)     // capital B in derivation
+              for (int aComponent = 0; aComponent < D; aComponent++)           // a
               {
-                // compute derivatives of phi
-                double_v_t dphiM_dXB = 0.0;
+                double_v_t fInv_Ba_dphiM_dXB = 0.0;
 
-                // helper index k for multiplication with inverse Jacobian
-                for (int k = 0; k < D; k++)
+                for (int bInternal = 0; bInternal < D; bInternal++)     // capital B in derivation
                 {
-                  // (column-major storage) gradPhi[L][k] = dphi_L / dxi_k
-                  // gradPhi[column][row] = gradPhi[dofIndex][k] = dphi_dofIndex/dxi_k, columnIdx = dofIndex, rowIdx = which direction
+                  // compute derivatives of phi
+                  double_v_t dphiM_dXB = 0.0;
+
+                  // helper index k for multiplication with inverse Jacobian
+                  for (int k = 0; k < D; k++)
+                  {
+                    // (column-major storage) gradPhi[L][k] = dphi_L / dxi_k
+                    // gradPhi[column][row] = gradPhi[dofIndex][k] = dphi_dofIndex/dxi_k, columnIdx = dofIndex, rowIdx = which direction
+
+                    // compute dphiM/dXB from dphiM/dxik and dxik/dXB
+                    const double dphiM_dxik = gradPhi[aDof][k];    // dphi_M/dxik
+                    const double_v_t dxik_dXB = inverseJacobianMaterial[bInternal][k];  // inverseJacobianMaterial[B][k] = J^{-1}_kB = dxi_k/dX_B
 
-                  // compute dphiM/dXB from dphiM/dxik and dxik/dXB
-                  const double dphiM_dxik = gradPhi[aDof][k];    // dphi_M/dxik
-                  const double_v_t dxik_dXB = inverseJacobianMaterial[bInternal][k];  // inverseJacobianMaterial[B][k] = J^{-1}_kB = dxi_k/dX_B
+                    dphiM_dXB += dphiM_dxik * dxik_dXB;
+                  }   // k
 
-                  dphiM_dXB += dphiM_dxik * dxik_dXB;
-                }   // k
+                  const double_v_t fInv_Ba = inverseDeformationGradient[aComponent][bInternal];
 
-                const double_v_t fInv_Ba = inverseDeformationGradient[aComponent][bInternal];
+                  fInv_Ba_dphiM_dXB += fInv_Ba * dphiM_dXB;
+                }
 
-                fInv_Ba_dphiM_dXB += fInv_Ba * dphiM_dXB;
-              }
+                // compute integrand J * psi_L * (F^-1)_Ba * phi_Ma,B
+
+                const double_v_t psiL = pressureFunctionSpace->phi(lDof,xi);
+                const double_v_t integrand = deformationGradientDeterminant * psiL * fInv_Ba_dphiM_dXB;
+
+                // compute index of degree of freedom and component (result vector index)
+                const int j = lDof;
+                const int i = aDof*D + aComponent;
+                const int index = j*nUnknowsPerElement + i;
 
-              // compute integrand J * psi_L * (F^-1)_Ba * phi_Ma,B
+                // store integrand in evaluations array
+                evaluationsArrayPressure[samplingPointIndex][index] = integrand * integrationFactor;
 
-              const double_v_t psiL = pressureFunctionSpace->phi(lDof,xi);
-              const double_v_t integrand = deformationGradientDeterminant * psiL * fInv_Ba_dphiM_dXB;
+              }  // a
+            }  // M
+          }  // L
+        }  // if incompressible
+
+        // add contributions of submatrix uv (top-center, only for dynamic problem)
+        if (nDisplacementComponents == 6)
+        {
+          for (int lDof = 0; lDof < nDisplacementsDofsPerElement; lDof++)    // index over dofs, each dof has D components, L in derivation
+          {
+            for (int mDof = 0; mDof < nDisplacementsDofsPerElement; mDof++)  // index over dofs, each dof has D components, M in derivation
+            {
+              // integrate ∫_Ω ρ0 ϕ^L ϕ^M dV, the actual needed value is 1/dt δ_ab ∫_Ω ρ0 ϕ^L ϕ^M dV, but this will be computed later
+              const double integrand = this->density_ * displacementsFunctionSpace->phi(lDof, xi) * displacementsFunctionSpace->phi(mDof, xi);
 
               // compute index of degree of freedom and component (result vector index)
-              const int j = lDof;
-              const int i = aDof*D + aComponent;
-              const int index = j*nUnknowsPerElement + i;
+              const int index = lDof*nDisplacementsDofsPerElement + mDof;
 
               // store integrand in evaluations array
-              evaluationsArrayPressure[samplingPointIndex][index] = integrand * integrationFactor;
+              evaluationsArrayUV[samplingPointIndex][index] = integrand * integrationFactor;
+            }   // M, mDof
+          }   // L, lDof
 
-            }  // a
-          }  // M
-        }  // L
-      }  // if incompressible
+        }  // if dynamic problem
+      }   // sampling points
 
-      // add contributions of submatrix uv (top-center, only for dynamic problem)
-      if (nDisplacementComponents == 6)
+      // integrate all values for result vector entries at once
+      if (assembleJacobianMatrix)
       {
-        for (int lDof = 0; lDof < nDisplacementsDofsPerElement; lDof++)    // index over dofs, each dof has D components, L in derivation
-        {
-          for (int mDof = 0; mDof < nDisplacementsDofsPerElement; mDof++)  // index over dofs, each dof has D components, M in derivation
-          {
-            // integrate ∫_Ω ρ0 ϕ^L ϕ^M dV, the actual needed value is 1/dt δ_ab ∫_Ω ρ0 ϕ^L ϕ^M dV, but this will be computed later
-            const double integrand = this->density_ * displacementsFunctionSpace->phi(lDof, xi) * displacementsFunctionSpace->phi(mDof, xi);
-
-            // compute index of degree of freedom and component (result vector index)
-            const int index = lDof*nDisplacementsDofsPerElement + mDof;
+        integratedValuesDisplacements = QuadratureDD::computeIntegral(evaluationsArrayDisplacements);
 
-            // store integrand in evaluations array
-            evaluationsArrayUV[samplingPointIndex][index] = integrand * integrationFactor;
-          }   // M, mDof
-        }   // L, lDof
+        if (Term::isIncompressible)
+        {
+          integratedValuesPressure = QuadratureDD::computeIntegral(evaluationsArrayPressure);
+        }
 
-      }  // if dynamic problem
-    }   // sampling points
+        if (nDisplacementComponents == 6)
+        {
+          integratedValuesUV = QuadratureDD::computeIntegral(evaluationsArrayUV);
+        }
+      }
 
-    // integrate all values for result vector entries at once
-    EvaluationsDisplacementsType integratedValuesDisplacements = QuadratureDD::computeIntegral(evaluationsArrayDisplacements);
+      // store the element contributions and the state for which they were computed
+      if (storeElementJacobianValues)
+      {
+        if (assembleJacobianMatrix)
+        {
+          typename std::vector<double_v_t>::iterator elementJacobianValuesIter = elementJacobianValues_.begin() + elementChunkNo*nElementJacobianValues;
+          elementJacobianValuesIter = std::copy(integratedValuesDisplacements.begin(), integratedValuesDisplacements.end(), elementJacobianValuesIter);
+          elementJacobianValuesIter = std::copy(integratedValuesPressure.begin(), integratedValuesPressure.end(), elementJacobianValuesIter);
+          std::copy(integratedValuesUV.begin(), integratedValuesUV.end(), elementJacobianValuesIter);
+        }
 
-    EvaluationsPressureType integratedValuesPressure;
-    if (Term::isIncompressible)
-    {
-      integratedValuesPressure = QuadratureDD::computeIntegral(evaluationsArrayPressure);
-    }
+        const int nElementStateValues = elementState.size();
+        elementJacobianStates_.resize(nElementChunks*nElementStateValues);
+        std::copy(elementState.begin(), elementState.end(), elementJacobianStates_.begin() + elementChunkNo*nElementStateValues);
+        elementJacobianValid_[elementChunkNo] = true;
+      }
+    }   // if not reuseElementJacobian
 
-    EvaluationsUVType integratedValuesUV;
-    if (nDisplacementComponents == 6)
-    {
-      integratedValuesUV = QuadratureDD::computeIntegral(evaluationsArrayUV);
-    }
+    if (!assembleJacobianMatrix)
+      continue;
 
     // get indices of element-local dofs
     std::array<dof_no_v_t,nDisplacementsDofsPerElement> dofNosLocal = displacementsFunctionSpace->getElementDofNosLocal(elementNoLocalv);
@@ -1515,7 +1744,12 @@ materialComputeJacobian()
     }
   }  // local elements
 
-  combinedMatrixJacobian_->assembly(MAT_FINAL_ASSEMBLY);
+  this->nReusedElementJacobiansTotal_ += nReusedElementChunks;
+  if (this->jacobianReassemblyTolerance_ > 0)
+    LOG(DEBUG) << "jacobian: reused the element contributions of " << nReusedElementChunks << " of " << nElementChunks << " element chunks";
+
+  if (assembleJacobianMatrix)
+    combinedMatrixJacobian_->assembly(MAT_FINAL_ASSEMBLY);
 
   if (!this->lastSolveSucceeded_)
   {
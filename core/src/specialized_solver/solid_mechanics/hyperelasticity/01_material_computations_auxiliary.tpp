@@ -340,5 +340,42 @@ computePSbar(const Tensor2<3,double_v_t> &fictitiousPK2Stress, const Tensor2<3,d
   return PSbar;
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+getElementState(const std::array<Vec3_v_t,DisplacementsFunctionSpace::nDofsPerElement()> &displacementsValues,
+                const std::array<double_v_t,PressureFunctionSpace::nDofsPerElement()> &pressureValues,
+                const std::array<Vec3_v_t,DisplacementsFunctionSpace::nDofsPerElement()> &fiberDirectionValues,
+                std::vector<double_v_t> &elementState)
+{
+  elementState.clear();
+
+  // displacements
+  for (const Vec3_v_t &value : displacementsValues)
+    elementState.insert(elementState.end(), value.begin(), value.end());
+
+  // pressure, only the incompressible formulation has the pressure as unknown
+  if (Term::isIncompressible)
+    elementState.insert(elementState.end(), pressureValues.begin(), pressureValues.end());
+
+  // fiber direction
+  for (const Vec3_v_t &value : fiberDirectionValues)
+    elementState.insert(elementState.end(), value.begin(), value.end());
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+bool HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+elementStateChanged(const std::vector<double_v_t> &elementState, const std::vector<double_v_t> &elementStates, int elementChunkNo, double tolerance)
+{
+  const int nElementStateValues = elementState.size();
+
+  for (int i = 0; i < nElementStateValues; i++)
+  {
+    const double_v_t difference = elementState[i] - elementStates[elementChunkNo*nElementStateValues + i];
+    if (Vc::any_of(MathUtility::abs(difference) > tolerance))
+      return true;
+  }
+  return false;
+}
+
 } // namespace
 
@@ -36,14 +36,16 @@ computeElasticityTensor(const Tensor2<3,double_v_t> &rightCauchyGreen,         /
   const bool usesFormulationWithC = typeid(decltype(Term::strainEnergyDensityFunctionCoupledDependentOnC)) != typeid(decltype(INT(0)));
 
   // Ibar1, Ibar2, Ibar4, Ibar5, J, I1, I2, I3, C11, C12, C13, C22, C23, C33, a1, a2, a3
-  std::vector<double_v_t> parameterVector = {
+  // the storage of the variables is a member such that it is reused and not allocated again at every quadrature point
+  ExpressionVariables<double_v_t> &parameterVector = std::get<ExpressionVariables<double_v_t>>(expressionVariables_);
+  parameterVector.set({
     reducedInvariants[0], reducedInvariants[1], reducedInvariants[3], reducedInvariants[4],  // Ibar1, Ibar2, Ibar4, Ibar5
     deformationGradientDeterminant,                                                          // J
     invariants[0], invariants[1], invariants[2],                                             // I1, I2, I3
     rightCauchyGreen[0][0], rightCauchyGreen[1][0], rightCauchyGreen[2][0],                  // C11, C12, C13
     rightCauchyGreen[1][1], rightCauchyGreen[2][1], rightCauchyGreen[2][2],                  // C22, C23, C33
     fiberDirection[0], fiberDirection[1], fiberDirection[2]                                  // a1, a2, a3
-  };
+  });
 
   // compute preliminary variables that are independent of the indices a,b,c,d
   // decoupled form of strain energy function
@@ -0,0 +1,380 @@
+#include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations.h"
+
+#include <Python.h>  // has to be the first included header
+#include <cmath>
+
+#include "utility/math_utility.h"
+#include "utility/mpi_utility.h"
+
+namespace SpatialDiscretization
+{
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+materialComputeLumpedMass()
+{
+  // compute the row sums of the consistent mass matrix, m^L = sum_M int_Ω rho_0 phi^L phi^M dV = int_Ω rho_0 phi^L dV, because sum_M phi^M = 1
+  assert (nDisplacementComponents == 6);
+
+  LOG(DEBUG) << "materialComputeLumpedMass";
+
+  const int D = 3;  // dimension
+  std::shared_ptr<DisplacementsFunctionSpace> functionSpace = this->data_.displacementsFunctionSpace();
+  const int nDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
+  const dof_no_t nDofsLocalWithoutGhosts = displacementsFunctionSpace_->meshPartition()->nDofsLocalWithoutGhosts();
+
+  // define shortcuts for quadrature
+  typedef Quadrature::TensorProduct<D,Quadrature::Gauss<3>> QuadratureDD;   // quadratic*quadratic = 4th order polynomial, 3 gauss points = 2*3-1 = 5th order exact
+
+  // define type to hold evaluations of integrand
+  typedef std::array<double, nDofsPerElement> EvaluationsType;
+  std::array<EvaluationsType, QuadratureDD::numberEvaluations()> evaluationsArray{};
+
+  // setup arrays used for integration
+  std::array<Vec3, QuadratureDD::numberEvaluations()> samplingPoints = QuadratureDD::samplingPoints();
+
+  // the lumped mass is assembled in a temporary vector, such that the contributions of ghost dofs are added up
+  std::shared_ptr<VecHyperelasticity> combinedVecLumpedMass = this->createPartitionedPetscVec("combinedVecLumpedMass");
+  combinedVecLumpedMass->setRepresentationGlobal();
+  combinedVecLumpedMass->zeroEntries();
+  combinedVecLumpedMass->startGhostManipulation();
+
+  functionSpace->geometryField().setRepresentationGlobal();
+  functionSpace->geometryField().startGhostManipulation();   // ensure that local ghost values of geometry field are set
+
+  // loop over elements
+  for (element_no_t elementNoLocal = 0; elementNoLocal < functionSpace->nElementsLocal(); elementNoLocal++)
+  {
+    // get geometry field values of the reference configuration
+    std::array<Vec3,DisplacementsFunctionSpace::nDofsPerElement()> geometry;
+    functionSpace->getElementGeometry(elementNoLocal, geometry);
+
+    // evaluate integrand at sampling points
+    for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+    {
+      std::array<double,D> xi = samplingPoints[samplingPointIndex];
+
+      // compute the 3xD jacobian of the parameter space to world space mapping
+      auto jacobian = DisplacementsFunctionSpace::computeJacobian(geometry, xi);
+      double integrationFactor = MathUtility::computeIntegrationFactor(jacobian);
+
+      for (unsigned int elementalDofNoL = 0; elementalDofNoL < nDofsPerElement; elementalDofNoL++)   // dof index L
+      {
+        evaluationsArray[samplingPointIndex][elementalDofNoL] = this->density_ * DisplacementsFunctionSpace::phi(elementalDofNoL,xi) * integrationFactor;
+      }
+    }  // function evaluations
+
+    // integrate all values for the L dofs at once
+    EvaluationsType integratedValues = QuadratureDD::computeIntegral(evaluationsArray);
+
+    std::array<dof_no_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocal);
+
+    // add integrated entries to the lumped mass vector, the same value for every displacement component
+    for (unsigned int elementalDofNoL = 0; elementalDofNoL < nDofsPerElement; elementalDofNoL++)   // dof index L
+    {
+      for (int dimensionNo = 0; dimensionNo < 3; dimensionNo++)
+      {
+        combinedVecLumpedMass->setValue(dimensionNo, dofNosLocal[elementalDofNoL], integratedValues[elementalDofNoL], ADD_VALUES);
+      }
+    }
+  }  // elementNoLocal
+
+  combinedVecLumpedMass->finishGhostManipulation();     // communicate and add up values in ghost buffers
+
+  // determine which local dofs are prescribed by Dirichlet boundary conditions, these are not updated by the explicit scheme
+  for (int componentNo = 0; componentNo < nDisplacementComponents; componentNo++)
+  {
+    isDirichletDofLocal_[componentNo].assign(nDofsLocalWithoutGhosts, false);
+    for (dof_no_t dofNoLocal : this->dirichletBoundaryConditions_->boundaryConditionsByComponent()[componentNo].dofNosLocal)
+    {
+      if (dofNoLocal < nDofsLocalWithoutGhosts)
+        isDirichletDofLocal_[componentNo][dofNoLocal] = true;
+    }
+  }
+
+  // get the local values, the entries of Dirichlet dofs are not set and not used
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    lumpedMass_[componentNo].resize(nDofsLocalWithoutGhosts);
+    combinedVecLumpedMass->getValues(componentNo, nDofsLocalWithoutGhosts, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(),
+                                     lumpedMass_[componentNo].data());
+
+    for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+    {
+      if (!isDirichletDofLocal_[componentNo][dofNoLocal] && lumpedMass_[componentNo][dofNoLocal] <= 0)
+      {
+        LOG(FATAL) << "The lumped mass of dof " << dofNoLocal << ", component " << componentNo << " is " << lumpedMass_[componentNo][dofNoLocal]
+          << ", but it has to be positive for the explicit time integration. Check the density and the mesh.";
+      }
+    }
+  }
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+bool HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+materialComputeExplicitForces(std::array<std::vector<double>,3> &forces)
+{
+  const dof_no_t nDofsLocalWithoutGhosts = displacementsFunctionSpace_->meshPartition()->nDofsLocalWithoutGhosts();
+
+  // copy the solution values to this->data_.displacements(), this->data_.velocities() and this->data_.pressure()
+  setUVP(solverVariableSolution_);
+
+  // compute δW_int in solverVariableResidual_
+  if (!materialComputeInternalVirtualWork())
+    return false;
+
+  // compute δW_int - δW_ext,dead
+  PetscErrorCode ierr;
+  ierr = VecAXPY(solverVariableResidual_, -1.0, externalVirtualWorkDead_);
+  if (ierr)
+    return false;
+
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    forces[componentNo].resize(nDofsLocalWithoutGhosts);
+    combinedVecResidual_->getValues(componentNo, nDofsLocalWithoutGhosts, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(),
+                                    forces[componentNo].data());
+  }
+  return true;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+setSolutionComponentValues(int componentNoBegin, const std::array<std::vector<double>,3> &values)
+{
+  combinedVecSolution_->startGhostManipulation();
+
+  // setValues does not change the values of Dirichlet dofs
+  for (int i = 0; i < 3; i++)
+  {
+    combinedVecSolution_->setValues(componentNoBegin+i, displacementsFunctionSpace_->meshPartition()->nDofsLocalWithoutGhosts(),
+                                    displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(), values[i].data(), INSERT_VALUES);
+  }
+
+  combinedVecSolution_->zeroGhostBuffer();
+  combinedVecSolution_->finishGhostManipulation();
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+double HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+estimateCriticalTimeStepWidth()
+{
+  // the critical time step width of the central difference scheme is dt_crit = 2/ω_max, where ω_max^2 = λ_max is the largest eigenvalue of M_L^-1 K.
+  // λ_max is estimated by a power iteration, the products K*w are computed by finite differences of the internal forces, K*w ≈ (F(u + ε w) - F(u)) / ε
+
+  const dof_no_t nDofsLocalWithoutGhosts = displacementsFunctionSpace_->meshPartition()->nDofsLocalWithoutGhosts();
+  MPI_Comm mpiCommunicator = displacementsFunctionSpace_->meshPartition()->rankSubset()->mpiCommunicator();
+
+  const int maximumNumberOfIterations = 50;
+  const double relativeTolerance = 1e-3;
+
+  // get the current displacements and forces
+  std::array<std::vector<double>,3> displacements0;
+  std::array<std::vector<double>,3> forces0;
+  std::array<std::vector<double>,3> forces;
+  std::array<std::vector<double>,3> displacements;
+  std::array<std::vector<double>,3> w;
+
+  double maximumDisplacement = 0;
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    displacements0[componentNo].resize(nDofsLocalWithoutGhosts);
+    combinedVecSolution_->getValues(componentNo, nDofsLocalWithoutGhosts, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(),
+                                    displacements0[componentNo].data());
+
+    // initialize w with an oscillating pattern that excites the high frequency modes, this gives fast convergence of the power iteration
+    w[componentNo].resize(nDofsLocalWithoutGhosts);
+    for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+    {
+      w[componentNo][dofNoLocal] = 0;
+      if (!isDirichletDofLocal_[componentNo][dofNoLocal])
+        w[componentNo][dofNoLocal] = ((dofNoLocal + componentNo) % 2 == 0? 1.0 : -1.0) * (1.0 + 0.1*((dofNoLocal*7) % 11));
+
+      maximumDisplacement = std::max(maximumDisplacement, fabs(displacements0[componentNo][dofNoLocal]));
+    }
+  }
+  MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, &maximumDisplacement, 1, MPI_DOUBLE, MPI_MAX, mpiCommunicator), "MPI_Allreduce");
+
+  if (!materialComputeExplicitForces(forces0))
+  {
+    LOG(ERROR) << "Could not compute the internal forces to estimate the critical time step width of the explicit scheme.";
+    return this->timeStepWidth_;
+  }
+
+  // the step width of the finite differences, like the default of the PETSc matrix-free differencing
+  const double epsilon = 1e-8 * (1.0 + maximumDisplacement);
+
+  double lambdaMax = 0;
+  int iterationNo = 0;
+  for (; iterationNo < maximumNumberOfIterations; iterationNo++)
+  {
+    // normalize w to maximum norm 1
+    double wNorm = 0;
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+      for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+        wNorm = std::max(wNorm, fabs(w[componentNo][dofNoLocal]));
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, &wNorm, 1, MPI_DOUBLE, MPI_MAX, mpiCommunicator), "MPI_Allreduce");
+
+    if (wNorm == 0)
+      break;
+
+    // set perturbed displacements u + ε w
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      displacements[componentNo].resize(nDofsLocalWithoutGhosts);
+      for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+      {
+        w[componentNo][dofNoLocal] /= wNorm;
+        displacements[componentNo][dofNoLocal] = displacements0[componentNo][dofNoLocal] + epsilon * w[componentNo][dofNoLocal];
+      }
+    }
+    setSolutionComponentValues(0, displacements);
+
+    if (!materialComputeExplicitForces(forces))
+      break;
+
+    // compute z = M_L^-1 K w and the Rayleigh quotient λ = (w•M_L z)/(w•M_L w), the new w is z
+    double wMz = 0;
+    double wMw = 0;
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+      {
+        if (isDirichletDofLocal_[componentNo][dofNoLocal])
+          continue;
+
+        double mass = lumpedMass_[componentNo][dofNoLocal];
+        double z = (forces[componentNo][dofNoLocal] - forces0[componentNo][dofNoLocal]) / (epsilon * mass);
+
+        wMz += w[componentNo][dofNoLocal] * mass * z;
+        wMw += w[componentNo][dofNoLocal] * mass * w[componentNo][dofNoLocal];
+        w[componentNo][dofNoLocal] = z;
+      }
+    }
+    std::array<double,2> products({wMz, wMw});
+    MPIUtility::handleReturnValue(MPI_Allreduce(MPI_IN_PLACE, products.data(), 2, MPI_DOUBLE, MPI_SUM, mpiCommunicator), "MPI_Allreduce");
+
+    double lambda = products[0] / products[1];
+    VLOG(1) << "power iteration " << iterationNo << ", λ: " << lambda;
+
+    if (fabs(lambda - lambdaMax) < relativeTolerance * fabs(lambda))
+    {
+      lambdaMax = lambda;
+      break;
+    }
+    lambdaMax = lambda;
+  }
+
+  // restore the displacements
+  setSolutionComponentValues(0, displacements0);
+  setUVP(solverVariableSolution_);
+
+  if (lambdaMax <= 0)
+  {
+    LOG(WARNING) << "Could not estimate the critical time step width of the explicit scheme (λ_max = " << lambdaMax << "), "
+      << "set \"explicitTimeStepWidth\" to a value that is small enough. Using the time step width " << this->timeStepWidth_ << ".";
+    return this->timeStepWidth_;
+  }
+
+  double criticalTimeStepWidth = 2.0 / sqrt(lambdaMax);
+  LOG(DEBUG) << "estimateCriticalTimeStepWidth: λ_max = " << lambdaMax << " after " << iterationNo+1 << " iterations, dt_crit = " << criticalTimeStepWidth;
+
+  return criticalTimeStepWidth;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+bool HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+explicitTimeStep()
+{
+  // central difference scheme with velocities at the half time steps (leapfrog):
+  //   M_L a^(n) = δW_ext,dead - δW_int(u^(n)) - damping
+  //   v^(n+1/2) = v^(n-1/2) + dt a^(n)
+  //   u^(n+1) = u^(n) + dt v^(n+1/2)
+  // M_L is the lumped (diagonal) mass matrix, therefore no linear system has to be solved
+  // The velocities in solverVariableSolution_ are the half step values, i.e. the given velocities are v^(n-1/2) and the
+  // velocities after the time step are v^(n+1/2) of the last substep, half a substep behind the displacements u^(n+1).
+  // They are stored and written to the output as they are, without synchronization to the full time step.
+
+  assert (nDisplacementComponents == 6);
+  assert(combinedVecSolution_->currentRepresentation() == Partition::values_representation_t::representationCombinedGlobal);
+
+  const dof_no_t nDofsLocalWithoutGhosts = displacementsFunctionSpace_->meshPartition()->nDofsLocalWithoutGhosts();
+
+  // assemble the lumped mass matrix at the first call
+  if (lumpedMass_[0].empty())
+    materialComputeLumpedMass();
+
+  // determine the time step width of the explicit scheme at the first call
+  if (this->explicitTimeStepWidth_ == 0)
+  {
+    double criticalTimeStepWidth = estimateCriticalTimeStepWidth();
+    this->explicitTimeStepWidth_ = this->explicitTimeStepSafetyFactor_ * criticalTimeStepWidth;
+
+    LOG(INFO) << "Explicit time integration: estimated critical time step width " << criticalTimeStepWidth
+      << ", using " << this->explicitTimeStepWidth_ << " (explicitTimeStepSafetyFactor: " << this->explicitTimeStepSafetyFactor_ << ").";
+  }
+
+  // split the time step into substeps that are below the stable time step width
+  const int nSubsteps = std::max(1, (int)std::ceil(this->timeStepWidth_ / this->explicitTimeStepWidth_ - 1e-10));
+  const double dt = this->timeStepWidth_ / nSubsteps;
+
+  LOG(DEBUG) << "explicitTimeStep, " << nSubsteps << " substeps of width " << dt;
+
+  // get the current displacements and velocities
+  std::array<std::vector<double>,3> displacements;
+  std::array<std::vector<double>,3> velocities;
+  std::array<std::vector<double>,3> forces;
+
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    displacements[componentNo].resize(nDofsLocalWithoutGhosts);
+    velocities[componentNo].resize(nDofsLocalWithoutGhosts);
+    combinedVecSolution_->getValues(componentNo, nDofsLocalWithoutGhosts, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(),
+                                    displacements[componentNo].data());
+    combinedVecSolution_->getValues(3+componentNo, nDofsLocalWithoutGhosts, displacementsFunctionSpace_->meshPartition()->dofNosLocal().data(),
+                                    velocities[componentNo].data());
+  }
+
+  // the damping term int_Ω d v^L phi^L phi^M dV of the implicit scheme, lumped in the same way as the mass, gives d/rho_0 * m^L v^L
+  const double dampingFactor = this->dampingFactor_ / this->density_;
+
+  for (int substepNo = 0; substepNo < nSubsteps; substepNo++)
+  {
+    // compute δW_int - δW_ext,dead at the current displacements
+    if (!materialComputeExplicitForces(forces))
+    {
+      LOG(ERROR) << "Explicit time integration failed in substep " << substepNo << " of " << nSubsteps << " (negative jacobian). "
+        << "Decrease \"explicitTimeStepWidth\" or \"explicitTimeStepSafetyFactor\".";
+      return false;
+    }
+
+    // update velocities and displacements of all dofs that are not prescribed
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+      {
+        if (isDirichletDofLocal_[componentNo][dofNoLocal])
+          continue;
+
+        double &v = velocities[componentNo][dofNoLocal];
+        if (!isDirichletDofLocal_[3+componentNo][dofNoLocal])
+        {
+          double acceleration = -forces[componentNo][dofNoLocal] / lumpedMass_[componentNo][dofNoLocal] - dampingFactor * v;
+          v += dt * acceleration;
+        }
+
+        displacements[componentNo][dofNoLocal] += dt * v;
+      }
+    }
+
+    setSolutionComponentValues(0, displacements);
+    setSolutionComponentValues(3, velocities);
+  }
+
+  // copy the solution values back to this->data_.displacements() and this->data_.velocities()
+  setUVP(solverVariableSolution_);
+
+  return true;
+}
+
+}  // namespace SpatialDiscretization
@@ -0,0 +1,478 @@
+#include "specialized_solver/solid_mechanics/hyperelasticity/01_material_computations.h"
+
+#include <Python.h>  // has to be the first included header
+
+namespace SpatialDiscretization
+{
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+getMatrixFreeQuadraturePointValues(int elementNoLocal, int samplingPointIndex, std::array<double,81> &tangent,
+                                   Tensor2<3> &inverseJacobianMaterial, Tensor2<3> &scaledInverseDeformationGradient, double &integrationFactor)
+{
+  typedef Quadrature::TensorProduct<3,Quadrature::Gauss<3>> QuadratureDD;   // the same quadrature as in materialComputeJacobian
+  const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+
+  // the values are stored for chunks of nVcComponents elements, extract the values of the single element elementNoLocal
+  const int elementChunkNo = elementNoLocal / nVcComponents;
+  const HyperelasticityMatrixFreeQuadraturePointValues &values = matrixFreeQuadraturePointValues_[elementChunkNo*nQuadraturePoints + samplingPointIndex];
+
+  auto elementValue = [elementNoLocal](const double_v_t &value) -> double
+  {
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+    return (double)(value[elementNoLocal % nVcComponents]);
+#else
+    return value;
+#endif
+  };
+
+  for (int i = 0; i < 81; i++)
+  {
+    tangent[i] = elementValue(values.tangent[i]);
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      inverseJacobianMaterial[i][j] = elementValue(values.inverseJacobianMaterial[i][j]);
+      scaledInverseDeformationGradient[i][j] = elementValue(values.scaledInverseDeformationGradient[i][j]);
+    }
+  }
+  integrationFactor = elementValue(values.integrationFactor);
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+applyMatrixFreeJacobian(Vec x, Vec y)
+{
+  // compute y = J*x element by element with the quadrature point values of the last call to materialComputeJacobian(), no element matrices are used,
+  // the result is the same as with the assembled jacobian, except for the regularization of the pressure diagonal that is only needed for direct solvers
+  std::shared_ptr<DisplacementsFunctionSpace> displacementsFunctionSpace = this->data_.displacementsFunctionSpace();
+  std::shared_ptr<PressureFunctionSpace> pressureFunctionSpace = this->data_.pressureFunctionSpace();
+
+  const int D = 3;  // dimension
+  const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
+  const int nPressureDofsPerElement = PressureFunctionSpace::nDofsPerElement();
+  const int nElementsLocal = displacementsFunctionSpace->nElementsLocal();
+  const int pressureDofNo = nDisplacementComponents;  // 3 or 6, depending if static or dynamic problem
+
+  typedef Quadrature::TensorProduct<D,Quadrature::Gauss<3>> QuadratureDD;   // the same quadrature as in materialComputeJacobian
+  const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+
+  if (matrixFreeQuadraturePointValues_.size() != ((nElementsLocal + nVcComponents - 1) / nVcComponents) * nQuadraturePoints)
+  {
+    LOG(FATAL) << "The matrix-free jacobian is applied before the quadrature point values were computed.";
+  }
+
+  // evaluate the basis functions at the quadrature points, they are the same for all elements
+  std::array<Vec3,nQuadraturePoints> samplingPoints = QuadratureDD::samplingPoints();
+  std::array<std::array<Vec3,nDisplacementsDofsPerElement>,nQuadraturePoints> gradPhi;   // [samplingPointIndex][L][k] = dphi_L/dxi_k
+  std::array<std::array<double,nDisplacementsDofsPerElement>,nQuadraturePoints> phi;     // [samplingPointIndex][L] = phi_L
+  std::array<std::array<double,nPressureDofsPerElement>,nQuadraturePoints> psi;          // [samplingPointIndex][L] = psi_L
+
+  for (int samplingPointIndex = 0; samplingPointIndex < nQuadraturePoints; samplingPointIndex++)
+  {
+    const Vec3 xi = samplingPoints[samplingPointIndex];
+    gradPhi[samplingPointIndex] = displacementsFunctionSpace->getGradPhi(xi);
+
+    for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)
+      phi[samplingPointIndex][aDof] = displacementsFunctionSpace->phi(aDof, xi);
+
+    for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+      psi[samplingPointIndex][lDof] = pressureFunctionSpace->phi(lDof, xi);
+  }
+
+  // get the values of x including ghost values
+  PetscErrorCode ierr;
+  ierr = VecCopy(x, this->matrixFreeInput_->valuesGlobal()); CHKERRV(ierr);
+  this->matrixFreeInput_->startGhostManipulation();
+
+  // prepare the result vector, the element contributions to ghost dofs are added to the owning rank in finishGhostManipulation
+  this->matrixFreeOutput_->zeroEntries();
+  this->matrixFreeOutput_->startGhostManipulation();
+  this->matrixFreeOutput_->zeroGhostBuffer();
+
+  std::array<double,81> tangent;                  // k_abBD
+  Tensor2<D> inverseJacobianMaterial;             // dxi/dX
+  Tensor2<D> scaledInverseDeformationGradient;    // J*F^-1
+  double integrationFactor;
+
+  std::array<std::array<double,nDisplacementsDofsPerElement>,nDisplacementComponents> xDisplacements;     // [componentNo][aDof], values of u (and v) in the element
+  std::array<double,nPressureDofsPerElement> xPressure{};
+  std::array<std::array<double,nDisplacementsDofsPerElement>,3> yDisplacements;
+  std::array<double,nPressureDofsPerElement> yPressure;
+  std::array<Vec3,nDisplacementsDofsPerElement> dphi_dX;   // [L][B] = dphi_L/dX_B
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    // get indices of element-local dofs
+    std::array<dof_no_t,nDisplacementsDofsPerElement> dofNosLocal = displacementsFunctionSpace->getElementDofNosLocal(elementNoLocal);
+    std::array<dof_no_t,nPressureDofsPerElement> dofNosLocalPressure = pressureFunctionSpace->getElementDofNosLocal(elementNoLocal);
+
+    // get the input values of the element, prescribed dofs are not part of the system and get the value 0
+    for (int componentNo = 0; componentNo < nDisplacementComponents; componentNo++)
+    {
+      this->matrixFreeInput_->getValues(componentNo, nDisplacementsDofsPerElement, dofNosLocal.data(), xDisplacements[componentNo].data());
+      for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)
+      {
+        if (this->matrixFreeInput_->isPrescribed(componentNo, dofNosLocal[aDof]))
+          xDisplacements[componentNo][aDof] = 0;
+      }
+    }
+
+    if (Term::isIncompressible)
+    {
+      this->matrixFreeInput_->getValues(pressureDofNo, nPressureDofsPerElement, dofNosLocalPressure.data(), xPressure.data());
+      for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+      {
+        if (this->matrixFreeInput_->isPrescribed(pressureDofNo, dofNosLocalPressure[lDof]))
+          xPressure[lDof] = 0;
+      }
+    }
+
+    for (int aComponent = 0; aComponent < D; aComponent++)
+      yDisplacements[aComponent].fill(0.0);
+    yPressure.fill(0.0);
+
+    for (int samplingPointIndex = 0; samplingPointIndex < nQuadraturePoints; samplingPointIndex++)
+    {
+      getMatrixFreeQuadraturePointValues(elementNoLocal, samplingPointIndex, tangent, inverseJacobianMaterial, scaledInverseDeformationGradient, integrationFactor);
+
+      // compute dphi_L/dX_B = dphi_L/dxi_k * dxi_k/dX_B, inverseJacobianMaterial[B][k] = dxi_k/dX_B
+      for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)
+      {
+        for (int bInternal = 0; bInternal < D; bInternal++)
+        {
+          dphi_dX[aDof][bInternal] = 0;
+          for (int k = 0; k < D; k++)
+            dphi_dX[aDof][bInternal] += gradPhi[samplingPointIndex][aDof][k] * inverseJacobianMaterial[bInternal][k];
+        }
+      }
+
+      // gradient of the input displacements, gradX[b][D] = sum_M x_bM * dphi_M/dX_D
+      Tensor2<D> gradX{};
+      for (int bDof = 0; bDof < nDisplacementsDofsPerElement; bDof++)
+      {
+        for (int bComponent = 0; bComponent < D; bComponent++)
+        {
+          for (int dInternal = 0; dInternal < D; dInternal++)
+            gradX[bComponent][dInternal] += xDisplacements[bComponent][bDof] * dphi_dX[bDof][dInternal];
+        }
+      }
+
+      // submatrix uu, y_La += phi_La,B * k_abBD * gradX_bD
+      for (int aComponent = 0; aComponent < D; aComponent++)         // a
+      {
+        for (int bInternal = 0; bInternal < D; bInternal++)          // B
+        {
+          double k_aB = 0;
+          for (int bComponent = 0; bComponent < D; bComponent++)     // b
+          {
+            for (int dInternal = 0; dInternal < D; dInternal++)      // D
+              k_aB += tangent[((aComponent*D + bComponent)*D + bInternal)*D + dInternal] * gradX[bComponent][dInternal];
+          }
+
+          k_aB *= integrationFactor;
+          for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)   // L
+            yDisplacements[aComponent][aDof] += dphi_dX[aDof][bInternal] * k_aB;
+        }
+      }
+
+      // submatrices pu and up with the entries J * psi_L * (F^-1)_Ba * phi_Ma,B, only for incompressible formulation
+      if (Term::isIncompressible)
+      {
+        double pressure = 0;
+        for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+          pressure += psi[samplingPointIndex][lDof] * xPressure[lDof];
+
+        double jFInvGradX = 0;
+        for (int aComponent = 0; aComponent < D; aComponent++)
+        {
+          for (int bInternal = 0; bInternal < D; bInternal++)
+            jFInvGradX += scaledInverseDeformationGradient[aComponent][bInternal] * gradX[aComponent][bInternal];
+        }
+
+        for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+          yPressure[lDof] += integrationFactor * psi[samplingPointIndex][lDof] * jFInvGradX;
+
+        for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)
+        {
+          for (int aComponent = 0; aComponent < D; aComponent++)
+          {
+            double jFInv_dphiM_dX = 0;
+            for (int bInternal = 0; bInternal < D; bInternal++)
+              jFInv_dphiM_dX += scaledInverseDeformationGradient[aComponent][bInternal] * dphi_dX[aDof][bInternal];
+
+            yDisplacements[aComponent][aDof] += integrationFactor * pressure * jFInv_dphiM_dX;
+          }
+        }
+      }
+
+      // submatrix uv, 1/dt δ_ab ∫_Ω ρ0 ϕ^L ϕ^M dV, row (M,a), column (L,a), only for dynamic problem
+      if (nDisplacementComponents == 6)
+      {
+        for (int aComponent = 0; aComponent < D; aComponent++)
+        {
+          double velocity = 0;
+          for (int lDof = 0; lDof < nDisplacementsDofsPerElement; lDof++)
+            velocity += phi[samplingPointIndex][lDof] * xDisplacements[3+aComponent][lDof];
+
+          const double factor = 1./this->timeStepWidth_ * this->density_ * integrationFactor * velocity;
+          for (int mDof = 0; mDof < nDisplacementsDofsPerElement; mDof++)
+            yDisplacements[aComponent][mDof] += factor * phi[samplingPointIndex][mDof];
+        }
+      }
+    }  // samplingPointIndex
+
+    // add the element contributions to the result, values for prescribed dofs are discarded by setValues
+    for (int aComponent = 0; aComponent < D; aComponent++)
+    {
+      this->matrixFreeOutput_->setValues(aComponent, nDisplacementsDofsPerElement, dofNosLocal.data(), yDisplacements[aComponent].data(), ADD_VALUES);
+    }
+
+    if (Term::isIncompressible)
+    {
+      this->matrixFreeOutput_->setValues(pressureDofNo, nPressureDofsPerElement, dofNosLocalPressure.data(), yPressure.data(), ADD_VALUES);
+    }
+  }  // elementNoLocal
+
+  // the constant submatrices vu = 1/dt δ_ab δ_LM and vv = -δ_ab δ_LM of the dynamic problem, they are set per dof and not per element
+  if (nDisplacementComponents == 6)
+  {
+    const int nDofsLocalWithoutGhosts = displacementsFunctionSpace->nDofsLocalWithoutGhosts();
+    const std::vector<PetscInt> &dofNosLocal = displacementsFunctionSpace->meshPartition()->dofNosLocal();
+    std::vector<double> displacements(nDofsLocalWithoutGhosts);
+    std::vector<double> velocities(nDofsLocalWithoutGhosts);
+    std::vector<double> result(nDofsLocalWithoutGhosts);
+
+    for (int aComponent = 0; aComponent < D; aComponent++)
+    {
+      this->matrixFreeInput_->getValues(aComponent, nDofsLocalWithoutGhosts, dofNosLocal.data(), displacements.data());
+      this->matrixFreeInput_->getValues(3+aComponent, nDofsLocalWithoutGhosts, dofNosLocal.data(), velocities.data());
+
+      for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+      {
+        const double displacement = (this->matrixFreeInput_->isPrescribed(aComponent, dofNoLocal)? 0 : displacements[dofNoLocal]);
+        const double velocity = (this->matrixFreeInput_->isPrescribed(3+aComponent, dofNoLocal)? 0 : velocities[dofNoLocal]);
+        result[dofNoLocal] = 1./this->timeStepWidth_ * displacement - velocity;
+      }
+
+      this->matrixFreeOutput_->setValues(3+aComponent, nDofsLocalWithoutGhosts, dofNosLocal.data(), result.data(), ADD_VALUES);
+    }
+  }
+
+  // discard the ghost values of the input, they must not be added to the owning ranks
+  this->matrixFreeInput_->setRepresentationGlobal();
+
+  // add the ghost contributions of the result
+  this->matrixFreeOutput_->finishGhostManipulation();
+
+  ierr = VecCopy(this->matrixFreeOutput_->valuesGlobal(), y); CHKERRV(ierr);
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+computeMatrixFreeDisplacementsDiagonal()
+{
+  // compute the diagonal of the submatrix uu from the quadrature point values of the last call to materialComputeJacobian(),
+  // the pressure rows have no diagonal entries and are left at zero
+  std::shared_ptr<DisplacementsFunctionSpace> displacementsFunctionSpace = this->data_.displacementsFunctionSpace();
+
+  const int D = 3;  // dimension
+  const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
+  const int nElementsLocal = displacementsFunctionSpace->nElementsLocal();
+
+  typedef Quadrature::TensorProduct<D,Quadrature::Gauss<3>> QuadratureDD;   // the same quadrature as in materialComputeJacobian
+  const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+  std::array<Vec3,nQuadraturePoints> samplingPoints = QuadratureDD::samplingPoints();
+
+  this->matrixFreeOutput_->zeroEntries();
+  this->matrixFreeOutput_->startGhostManipulation();
+  this->matrixFreeOutput_->zeroGhostBuffer();
+
+  std::array<double,81> tangent;
+  Tensor2<D> inverseJacobianMaterial;
+  Tensor2<D> scaledInverseDeformationGradient;
+  double integrationFactor;
+  std::array<std::array<double,nDisplacementsDofsPerElement>,3> diagonalValues;
+
+  for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+  {
+    for (int aComponent = 0; aComponent < D; aComponent++)
+      diagonalValues[aComponent].fill(0.0);
+
+    for (int samplingPointIndex = 0; samplingPointIndex < nQuadraturePoints; samplingPointIndex++)
+    {
+      getMatrixFreeQuadraturePointValues(elementNoLocal, samplingPointIndex, tangent, inverseJacobianMaterial, scaledInverseDeformationGradient, integrationFactor);
+      std::array<Vec3,nDisplacementsDofsPerElement> gradPhi = displacementsFunctionSpace->getGradPhi(samplingPoints[samplingPointIndex]);
+
+      for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)
+      {
+        // dphi_L/dX_B
+        Vec3 dphiL_dX{};
+        for (int bInternal = 0; bInternal < D; bInternal++)
+        {
+          for (int k = 0; k < D; k++)
+            dphiL_dX[bInternal] += gradPhi[aDof][k] * inverseJacobianMaterial[bInternal][k];
+        }
+
+        // diagonal entry phi_La,B * k_aaBD * phi_La,D
+        for (int aComponent = 0; aComponent < D; aComponent++)
+        {
+          double value = 0;
+          for (int bInternal = 0; bInternal < D; bInternal++)
+          {
+            for (int dInternal = 0; dInternal < D; dInternal++)
+              value += dphiL_dX[bInternal] * tangent[((aComponent*D + aComponent)*D + bInternal)*D + dInternal] * dphiL_dX[dInternal];
+          }
+          diagonalValues[aComponent][aDof] += integrationFactor * value;
+        }
+      }
+    }
+
+    std::array<dof_no_t,nDisplacementsDofsPerElement> dofNosLocal = displacementsFunctionSpace->getElementDofNosLocal(elementNoLocal);
+    for (int aComponent = 0; aComponent < D; aComponent++)
+    {
+      this->matrixFreeOutput_->setValues(aComponent, nDisplacementsDofsPerElement, dofNosLocal.data(), diagonalValues[aComponent].data(), ADD_VALUES);
+    }
+  }
+
+  // diagonal entries -1 of the constant submatrix vv of the dynamic problem
+  if (nDisplacementComponents == 6)
+  {
+    const int nDofsLocalWithoutGhosts = displacementsFunctionSpace->nDofsLocalWithoutGhosts();
+    const std::vector<PetscInt> &dofNosLocal = displacementsFunctionSpace->meshPartition()->dofNosLocal();
+    std::vector<double> values(nDofsLocalWithoutGhosts, -1.0);
+
+    for (int aComponent = 0; aComponent < D; aComponent++)
+    {
+      this->matrixFreeOutput_->setValues(3+aComponent, nDofsLocalWithoutGhosts, dofNosLocal.data(), values.data(), ADD_VALUES);
+    }
+  }
+
+  this->matrixFreeOutput_->finishGhostManipulation();
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+getMatrixFreeJacobianDiagonal(Vec diagonal)
+{
+  // the diagonal of the jacobian, this is used for the jacobi preconditioner,
+  // the pressure rows have no diagonal entries, PETSc uses 1 for zero diagonal entries in the jacobi preconditioner
+  computeMatrixFreeDisplacementsDiagonal();
+
+  PetscErrorCode ierr;
+  ierr = VecCopy(this->matrixFreeOutput_->valuesGlobal(), diagonal); CHKERRV(ierr);
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+getMatrixFreeBlockPreconditionerDiagonal(Vec diagonal)
+{
+  // The jacobian of the incompressible formulation has the saddle point structure [A B^T; B 0]. The block preconditioner diag(A, S) uses
+  // the diagonal of A for the displacements and the diagonal of the Schur complement S = B diag(A)^-1 B^T for the pressure.
+  // The element contributions of B are squared separately, which approximates the diagonal of S without assembling B.
+  computeMatrixFreeDisplacementsDiagonal();
+
+  PetscErrorCode ierr;
+  if (Term::isIncompressible)
+  {
+    std::shared_ptr<DisplacementsFunctionSpace> displacementsFunctionSpace = this->data_.displacementsFunctionSpace();
+    std::shared_ptr<PressureFunctionSpace> pressureFunctionSpace = this->data_.pressureFunctionSpace();
+
+    const int D = 3;  // dimension
+    const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
+    const int nPressureDofsPerElement = PressureFunctionSpace::nDofsPerElement();
+    const int nElementsLocal = displacementsFunctionSpace->nElementsLocal();
+    const int pressureDofNo = nDisplacementComponents;  // 3 or 6, depending if static or dynamic problem
+
+    typedef Quadrature::TensorProduct<D,Quadrature::Gauss<3>> QuadratureDD;   // the same quadrature as in materialComputeJacobian
+    const int nQuadraturePoints = QuadratureDD::numberEvaluations();
+    std::array<Vec3,nQuadraturePoints> samplingPoints = QuadratureDD::samplingPoints();
+
+    // get the diagonal of A including the ghost values
+    ierr = VecCopy(this->matrixFreeOutput_->valuesGlobal(), this->matrixFreeInput_->valuesGlobal()); CHKERRV(ierr);
+    this->matrixFreeInput_->startGhostManipulation();
+
+    // add the pressure entries to the diagonal, the entries of A are kept
+    this->matrixFreeOutput_->startGhostManipulation();
+    this->matrixFreeOutput_->zeroGhostBuffer();
+
+    std::array<double,81> tangent;
+    Tensor2<D> inverseJacobianMaterial;
+    Tensor2<D> scaledInverseDeformationGradient;
+    double integrationFactor;
+    std::array<std::array<double,nDisplacementsDofsPerElement>,3> diagonalA;
+    std::array<std::array<std::array<double,nDisplacementsDofsPerElement>,3>,nPressureDofsPerElement> elementB;   // [L][a][M]
+    std::array<double,nPressureDofsPerElement> schurComplementDiagonal;
+
+    for (element_no_t elementNoLocal = 0; elementNoLocal < nElementsLocal; elementNoLocal++)
+    {
+      std::array<dof_no_t,nDisplacementsDofsPerElement> dofNosLocal = displacementsFunctionSpace->getElementDofNosLocal(elementNoLocal);
+      std::array<dof_no_t,nPressureDofsPerElement> dofNosLocalPressure = pressureFunctionSpace->getElementDofNosLocal(elementNoLocal);
+
+      for (int aComponent = 0; aComponent < D; aComponent++)
+        this->matrixFreeInput_->getValues(aComponent, nDisplacementsDofsPerElement, dofNosLocal.data(), diagonalA[aComponent].data());
+
+      // integrate the element contribution of B, J * psi_L * (F^-1)_Ba * phi_Ma,B
+      for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+      {
+        for (int aComponent = 0; aComponent < D; aComponent++)
+          elementB[lDof][aComponent].fill(0.0);
+      }
+
+      for (int samplingPointIndex = 0; samplingPointIndex < nQuadraturePoints; samplingPointIndex++)
+      {
+        getMatrixFreeQuadraturePointValues(elementNoLocal, samplingPointIndex, tangent, inverseJacobianMaterial, scaledInverseDeformationGradient, integrationFactor);
+        const Vec3 xi = samplingPoints[samplingPointIndex];
+        std::array<Vec3,nDisplacementsDofsPerElement> gradPhi = displacementsFunctionSpace->getGradPhi(xi);
+
+        for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)
+        {
+          Vec3 dphiM_dX{};
+          for (int bInternal = 0; bInternal < D; bInternal++)
+          {
+            for (int k = 0; k < D; k++)
+              dphiM_dX[bInternal] += gradPhi[aDof][k] * inverseJacobianMaterial[bInternal][k];
+          }
+
+          for (int aComponent = 0; aComponent < D; aComponent++)
+          {
+            double jFInv_dphiM_dX = 0;
+            for (int bInternal = 0; bInternal < D; bInternal++)
+              jFInv_dphiM_dX += scaledInverseDeformationGradient[aComponent][bInternal] * dphiM_dX[bInternal];
+
+            for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+              elementB[lDof][aComponent][aDof] += integrationFactor * pressureFunctionSpace->phi(lDof, xi) * jFInv_dphiM_dX;
+          }
+        }
+      }
+
+      // sum B_{L,Ma}^2 / A_{Ma,Ma} over the unknowns of the element, prescribed displacements are not part of the system
+      schurComplementDiagonal.fill(0.0);
+      for (int aComponent = 0; aComponent < D; aComponent++)
+      {
+        for (int aDof = 0; aDof < nDisplacementsDofsPerElement; aDof++)
+        {
+          if (this->matrixFreeInput_->isPrescribed(aComponent, dofNosLocal[aDof]) || diagonalA[aComponent][aDof] == 0)
+            continue;
+
+          for (int lDof = 0; lDof < nPressureDofsPerElement; lDof++)
+            schurComplementDiagonal[lDof] += MathUtility::sqr(elementB[lDof][aComponent][aDof]) / fabs(diagonalA[aComponent][aDof]);
+        }
+      }
+
+      this->matrixFreeOutput_->setValues(pressureDofNo, nPressureDofsPerElement, dofNosLocalPressure.data(), schurComplementDiagonal.data(), ADD_VALUES);
+    }
+
+    // discard the ghost values of the diagonal of A, they must not be added to the owning ranks
+    this->matrixFreeInput_->setRepresentationGlobal();
+
+    this->matrixFreeOutput_->finishGhostManipulation();
+  }
+
+  ierr = VecCopy(this->matrixFreeOutput_->valuesGlobal(), diagonal); CHKERRV(ierr);
+}
+
+} // namespace
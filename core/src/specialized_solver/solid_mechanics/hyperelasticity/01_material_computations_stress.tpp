@@ -33,14 +33,16 @@ computePK2Stress(double_v_t &pressure,                                   //< [in
   const bool usesFormulationWithC = typeid(decltype(Term::strainEnergyDensityFunctionCoupledDependentOnC)) != typeid(decltype(INT(0)));
 
   // Ibar1, Ibar2, Ibar4, Ibar5, J, I1, I2, I3, C11, C12, C13, C22, C23, C33, a1, a2, a3
-  std::vector<double_v_t> parameterVector = {
+  // the storage of the variables is a member such that it is reused and not allocated again at every quadrature point
+  ExpressionVariables<double_v_t> &parameterVector = std::get<ExpressionVariables<double_v_t>>(expressionVariables_);
+  parameterVector.set({
     reducedInvariants[0], reducedInvariants[1], reducedInvariants[3], reducedInvariants[4],  // Ibar1, Ibar2, Ibar4, Ibar5
     deformationGradientDeterminant,                                                          // J
     invariants[0], invariants[1], invariants[2],                                             // I1, I2, I3
     rightCauchyGreen[0][0], rightCauchyGreen[1][0], rightCauchyGreen[2][0],                  // C11, C12, C13
     rightCauchyGreen[1][1], rightCauchyGreen[2][1], rightCauchyGreen[2][2],                  // C22, C23, C33
     fiberDirection[0], fiberDirection[1], fiberDirection[2]                                  // a1, a2, a3
-  };
+  });
 
   // reduced invariants, arguments of `strainEnergyDensityFunctionIsochoric`
   // compute factors for decoupled form
@@ -375,17 +377,20 @@ computePK2Stress(double_v_t &pressure,                                   //< [in
 
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
-computePK2StressField()
+computePK2StressField(bool onlyDeformationGradient)
 {
   //LOG(TRACE) << "computePK2StressField";
 
-  //this->data_.pK2Stress()->startGhostManipulation();
-  this->data_.pK2Stress()->zeroGhostBuffer();
-  this->data_.materialTraction()->zeroGhostBuffer();
-  this->data_.materialTraction()->zeroEntries();
+  if (!onlyDeformationGradient)
+  {
+    //this->data_.pK2Stress()->startGhostManipulation();
+    this->data_.pK2Stress()->zeroGhostBuffer();
+    this->data_.materialTraction()->zeroGhostBuffer();
+    this->data_.materialTraction()->zeroEntries();
 
-  this->data_.traction()->zeroGhostBuffer();
-  this->data_.traction()->zeroEntries();
+    this->data_.traction()->zeroGhostBuffer();
+    this->data_.traction()->zeroEntries();
+  }
 
   this->data_.deformationGradient()->zeroGhostBuffer();
   this->data_.deformationGradientTimeDerivative()->zeroGhostBuffer();
@@ -573,6 +578,9 @@ computePK2StressField()
       this->data_.deformationGradient()->setValue(dofNoLocal, deformationGradientValues, INSERT_VALUES);
       this->data_.deformationGradientTimeDerivative()->setValue(dofNoLocal, deformationGradientTimeDerivativeValues, INSERT_VALUES);
 
+      // the stress and traction fields are not needed, e.g. when their computation is deferred until output is written
+      if (onlyDeformationGradient)
+        continue;
 
       Tensor2_v_t<D> rightCauchyGreen = this->computeRightCauchyGreenTensor(deformationGradient);  // C = F^T*F
 
@@ -687,17 +695,20 @@ computePK2StressField()
       this->data_.traction()->setValue(dofNoLocal, traction, INSERT_VALUES);
     }
   }
-  this->data_.pK2Stress()->zeroGhostBuffer();
-  this->data_.pK2Stress()->finishGhostManipulation();
-  this->data_.pK2Stress()->startGhostManipulation();
+  if (!onlyDeformationGradient)
+  {
+    this->data_.pK2Stress()->zeroGhostBuffer();
+    this->data_.pK2Stress()->finishGhostManipulation();
+    this->data_.pK2Stress()->startGhostManipulation();
 
-  this->data_.materialTraction()->zeroGhostBuffer();
-  this->data_.materialTraction()->finishGhostManipulation();
-  this->data_.materialTraction()->startGhostManipulation();
+    this->data_.materialTraction()->zeroGhostBuffer();
+    this->data_.materialTraction()->finishGhostManipulation();
+    this->data_.materialTraction()->startGhostManipulation();
 
-  this->data_.traction()->zeroGhostBuffer();
-  this->data_.traction()->finishGhostManipulation();
-  this->data_.traction()->startGhostManipulation();
+    this->data_.traction()->zeroGhostBuffer();
+    this->data_.traction()->finishGhostManipulation();
+    this->data_.traction()->startGhostManipulation();
+  }
 
   this->data_.deformationGradient()->zeroGhostBuffer();
   this->data_.deformationGradient()->finishGhostManipulation();
@@ -706,6 +717,19 @@ computePK2StressField()
   this->data_.deformationGradientTimeDerivative()->zeroGhostBuffer();
   this->data_.deformationGradientTimeDerivative()->finishGhostManipulation();
   this->data_.deformationGradientTimeDerivative()->startGhostManipulation();
+
+  this->stressFieldsUpToDate_ = !onlyDeformationGradient;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+computeDeferredStressFields()
+{
+  if (this->stressFieldsUpToDate_)
+    return;
+
+  // F and Fdot are computed again, this is cheap compared to the PK2 stress
+  this->computePK2StressField();
 }
 
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
@@ -713,6 +737,9 @@ void HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplace
 computeBearingForceAndMoment(const std::vector<std::tuple<element_no_t,bool>> &elements,
                              Vec3 &bearingForceBottom, Vec3 &bearingMomentBottom, Vec3 &bearingForceTop, Vec3 &bearingMomentTop)
 {
+  // the traction field is needed, compute it if its computation after the last solve was deferred
+  this->computeDeferredStressFields();
+
   // set result variables to zero
   bearingForceBottom = Vec3{0};
   bearingMomentBottom = Vec3{0};
@@ -721,14 +748,13 @@ computeBearingForceAndMoment(const std::vector<std::tuple<element_no_t,bool>> &e
 
   // get pointer to function space
   std::shared_ptr<DisplacementsFunctionSpace> displacementsFunctionSpace = this->data_.displacementsFunctionSpace();
-  std::shared_ptr<PressureFunctionSpace> pressureFunctionSpace = this->data_.pressureFunctionSpace();
 
   const int D = 3;  // dimension
   const int nDisplacementsDofsPerElement = DisplacementsFunctionSpace::nDofsPerElement();
 
   // define shortcuts for integrator and basis
   typedef Quadrature::TensorProduct<D-1,Quadrature::Gauss<2>> QuadratureSurface;
-  typedef Vec3 EvaluationsType;
+  typedef Vec3_v_t EvaluationsType;
   typedef std::array<
             EvaluationsType,
             QuadratureSurface::numberEvaluations()
@@ -739,56 +765,92 @@ computeBearingForceAndMoment(const std::vector<std::tuple<element_no_t,bool>> &e
   EvaluationsArrayType evaluationsArrayForce{};
   EvaluationsArrayType evaluationsArrayMoment{};
 
-  for (int elementNoIndex = 0; elementNoIndex < elements.size(); elementNoIndex++)
+  // sort the elements into bottom and top elements, such that all elements that are handled at once by the vectorized functions have the same xi
+  std::array<std::vector<element_no_t>,2> elementNosLocal;   // [0]: bottom elements, [1]: top elements
+  for (const std::tuple<element_no_t,bool> &element : elements)
   {
-    element_no_t elementNoLocal = std::get<0>(elements[elementNoIndex]);
-    bool isTop = std::get<1>(elements[elementNoIndex]);
-
-    // get geometry field of reference configuration
-    std::array<Vec3,nDisplacementsDofsPerElement> geometryReferenceValues;
-    this->data_.geometryReference()->getElementValues(elementNoLocal, geometryReferenceValues);
+    bool isTop = std::get<1>(element);
+    elementNosLocal[isTop? 1 : 0].push_back(std::get<0>(element));
+  }
 
-    // get traction t values in current element
-    std::array<Vec3,nDisplacementsDofsPerElement> tractionValues;
-    this->data_.traction()->getElementValues(elementNoLocal, tractionValues);
+  for (int topIndex = 0; topIndex < 2; topIndex++)
+  {
+    const bool isTop = (topIndex == 1);
+    const std::vector<element_no_t> &currentElementNosLocal = elementNosLocal[topIndex];
+    const int nElements = currentElementNosLocal.size();
 
-    // compute integral
-    for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+    // loop over elements, always nVcComponents elements at once using the vectorized functions
+    for (int elementIndex = 0; elementIndex < nElements; elementIndex += nVcComponents)
     {
-      // evaluate function to integrate at samplingPoint
-      std::array<double,D-1> xiSurface = samplingPoints[samplingPointIndex];
-      double xi2 = 0;
-      if (isTop)
-        xi2 = 1;
-      std::array<double,D> xi{xiSurface[0], xiSurface[1], xi2};
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+      // get element nos that should be handled in the current iteration, unused entries are set to -1
+      dof_no_v_t elementNoLocalv([&currentElementNosLocal, elementIndex, nElements](int i)
+      {
+        return (i >= nVcComponents || elementIndex+i >= nElements? -1: currentElementNosLocal[elementIndex+i]);
+      });
+#else
+      element_no_t elementNoLocalv = currentElementNosLocal[elementIndex];
+#endif
 
-      // compute the 3xD jacobian of the parameter space to world space mapping
-      std::array<Vec3,D> jacobianMaterial = this->displacementsFunctionSpace_->computeJacobian(geometryReferenceValues, xi);
+      // get geometry field of reference configuration
+      std::array<Vec3_v_t,nDisplacementsDofsPerElement> geometryReferenceValues;
+      this->data_.geometryReference()->getElementValues(elementNoLocalv, geometryReferenceValues);
 
-      // compute the traction value at the current sampling point xi
-      Vec3 traction = this->displacementsFunctionSpace_->interpolateValueInElement(tractionValues, xi);
+      // get traction t values in current element
+      std::array<Vec3_v_t,nDisplacementsDofsPerElement> tractionValues;
+      this->data_.traction()->getElementValues(elementNoLocalv, tractionValues);
 
-      // compute the position in reference configuration of the current sampling point
-      Vec3 point = this->displacementsFunctionSpace_->interpolateValueInElement(geometryReferenceValues, xi);
+      // compute integral
+      for (unsigned int samplingPointIndex = 0; samplingPointIndex < samplingPoints.size(); samplingPointIndex++)
+      {
+        // evaluate function to integrate at samplingPoint
+        std::array<double,D-1> xiSurface = samplingPoints[samplingPointIndex];
+        double xi2 = 0;
+        if (isTop)
+          xi2 = 1;
+        std::array<double,D> xi{xiSurface[0], xiSurface[1], xi2};
 
-      double integrationFactor = MathUtility::computeIntegrationFactor(jacobianMaterial);
-      evaluationsArrayForce[samplingPointIndex] = traction * integrationFactor;
-      evaluationsArrayMoment[samplingPointIndex] = traction * point * integrationFactor;
-    }
+        // compute the 3xD jacobian of the parameter space to world space mapping
+        std::array<Vec3_v_t,D> jacobianMaterial = DisplacementsFunctionSpace::computeJacobian(geometryReferenceValues, xi);
 
-    // integrate all values in the element at once
-    EvaluationsType integratedValuesForce = QuadratureSurface::computeIntegral(evaluationsArrayForce);
-    EvaluationsType integratedValuesMoment = QuadratureSurface::computeIntegral(evaluationsArrayMoment);
+        // compute the traction value at the current sampling point xi
+        Vec3_v_t traction = displacementsFunctionSpace->template interpolateValueInElement<3>(tractionValues, xi);
 
-    if (isTop)
-    {
-      bearingForceTop += integratedValuesForce;
-      bearingMomentTop += integratedValuesMoment;
-    }
-    else
-    {
-      bearingForceBottom += integratedValuesForce;
-      bearingMomentBottom += integratedValuesMoment;
+        // compute the position in reference configuration of the current sampling point
+        Vec3_v_t point = displacementsFunctionSpace->template interpolateValueInElement<3>(geometryReferenceValues, xi);
+
+        double_v_t integrationFactor = MathUtility::computeIntegrationFactor(jacobianMaterial);
+        for (int i = 0; i < 3; i++)
+        {
+          evaluationsArrayForce[samplingPointIndex][i] = traction[i] * integrationFactor;
+          evaluationsArrayMoment[samplingPointIndex][i] = traction[i] * point[i] * integrationFactor;
+        }
+      }
+
+      // integrate all values in the elements at once
+      EvaluationsType integratedValuesForce = QuadratureSurface::computeIntegral(evaluationsArrayForce);
+      EvaluationsType integratedValuesMoment = QuadratureSurface::computeIntegral(evaluationsArrayMoment);
+
+      Vec3 &bearingForce = (isTop? bearingForceTop : bearingForceBottom);
+      Vec3 &bearingMoment = (isTop? bearingMomentTop : bearingMomentBottom);
+
+#ifdef USE_VECTORIZED_FE_MATRIX_ASSEMBLY
+      // add the values of the used entries
+      for (int vcComponent = 0; vcComponent < nVcComponents; vcComponent++)
+      {
+        if (elementNoLocalv[vcComponent] == -1)
+          continue;
+
+        for (int i = 0; i < 3; i++)
+        {
+          bearingForce[i] += integratedValuesForce[i][vcComponent];
+          bearingMoment[i] += integratedValuesMoment[i][vcComponent];
+        }
+      }
+#else
+      bearingForce += integratedValuesForce;
+      bearingMoment += integratedValuesMoment;
+#endif
     }
   }
 
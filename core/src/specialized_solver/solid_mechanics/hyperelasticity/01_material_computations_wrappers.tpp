@@ -88,7 +88,7 @@ solveDynamicProblem(
     this->outputWriterManagerPressure_.writeOutput(this->pressureDataCopy_, 0, 0.0, 0);
   }
 
-  if (this->extrapolateInitialGuess_)
+  if (this->extrapolateInitialGuess_ && !this->explicitTimeIntegration_)
   {
     // copy the solution values back to this->data_.displacements(), and this->data_.velocities() and this->data.pressure()
     setUVP(combinedVecSolution_->valuesGlobal());
@@ -132,7 +132,7 @@ solveDynamicProblem(
   VLOG(1) << *this->data_.velocitiesPreviousTimestep();
   VLOG(1) << *this->data_.pressurePreviousTimestep();
 
-  if (this->extrapolateInitialGuess_)
+  if (this->extrapolateInitialGuess_ && !this->explicitTimeIntegration_)
   {
     combinedVecSolution_->startGhostManipulation();
 
@@ -169,8 +169,26 @@ solveDynamicProblem(
     LOG(DEBUG) << "extrapolateInitialGuess: initial values: " << getString(solverVariableSolution_);
   }
 
-  // find the solution for u,v,p of the nonlinear equation, potentially multiple load steps and repeated solve calls
-  this->nonlinearSolve();
+  if (this->explicitTimeIntegration_)
+  {
+    // save the solution of the previous time step, to restore it if the explicit scheme fails
+    ierr = VecCopy(solverVariableSolution_, this->lastSolution_); CHKERRV(ierr);
+
+    // advance u,v with the explicit central difference scheme and the lumped mass matrix
+    this->lastSolveSucceeded_ = this->explicitTimeStep();
+
+    // if there was a negative jacobian, keep the solution of the previous time step, like the implicit scheme keeps the best found solution
+    if (!this->lastSolveSucceeded_)
+    {
+      LOG(WARNING) << "Explicit time step failed, use the solution of the previous time step.";
+      ierr = VecCopy(this->lastSolution_, solverVariableSolution_); CHKERRV(ierr);
+    }
+  }
+  else
+  {
+    // find the solution for u,v,p of the nonlinear equation, potentially multiple load steps and repeated solve calls
+    this->nonlinearSolve();
+  }
 
   LOG(DEBUG) << "result: " << getString(solverVariableSolution_);
 
@@ -185,6 +203,9 @@ solveDynamicProblem(
   // output with output writers of hyperelasticity_solver
   if (withOutputWritersEnabled)
   {
+    if (this->outputWriterManager_.willWriteOutput())
+      this->computeDeferredStressFields();
+
     this->outputWriterManager_.writeOutput(this->data_, 0, this->endTime_);
     this->outputWriterManagerPressure_.writeOutput(this->pressureDataCopy_, 0, this->endTime_);
   }
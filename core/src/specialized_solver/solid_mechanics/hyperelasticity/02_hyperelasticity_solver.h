@@ -88,6 +88,24 @@ public:
   //! callback after each nonlinear iteration
   void monitorSolvingIteration(SNES snes, PetscInt its, PetscReal norm);
 
+  //! get the coloring context to compute the numeric jacobian, PETSC_NULL if the numeric jacobian is computed without coloring
+  MatFDColoring numericJacobianColoring();
+
+  //! count a computation of the jacobian, this is called by the jacobian callback functions, to report how many computations were skipped by a lagged jacobian
+  void countJacobianComputation();
+
+  //! get the total number of nonlinear iterations in all nonlinear solves so far, including the iterations of failed solves
+  int nNonlinearIterationsTotal() const;
+
+  //! get the total number of computations of the jacobian in all nonlinear solves so far, this is lower than nNonlinearIterationsTotal() if the jacobian is lagged
+  int nJacobianComputationsTotal() const;
+
+  //! get the total number of evaluations of the nonlinear function so far, including the evaluations for the finite differences jacobian
+  int nResidualEvaluationsTotal() const;
+
+  //! get the total number of element chunks whose jacobian contributions were reused instead of recomputed, because of the option jacobianReassemblyTolerance
+  int nReusedElementJacobiansTotal() const;
+
 protected:
 
   typedef HyperelasticityMaterialComputations<Term,withLargeOutput,MeshType,nDisplacementComponents> Parent;
@@ -105,8 +123,16 @@ protected:
   //! set all PETSc callback functions, e.g. for computation jacobian or the nonlinear function itself
   void initializePetscCallbackFunctions();
 
+  //! restore the configured lag of the jacobian and preconditioner after a rebuild was forced by the monitor function
+  void restoreJacobianLag(SNES snes);
+
+  //! create the coloring of the given matrix, which has to contain the nonzero structure, and the MatFDColoring context that computes the numeric jacobian
+  void initializeNumericJacobianColoring(Mat jacobian);
+
   using Parent::lastSolution_;           //< a temporary variable to hold the previous solution in the nonlinear solver, to be used to reset the nonlinear scheme if it diverged
   using Parent::bestSolution_;           //< a temporary variable to hold the best solution so, the one with the lowest residual norm
+  using Parent::loadStepSolution_;       //< the solution of the last converged load step, only used for extrapolateLoadStepInitialGuess_
+  using Parent::previousLoadStepSolution_;  //< the solution of the second last converged load step, only used for extrapolateLoadStepInitialGuess_
 
   using Parent::loadFactors_;            //< vector of load factors, 1.0 means normal computation, any lower value reduces the right hand side (scales body and traction forces)
 
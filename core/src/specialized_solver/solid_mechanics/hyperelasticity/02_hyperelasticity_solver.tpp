@@ -9,6 +9,7 @@
 #include "control/diagnostic_tool/performance_measurement.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
 #include "partition/mesh_partition/01_mesh_partition_structured.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace SpatialDiscretization
 {
@@ -49,6 +50,9 @@ advanceTimeSpan(bool withOutputWritersEnabled)
   // write current output values
   if (withOutputWritersEnabled)
   {
+    if (this->outputWriterManager_.willWriteOutput())
+      this->computeDeferredStressFields();
+
     this->outputWriterManager_.writeOutput(this->data_, 1, endTime_);
     this->outputWriterManagerPressure_.writeOutput(this->pressureDataCopy_, 1, endTime_);
   }
@@ -63,6 +67,9 @@ run()
   this->initialize();
 
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
@@ -77,6 +84,9 @@ void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents
 callOutputWriter(int timeStepNo, double currentTime, int callCountIncrement)
 {
   // call the own output writer
+  if (this->outputWriterManager_.willWriteOutput())
+    this->computeDeferredStressFields();
+
   this->outputWriterManager_.writeOutput(this->data_, 1, endTime_);
   this->outputWriterManagerPressure_.writeOutput(this->pressureDataCopy_, 1, endTime_);
 }
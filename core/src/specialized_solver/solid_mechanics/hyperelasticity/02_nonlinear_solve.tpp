@@ -37,6 +37,20 @@ nonlinearSolve()
 
   // loop over load loadFactors, i.e. load increments
   std::vector<double> loadFactors(this->loadFactors_);
+
+  // for adaptive load stepping, only the first load factor is given, the next ones are computed from the number of iterations of the previous load step
+  if (this->adaptiveLoadStepping_)
+    loadFactors.resize(1);
+
+  // the load factors of the last two converged load steps, for adaptive load stepping and the extrapolation of the initial guess
+  double lastConvergedLoadFactor = 0;
+  double secondLastConvergedLoadFactor = 0;
+  int nConvergedLoadSteps = 0;
+
+  // the number of computations of the jacobian and of nonlinear iterations in this call, to report how many computations were skipped by a lagged jacobian
+  const int nJacobianComputationsBefore = this->nJacobianComputationsTotal_;
+  const int nJacobianRequestsBefore = this->nJacobianRequestsTotal_;
+
   for (int loadFactorIndex = 0; loadFactorIndex < loadFactors.size(); loadFactorIndex++)
   {
     double loadFactor = loadFactors[loadFactorIndex];
@@ -72,8 +86,20 @@ nonlinearSolve()
     }
     else
     {
+      // compute the initial guess by linear extrapolation (secant predictor) of the solutions x_n, x_{n-1} of the last two converged load steps
+      // with load factors l_n, l_{n-1}: x = x_n + (l - l_n)/(l_n - l_{n-1}) * (x_n - x_{n-1})
+      if (loadFactorIndex > 0 && this->extrapolateLoadStepInitialGuess_ && nConvergedLoadSteps >= 2 && lastConvergedLoadFactor != secondLastConvergedLoadFactor)
+      {
+        double extrapolationFactor = (currentLoadFactor_ - lastConvergedLoadFactor) / (lastConvergedLoadFactor - secondLastConvergedLoadFactor);
+        LOG(INFO) << "Extrapolate initial guess from load factors " << secondLastConvergedLoadFactor << " and " << lastConvergedLoadFactor
+          << " with factor " << extrapolationFactor << ".";
+
+        PetscErrorCode ierr;
+        ierr = VecWAXPY(solverVariableSolution_, -1.0, previousLoadStepSolution_, loadStepSolution_); CHKERRV(ierr);   // x = x_n - x_{n-1}
+        ierr = VecAYPX(solverVariableSolution_, extrapolationFactor, loadStepSolution_); CHKERRV(ierr);                // x = x_n + factor*x
+      }
       // scale initial solution by increased load factor
-      if (loadFactorIndex > 0 && this->scaleInitialGuess_)
+      else if (loadFactorIndex > 0 && this->scaleInitialGuess_)
       {
         double scalingFactor = sqrt(currentLoadFactor_*previousLoadFactor_) / previousLoadFactor_;
         LOG(INFO) << "Scale initial guess by factor " << scalingFactor << ".";
@@ -83,6 +109,8 @@ nonlinearSolve()
     }
 
     // try as many times to solve the nonlinear problem as given in the option nNonlinearSolveCalls
+    bool loadStepConverged = false;
+    int nIterationsLoadStep = 0;
     for (int i = 0; i < this->nNonlinearSolveCalls_; i++)
     {
       LOG(DEBUG) << "------------------  start solve " << i << "/" << this->nNonlinearSolveCalls_ << " ------------------";
@@ -96,14 +124,24 @@ nonlinearSolve()
 
       // reset indicator whether the last solve did not encounter a negative jacobian
       this->lastSolveSucceeded_ = true;
+      this->nJacobianComputations_ = 0;
+
       // solve the system nonlinearFunction(displacements) = 0
       ierr = SNESSolve(*snes, NULL, solverVariableSolution_); CHKERRV(ierr);
 
+      // if a rebuild of the jacobian was forced in the last iteration, restore the lag for the next solve
+      restoreJacobianLag(*snes);
+
       // get information about the solution process
       PetscInt numberOfIterations = 0;
       PetscReal residualNorm = 0.0;
       ierr = SNESGetIterationNumber(*snes, &numberOfIterations); CHKERRV(ierr);
       ierr = SNESGetFunctionNorm(*snes, &residualNorm); CHKERRV(ierr);
+      nIterationsLoadStep = numberOfIterations;
+
+      // count the computations of the jacobian, every nonlinear iteration needs the jacobian, with a lag it is only rebuilt in some of them
+      this->nJacobianComputationsTotal_ += this->nJacobianComputations_;
+      this->nJacobianRequestsTotal_ += numberOfIterations;
 
       SNESConvergedReason convergedReason;
       KSPConvergedReason kspConvergedReason;
@@ -162,10 +200,41 @@ nonlinearSolve()
       // if the nonlinear scheme converged, finish loop
       if (convergedReason >= 0)
       {
+        loadStepConverged = true;
         break;
       }
     }
 
+    if (loadStepConverged)
+    {
+      // store the solution of the converged load step for the extrapolation of the initial guess
+      if (this->extrapolateLoadStepInitialGuess_)
+      {
+        PetscErrorCode ierr;
+        ierr = VecCopy(loadStepSolution_, previousLoadStepSolution_); CHKERRV(ierr);
+        ierr = VecCopy(solverVariableSolution_, loadStepSolution_); CHKERRV(ierr);
+      }
+      secondLastConvergedLoadFactor = lastConvergedLoadFactor;
+      lastConvergedLoadFactor = currentLoadFactor_;
+      nConvergedLoadSteps++;
+
+      // for adaptive load stepping, add the next load factor if the current is the last one and 1.0 is not yet reached
+      // the increment is scaled by the ratio of the desired and the actual number of nonlinear iterations, limited to [0.5,2]
+      if (this->adaptiveLoadStepping_ && loadFactorIndex == loadFactors.size()-1 && currentLoadFactor_ < 1.0 - 1e-12)
+      {
+        double increment = currentLoadFactor_ - secondLastConvergedLoadFactor;
+        double incrementFactor = 2.0;
+        if (nIterationsLoadStep > 0)
+          incrementFactor = std::max(0.5, std::min(2.0, double(this->adaptiveLoadSteppingNIterations_) / nIterationsLoadStep));
+
+        double nextLoadFactor = std::min(1.0, currentLoadFactor_ + incrementFactor*increment);
+        loadFactors.push_back(nextLoadFactor);
+
+        LOG(INFO) << "Adaptive load stepping: load step needed " << nIterationsLoadStep << " iterations (desired: "
+          << this->adaptiveLoadSteppingNIterations_ << "), next load factor " << nextLoadFactor << " (increment " << nextLoadFactor - currentLoadFactor_ << ")";
+      }
+    }
+
     // reset value of last residual norm that is needed for computational of experimental order of convergence
     lastNorm_ = 0;
     secondLastNorm_ = 0;
@@ -177,6 +246,16 @@ nonlinearSolve()
     }
   }
 
+  // report how many computations of the jacobian were skipped in all load steps of this solve, if it is lagged
+  if (this->jacobianLag_ != 1)
+  {
+    const int nJacobianComputations = this->nJacobianComputationsTotal_ - nJacobianComputationsBefore;
+    const int nJacobianRequests = this->nJacobianRequestsTotal_ - nJacobianRequestsBefore;
+    LOG(INFO) << "Jacobian computed " << nJacobianComputations << " times in " << nJacobianRequests << " nonlinear iterations, "
+      << "skipped " << std::max(0, nJacobianRequests - nJacobianComputations) << " computations ("
+      << std::max(0, this->nJacobianRequestsTotal_ - this->nJacobianComputationsTotal_) << " of " << this->nJacobianRequestsTotal_ << " in all solves).";
+  }
+
   if (this->durationLogKey_ != "")
     Control::PerformanceMeasurement::stop(this->durationLogKey_+std::string("_durationSolve"));
 
@@ -193,8 +272,8 @@ postprocessSolution()
   // copy the solution values back to this->data_.displacements() and this->data.pressure() (and this->data_.velocities() for the dynamic case)
   this->setUVP(this->combinedVecSolution_->valuesGlobal());
 
-  // compute the PK2 stress at every node
-  this->computePK2StressField();
+  // compute the PK2 stress at every node, if it is deferred compute only F and Fdot, the stress is then computed when output is written
+  this->computePK2StressField(this->deferStressFieldComputation_);
 
   LOG(DEBUG) << "solution: " << combinedVecSolution_->getString();
 
@@ -225,6 +304,27 @@ monitorSolvingIteration(SNES snes, PetscInt its, PetscReal currentNorm)
   // e_current = e_old ^ c = exp(c*log(e_old)) => c = log(e_current) / log(e_old)
   PetscReal experimentalOrderOfConvergence = log(currentNorm) / log(lastNorm_);
 
+  // if the jacobian or the preconditioner is lagged, i.e. not rebuilt in every iteration, rebuild it in the next iteration if the convergence degraded
+  if (this->rebuildLaggedJacobianThreshold_ > 0 && (this->jacobianLag_ != 1 || this->preconditionerLag_ != 1))
+  {
+    if (this->jacobianRebuildRequested_)
+    {
+      // the rebuild was done in the last iteration
+      restoreJacobianLag(snes);
+    }
+    else if (lastNorm_ > 0 && currentNorm > this->rebuildLaggedJacobianThreshold_ * lastNorm_)
+    {
+      LOG(INFO) << "  Residual norm decreased only by factor " << currentNorm / lastNorm_ << " > " << this->rebuildLaggedJacobianThreshold_
+        << ", rebuild jacobian and preconditioner.";
+
+      // -2 means rebuild at the next chance, afterwards PETSc sets the lag to -1
+      PetscErrorCode ierr;
+      ierr = SNESSetLagJacobian(snes, -2); CHKERRV(ierr);
+      ierr = SNESSetLagPreconditioner(snes, -2); CHKERRV(ierr);
+      this->jacobianRebuildRequested_ = true;
+    }
+  }
+
   secondLastNorm_ = lastNorm_;
   lastNorm_ = currentNorm;
   this->norms_.push_back(currentNorm);
@@ -289,11 +389,82 @@ initializePetscCallbackFunctions()
   PetscErrorCode (*callbackJacobianFiniteDifferences)(SNES, Vec, Mat, Mat, void *) = *jacobianFunctionFiniteDifferences<ThisClass>;
   PetscErrorCode (*callbackJacobianCombined)(SNES, Vec, Mat, Mat, void *)          = *jacobianFunctionCombined<ThisClass>;
   PetscErrorCode (*callbackMonitorFunction)(SNES, PetscInt, PetscReal, void *)     = *monitorFunction<ThisClass>;
+  PetscErrorCode (*callbackMatrixFreeJacobianMult)(Mat, Vec, Vec)                  = *matrixFreeJacobianMult<ThisClass>;
+  PetscErrorCode (*callbackMatrixFreeJacobianGetDiagonal)(Mat, Vec)                = *matrixFreeJacobianGetDiagonal<ThisClass>;
+  PetscErrorCode (*callbackMatrixFreePreconditionerGetDiagonal)(Mat, Vec)          = *matrixFreePreconditionerGetDiagonal<ThisClass>;
 
   // set function
   PetscErrorCode ierr;
   ierr = SNESSetFunction(*snes, solverVariableResidual_, callbackNonlinearFunction, this); CHKERRV(ierr);
 
+  // store the configured lags of the jacobian and preconditioner, they are changed temporarily if a rebuild is forced in monitorSolvingIteration
+  ierr = SNESGetLagJacobian(*snes, &this->jacobianLag_); CHKERRV(ierr);
+  ierr = SNESGetLagPreconditioner(*snes, &this->preconditionerLag_); CHKERRV(ierr);
+
+  // the operator of the linear system in every Newton iteration and the matrix from which the preconditioner is computed,
+  // normally this is the assembled jacobian for both
+  Mat jacobianOperator = this->solverMatrixJacobian_;
+  Mat preconditionerMatrix = this->solverMatrixJacobian_;
+
+  // for the matrix-free jacobian, the jacobian is not assembled, but applied element by element from the element contributions of the analytic jacobian
+  if (this->useMatrixFreeJacobian_)
+  {
+    // the number of unknowns changes when new Dirichlet boundary conditions are added, then this method is called again and the shell matrices have to be recreated
+    if (this->solverMatrixMatrixFreeJacobian_ != PETSC_NULL)
+    {
+      ierr = MatDestroy(&this->solverMatrixMatrixFreeJacobian_); CHKERRV(ierr);
+    }
+    if (this->solverMatrixMatrixFreePreconditioner_ != PETSC_NULL)
+    {
+      ierr = MatDestroy(&this->solverMatrixMatrixFreePreconditioner_); CHKERRV(ierr);
+    }
+
+    PetscInt nRowsLocal, nRowsGlobal;
+    ierr = VecGetLocalSize(solverVariableSolution_, &nRowsLocal); CHKERRV(ierr);
+    ierr = VecGetSize(solverVariableSolution_, &nRowsGlobal); CHKERRV(ierr);
+
+    ierr = MatCreateShell(this->displacementsFunctionSpace_->meshPartition()->mpiCommunicator(), nRowsLocal, nRowsLocal, nRowsGlobal, nRowsGlobal,
+                          this, &this->solverMatrixMatrixFreeJacobian_); CHKERRV(ierr);
+    ierr = MatShellSetOperation(this->solverMatrixMatrixFreeJacobian_, MATOP_MULT, (void (*)(void))callbackMatrixFreeJacobianMult); CHKERRV(ierr);
+    ierr = MatShellSetOperation(this->solverMatrixMatrixFreeJacobian_, MATOP_GET_DIAGONAL, (void (*)(void))callbackMatrixFreeJacobianGetDiagonal); CHKERRV(ierr);
+
+    jacobianOperator = this->solverMatrixMatrixFreeJacobian_;
+
+    // with the block or jacobi preconditioner, no matrix is assembled at all, the diagonal is also computed from the quadrature point values
+    if (this->matrixFreePreconditionerType_ == "jacobi")
+    {
+      preconditionerMatrix = this->solverMatrixMatrixFreeJacobian_;
+    }
+    else if (this->matrixFreePreconditionerType_ == "block")
+    {
+      // the jacobi preconditioner of this shell matrix uses the diagonal of the jacobian for the displacements and of the approximated Schur complement for the pressure,
+      // instead of the zero diagonal entries of the pressure rows
+      ierr = MatCreateShell(this->displacementsFunctionSpace_->meshPartition()->mpiCommunicator(), nRowsLocal, nRowsLocal, nRowsGlobal, nRowsGlobal,
+                            this, &this->solverMatrixMatrixFreePreconditioner_); CHKERRV(ierr);
+      ierr = MatShellSetOperation(this->solverMatrixMatrixFreePreconditioner_, MATOP_MULT, (void (*)(void))callbackMatrixFreeJacobianMult); CHKERRV(ierr);
+      ierr = MatShellSetOperation(this->solverMatrixMatrixFreePreconditioner_, MATOP_GET_DIAGONAL, (void (*)(void))callbackMatrixFreePreconditionerGetDiagonal); CHKERRV(ierr);
+
+      preconditionerMatrix = this->solverMatrixMatrixFreePreconditioner_;
+    }
+
+    if (this->matrixFreePreconditionerType_ != "assembled")
+    {
+      // other preconditioners than jacobi need the entries of the matrix
+      PC pc;
+      PetscBool isJacobi, isNone;
+      ierr = KSPGetPC(*ksp, &pc); CHKERRV(ierr);
+      ierr = PetscObjectTypeCompare((PetscObject)pc, PCJACOBI, &isJacobi); CHKERRV(ierr);
+      ierr = PetscObjectTypeCompare((PetscObject)pc, PCNONE, &isNone); CHKERRV(ierr);
+      if (!isJacobi && !isNone)
+      {
+        LOG(WARNING) << "The matrix-free jacobian with \"matrixFreePreconditionerType\": \"" << this->matrixFreePreconditionerType_ << "\" only supports the preconditioner types "
+          << "\"jacobi\" and \"none\", now using \"jacobi\". Set \"matrixFreePreconditionerType\": \"assembled\" to use other preconditioners.";
+        ierr = PCSetType(pc, PCJACOBI); CHKERRV(ierr);
+      }
+    }
+    LOG(DEBUG) << "Use matrix-free jacobian " << jacobianOperator << ", preconditioner type \"" << this->matrixFreePreconditionerType_ << "\"";
+  }
+
   // set jacobian
   if (this->useAnalyticJacobian_)
   {
@@ -301,21 +472,27 @@ initializePetscCallbackFunctions()
     {
       // use the analytic jacobian for the preconditioner and the numeric jacobian (from finite differences) as normal jacobian
       ierr = SNESSetJacobian(*snes, this->solverMatrixAdditionalNumericJacobian_, this->solverMatrixJacobian_, callbackJacobianCombined, this); CHKERRV(ierr);
+
+      if (this->useColoringForNumericJacobian_)
+        initializeNumericJacobianColoring(this->solverMatrixAdditionalNumericJacobian_);
       //ierr = SNESSetJacobian(*snes, solverMatrixAdditionalNumericJacobian_, solverMatrixAdditionalNumericJacobian_, callbackJacobianCombined, this); CHKERRV(ierr);
       //ierr = SNESSetJacobian(*snes, solverMatrixJacobian_, solverMatrixJacobian_, callbackJacobianCombined, this); CHKERRV(ierr);
       LOG(DEBUG) << "Use combination of numeric and analytic jacobian: " << this->solverMatrixJacobian_;
     }
     else    // use pure analytic jacobian, without fd
     {
-      ierr = SNESSetJacobian(*snes, this->solverMatrixJacobian_, this->solverMatrixJacobian_, callbackJacobianAnalytic, this); CHKERRV(ierr);
+      ierr = SNESSetJacobian(*snes, jacobianOperator, preconditionerMatrix, callbackJacobianAnalytic, this); CHKERRV(ierr);
       LOG(DEBUG) << "Use only analytic jacobian: " << this->solverMatrixJacobian_;
     }
   }
   else
   {
     // set function to compute jacobian from finite differences
-    ierr = SNESSetJacobian(*snes, this->solverMatrixJacobian_, this->solverMatrixJacobian_, callbackJacobianFiniteDifferences, this); CHKERRV(ierr);
+    ierr = SNESSetJacobian(*snes, jacobianOperator, this->solverMatrixJacobian_, callbackJacobianFiniteDifferences, this); CHKERRV(ierr);
     LOG(DEBUG) << "Use Finite-Differences approximation for jacobian";
+
+    if (this->useColoringForNumericJacobian_)
+      initializeNumericJacobianColoring(this->solverMatrixJacobian_);
   }
 
   // prepare log file
@@ -336,6 +513,99 @@ initializePetscCallbackFunctions()
 
 }
 
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+initializeNumericJacobianColoring(Mat jacobian)
+{
+  // The numeric jacobian is computed by finite differences. Without coloring, every unknown is perturbed separately, which needs
+  // as many evaluations of the nonlinear function as there are unknowns. With coloring, all columns of the same color, i.e. unknowns that do
+  // not share an element, are perturbed at once. The number of colors only depends on the element connectivity and not on the mesh size.
+  typedef HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents> ThisClass;
+  PetscErrorCode (*callbackNonlinearFunction)(SNES, Vec, Vec, void *) = *nonlinearFunction<ThisClass>;
+
+  // compute the distance-2 coloring of the nonzero structure, the type can be changed by the command line option -mat_coloring_type
+  PetscErrorCode ierr;
+  if (this->numericJacobianColoring_ != PETSC_NULL)
+  {
+    ierr = MatFDColoringDestroy(&this->numericJacobianColoring_); CHKERRV(ierr);
+  }
+
+  MatColoring matColoring;
+  ISColoring isColoring;
+  ierr = MatColoringCreate(jacobian, &matColoring); CHKERRV(ierr);
+  ierr = MatColoringSetType(matColoring, MATCOLORINGSL); CHKERRV(ierr);
+  ierr = MatColoringSetDistance(matColoring, 2); CHKERRV(ierr);
+  ierr = MatColoringSetFromOptions(matColoring); CHKERRV(ierr);
+  ierr = MatColoringApply(matColoring, &isColoring); CHKERRV(ierr);
+  ierr = MatColoringDestroy(&matColoring); CHKERRV(ierr);
+
+  // create the context that computes the jacobian with the nonlinear function
+  ierr = MatFDColoringCreate(jacobian, isColoring, &this->numericJacobianColoring_); CHKERRV(ierr);
+  ierr = MatFDColoringSetFunction(this->numericJacobianColoring_, (PetscErrorCode (*)(void))callbackNonlinearFunction, this); CHKERRV(ierr);
+  ierr = MatFDColoringSetFromOptions(this->numericJacobianColoring_); CHKERRV(ierr);
+  ierr = MatFDColoringSetUp(jacobian, isColoring, this->numericJacobianColoring_); CHKERRV(ierr);
+  ierr = ISColoringDestroy(&isColoring); CHKERRV(ierr);
+
+  LOG(DEBUG) << "Use coloring of the nonzero structure for the finite differences jacobian";
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+MatFDColoring HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+numericJacobianColoring()
+{
+  return this->numericJacobianColoring_;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+countJacobianComputation()
+{
+  this->nJacobianComputations_++;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+int HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+nNonlinearIterationsTotal() const
+{
+  // every nonlinear iteration requests the jacobian once
+  return this->nJacobianRequestsTotal_;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+int HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+nJacobianComputationsTotal() const
+{
+  return this->nJacobianComputationsTotal_;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+int HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+nResidualEvaluationsTotal() const
+{
+  return this->nResidualEvaluationsTotal_;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+int HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+nReusedElementJacobiansTotal() const
+{
+  return this->nReusedElementJacobiansTotal_;
+}
+
+template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
+void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
+restoreJacobianLag(SNES snes)
+{
+  if (!this->jacobianRebuildRequested_)
+    return;
+
+  // after a rebuild with lag -2, PETSc sets the lag to -1 (never rebuild again), set the configured values again
+  PetscErrorCode ierr;
+  ierr = SNESSetLagJacobian(snes, this->jacobianLag_); CHKERRV(ierr);
+  ierr = SNESSetLagPreconditioner(snes, this->preconditionerLag_); CHKERRV(ierr);
+  this->jacobianRebuildRequested_ = false;
+}
+
 #if 0
 template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementComponents>
 void HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
@@ -498,6 +768,7 @@ template<typename Term,bool withLargeOutput,typename MeshType,int nDisplacementC
 bool HyperelasticitySolver<Term,withLargeOutput,MeshType,nDisplacementComponents>::
 evaluateNonlinearFunction(Vec x, Vec f)
 {
+  this->nResidualEvaluationsTotal_++;
   //VLOG(1) << "evaluateNonlinearFunction at " << getString(x);
 
   // determine if Vecs need to be backed up and instead x,f should take the place of solverVariableSolution_,solverVariableResidual_
@@ -42,6 +42,41 @@ PetscErrorCode jacobianFunctionFiniteDifferences(SNES snes, Vec x, Mat jac, Mat
 template<typename T>
 PetscErrorCode jacobianFunctionCombined(SNES snes, Vec x, Mat jac, Mat b, void *context);
 
+/**
+ * Multiplication of the matrix-free jacobian with a vector, this is the MATOP_MULT operation of the shell matrix
+ *  Input Parameters:
+ *  jac - the shell matrix, its context is the solver object
+ *  x   - input vector
+ *
+ *  Output Parameter:
+ *  y   - result vector, y = jac*x
+ */
+template<typename T>
+PetscErrorCode matrixFreeJacobianMult(Mat jac, Vec x, Vec y);
+
+/**
+ * Diagonal of the matrix-free jacobian, this is the MATOP_GET_DIAGONAL operation of the shell matrix, it is needed for the jacobi preconditioner
+ *  Input Parameters:
+ *  jac - the shell matrix, its context is the solver object
+ *
+ *  Output Parameter:
+ *  diagonal - the diagonal entries of jac
+ */
+template<typename T>
+PetscErrorCode matrixFreeJacobianGetDiagonal(Mat jac, Vec diagonal);
+
+/**
+ * Diagonal of the block preconditioner of the matrix-free jacobian, this is the MATOP_GET_DIAGONAL operation of the shell matrix from which the jacobi preconditioner is computed,
+ * it contains the diagonal of the jacobian for the displacements and the diagonal of the approximated Schur complement for the pressure
+ *  Input Parameters:
+ *  jac - the shell matrix, its context is the solver object
+ *
+ *  Output Parameter:
+ *  diagonal - the diagonal entries of the block preconditioner
+ */
+template<typename T>
+PetscErrorCode matrixFreePreconditionerGetDiagonal(Mat jac, Vec diagonal);
+
 /**
  * Monitor convergence of nonlinear solver
  *
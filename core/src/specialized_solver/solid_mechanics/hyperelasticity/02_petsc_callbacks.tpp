@@ -59,14 +59,31 @@ PetscErrorCode jacobianFunctionAnalytic(SNES snes, Vec x, Mat jac, Mat b, void *
   VLOG(1) << "pointer value jac: " << jac << " (should be analytic slot)";
   VLOG(1) << "pointer value b:   " << b << " (should be analytic slot)";
 
-  // compute jacobian by analytic formula
-  object->evaluateAnalyticJacobian(x, jac);
+  // compute jacobian by analytic formula, in b which is the same as jac, unless the matrix-free jacobian is used for jac, for the matrix-free jacobian only the quadrature point values are computed if b is not an assembled matrix
+  object->evaluateAnalyticJacobian(x, b);
+  object->countJacobianComputation();
+
+  // assemble the shell matrices of the matrix-free jacobian, their quadrature point values were already updated by evaluateAnalyticJacobian,
+  // the assembly increases the state of the matrices, such that PETSc also recomputes the preconditioner from a shell matrix b
+  if (jac != b)
+  {
+    MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(jac, MAT_FINAL_ASSEMBLY);
+  }
+
+  PetscBool preconditionerMatrixIsShell;
+  PetscObjectTypeCompare((PetscObject)b, MATSHELL, &preconditionerMatrixIsShell);
+  if (preconditionerMatrixIsShell)
+  {
+    MatAssemblyBegin(b, MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(b, MAT_FINAL_ASSEMBLY);
+  }
 
   // output the jacobian matrix for debugging
-  object->dumpJacobianMatrix(jac);
+  object->dumpJacobianMatrix(b);
 
-  VLOG(2) << "-- computed tangent stiffness matrix analytically: " << PetscUtility::getStringMatrix(jac);
-  VLOG(2) << "-- non-zeros pattern: " << std::endl << PetscUtility::getStringSparsityPattern(jac);
+  VLOG(2) << "-- computed tangent stiffness matrix analytically: " << PetscUtility::getStringMatrix(b);
+  VLOG(2) << "-- non-zeros pattern: " << std::endl << PetscUtility::getStringSparsityPattern(b);
 
   return 0;
 }
@@ -84,14 +101,24 @@ PetscErrorCode jacobianFunctionFiniteDifferences(SNES snes, Vec x, Mat jac, Mat
   LOG(DEBUG) << "in jacobianFunctionFiniteDifferences, "
     << "solution: " << object->combinedVecSolution()->getString() << ", residual: " << object->combinedVecResidual()->getString();
 
+  object->countJacobianComputation();
+
   // compute jacobian by finite differences, in b (but this is the same pointer as jac)
-  SNESComputeJacobianDefault(snes, x, jac, b, context);
+  // if the coloring is available, only one evaluation of the nonlinear function per color is needed, otherwise one per unknown
+  if (object->numericJacobianColoring() != PETSC_NULL)
+  {
+    SNESComputeJacobianDefaultColor(snes, x, jac, b, object->numericJacobianColoring());
+  }
+  else
+  {
+    SNESComputeJacobianDefault(snes, x, jac, b, context);
+  }
 
   // output the jacobian matrix for debugging
-  object->dumpJacobianMatrix(jac);
+  object->dumpJacobianMatrix(b);
 
-  VLOG(2) << "-- computed tangent stiffness matrix by finite differences: " << PetscUtility::getStringMatrix(jac);
-  VLOG(2) << "-- non-zeros pattern: " << std::endl << PetscUtility::getStringSparsityPattern(jac);
+  VLOG(2) << "-- computed tangent stiffness matrix by finite differences: " << PetscUtility::getStringMatrix(b);
+  VLOG(2) << "-- non-zeros pattern: " << std::endl << PetscUtility::getStringSparsityPattern(b);
 
   return 0;
 }
@@ -107,14 +134,22 @@ PetscErrorCode jacobianFunctionCombined(SNES snes, Vec x, Mat jac, Mat b, void *
   VLOG(1) << "pointer value jac: " << jac << " (should be the numeric slot)";
   VLOG(1) << "pointer value b:   " << b << " (should be the analytic slot)";
 
-  // compute the finite differences jacobian in the main jacobian slot jac
-  SNESComputeJacobianDefault(snes, x, jac, jac, context);
+  // compute the finite differences jacobian in the main jacobian slot jac, using the coloring if it is available
+  if (object->numericJacobianColoring() != PETSC_NULL)
+  {
+    SNESComputeJacobianDefaultColor(snes, x, jac, jac, object->numericJacobianColoring());
+  }
+  else
+  {
+    SNESComputeJacobianDefault(snes, x, jac, jac, context);
+  }
 
   // output the jacobian matrix for debugging
   object->dumpJacobianMatrix(jac);
 
   // compute the analytical jacobian matrix, stored in the preconditioner slot b
   object->evaluateAnalyticJacobian(x, b);
+  object->countJacobianComputation();
 
   // output the jacobian matrix for debugging
   object->dumpJacobianMatrix(b);
@@ -123,6 +158,46 @@ PetscErrorCode jacobianFunctionCombined(SNES snes, Vec x, Mat jac, Mat b, void *
   return 0;
 }
 
+template<typename T>
+PetscErrorCode matrixFreeJacobianMult(Mat jac, Vec x, Vec y)
+{
+  void *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(jac, &context); CHKERRQ(ierr);
+  T* object = static_cast<T*>(context);
+
+  // compute y = jac*x element by element, with the quadrature point values of the last jacobian computation
+  object->applyMatrixFreeJacobian(x, y);
+
+  return 0;
+}
+
+template<typename T>
+PetscErrorCode matrixFreeJacobianGetDiagonal(Mat jac, Vec diagonal)
+{
+  void *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(jac, &context); CHKERRQ(ierr);
+  T* object = static_cast<T*>(context);
+
+  object->getMatrixFreeJacobianDiagonal(diagonal);
+
+  return 0;
+}
+
+template<typename T>
+PetscErrorCode matrixFreePreconditionerGetDiagonal(Mat jac, Vec diagonal)
+{
+  void *context;
+  PetscErrorCode ierr;
+  ierr = MatShellGetContext(jac, &context); CHKERRQ(ierr);
+  T* object = static_cast<T*>(context);
+
+  object->getMatrixFreeBlockPreconditionerDiagonal(diagonal);
+
+  return 0;
+}
+
 /**
  * Monitor convergence of nonlinear solver
  *
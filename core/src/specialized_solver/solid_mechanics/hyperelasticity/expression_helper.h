@@ -2,16 +2,78 @@
 
 #include <Python.h>  // has to be the first included header
 
+#include <array>
 #include <vector>
+#include <initializer_list>
+#include <type_traits>
+#include <iostream>
 #include <vc_or_std_simd.h>  // this includes <Vc/Vc> or a Vc-emulating wrapper of <experimental/simd> if available
 
+#include "semt/Semt.h"
+#include "semt/Shortcuts.h"
+#include "utility/vector_operators.h"
+
 namespace SpatialDiscretization
 {
 
+template<typename T>
+class ExpressionVariables {};
+
+/** The values of the variables that are inserted in SEMT symbolic expressions, e.g. Ibar1, Ibar2, ..., a3 of the hyperelasticity formulation.
+ *  The values are set once per quadrature point and are then used for all expressions. The storage is reused by subsequent calls to set,
+ *  such that no memory is allocated at every quadrature point if the object is kept, e.g. as a member of the solver.
+ */
+template<>
+class ExpressionVariables<double>
+{
+public:
+
+  //! set the values of all variables
+  void set(std::initializer_list<double> values);
+
+  //! get the values in the format of SEMT, the parameter is only needed for the interface to be the same as for Vc::double_v
+  const std::vector<double> &values(int vcComponentNo=0) const;
+
+  static constexpr int nVcComponents = 1;   //< number of components for which values are stored
+
+protected:
+  std::vector<double> values_;    //< the values of the variables
+};
+
+/** Partial specialization for Vc::double_v, the values are stored separately for every component of the vectorized data type,
+ *  because SEMT can only evaluate expressions for scalar values. The values are split into the components once in set,
+ *  not at every evaluation of an expression.
+ */
+template<>
+class ExpressionVariables<Vc::double_v>
+{
+public:
+
+  //! set the values of all variables
+  void set(std::initializer_list<Vc::double_v> values);
+
+  //! get the values of the given component of the vectorized data type in the format of SEMT
+  const std::vector<double> &values(int vcComponentNo) const;
+
+  static constexpr int nVcComponents = Vc::double_v::size();   //< number of components for which values are stored
+
+protected:
+  std::array<std::vector<double>,Vc::double_v::size()> values_;    //< for every component of the vectorized data type the values of the variables
+};
+
+//! output the values of the variables
+template<typename T>
+std::ostream &operator<<(std::ostream &stream, const ExpressionVariables<T> &variables);
+
+//! type trait if the SEMT expression is the constant zero, then its type is known at compile time
+template<typename SEMTExpressionType>
+using isZeroExpression = std::is_same<typename std::remove_cv<SEMTExpressionType>::type, decltype(INT(0))>;
+
 template<typename T>
 class ExpressionHelper {};
 
 /** Helper class that inserts variables in a SEMT symbolic expression.
+ * The expression tree is evaluated by SEMT at every call, common subexpressions of different derivatives are not shared.
  * This partial specialization is for normal double values.
  */
 template<>
@@ -21,7 +83,17 @@ public:
 
   // apply the SEMT expression to the given variables
   template<typename SEMTExpressionType>
-  static double apply(SEMTExpressionType &expression, const std::vector<double> &variables);
+  static double apply(SEMTExpressionType &expression, const ExpressionVariables<double> &variables);
+
+protected:
+
+  //! evaluate the expression, this is the case for an expression that is not the constant zero
+  template<typename SEMTExpressionType>
+  static double applyExpression(SEMTExpressionType &expression, const ExpressionVariables<double> &variables, std::false_type isZero);
+
+  //! the expression is the constant zero (e.g. a derivative of a term that is INT(0)), it does not need to be evaluated
+  template<typename SEMTExpressionType>
+  static double applyExpression(SEMTExpressionType &expression, const ExpressionVariables<double> &variables, std::true_type isZero);
 };
 
 /** Partial specialization for Vc::double_v, i.e. vectorized apply for multiple sets of values at once
@@ -33,7 +105,17 @@ public:
 
   // apply the SEMT expression to the given variables
   template<typename SEMTExpressionType>
-  static Vc::double_v apply(SEMTExpressionType &expression, const std::vector<Vc::double_v> &variables);
+  static Vc::double_v apply(SEMTExpressionType &expression, const ExpressionVariables<Vc::double_v> &variables);
+
+protected:
+
+  //! evaluate the expression for every component of the vectorized data type, this is the case for an expression that is not the constant zero
+  template<typename SEMTExpressionType>
+  static Vc::double_v applyExpression(SEMTExpressionType &expression, const ExpressionVariables<Vc::double_v> &variables, std::false_type isZero);
+
+  //! the expression is the constant zero (e.g. a derivative of a term that is INT(0)), it does not need to be evaluated
+  template<typename SEMTExpressionType>
+  static Vc::double_v applyExpression(SEMTExpressionType &expression, const ExpressionVariables<Vc::double_v> &variables, std::true_type isZero);
 };
 
 }  // namespace
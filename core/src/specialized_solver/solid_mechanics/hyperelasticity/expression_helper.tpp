@@ -3,32 +3,97 @@
 namespace SpatialDiscretization
 {
 
-template<typename SEMTExpressionType>
-double ExpressionHelper<double>::apply(SEMTExpressionType &expression, const std::vector<double> &variables)
+inline void ExpressionVariables<double>::set(std::initializer_list<double> values)
 {
-  return expression.apply(variables);
+  // assign does not reallocate if the number of variables is the same as before
+  values_.assign(values.begin(), values.end());
 }
 
-template<typename SEMTExpressionType>
-Vc::double_v ExpressionHelper<Vc::double_v>::apply(SEMTExpressionType &expression, const std::vector<Vc::double_v> &variables)
+inline const std::vector<double> &ExpressionVariables<double>::values(int vcComponentNo) const
 {
-  Vc::double_v result;
-  std::vector<double> variablesVector(variables.size());
+  return values_;
+}
+
+inline void ExpressionVariables<Vc::double_v>::set(std::initializer_list<Vc::double_v> values)
+{
+  const int nVariables = values.size();
 
   // loop over the components of the vectorized data type
   for (int vcComponentNo = 0; vcComponentNo < Vc::double_v::size(); vcComponentNo++)
   {
+    std::vector<double> &variablesVector = values_[vcComponentNo];
+    variablesVector.resize(nVariables);
+
     // loop over variables and set the variables vector for the current vc component
-    for (int i = 0; i < variables.size(); i++)
+    int i = 0;
+    for (const Vc::double_v &value : values)
     {
-      variablesVector[i] = variables[i][vcComponentNo];
+      variablesVector[i++] = value[vcComponentNo];
     }
+  }
+}
+
+inline const std::vector<double> &ExpressionVariables<Vc::double_v>::values(int vcComponentNo) const
+{
+  return values_[vcComponentNo];
+}
 
-    // apply expression for current component
-    result[vcComponentNo] = expression.apply(variablesVector);
+template<typename T>
+std::ostream &operator<<(std::ostream &stream, const ExpressionVariables<T> &variables)
+{
+  stream << "(";
+  for (int vcComponentNo = 0; vcComponentNo < ExpressionVariables<T>::nVcComponents; vcComponentNo++)
+  {
+    if (vcComponentNo != 0)
+      stream << ",";
+    stream << variables.values(vcComponentNo);
+  }
+  stream << ")";
+  return stream;
+}
+
+template<typename SEMTExpressionType>
+double ExpressionHelper<double>::apply(SEMTExpressionType &expression, const ExpressionVariables<double> &variables)
+{
+  return applyExpression(expression, variables, isZeroExpression<SEMTExpressionType>());
+}
+
+template<typename SEMTExpressionType>
+double ExpressionHelper<double>::applyExpression(SEMTExpressionType &expression, const ExpressionVariables<double> &variables, std::false_type isZero)
+{
+  return expression.apply(variables.values());
+}
+
+template<typename SEMTExpressionType>
+double ExpressionHelper<double>::applyExpression(SEMTExpressionType &expression, const ExpressionVariables<double> &variables, std::true_type isZero)
+{
+  return 0.0;
+}
+
+template<typename SEMTExpressionType>
+Vc::double_v ExpressionHelper<Vc::double_v>::apply(SEMTExpressionType &expression, const ExpressionVariables<Vc::double_v> &variables)
+{
+  return applyExpression(expression, variables, isZeroExpression<SEMTExpressionType>());
+}
+
+template<typename SEMTExpressionType>
+Vc::double_v ExpressionHelper<Vc::double_v>::applyExpression(SEMTExpressionType &expression, const ExpressionVariables<Vc::double_v> &variables, std::true_type isZero)
+{
+  return Vc::double_v(0.0);
+}
+
+template<typename SEMTExpressionType>
+Vc::double_v ExpressionHelper<Vc::double_v>::applyExpression(SEMTExpressionType &expression, const ExpressionVariables<Vc::double_v> &variables, std::false_type isZero)
+{
+  Vc::double_v result;
+
+  // loop over the components of the vectorized data type
+  for (int vcComponentNo = 0; vcComponentNo < Vc::double_v::size(); vcComponentNo++)
+  {
+    // apply expression for current component, the variables have already been split into the components
+    result[vcComponentNo] = expression.apply(variables.values(vcComponentNo));
   }
   return result;
 }
 
 }  // namespace
-
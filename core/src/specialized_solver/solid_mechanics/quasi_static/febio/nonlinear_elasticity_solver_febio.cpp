@@ -2,18 +2,31 @@
 
 #include <Python.h>  // has to be the first included header
 
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+
 #include "utility/python_utility.h"
 #include "utility/petsc_utility.h"
 #include "data_management/specialized_solver/multidomain.h"
 #include "control/diagnostic_tool/performance_measurement.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
 
+extern char **environ;
+
 namespace TimeSteppingScheme
 {
 #if 1
+constexpr int NonlinearElasticitySolverFebio::nFebioNodeValues;
+constexpr int NonlinearElasticitySolverFebio::nFebioElementValues;
+
 NonlinearElasticitySolverFebio::
 NonlinearElasticitySolverFebio(DihuContext context, std::string solverName) :
-  context_(context[solverName]), data_(context_), solverName_(solverName), initialized_(false)
+  context_(context[solverName]), data_(context_), solverName_(solverName), febioProcessStarted_(false), febioProcessId_(0),
+  febioProcessInput_(-1), febioProcessOutput_(-1), endTime_(0), initialized_(false)
 {
 
   // get python config
@@ -39,6 +52,12 @@ NonlinearElasticitySolverFebio(DihuContext context, std::string solverName) :
     }
   }
 
+  // command of a persistent febio process, if not given, febio3 is run on files in every time step
+  if (specificSettings_.hasKey("persistentProcessCommand"))
+  {
+    this->persistentProcessCommand_ = specificSettings_.getOptionString("persistentProcessCommand", "");
+  }
+
   // load traction elements
   specificSettings_.getOptionVector("tractionElementNos", tractionElementNos_);
   tractionVector_ = specificSettings_.getOptionArray<double,3>("tractionVector", 0);
@@ -52,6 +71,12 @@ NonlinearElasticitySolverFebio(DihuContext context, std::string solverName) :
   LOG(DEBUG) << "initialized NonlinearElasticitySolverFebio";
 }
 
+NonlinearElasticitySolverFebio::
+~NonlinearElasticitySolverFebio()
+{
+  stopFebioProcess();
+}
+
 void NonlinearElasticitySolverFebio::
 advanceTimeSpan(bool withOutputWritersEnabled)
 {
@@ -61,11 +86,27 @@ advanceTimeSpan(bool withOutputWritersEnabled)
   if (this->durationLogKey_ != "")
     Control::PerformanceMeasurement::start(this->durationLogKey_);
 
-  createFebioInputFile();
+  if (persistentProcessCommand_.empty())
+  {
+    createFebioInputFile();
 
-  runFebio();
+    runFebio();
 
-  loadFebioOutputFile();
+    loadFebioOutputFile();
+  }
+  else
+  {
+    // at the first time step, write the febio input file which describes the problem and start the process on it
+    if (!febioProcessStarted_)
+    {
+      createFebioInputFile();
+
+      startFebioProcess();
+      febioProcessStarted_ = true;
+    }
+
+    exchangeDataWithFebioProcess();
+  }
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
@@ -120,6 +161,257 @@ runFebio()
   MPIUtility::handleReturnValue(MPI_Barrier(this->data_.functionSpace()->meshPartition()->mpiCommunicator()), "MPI_Barrier");
 }
 
+void NonlinearElasticitySolverFebio::
+startFebioProcess()
+{
+  // only run febio on rank 0
+  int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  if (ownRankNo != 0)
+    return;
+
+  // create pipes for stdin and stdout of the process
+  int pipeToProcess[2];
+  int pipeFromProcess[2];
+  if (pipe(pipeToProcess) != 0 || pipe(pipeFromProcess) != 0)
+  {
+    LOG(FATAL) << "Could not create pipes for the persistent FEBio process: " << strerror(errno);
+  }
+
+  // redirect stdin and stdout of the new process to the pipes
+  posix_spawn_file_actions_t fileActions;
+  posix_spawn_file_actions_init(&fileActions);
+  posix_spawn_file_actions_adddup2(&fileActions, pipeToProcess[0], STDIN_FILENO);
+  posix_spawn_file_actions_adddup2(&fileActions, pipeFromProcess[1], STDOUT_FILENO);
+  posix_spawn_file_actions_addclose(&fileActions, pipeToProcess[0]);
+  posix_spawn_file_actions_addclose(&fileActions, pipeToProcess[1]);
+  posix_spawn_file_actions_addclose(&fileActions, pipeFromProcess[0]);
+  posix_spawn_file_actions_addclose(&fileActions, pipeFromProcess[1]);
+
+  // run the command in a shell with the febio input file as argument,
+  // posix_spawn is used instead of fork, because fork is not supported by some MPI implementations
+  std::string command = persistentProcessCommand_ + " febio3_input.feb";
+  std::vector<char> commandString(command.begin(), command.end());
+  commandString.push_back('\0');
+  char shellString[] = "sh";
+  char optionString[] = "-c";
+  char *arguments[] = {shellString, optionString, commandString.data(), nullptr};
+
+  int returnValue = posix_spawn(&febioProcessId_, "/bin/sh", &fileActions, nullptr, arguments, environ);
+  posix_spawn_file_actions_destroy(&fileActions);
+
+  // close the ends of the pipes that are used by the process
+  close(pipeToProcess[0]);
+  close(pipeFromProcess[1]);
+
+  if (returnValue != 0)
+  {
+    LOG(FATAL) << "Could not start the persistent FEBio process \"" << command << "\": " << strerror(returnValue);
+  }
+
+  febioProcessInput_ = pipeToProcess[1];
+  febioProcessOutput_ = pipeFromProcess[0];
+
+  LOG(INFO) << "Started persistent FEBio process \"" << command << "\" (pid " << febioProcessId_ << ").";
+}
+
+void NonlinearElasticitySolverFebio::
+exchangeDataWithFebioProcess()
+{
+  int ownRankNo = DihuContext::ownRankNoCommWorld();
+
+  // communicate elemental values
+  std::vector<double> activationValuesGlobal;
+  std::vector<int> nodeNosGlobal;
+  communicateElementValues(activationValuesGlobal, nodeNosGlobal);
+
+  // communicate node positions
+  std::vector<double> nodePositionValuesGlobal;
+  communicateNodeValues(nodePositionValuesGlobal);
+
+  const int nNodesGlobal = data_.functionSpace()->nNodesGlobal();
+  const int nElementsGlobal = data_.functionSpace()->nElementsGlobal();
+
+  // the results of all global nodes and elements on rank 0, in the same layout as parsed from the febio log files, i.e. every entry starts with the 1-based id
+  std::vector<double> nodeValuesGlobal;
+  std::vector<double> elementValuesGlobal;
+  int status = 0;
+
+  if (ownRankNo == 0)
+  {
+    nodeValuesGlobal.resize(nNodesGlobal*(1+nFebioNodeValues));
+    elementValuesGlobal.resize(nElementsGlobal*(1+nFebioElementValues));
+
+    // send the request
+    int command = 1;
+    bool success = writeToFebioProcess(&command, sizeof(int))
+      && writeToFebioProcess(&endTime_, sizeof(double))
+      && writeToFebioProcess(&nElementsGlobal, sizeof(int))
+      && writeToFebioProcess(activationValuesGlobal.data(), nElementsGlobal*sizeof(double))
+      && writeToFebioProcess(&nNodesGlobal, sizeof(int))
+      && writeToFebioProcess(nodePositionValuesGlobal.data(), 3*nNodesGlobal*sizeof(double));
+
+    // receive the status
+    if (success)
+      success = readFromFebioProcess(&status, sizeof(int)) && status == 0;
+
+    // receive the node values and the element values
+    std::vector<double> buffer;
+    for (int i = 0; i < 2 && success; i++)
+    {
+      const int nEntriesExpected = (i == 0? nNodesGlobal : nElementsGlobal);
+      const int nValuesPerEntry = (i == 0? nFebioNodeValues : nFebioElementValues);
+      std::vector<double> &values = (i == 0? nodeValuesGlobal : elementValuesGlobal);
+
+      int nEntries = 0;
+      success = readFromFebioProcess(&nEntries, sizeof(int));
+      if (success && nEntries != nEntriesExpected)
+      {
+        LOG(ERROR) << "The persistent FEBio process sent " << nEntries << " " << (i == 0? "nodes" : "elements")
+          << ", but " << nEntriesExpected << " were expected.";
+        success = false;
+      }
+
+      buffer.resize(nEntries*nValuesPerEntry);
+      if (success)
+        success = readFromFebioProcess(buffer.data(), buffer.size()*sizeof(double));
+
+      // store values with preceding id
+      for (int entryNo = 0; entryNo < nEntries && success; entryNo++)
+      {
+        values[entryNo*(1+nValuesPerEntry)] = entryNo+1;
+        std::copy(buffer.begin() + entryNo*nValuesPerEntry, buffer.begin() + (entryNo+1)*nValuesPerEntry,
+                  values.begin() + entryNo*(1+nValuesPerEntry) + 1);
+      }
+    }
+
+    if (!success)
+    {
+      LOG(ERROR) << "Data exchange with the persistent FEBio process failed (status " << status << ").";
+      if (status == 0)
+        status = -1;
+    }
+  }
+
+  // send the status to all ranks
+  MPIUtility::handleReturnValue(MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Bcast");
+
+  // without results of the current time step, the simulation cannot continue
+  if (status != 0)
+  {
+    LOG(FATAL) << "The persistent FEBio process failed to compute the time step at t=" << endTime_ << " (status " << status << ").";
+  }
+
+  // send to every rank only the entries of its own nodes and elements,
+  // the entries are ordered by ranks in the same way as the values were gathered in communicateNodeValues and communicateElementValues
+  int nRanks = DihuContext::nRanksCommWorld();
+  std::vector<double> nodeValues(data_.functionSpace()->nNodesLocalWithoutGhosts()*(1+nFebioNodeValues));
+  std::vector<double> elementValues(data_.functionSpace()->nElementsLocal()*(1+nFebioElementValues));
+
+  for (int i = 0; i < 2; i++)
+  {
+    std::vector<double> &valuesLocal = (i == 0? nodeValues : elementValues);
+    std::vector<double> &valuesGlobal = (i == 0? nodeValuesGlobal : elementValuesGlobal);
+
+    // prepare helper values for MPI_Scatterv
+    int ownSize = valuesLocal.size();
+    std::vector<int> sizesOnRanks(nRanks);
+    MPIUtility::handleReturnValue(MPI_Gather(&ownSize, 1, MPI_INT, sizesOnRanks.data(), 1, MPI_INT, 0, MPI_COMM_WORLD), "MPI_Gather");
+
+    std::vector<int> offsets(nRanks, 0);
+    for (int rankNo = 1; rankNo < nRanks; rankNo++)
+    {
+      offsets[rankNo] = offsets[rankNo-1] + sizesOnRanks[rankNo-1];
+    }
+
+    MPIUtility::handleReturnValue(MPI_Scatterv(valuesGlobal.data(), sizesOnRanks.data(), offsets.data(), MPI_DOUBLE,
+                                               valuesLocal.data(), ownSize, MPI_DOUBLE, 0, MPI_COMM_WORLD), "MPI_Scatterv");
+  }
+
+  setFebioResults(nodeValues, elementValues);
+}
+
+void NonlinearElasticitySolverFebio::
+stopFebioProcess()
+{
+  if (febioProcessId_ <= 0)
+    return;
+
+  // tell the process to exit
+  int command = 0;
+  writeToFebioProcess(&command, sizeof(int));
+
+  close(febioProcessInput_);
+  close(febioProcessOutput_);
+  febioProcessInput_ = -1;
+  febioProcessOutput_ = -1;
+
+  // wait until the process has finished
+  int processStatus = 0;
+  waitpid(febioProcessId_, &processStatus, 0);
+
+  if (!WIFEXITED(processStatus) || WEXITSTATUS(processStatus) != EXIT_SUCCESS)
+  {
+    LOG(WARNING) << "The persistent FEBio process (pid " << febioProcessId_ << ") did not exit successfully.";
+  }
+  febioProcessId_ = 0;
+}
+
+bool NonlinearElasticitySolverFebio::
+writeToFebioProcess(const void *data, std::size_t nBytes)
+{
+  // if the process has terminated, writing to the pipe should fail with an error instead of terminating the program by SIGPIPE,
+  // therefore ignore SIGPIPE during the write and restore the previous handler afterwards
+  struct sigaction ignoreAction;
+  struct sigaction previousAction;
+  memset(&ignoreAction, 0, sizeof(ignoreAction));
+  ignoreAction.sa_handler = SIG_IGN;
+  sigemptyset(&ignoreAction.sa_mask);
+  sigaction(SIGPIPE, &ignoreAction, &previousAction);
+
+  bool success = true;
+  const char *position = static_cast<const char *>(data);
+  while (nBytes > 0)
+  {
+    ssize_t nBytesWritten = write(febioProcessInput_, position, nBytes);
+    if (nBytesWritten < 0)
+    {
+      if (errno == EINTR)
+        continue;
+
+      LOG(ERROR) << "Could not write to the persistent FEBio process: " << strerror(errno);
+      success = false;
+      break;
+    }
+    position += nBytesWritten;
+    nBytes -= nBytesWritten;
+  }
+
+  sigaction(SIGPIPE, &previousAction, nullptr);
+  return success;
+}
+
+bool NonlinearElasticitySolverFebio::
+readFromFebioProcess(void *data, std::size_t nBytes)
+{
+  char *position = static_cast<char *>(data);
+  while (nBytes > 0)
+  {
+    ssize_t nBytesRead = read(febioProcessOutput_, position, nBytes);
+    if (nBytesRead < 0 && errno == EINTR)
+      continue;
+
+    if (nBytesRead <= 0)
+    {
+      LOG(ERROR) << "Could not read from the persistent FEBio process: " << (nBytesRead == 0? "the process has terminated" : strerror(errno));
+      return false;
+    }
+    position += nBytesRead;
+    nBytes -= nBytesRead;
+  }
+  return true;
+}
+
 void NonlinearElasticitySolverFebio::
 createFebioInputFile()
 {
@@ -423,9 +715,20 @@ loadFebioOutputFile()
   fileGeometry.clear();
   fileGeometry.seekg(0);
 
-  // load last step
+  // parse a line of the form "id,value0,value1,...", append id and values to data
+  auto parseLine = [](std::string line, int nValues, std::vector<double> &data)
+  {
+    data.push_back(atoi(StringUtility::extractUntil(line, ",").c_str()));
+    for (int valueNo = 0; valueNo < nValues-1; valueNo++)
+    {
+      data.push_back(atof(StringUtility::extractUntil(line, ",").c_str()));
+    }
+    data.push_back(atof(line.c_str()));
+  };
+
+  // load last step, entries are id;x;y;z;ux;uy;uz;Rx;Ry;Rz
   int currentStepNo = 0;
-  std::vector<Vec3> geometryValues;
+  std::vector<double> nodeValues;
   while(!fileGeometry.eof())
   {
     std::getline(fileGeometry, line);
@@ -438,36 +741,7 @@ loadFebioOutputFile()
     {
       if (line.find("*") == std::string::npos && line.find(",") != std::string::npos)
       {
-        int id = atoi(StringUtility::extractUntil(line, ",").c_str());
-
-        // x;y;z;ux;uy;uz;Rx;Ry;Rz
-        double x = atof(StringUtility::extractUntil(line, ",").c_str());
-        double y = atof(StringUtility::extractUntil(line, ",").c_str());
-        double z = atof(StringUtility::extractUntil(line, ",").c_str());
-        double ux = atof(StringUtility::extractUntil(line, ",").c_str());
-        double uy = atof(StringUtility::extractUntil(line, ",").c_str());
-        double uz = atof(StringUtility::extractUntil(line, ",").c_str());
-        double Rx = atof(StringUtility::extractUntil(line, ",").c_str());
-        double Ry = atof(StringUtility::extractUntil(line, ",").c_str());
-        double Rz = atof(line.c_str());
-
-        global_no_t nodeNoGlobalPetsc = id - 1;
-
-        // convert global node no to local no
-        bool isLocal = false;
-        node_no_t nodeNoLocal = this->data_.functionSpace()->meshPartition()->getNodeNoLocal(nodeNoGlobalPetsc, isLocal);
-
-        LOG(DEBUG) << "read point " << id << ": " << Vec3({x,y,z}) << ", global: " << nodeNoGlobalPetsc << ", local: " << nodeNoLocal;
-
-        if (isLocal)
-        {
-          LOG(DEBUG) << "is local";
-
-          this->data_.displacements()->setValue(nodeNoLocal, Vec3{ux,uy,uz});
-          this->data_.reactionForce()->setValue(nodeNoLocal, Vec3{Rx,Ry,Rz});
-
-          geometryValues.push_back(Vec3{x,y,z});
-        }
+        parseLine(line, nFebioNodeValues, nodeValues);
       }
     }
   }
@@ -483,11 +757,9 @@ loadFebioOutputFile()
     return;
   }
 
-  // load last step
+  // load last step, entries are id;sx;sy;sz;sxy;syz;sxz;Ex;Ey;Ez;Exy;Eyz;Exz;J;Fxx,Fxy,Fxz;Fyx;Fyy;Fyz;Fzx;Fzy;Fzz
   currentStepNo = 0;
-  std::vector<Vec3> elementValues;
-
-  // advance to line in file where actual data starts
+  std::vector<double> elementValues;
   while(!fileStress.eof())
   {
     std::getline(fileStress, line);
@@ -499,14 +771,63 @@ loadFebioOutputFile()
 
     if (currentStepNo == nStepsContainedInFile)
     {
-      if (line.find("*") == std::string::npos)
+      if (line.find("*") == std::string::npos && line.find(",") != std::string::npos)
       {
-        LOG(DEBUG) << "line to start: [" << line << "]";
-        break;
+        parseLine(line, nFebioElementValues, elementValues);
       }
     }
   }
 
+  fileStress.close();
+
+  setFebioResults(nodeValues, elementValues);
+}
+
+void NonlinearElasticitySolverFebio::
+setFebioResults(const std::vector<double> &nodeValues, const std::vector<double> &elementValues)
+{
+  const int nNodeEntries = nodeValues.size() / (1+nFebioNodeValues);
+  const int nElementEntries = elementValues.size() / (1+nFebioElementValues);
+
+  // start with the current geometry, such that nodes without values from febio keep their position
+  std::vector<Vec3> geometryValues;
+  this->data_.functionSpace()->geometryField().getValuesWithoutGhosts(geometryValues);
+
+  // loop over the node entries, set the values of local nodes
+  for (int entryNo = 0; entryNo < nNodeEntries; entryNo++)
+  {
+    // x;y;z;ux;uy;uz;Rx;Ry;Rz
+    const double *values = nodeValues.data() + entryNo*(1+nFebioNodeValues);
+    int id = int(values[0]);
+    double x  = values[1];
+    double y  = values[2];
+    double z  = values[3];
+    double ux = values[4];
+    double uy = values[5];
+    double uz = values[6];
+    double Rx = values[7];
+    double Ry = values[8];
+    double Rz = values[9];
+
+    global_no_t nodeNoGlobalPetsc = id - 1;
+
+    // convert global node no to local no
+    bool isLocal = false;
+    node_no_t nodeNoLocal = this->data_.functionSpace()->meshPartition()->getNodeNoLocal(nodeNoGlobalPetsc, isLocal);
+
+    LOG(DEBUG) << "read point " << id << ": " << Vec3({x,y,z}) << ", global: " << nodeNoGlobalPetsc << ", local: " << nodeNoLocal;
+
+    if (isLocal && nodeNoLocal < (node_no_t)geometryValues.size())
+    {
+      LOG(DEBUG) << "is local";
+
+      this->data_.displacements()->setValue(nodeNoLocal, Vec3{ux,uy,uz});
+      this->data_.reactionForce()->setValue(nodeNoLocal, Vec3{Rx,Ry,Rz});
+
+      geometryValues[nodeNoLocal] = Vec3{x,y,z};
+    }
+  }
+
   this->data_.pk2Stress()->zeroEntries();
   this->data_.cauchyStress()->zeroEntries();
   this->data_.greenLagrangeStrain()->zeroEntries();
@@ -516,9 +837,10 @@ loadFebioOutputFile()
   int nElementsLoaded = 0;
 
   // loop over elements, average element-based values to nodal values
-  for (;;)
+  for (int entryNo = 0; entryNo < nElementEntries; entryNo++)
   {
-    int id = atoi(StringUtility::extractUntil(line, ",").c_str());
+    const double *values = elementValues.data() + entryNo*(1+nFebioElementValues);
+    int id = int(values[0]);
 
     // get local element no for global element no
     global_no_t elementNoGlobalPetsc = id - 1;
@@ -527,80 +849,72 @@ loadFebioOutputFile()
 
     LOG(DEBUG) << "read element global " << elementNoGlobalPetsc << ", local: " << elementNoLocal << ", isOnLocalDomain: " << isOnLocalDomain;
 
-    if (isOnLocalDomain)
-    {
-      std::array<dof_no_t,FunctionSpace::nNodesPerElement()> elementNodeNos = data_.functionSpace()->getElementNodeNos(elementNoLocal);
-
-      // sx;sy;sz;sxy;syz;sxz;Ex;Ey;Ez;Exy;Eyz;Exz;J;Fxx,Fxy,Fxz;Fyx;Fyy;Fyz;Fzx;Fzy;Fzz
-      double sx  = atof(StringUtility::extractUntil(line, ",").c_str());
-      double sy  = atof(StringUtility::extractUntil(line, ",").c_str());
-      double sz  = atof(StringUtility::extractUntil(line, ",").c_str());
-      double sxy = atof(StringUtility::extractUntil(line, ",").c_str());
-      double syz = atof(StringUtility::extractUntil(line, ",").c_str());
-      double sxz = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Ex  = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Ey  = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Ez  = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Exy = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Eyz = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Exz = atof(StringUtility::extractUntil(line, ",").c_str());
-      double J   = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fxx = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fxy = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fxz = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fyx = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fyy = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fyz = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fzx = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fzy = atof(StringUtility::extractUntil(line, ",").c_str());
-      double Fzz = atof(line.c_str());
-
-      // compute 2nd Piola-Kirchhoff stress, S, from Cauchy stress, σ
-      // S = J F^-1 σ F^-T
-      Tensor2<3> cauchyStress{Vec3{sx,sxy,sxz}, Vec3{sxy, sy, syz}, Vec3{sxz, syz, sz}};
-      Tensor2<3> deformationGradient{Vec3{Fxx, Fyx, Fzx}, Vec3{Fxy, Fyy, Fzy}, Vec3{Fxz, Fyz, Fzz}};
-      double determinant = 0;
-      double approximateMeshWidth = 0;
-      Tensor2<3> inverseDeformationGradient = MathUtility::computeInverse(deformationGradient, approximateMeshWidth, determinant);
-
-      Tensor2<3> deformationGradientCofactor = MathUtility::computeCofactorMatrix<double>(deformationGradient);  // cof(M) = det(M) * M^{-T}
-      Tensor2<3> pk2Stress = inverseDeformationGradient * cauchyStress * deformationGradientCofactor;
-
-      LOG(DEBUG) << "local element " << elementNoLocal << " of " << this->data_.functionSpace()->nElementsLocal() << ", " << FunctionSpace::nNodesPerElement() << " elementNodeNos: " << elementNodeNos;
-
-      LOG(DEBUG) << "F: " << deformationGradient << ", J: " << J << "=" << determinant;
-      LOG(DEBUG) << "pk2Stress = " << pk2Stress << " = " << inverseDeformationGradient << "*" << cauchyStress << "*" << deformationGradientCofactor;
-
-      for (node_no_t elementalNodeNo = 0; elementalNodeNo < FunctionSpace::nNodesPerElement(); elementalNodeNo++)
-      {
-        node_no_t nodeNoLocal = elementNodeNos[elementalNodeNo];
+    if (!isOnLocalDomain)
+      continue;
 
-        if (nodeNoLocal >= this->data_.functionSpace()->nNodesLocalWithoutGhosts())
-          continue;
+    std::array<dof_no_t,FunctionSpace::nNodesPerElement()> elementNodeNos = data_.functionSpace()->getElementNodeNos(elementNoLocal);
 
-        this->data_.pk2Stress()->setValue(nodeNoLocal, std::array<double,6>{pk2Stress[0][0],pk2Stress[1][1],pk2Stress[2][2],pk2Stress[1][0],pk2Stress[2][1],pk2Stress[2][0]}, ADD_VALUES);
-        this->data_.cauchyStress()->setValue(nodeNoLocal, std::array<double,6>{sx,sy,sz,sxy,syz,sxz}, ADD_VALUES);
-        this->data_.greenLagrangeStrain()->setValue(nodeNoLocal, std::array<double,6>{Ex,Ey,Ez,Exy,Eyz,Exz}, ADD_VALUES);
-        this->data_.relativeVolume()->setValue(nodeNoLocal, J, ADD_VALUES);
+    // sx;sy;sz;sxy;syz;sxz;Ex;Ey;Ez;Exy;Eyz;Exz;J;Fxx,Fxy,Fxz;Fyx;Fyy;Fyz;Fzx;Fzy;Fzz
+    double sx  = values[1];
+    double sy  = values[2];
+    double sz  = values[3];
+    double sxy = values[4];
+    double syz = values[5];
+    double sxz = values[6];
+    double Ex  = values[7];
+    double Ey  = values[8];
+    double Ez  = values[9];
+    double Exy = values[10];
+    double Eyz = values[11];
+    double Exz = values[12];
+    double J   = values[13];
+    double Fxx = values[14];
+    double Fxy = values[15];
+    double Fxz = values[16];
+    double Fyx = values[17];
+    double Fyy = values[18];
+    double Fyz = values[19];
+    double Fzx = values[20];
+    double Fzy = values[21];
+    double Fzz = values[22];
+
+    // compute 2nd Piola-Kirchhoff stress, S, from Cauchy stress, σ
+    // S = J F^-1 σ F^-T
+    Tensor2<3> cauchyStress{Vec3{sx,sxy,sxz}, Vec3{sxy, sy, syz}, Vec3{sxz, syz, sz}};
+    Tensor2<3> deformationGradient{Vec3{Fxx, Fyx, Fzx}, Vec3{Fxy, Fyy, Fzy}, Vec3{Fxz, Fyz, Fzz}};
+    double determinant = 0;
+    double approximateMeshWidth = 0;
+    Tensor2<3> inverseDeformationGradient = MathUtility::computeInverse(deformationGradient, approximateMeshWidth, determinant);
+
+    Tensor2<3> deformationGradientCofactor = MathUtility::computeCofactorMatrix<double>(deformationGradient);  // cof(M) = det(M) * M^{-T}
+    Tensor2<3> pk2Stress = inverseDeformationGradient * cauchyStress * deformationGradientCofactor;
+
+    LOG(DEBUG) << "local element " << elementNoLocal << " of " << this->data_.functionSpace()->nElementsLocal() << ", " << FunctionSpace::nNodesPerElement() << " elementNodeNos: " << elementNodeNos;
+
+    LOG(DEBUG) << "F: " << deformationGradient << ", J: " << J << "=" << determinant;
+    LOG(DEBUG) << "pk2Stress = " << pk2Stress << " = " << inverseDeformationGradient << "*" << cauchyStress << "*" << deformationGradientCofactor;
+
+    for (node_no_t elementalNodeNo = 0; elementalNodeNo < FunctionSpace::nNodesPerElement(); elementalNodeNo++)
+    {
+      node_no_t nodeNoLocal = elementNodeNos[elementalNodeNo];
 
-        assert (nodeNoLocal < nSummands.size());
-        nSummands[nodeNoLocal]++;
-      }
-      nElementsLoaded++;
-    }
+      if (nodeNoLocal >= this->data_.functionSpace()->nNodesLocalWithoutGhosts())
+        continue;
 
-    // read next line from file
-    std::getline(fileStress, line);
+      this->data_.pk2Stress()->setValue(nodeNoLocal, std::array<double,6>{pk2Stress[0][0],pk2Stress[1][1],pk2Stress[2][2],pk2Stress[1][0],pk2Stress[2][1],pk2Stress[2][0]}, ADD_VALUES);
+      this->data_.cauchyStress()->setValue(nodeNoLocal, std::array<double,6>{sx,sy,sz,sxy,syz,sxz}, ADD_VALUES);
+      this->data_.greenLagrangeStrain()->setValue(nodeNoLocal, std::array<double,6>{Ex,Ey,Ez,Exy,Eyz,Exz}, ADD_VALUES);
+      this->data_.relativeVolume()->setValue(nodeNoLocal, J, ADD_VALUES);
 
-    // check if file is done
-    if (line.find("*") != std::string::npos || fileStress.eof())
-    {
-      if (nElementsLoaded != data_.functionSpace()->nElementsLocal())
-      {
-        LOG(ERROR) << "Loaded " << nElementsLoaded << " local elements from \"febio3_stress_output.txt\", but " << this->data_.functionSpace()->nElementsLocal() << " were expected.";
-      }
-      break;
+      assert (nodeNoLocal < nSummands.size());
+      nSummands[nodeNoLocal]++;
     }
+    nElementsLoaded++;
+  }
+
+  if (nElementsLoaded != data_.functionSpace()->nElementsLocal())
+  {
+    LOG(ERROR) << "Loaded " << nElementsLoaded << " local elements from the FEBio results, but " << this->data_.functionSpace()->nElementsLocal() << " were expected.";
   }
 
   // divide values at nodes by number of summands
@@ -628,8 +942,6 @@ loadFebioOutputFile()
     this->data_.relativeVolume()->setValue(nodeNoLocal, relativeVolumeValue, INSERT_VALUES);
   }
 
-  fileStress.close();
-
   // update function space
   LOG(DEBUG) << "geometry field has representation "
     << this->data_.functionSpace()->geometryField().partitionedPetscVec()->getCurrentRepresentationString();
@@ -819,6 +1131,9 @@ run()
   initialize();
 
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 void NonlinearElasticitySolverFebio::
@@ -862,6 +1177,8 @@ initialize()
 
 void NonlinearElasticitySolverFebio::reset()
 {
+  stopFebioProcess();
+  this->febioProcessStarted_ = false;
   this->initialized_ = false;
 }
 
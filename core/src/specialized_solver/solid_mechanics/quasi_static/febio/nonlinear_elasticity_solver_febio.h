@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Python.h>  // has to be the first included header
+#include <sys/types.h>
 
 #include "data_management/specialized_solver/quasi_static_nonlinear_elasticity_febio.h"
 #include "slot_connection/slot_connector_data.h"
@@ -16,6 +17,21 @@ namespace TimeSteppingScheme
  *  QuasiStaticNonlinearElasticitySolverFebio class computes the quasi static problem using the febio muscle material in a timestepping scheme.
  *
  *  This class produces febio files that can only be computed by febio3
+ *
+ *  By default, the input file is written, febio3 is run and its output files are parsed in every time step, on rank 0.
+ *  If "persistentProcessCommand" is given, this command is started once on rank 0 with the febio input file as argument
+ *  and the process is kept alive over all time steps. In every time step, the data is exchanged over pipes to stdin and stdout
+ *  of the process, using the native binary representation of int (32 bit) and double values:
+ *
+ *  request, sent to the process:  command (int, 1=solve, 0=exit), endTime (double),
+ *                                 nElements (int), activation values of all global elements (nElements doubles),
+ *                                 nNodes (int), reference positions x,y,z of all global nodes (3*nNodes doubles)
+ *  response, sent by the process: status (int, 0=success),
+ *                                 nNodes (int), x;y;z;ux;uy;uz;Rx;Ry;Rz of all global nodes (9*nNodes doubles),
+ *                                 nElements (int), sx;sy;sz;sxy;syz;sxz;Ex;Ey;Ez;Exy;Eyz;Exz;J;Fxx;Fxy;Fxz;Fyx;Fyy;Fyz;Fzx;Fzy;Fzz of all global elements (22*nElements doubles)
+ *
+ *  The values are the same as in the log files of the file based approach. They are scattered from rank 0 such that each rank receives and stores only the values of its local nodes and elements.
+ *  The process is, e.g., a driver program that keeps the FEBio model in memory, or a stub process for testing. The protocol is also described in doc/sphinx/settings/febio.rst.
  */
 class NonlinearElasticitySolverFebio :
   public Runnable
@@ -29,6 +45,9 @@ public:
   //! constructor
   NonlinearElasticitySolverFebio(DihuContext context, std::string solverName="NonlinearElasticitySolverFebio");
 
+  //! destructor, terminates the persistent febio process if there is one
+  virtual ~NonlinearElasticitySolverFebio();
+
   //! advance simulation by the given time span, data in solution is used, afterwards new data is in solution
   void advanceTimeSpan(bool withOutputWritersEnabled = true);
 
@@ -71,6 +90,25 @@ protected:
   //! run the febio program on the generated input file
   void runFebio();
 
+  //! set the values of the febio simulation in the field variables, the arrays contain for every global node/element the id (1-based) followed by the nFebioNodeValues/nFebioElementValues values
+  void setFebioResults(const std::vector<double> &nodeValues, const std::vector<double> &elementValues);
+
+  //! start the persistent febio process given by persistentProcessCommand_ on rank 0, with the febio input file as argument
+  void startFebioProcess();
+
+  //! send the current activation values and node positions to the persistent febio process, receive the results and set them in the field variables on all ranks,
+  //! if the process fails or sends invalid data, this is a fatal error
+  void exchangeDataWithFebioProcess();
+
+  //! tell the persistent febio process to exit and wait for it
+  void stopFebioProcess();
+
+  //! write the given number of bytes to stdin of the persistent febio process, returns false on error, SIGPIPE is ignored during the write
+  bool writeToFebioProcess(const void *data, std::size_t nBytes);
+
+  //! read the given number of bytes from stdout of the persistent febio process, returns false on error
+  bool readFromFebioProcess(void *data, std::size_t nBytes);
+
   //! communicate elemtal values such as global node nos and activation values to rank 0
   void communicateElementValues(std::vector<double> &activationValuesGlobal, std::vector<int> &nodeNosGlobal);
 
@@ -93,6 +131,15 @@ protected:
   double activationFactor_;                 //< factor with which to multiply activation
   std::vector<double> materialParameters_;  //< the material parameters c0, c1 and k for Mooney-Rivlin material
   
+  std::string persistentProcessCommand_;    //< command of a process that is kept alive over all time steps and communicates via stdin and stdout, empty if febio3 is run on files in every time step
+  bool febioProcessStarted_;                //< if the persistent febio process was already started
+  pid_t febioProcessId_;                    //< process id of the persistent febio process, only set on rank 0
+  int febioProcessInput_;                   //< file descriptor of the pipe to stdin of the persistent febio process
+  int febioProcessOutput_;                  //< file descriptor of the pipe from stdout of the persistent febio process
+
+  static constexpr int nFebioNodeValues = 9;      //< number of values per node in the febio results, x;y;z;ux;uy;uz;Rx;Ry;Rz
+  static constexpr int nFebioElementValues = 22;  //< number of values per element in the febio results, sx;...;Fzz
+
   double endTime_;     //< end time of current time step
   bool initialized_;   //< if initialize() was already called
 };
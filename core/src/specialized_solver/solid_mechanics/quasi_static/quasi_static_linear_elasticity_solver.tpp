@@ -170,6 +170,9 @@ run()
   initialize();
 
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename FiniteElementMethod>
@@ -25,6 +25,9 @@ public:
   //! constructor
   StaticBidomainSolver(DihuContext context);
 
+  //! destructor, destroys the stored Petsc vectors of the initial guess and the electrodes
+  virtual ~StaticBidomainSolver();
+
   //! advance simulation by the given time span, data in solution is used, afterwards new data is in solution
   void advanceTimeSpan(bool withOutputWritersEnabled = true);
 
@@ -64,6 +67,24 @@ protected:
   //! solve the linear system of equations of the implicit scheme with rightHandSide_ and solution_
   void solveLinearSystem();
 
+  //! set the initial guess for the linear solver in the solution vector, according to initialGuessMethod_
+  void computeInitialGuess();
+
+  //! store the current solution for the initial guess of the next solve, either as previous solution or in the projection basis
+  void storeSolutionForInitialGuess();
+
+  //! destroy all stored vectors of previous solutions
+  void clearInitialGuessVectors();
+
+  //! destroy the lead field vectors of the electrodes
+  void clearElectrodeLeadFields();
+
+  //! compute the lead field vectors of the electrodes, one adjoint solve per electrode
+  void initializeElectrodes();
+
+  //! compute the electrode values from the lead fields and Vm and write them to the electrode file
+  void computeElectrodeValues();
+
   //! dump rhs vector
   void debugDumpData();
 
@@ -85,8 +106,23 @@ protected:
   PythonConfig specificSettings_; //< python object containing the value of the python config dict with corresponding key
   double endTime_;                //< end time of current time step
   bool initialGuessNonzero_;      //< if the initial guess for the linear solver is set to the previous solution
+  std::string initialGuessMethod_;  //< how the initial guess is computed, "previous", "extrapolation" or "projection"
+  int nInitialGuessVectors_;        //< number of previous solutions used for "extrapolation" or maximum size of the basis for "projection"
+  bool showLinearSolverOutput_;     //< if the number of iterations of the linear solver should be printed for every solve
+
+  std::vector<Vec> previousSolutions_;           //< for "extrapolation": the last solutions, oldest first
+  std::vector<double> previousSolutionTimes_;    //< for "extrapolation": the times of the solutions in previousSolutions_
+  std::vector<Vec> projectionBasis_;             //< for "projection": basis of previous solutions that is orthonormal w.r.t. the negated system matrix -A
+  std::vector<Vec> projectionBasisImage_;        //< for "projection": the negated system matrix -A times the vectors in projectionBasis_
+
+  std::vector<Vec3> electrodePositions_;         //< positions of the electrodes where the extracellular potential is sampled
+  std::vector<Vec> electrodeLeadFields_;         //< for every electrode the lead field vector, the scalar product with Vm gives the electrode value
+  std::vector<double> electrodeValues_;          //< the current values at the electrodes
+  std::string electrodeFilename_;                //< filename of the csv file to which the electrode values are written
+  bool onlyComputeElectrodes_;                   //< if only the electrode values are computed and the linear system for phi_e is not solved
 };
 
 }  // namespace
 
 #include "specialized_solver/static_bidomain_solver.tpp"
+#include "specialized_solver/static_bidomain_solver_electrodes.tpp"
@@ -28,11 +28,51 @@ StaticBidomainSolver(DihuContext context) :
   }
 
   this->initialGuessNonzero_ = specificSettings_.getOptionBool("initialGuessNonzero", true);
+  this->initialGuessMethod_ = specificSettings_.getOptionString("initialGuessMethod", "previous");
+  this->nInitialGuessVectors_ = specificSettings_.getOptionInt("nInitialGuessVectors", 3, PythonUtility::Positive);
+  this->showLinearSolverOutput_ = specificSettings_.getOptionBool("showLinearSolverOutput", false);
+
+  // electrodes for which the values are computed from lead fields
+  if (specificSettings_.hasKey("electrodePositions"))
+  {
+    PyObject *electrodePositionsPy = specificSettings_.getOptionPyObject("electrodePositions");
+    electrodePositions_ = PythonUtility::convertFromPython<std::vector<Vec3>>::get(electrodePositionsPy);
+  }
+  this->electrodeFilename_ = specificSettings_.getOptionString("electrodeFilename", "out/electrodes.csv");
+  this->onlyComputeElectrodes_ = specificSettings_.getOptionBool("onlyComputeElectrodes", false);
+
+  if (onlyComputeElectrodes_ && electrodePositions_.empty())
+  {
+    LOG(WARNING) << "StaticBidomainSolver: \"onlyComputeElectrodes\" is set, but no \"electrodePositions\" are given. The extracellular potential will be computed.";
+    onlyComputeElectrodes_ = false;
+  }
+
+  if (initialGuessMethod_ != "previous" && initialGuessMethod_ != "extrapolation" && initialGuessMethod_ != "projection")
+  {
+    LOG(ERROR) << "StaticBidomainSolver has invalid \"initialGuessMethod\": \"" << initialGuessMethod_
+      << "\". Valid options are \"previous\", \"extrapolation\" or \"projection\". Now using \"previous\".";
+    initialGuessMethod_ = "previous";
+  }
+
+  // extrapolation is done by a polynomial of degree at most 2
+  if (initialGuessMethod_ == "extrapolation" && nInitialGuessVectors_ > 3)
+  {
+    LOG(WARNING) << "StaticBidomainSolver: \"nInitialGuessVectors\" is " << nInitialGuessVectors_ << ", but at most 3 solutions are used for \"extrapolation\".";
+    nInitialGuessVectors_ = 3;
+  }
 
   // initialize output writers
   this->outputWriterManager_.initialize(this->context_, this->specificSettings_);
 }
 
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+~StaticBidomainSolver()
+{
+  clearInitialGuessVectors();
+  clearElectrodeLeadFields();
+}
+
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
 void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
 advanceTimeSpan(bool withOutputWritersEnabled)
@@ -49,12 +89,19 @@ advanceTimeSpan(bool withOutputWritersEnabled)
     => K(sigma_i+sigma_e) phi_e = -K(sigma_i) Vm
    */
 
-  // update right hand side: transmembraneFlow = -K(sigma_i) Vm
-  PetscErrorCode ierr;
-  ierr = MatMult(data_.rhsMatrix(), data_.transmembranePotential()->valuesGlobal(), data_.transmembraneFlow()->valuesGlobal()); CHKERRV(ierr);
+  // if only the electrode values are needed, the system does not have to be solved
+  if (!onlyComputeElectrodes_)
+  {
+    // update right hand side: transmembraneFlow = -K(sigma_i) Vm
+    PetscErrorCode ierr;
+    ierr = MatMult(data_.rhsMatrix(), data_.transmembranePotential()->valuesGlobal(), data_.transmembraneFlow()->valuesGlobal()); CHKERRV(ierr);
 
-  // solve K(sigma_i+sigma_e) phi_e = transmembraneFlow for phi_e
-  this->solveLinearSystem();
+    // solve K(sigma_i+sigma_e) phi_e = transmembraneFlow for phi_e
+    this->solveLinearSystem();
+  }
+
+  // compute the values at the electrodes as scalar products of the lead fields with Vm
+  this->computeElectrodeValues();
 
   // stop duration measurement
   if (this->durationLogKey_ != "")
@@ -73,6 +120,9 @@ run()
   initialize();
 
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
@@ -203,6 +253,10 @@ initialize()
   MatSetNearNullSpace(systemMatrix, constantFunctions); // for multigrid methods
   MatNullSpaceDestroy(&constantFunctions);
 
+  // compute the lead fields of the electrodes
+  if (!electrodePositions_.empty())
+    initializeElectrodes();
+
   // set the slotConnectorData for the solverStructureVisualizer to appear in the solver diagram
   DihuContext::solverStructureVisualizer()->setSlotConnectorData(getSlotConnectorData());
 
@@ -215,6 +269,10 @@ void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDi
 reset()
 {
   this->initialized_ = false;
+
+  // the system matrix will be recreated, then the previous solutions and lead fields are no longer useful
+  clearInitialGuessVectors();
+  clearElectrodeLeadFields();
 }
 
 //! call the output writer on the data object, output files will contain currentTime, with callCountIncrement !=1 output timesteps can be skipped
@@ -233,7 +291,7 @@ solveLinearSystem()
   VLOG(1) << "in solveLinearSystem";
 
   // configure that the initial value for the iterative solver is the value in solution, not zero
-  if (initialGuessNonzero_)
+  if (initialGuessNonzero_ || initialGuessMethod_ != "previous")
   {
     PetscErrorCode ierr;
     ierr = KSPSetInitialGuessNonzero(*this->linearSolver_->ksp(), PETSC_TRUE); CHKERRV(ierr);
@@ -249,12 +307,187 @@ solveLinearSystem()
   // dump vectors to be able to later check values
   //debugDumpData();
 
+  // compute the initial guess from the previous solutions
+  computeInitialGuess();
+
   // solve the system, KSPSolve(ksp,b,x)
+  std::string message;
 #ifndef NDEBUG
-  this->linearSolver_->solve(rightHandSide, solution, "Linear system of bidomain problem solved");
-#else
-  this->linearSolver_->solve(rightHandSide, solution);
+  message = "Linear system of bidomain problem solved";
 #endif
+  if (showLinearSolverOutput_)
+  {
+    message = std::string("Linear system of bidomain problem (initial guess: ") + initialGuessMethod_ + ") solved";
+  }
+
+  this->linearSolver_->solve(rightHandSide, solution, message);
+
+  // store the solution to be used for the initial guess of the next solve
+  storeSolutionForInitialGuess();
+}
+
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+computeInitialGuess()
+{
+  Vec rightHandSide = data_.transmembraneFlow()->valuesGlobal();
+  Vec solution = data_.extraCellularPotential()->valuesGlobal();
+  PetscErrorCode ierr;
+
+  if (initialGuessMethod_ == "extrapolation")
+  {
+    const int nPreviousSolutions = previousSolutions_.size();
+
+    // the solution vector already contains the last solution, only extrapolate if there are more solutions at distinct times
+    if (nPreviousSolutions < 2)
+      return;
+
+    // compute the weights of the Lagrange polynomials through the previous solutions, evaluated at the current time
+    std::vector<double> weights(nPreviousSolutions, 1.0);
+    for (int i = 0; i < nPreviousSolutions; i++)
+    {
+      for (int j = 0; j < nPreviousSolutions; j++)
+      {
+        if (i == j)
+          continue;
+
+        double timeDifference = previousSolutionTimes_[i] - previousSolutionTimes_[j];
+        if (fabs(timeDifference) < 1e-12)
+        {
+          VLOG(1) << "previous solutions are at the same time, use last solution as initial guess";
+          return;
+        }
+        weights[i] *= (endTime_ - previousSolutionTimes_[j]) / timeDifference;
+      }
+    }
+
+    VLOG(1) << "extrapolate initial guess at t=" << endTime_ << " from times " << previousSolutionTimes_ << ", weights: " << weights;
+
+    ierr = VecSet(solution, 0.0); CHKERRV(ierr);
+    ierr = VecMAXPY(solution, nPreviousSolutions, weights.data(), previousSolutions_.data()); CHKERRV(ierr);
+  }
+  else if (initialGuessMethod_ == "projection")
+  {
+    // The initial guess is the projection of the solution onto the span of the previous solutions, i.e.,
+    // the best approximation in the norm induced by the system matrix, see Fischer, "Projection techniques for iterative solution of Ax=b with successive right-hand sides" (1998).
+    // The stiffness matrix A is assembled with negative sign and is negative semidefinite, therefore the norm is induced by -A and the system is -Ax = -b.
+    // Because the basis is orthonormal w.r.t. -A, the coefficients are the scalar products of the basis vectors with -b.
+    const int nBasisVectors = projectionBasis_.size();
+    if (nBasisVectors == 0)
+      return;
+
+    std::vector<double> coefficients(nBasisVectors);
+    ierr = VecMDot(rightHandSide, nBasisVectors, projectionBasis_.data(), coefficients.data()); CHKERRV(ierr);
+
+    for (double &coefficient : coefficients)
+      coefficient *= -1;
+
+    ierr = VecSet(solution, 0.0); CHKERRV(ierr);
+    ierr = VecMAXPY(solution, nBasisVectors, coefficients.data(), projectionBasis_.data()); CHKERRV(ierr);
+
+    VLOG(1) << "projected initial guess onto " << nBasisVectors << " basis vectors, coefficients: " << coefficients;
+  }
+}
+
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+storeSolutionForInitialGuess()
+{
+  Vec solution = data_.extraCellularPotential()->valuesGlobal();
+  PetscErrorCode ierr;
+
+  if (initialGuessMethod_ == "extrapolation")
+  {
+    // reuse the vector of the oldest solution if the maximum number of solutions is stored
+    Vec previousSolution;
+    if (previousSolutions_.size() == nInitialGuessVectors_)
+    {
+      previousSolution = previousSolutions_.front();
+      previousSolutions_.erase(previousSolutions_.begin());
+      previousSolutionTimes_.erase(previousSolutionTimes_.begin());
+    }
+    else
+    {
+      ierr = VecDuplicate(solution, &previousSolution); CHKERRV(ierr);
+    }
+
+    ierr = VecCopy(solution, previousSolution); CHKERRV(ierr);
+    previousSolutions_.push_back(previousSolution);
+    previousSolutionTimes_.push_back(endTime_);
+  }
+  else if (initialGuessMethod_ == "projection")
+  {
+    Mat systemMatrix = finiteElementMethodDiffusionExtracellular_.data().stiffnessMatrix()->valuesGlobal();
+
+    // if the basis is full, restart with only the current solution
+    if (projectionBasis_.size() == nInitialGuessVectors_)
+    {
+      VLOG(1) << "projection basis is full, restart";
+      clearInitialGuessVectors();
+    }
+
+    Vec basisVector;
+    Vec basisVectorImage;
+    ierr = VecDuplicate(solution, &basisVector); CHKERRV(ierr);
+    ierr = VecDuplicate(solution, &basisVectorImage); CHKERRV(ierr);
+
+    // orthogonalize the solution against the basis w.r.t. the positive semidefinite matrix -A (Gram-Schmidt), also update the image under -A
+    ierr = VecCopy(solution, basisVector); CHKERRV(ierr);
+    ierr = MatMult(systemMatrix, basisVector, basisVectorImage); CHKERRV(ierr);
+    ierr = VecScale(basisVectorImage, -1.0); CHKERRV(ierr);
+
+    double normBefore = 0;
+    ierr = VecDot(basisVector, basisVectorImage, &normBefore); CHKERRV(ierr);
+
+    const int nBasisVectors = projectionBasis_.size();
+    if (nBasisVectors > 0)
+    {
+      std::vector<double> coefficients(nBasisVectors);
+      ierr = VecMDot(basisVectorImage, nBasisVectors, projectionBasis_.data(), coefficients.data()); CHKERRV(ierr);
+
+      for (double &coefficient : coefficients)
+        coefficient *= -1;
+
+      ierr = VecMAXPY(basisVector, nBasisVectors, coefficients.data(), projectionBasis_.data()); CHKERRV(ierr);
+      ierr = VecMAXPY(basisVectorImage, nBasisVectors, coefficients.data(), projectionBasisImage_.data()); CHKERRV(ierr);
+    }
+
+    // normalize, the vector is not added if it is (almost) linearly dependent on the basis
+    double norm = 0;
+    ierr = VecDot(basisVector, basisVectorImage, &norm); CHKERRV(ierr);
+
+    if (norm <= 1e-12*normBefore || norm <= 0)
+    {
+      VLOG(1) << "solution is already contained in the projection basis";
+      VecDestroy(&basisVector);
+      VecDestroy(&basisVectorImage);
+      return;
+    }
+
+    norm = sqrt(norm);
+    ierr = VecScale(basisVector, 1./norm); CHKERRV(ierr);
+    ierr = VecScale(basisVectorImage, 1./norm); CHKERRV(ierr);
+
+    projectionBasis_.push_back(basisVector);
+    projectionBasisImage_.push_back(basisVectorImage);
+  }
+}
+
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+clearInitialGuessVectors()
+{
+  for (Vec &vector : previousSolutions_)
+    VecDestroy(&vector);
+  for (Vec &vector : projectionBasis_)
+    VecDestroy(&vector);
+  for (Vec &vector : projectionBasisImage_)
+    VecDestroy(&vector);
+
+  previousSolutions_.clear();
+  previousSolutionTimes_.clear();
+  projectionBasis_.clear();
+  projectionBasisImage_.clear();
 }
 
 //! return whether the underlying discretizableInTime object has a specified mesh type and is not independent of the mesh type
@@ -0,0 +1,157 @@
+#include "specialized_solver/static_bidomain_solver.h"
+
+#include <limits>
+
+#include "utility/mpi_utility.h"
+#include "output_writer/output_surface/output_points.h"
+
+namespace TimeSteppingScheme
+{
+
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+initializeElectrodes()
+{
+  LOG_SCOPE_FUNCTION;
+
+  /* The electrode value at point p is the interpolated extracellular potential, e_p^T phi_e, where e_p contains the values of the basis functions at p.
+   * With the system matrix A = K(sigma_i+sigma_e) and the right hand side matrix R = -K(sigma_i), it holds phi_e = A^{-1} R Vm and therefore
+   *   e_p^T phi_e = (R^T A^{-T} e_p)^T Vm = l_p^T Vm
+   * with the lead field vector l_p = R^T z_p, where A^T z_p = e_p. This needs one (adjoint) solve per electrode.
+   * Because A is singular with the constant functions as nullspace, e_p is projected to have zero mean, then the electrode values
+   * correspond to the solution phi_e with zero mean. Differences between electrodes are not affected by this.
+   */
+  std::shared_ptr<FunctionSpace> functionSpace = data_.functionSpace();
+  const int nDofsPerElement = FunctionSpace::nDofsPerElement();
+  const int nElectrodes = electrodePositions_.size();
+  int ownRankNo = rankSubset_->ownRankNo();
+  PetscErrorCode ierr;
+
+  Vec solution = data_.extraCellularPotential()->valuesGlobal();
+
+  Vec interpolationVector;
+  Vec adjointSolution;
+  ierr = VecDuplicate(solution, &interpolationVector); CHKERRV(ierr);
+  ierr = VecDuplicate(solution, &adjointSolution); CHKERRV(ierr);
+
+  PetscInt nDofsGlobal = 0;
+  ierr = VecGetSize(solution, &nDofsGlobal); CHKERRV(ierr);
+
+  // destroy lead fields of a previous initialization
+  clearElectrodeLeadFields();
+  electrodeLeadFields_.resize(nElectrodes);
+  electrodeValues_.resize(nElectrodes);
+
+  for (int electrodeNo = 0; electrodeNo < nElectrodes; electrodeNo++)
+  {
+    Vec3 point = electrodePositions_[electrodeNo];
+
+    // find the electrode position in the local elements
+    element_no_t elementNoLocal = 0;
+    int ghostMeshNo = -1;
+    std::array<double,FunctionSpace::dim()> xi;
+    double residual = 0;
+    bool searchedAllElements = false;
+
+    bool pointFound = functionSpace->findPosition(point, elementNoLocal, ghostMeshNo, xi, false, residual, searchedAllElements);
+
+    // if the point is found on multiple ranks, e.g., on a partition boundary, the rank with the smallest residual sets the interpolation weights
+    struct
+    {
+      double residual;
+      int rankNo;
+    } localResult, globalResult;
+    localResult.residual = (pointFound && ghostMeshNo == -1)? residual : std::numeric_limits<double>::max();
+    localResult.rankNo = ownRankNo;
+
+    MPIUtility::handleReturnValue(MPI_Allreduce(&localResult, &globalResult, 1, MPI_DOUBLE_INT, MPI_MINLOC, rankSubset_->mpiCommunicator()), "MPI_Allreduce");
+
+    if (globalResult.residual == std::numeric_limits<double>::max())
+    {
+      LOG(WARNING) << "StaticBidomainSolver: Electrode no. " << electrodeNo << " at " << point << " is not inside the mesh. Its value will be 0.";
+    }
+
+    // set the values of the basis functions at the electrode position
+    ierr = VecSet(interpolationVector, 0.0); CHKERRV(ierr);
+    if (globalResult.rankNo == ownRankNo && globalResult.residual != std::numeric_limits<double>::max())
+    {
+      std::array<dof_no_t,nDofsPerElement> dofNosLocal = functionSpace->getElementDofNosLocal(elementNoLocal);
+      for (int dofIndex = 0; dofIndex < nDofsPerElement; dofIndex++)
+      {
+        PetscInt dofNoGlobalPetsc = functionSpace->meshPartition()->getDofNoGlobalPetsc(dofNosLocal[dofIndex]);
+        double value = FunctionSpace::phi(dofIndex, xi);
+        ierr = VecSetValue(interpolationVector, dofNoGlobalPetsc, value, ADD_VALUES); CHKERRV(ierr);
+      }
+      LOG(DEBUG) << "electrode " << electrodeNo << " found in element " << elementNoLocal << ", xi: " << xi;
+    }
+    ierr = VecAssemblyBegin(interpolationVector); CHKERRV(ierr);
+    ierr = VecAssemblyEnd(interpolationVector); CHKERRV(ierr);
+
+    // remove the component in the nullspace of the matrix, i.e., subtract the mean value
+    double sum = 0;
+    ierr = VecSum(interpolationVector, &sum); CHKERRV(ierr);
+    ierr = VecShift(interpolationVector, -sum/nDofsGlobal); CHKERRV(ierr);
+
+    // solve A^T z = e, the system matrix is symmetric
+    ierr = VecSet(adjointSolution, 0.0); CHKERRV(ierr);
+    std::stringstream message;
+    message << "Adjoint system for electrode " << electrodeNo << " solved";
+    this->linearSolver_->solve(interpolationVector, adjointSolution, showLinearSolverOutput_? message.str() : "");
+
+    // compute the lead field l = R^T z
+    ierr = VecDuplicate(solution, &electrodeLeadFields_[electrodeNo]); CHKERRV(ierr);
+    ierr = MatMultTranspose(data_.rhsMatrix(), adjointSolution, electrodeLeadFields_[electrodeNo]); CHKERRV(ierr);
+  }
+
+  VecDestroy(&interpolationVector);
+  VecDestroy(&adjointSolution);
+
+  // create the electrode file with its header, the values of every solve are appended in computeElectrodeValues
+  if (ownRankNo == 0)
+  {
+    std::vector<double> geometry;
+    for (const Vec3 &position : electrodePositions_)
+      geometry.insert(geometry.end(), position.begin(), position.end());
+
+    OutputWriter::OutputPoints::writeCsvHeader(electrodeFilename_, geometry, true, false);
+  }
+
+  LOG(INFO) << "StaticBidomainSolver: computed lead fields for " << nElectrodes << " electrodes.";
+}
+
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+computeElectrodeValues()
+{
+  const int nElectrodes = electrodeLeadFields_.size();
+  if (nElectrodes == 0)
+    return;
+
+  // the electrode values are the scalar products of the lead fields with Vm
+  Vec transmembranePotential = data_.transmembranePotential()->valuesGlobal();
+  PetscErrorCode ierr;
+  ierr = VecMDot(transmembranePotential, nElectrodes, electrodeLeadFields_.data(), electrodeValues_.data()); CHKERRV(ierr);
+
+  VLOG(1) << "electrode values at t=" << endTime_ << ": " << electrodeValues_;
+
+  // write the values to the csv file, all ranks have the values, only rank 0 writes
+  if (rankSubset_->ownRankNo() == 0)
+  {
+    std::vector<double> geometry;
+    for (const Vec3 &position : electrodePositions_)
+      geometry.insert(geometry.end(), position.begin(), position.end());
+
+    OutputWriter::OutputPoints::writeCsvFile(electrodeFilename_, endTime_, geometry, electrodeValues_, false, false);
+  }
+}
+
+template<typename FiniteElementMethodPotentialFlow,typename FiniteElementMethodDiffusion>
+void StaticBidomainSolver<FiniteElementMethodPotentialFlow,FiniteElementMethodDiffusion>::
+clearElectrodeLeadFields()
+{
+  for (Vec &vector : electrodeLeadFields_)
+    VecDestroy(&vector);
+  electrodeLeadFields_.clear();
+}
+
+}  // namespace TimeSteppingScheme
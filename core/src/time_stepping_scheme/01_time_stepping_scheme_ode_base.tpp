@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "utility/python_utility.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace TimeSteppingScheme
 {
@@ -114,6 +115,9 @@ run()
 
   // do simulations
   this->advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 //! call the output writer on the data object, output files will contain currentTime, with callCountIncrement !=1 output timesteps can be skipped
@@ -5,6 +5,7 @@
 
 #include "utility/python_utility.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace TimeSteppingScheme
 {
@@ -85,6 +86,9 @@ run()
 {
   initialize();
   advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 //! call the output writer on the data object, output files will contain currentTime, with callCountIncrement !=1 output timesteps can be skipped
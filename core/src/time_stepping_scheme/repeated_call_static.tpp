@@ -5,6 +5,7 @@
 
 #include "utility/python_utility.h"
 #include "control/diagnostic_tool/solver_structure_visualizer.h"
+#include "output_writer/asynchronous_file_writer.h"
 
 namespace TimeSteppingScheme
 {
@@ -59,6 +60,9 @@ run()
 {
   initialize();
   advanceTimeSpan();
+
+  // wait until all output files that are written asynchronously are on disk
+  OutputWriter::AsynchronousFileWriter::instance().finish();
 }
 
 template<typename Solver>
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+#
+# Functions to parse binary point time series files, e.g. the EMG files written by OutputSurface with "enableBinaryFile": True
+# usage as script: point_time_series_reader.py <filename>
+#
+
+import sys
+import struct
+import numpy as np
+
+def parse_file(filename):
+  """
+    parse a point time series file that was written by OutputWriter::PointTimeSeriesWriter
+    :param filename: the name of the *.bin file
+    :return: a list of segments, one for every points block in the file (usually only one). Each segment is a dict with the keys
+      "positions": numpy array of shape (n_points,3), "names": list of the point names,
+      "times": numpy array of shape (n_samples,), "values": numpy array of shape (n_samples,n_points)
+  """
+
+  with open(filename, "rb") as f:
+    data = f.read()
+
+  if data[0:8] != b"DIHUPTS\0":
+    print("Error: File \"{}\" is not a point time series file.".format(filename))
+    return []
+
+  version = struct.unpack_from("<i", data, 8)[0]
+  if version != 1:
+    print("Warning: File \"{}\" has version {}, expected 1.".format(filename, version))
+
+  offset = 12
+  segments = []
+  n_points = 0
+  samples = []
+
+  while offset < len(data):
+    block_type = data[offset:offset+1]
+    offset += 1
+
+    if block_type == b"P":
+      # points block
+      n_points = struct.unpack_from("<i", data, offset)[0]
+      offset += 4
+      positions = np.frombuffer(data, dtype="<f8", count=3*n_points, offset=offset).reshape(n_points,3)
+      offset += 3*n_points*8
+
+      names = []
+      for point_no in range(n_points):
+        length = struct.unpack_from("<i", data, offset)[0]
+        offset += 4
+        names.append(data[offset:offset+length].decode("utf-8"))
+        offset += length
+
+      samples = []
+      segments.append({"positions": positions, "names": names, "samples": samples})
+
+    elif block_type == b"S":
+      # samples block, every sample is (time, values)
+      n_samples = struct.unpack_from("<i", data, offset)[0]
+      offset += 4
+      count = n_samples*(1+n_points)
+      samples.append(np.frombuffer(data, dtype="<f8", count=count, offset=offset).reshape(n_samples,1+n_points))
+      offset += count*8
+
+    else:
+      print("Error: Unknown block type {} at offset {} in file \"{}\".".format(block_type, offset-1, filename))
+      break
+
+  # combine all samples blocks of a segment
+  for segment in segments:
+    n_points = len(segment["names"])
+    samples = segment.pop("samples")
+    if samples:
+      samples = np.concatenate(samples)
+    else:
+      samples = np.zeros((0,1+n_points))
+    segment["times"] = samples[:,0]
+    segment["values"] = samples[:,1:]
+
+  return segments
+
+if __name__ == "__main__":
+  if len(sys.argv) < 2:
+    print("usage: {} <filename>".format(sys.argv[0]))
+    sys.exit(0)
+
+  segments = parse_file(sys.argv[1])
+  for segment_no,segment in enumerate(segments):
+    times = segment["times"]
+    print("segment {}: {} points, {} samples".format(segment_no, len(segment["names"]), len(times)))
+    if len(times) > 0:
+      print("  t in [{},{}], values in [{},{}]".format(times[0], times[-1], np.min(segment["values"]), np.max(segment["values"])))
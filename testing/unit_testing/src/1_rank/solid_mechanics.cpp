@@ -12,6 +12,272 @@
 #include "stiffness_matrix_tester.h"
 #include "node_positions_tester.h"
 
+namespace
+{
+
+// create the python config for a small Mooney-Rivlin problem with traction on the top face, solverOptions are appended to the HyperelasticitySolver settings and override the defaults
+std::string hyperelasticityConfig(std::string solverOptions)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+nx = 2
+ny = 2
+nz = 3
+mx = 2*nx + 1
+my = 2*ny + 1
+
+# fix the bottom face in z direction, the left edge in x direction and the front edge in y direction
+dirichlet_bc = {}
+for j in range(my):
+  for i in range(mx):
+    dirichlet_bc[j*mx + i] = [None, None, 0]
+for j in range(my):
+  dirichlet_bc[j*mx][0] = 0
+for i in range(mx):
+  dirichlet_bc[i][1] = 0
+
+neumann_bc = [{"element": (nz-1)*nx*ny + j*nx + i, "constantVector": [0,0,5], "face": "2+"} for j in range(ny) for i in range(nx)]
+
+config = {
+  "HyperelasticitySolver": {
+    "materialParameters":         [10, 10],
+    "displacementsScalingFactor": 1.0,
+    "constantBodyForce":          [0.0, 0.0, 0.0],
+    "residualNormLogFilename":    "log_residual_norm.txt",
+    "dumpDenseMatlabVariables":   False,
+
+    # mesh
+    "nElements":         [nx, ny, nz],
+    "inputMeshIsGlobal": True,
+    "physicalExtent":    [1, 1, 1.5],
+    "physicalOffset":    [0, 0, 0],
+
+    # nonlinear solver
+    "relativeTolerance":  1e-10,
+    "absoluteTolerance":  1e-10,
+    "solverType":         "gmres",
+    "preconditionerType": "lu",
+    "maxIterations":      1e4,
+    "dumpFilename":       "",
+    "dumpFormat":         "matlab",
+    "snesMaxFunctionEvaluations": 1e8,
+    "snesMaxIterations":          50,
+    "snesRelativeTolerance":      1e-10,
+    "snesAbsoluteTolerance":      1e-10,
+    "snesLineSearchType":         "l2",
+    "snesRebuildJacobianFrequency": 1,
+    "loadFactors":                [],
+    "nNonlinearSolveCalls":       1,
+
+    # boundary conditions
+    "dirichletBoundaryConditions": dirichlet_bc,
+    "neumannBoundaryConditions":   neumann_bc,
+    "divideNeumannBoundaryConditionValuesByTotalArea": False,
+    "updateDirichletBoundaryConditionsFunction": None,
+    "updateDirichletBoundaryConditionsFunctionCallInterval": 1,
+
+    "OutputWriter":   [],
+    "pressure":       None,
+    "LoadIncrements": None,
+    )" << solverOptions << R"(
+  },
+}
+)";
+  return pythonConfig.str();
+}
+
+// counts of the work done by the hyperelasticity solver
+struct SolverStatistics
+{
+  int nNonlinearIterations = 0;    //< total number of nonlinear iterations
+  int nJacobianComputations = 0;   //< number of computations of the jacobian, lower than nNonlinearIterations if the jacobian is lagged
+  int nResidualEvaluations = 0;    //< number of evaluations of the nonlinear function, including the ones for the finite differences jacobian
+  int nReusedElementJacobians = 0; //< number of element chunks whose jacobian contributions were reused because of jacobianReassemblyTolerance
+  bool jacobianMatrixAssembled = true;  //< if the jacobian matrix was created, this is false for the matrix-free jacobian without assembled preconditioner
+};
+
+// solve the hyperelasticity problem with the given solver options and return the displacements
+std::vector<Vec3> solveHyperelasticity(std::string solverOptions, SolverStatistics *statistics = nullptr)
+{
+  DihuContext settings(argc, argv, hyperelasticityConfig(solverOptions));
+
+  SpatialDiscretization::HyperelasticitySolver<> problem(settings);
+  problem.run();
+
+  if (statistics)
+  {
+    statistics->nNonlinearIterations = problem.nNonlinearIterationsTotal();
+    statistics->nJacobianComputations = problem.nJacobianComputationsTotal();
+    statistics->nResidualEvaluations = problem.nResidualEvaluationsTotal();
+    statistics->nReusedElementJacobians = problem.nReusedElementJacobiansTotal();
+    statistics->jacobianMatrixAssembled = problem.jacobianMatrix() != PETSC_NULL;
+  }
+
+  std::vector<Vec3> displacements;
+  problem.data().displacements()->getValuesWithoutGhosts(displacements);
+  return displacements;
+}
+
+// solve the hyperelasticity problem with the given solver options, then evaluate the residual and the analytic jacobian at the solution
+// in the same order as the nonlinear solver does, return the dense entries of the jacobian and the displacements
+std::vector<Vec3> computeHyperelasticityJacobian(std::string solverOptions, std::vector<double> &jacobianValues)
+{
+  DihuContext settings(argc, argv, hyperelasticityConfig(solverOptions));
+
+  SpatialDiscretization::HyperelasticitySolver<> problem(settings);
+  problem.run();
+
+  Vec x = problem.currentState();
+  problem.evaluateNonlinearFunction(x, problem.combinedVecResidual()->valuesGlobal());
+  problem.evaluateAnalyticJacobian(x, problem.jacobianMatrix());
+  PetscUtility::getMatrixEntries(problem.jacobianMatrix(), jacobianValues);
+
+  std::vector<Vec3> displacements;
+  problem.data().displacements()->getValuesWithoutGhosts(displacements);
+  return displacements;
+}
+
+// check that the displacements are equal to the reference displacements, which have to be deformed at all, otherwise the comparison is meaningless
+void expectEqualDisplacements(const std::vector<Vec3> &displacementsReference, const std::vector<Vec3> &displacements, double tolerance = 1e-6)
+{
+  ASSERT_EQ(displacementsReference.size(), displacements.size());
+  EXPECT_GT(fabs(displacementsReference.back()[2]), 1e-3);
+
+  for (int i = 0; i < displacementsReference.size(); i++)
+  {
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      EXPECT_NEAR(displacementsReference[i][componentNo], displacements[i][componentNo], tolerance);
+    }
+  }
+}
+
+// solve the hyperelasticity problem with the given solver options and compute the total forces at the bottom and top faces,
+// also return the z displacement of the top face
+void computeHyperelasticityBearingForces(std::string solverOptions, Vec3 &bearingForceBottom, Vec3 &bearingForceTop, double &topDisplacement)
+{
+  DihuContext settings(argc, argv, hyperelasticityConfig(solverOptions));
+
+  SpatialDiscretization::HyperelasticitySolver<> problem(settings);
+  problem.run();
+
+  // the 2x2 bottom elements and the 2x2 top elements of the 2x2x3 mesh
+  std::vector<std::tuple<element_no_t,bool>> bottomTopElements;
+  for (element_no_t elementNo = 0; elementNo < 4; elementNo++)
+  {
+    bottomTopElements.push_back(std::make_tuple(elementNo, false));
+    bottomTopElements.push_back(std::make_tuple(8 + elementNo, true));
+  }
+
+  Vec3 bearingMomentBottom;
+  Vec3 bearingMomentTop;
+  problem.computeBearingForceAndMoment(bottomTopElements, bearingForceBottom, bearingMomentBottom, bearingForceTop, bearingMomentTop);
+
+  std::vector<Vec3> displacements;
+  problem.data().displacements()->getValuesWithoutGhosts(displacements);
+  topDisplacement = displacements.back()[2];
+}
+
+// solve a short dynamic problem of a compressible Saint Venant-Kirchhoff material with traction on the top face and return the displacements
+std::vector<Vec3> solveDynamicHyperelasticity(std::string timeIntegrationScheme)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+nx = 1
+ny = 1
+nz = 2
+mx = 2*nx + 1
+my = 2*ny + 1
+mz = 2*nz + 1
+
+# fix the bottom face in z direction, the left edge in x direction and the front edge in y direction, the velocities are not prescribed
+dirichlet_bc = {}
+for j in range(my):
+  for i in range(mx):
+    dirichlet_bc[j*mx + i] = [None, None, 0, None, None, None]
+for j in range(my):
+  dirichlet_bc[j*mx][0] = 0
+for i in range(mx):
+  dirichlet_bc[i][1] = 0
+
+neumann_bc = [{"element": (nz-1)*nx*ny + j*nx + i, "constantVector": [0,0,5], "face": "2+"} for j in range(ny) for i in range(nx)]
+
+config = {
+  "DynamicHyperelasticitySolver": {
+    "timeStepWidth":              1e-4,
+    "endTime":                    0.02,
+    "timeStepOutputInterval":     100,
+    "durationLogKey":             "duration_mechanics",
+
+    "materialParameters":         [100, 50],
+    "density":                    1.0,
+    "displacementsScalingFactor": 1.0,
+    "residualNormLogFilename":    "log_residual_norm.txt",
+    "useAnalyticJacobian":        True,
+    "useNumericJacobian":         False,
+    "dumpDenseMatlabVariables":   False,
+
+    # mesh
+    "nElements":         [nx, ny, nz],
+    "inputMeshIsGlobal": True,
+    "physicalExtent":    [1, 1, 2],
+    "physicalOffset":    [0, 0, 0],
+
+    # nonlinear solver
+    "relativeTolerance":  1e-10,
+    "absoluteTolerance":  1e-10,
+    "solverType":         "preonly",
+    "preconditionerType": "lu",
+    "maxIterations":      1e4,
+    "dumpFilename":       "",
+    "dumpFormat":         "matlab",
+    "snesMaxFunctionEvaluations": 1e8,
+    "snesMaxIterations":          50,
+    "snesRelativeTolerance":      1e-10,
+    "snesAbsoluteTolerance":      1e-10,
+    "snesLineSearchType":         "l2",
+    "snesRebuildJacobianFrequency": 1,
+    "loadFactors":                [],
+    "loadFactorGiveUpThreshold":  1e-3,
+    "nNonlinearSolveCalls":       1,
+
+    # boundary and initial conditions
+    "dirichletBoundaryConditions": dirichlet_bc,
+    "neumannBoundaryConditions":   neumann_bc,
+    "divideNeumannBoundaryConditionValuesByTotalArea": False,
+    "updateDirichletBoundaryConditionsFunction": None,
+    "updateDirichletBoundaryConditionsFunctionCallInterval": 1,
+    "updateNeumannBoundaryConditionsFunction": None,
+    "updateNeumannBoundaryConditionsFunctionCallInterval": 1,
+    "initialValuesDisplacements":  [[0.0,0.0,0.0] for _ in range(mx*my*mz)],
+    "initialValuesVelocities":     [[0.0,0.0,0.0] for _ in range(mx*my*mz)],
+    "extrapolateInitialGuess":     True,
+    "constantBodyForce":           [0.0, 0.0, 0.0],
+    "timeIntegrationScheme":       ")" << timeIntegrationScheme << R"(",
+
+    "dirichletOutputFilename":     None,
+    "totalForceLogFilename":       "",
+
+    "OutputWriter":   [],
+    "pressure":       None,
+    "dynamic":        None,
+    "LoadIncrements": None,
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig.str());
+
+  TimeSteppingScheme::DynamicHyperelasticitySolver<Equation::SolidMechanics::SaintVenantKirchhoff> problem(settings);
+  problem.run();
+
+  std::vector<Vec3> displacements;
+  problem.hyperelasticitySolver().data().displacements()->getValuesWithoutGhosts(displacements);
+  return displacements;
+}
+
+}  // namespace
+
 TEST(SolidMechanicsTest, Test3DLinearElasticity)
 {
   std::string pythonConfig = R"(
@@ -674,3 +940,515 @@ config = {
 
   ASSERT_LE(error_rms, 1e-4);
 }
+
+TEST(SolidMechanicsTest, TestFEBioPersistentProcess)
+{
+  // check the data exchange with a persistent process via stdin and stdout,
+  // instead of febio a stub process is used that returns the displacements u = (0, 0, 0.1*t*Z) for the t-th request
+  std::ofstream stubFile("febio_stub.py");
+  stubFile << R"(
+import sys, struct
+stdin = sys.stdin.buffer
+stdout = sys.stdout.buffer
+
+def read(format):
+  return struct.unpack(format, stdin.read(struct.calcsize(format)))
+
+step = 0
+while True:
+  command, = read("i")
+  if command == 0:
+    break
+  step += 1
+  end_time, = read("d")
+  n_elements, = read("i")
+  activation = read("{}d".format(n_elements))
+  n_nodes, = read("i")
+  positions = read("{}d".format(3*n_nodes))
+
+  node_values = []
+  for i in range(n_nodes):
+    X = positions[3*i:3*i+3]
+    u = [0, 0, 0.1*step*X[2]]
+    node_values += [X[0]+u[0], X[1]+u[1], X[2]+u[2]] + u + [0, 0, 0]
+
+  # sx;sy;sz;sxy;syz;sxz;Ex;Ey;Ez;Exy;Eyz;Exz;J;Fxx;Fxy;Fxz;Fyx;Fyy;Fyz;Fzx;Fzy;Fzz
+  element_values = ([0]*12 + [1] + [1,0,0, 0,1,0, 0,0,1]) * n_elements
+
+  stdout.write(struct.pack("ii", 0, n_nodes))
+  stdout.write(struct.pack("{}d".format(len(node_values)), *node_values))
+  stdout.write(struct.pack("i", n_elements))
+  stdout.write(struct.pack("{}d".format(len(element_values)), *element_values))
+  stdout.flush()
+)";
+  stubFile.close();
+
+  std::string pythonConfig = R"(
+
+# number of elements
+nx = 2
+ny = 2
+nz = 5
+
+config = {
+  "NonlinearElasticitySolverFebio": {
+    "persistentProcessCommand": "python3 febio_stub.py",   # process that is started once and exchanges data via stdin and stdout
+    "force": 10,
+    "materialParameters": [10, 10, 1e6],
+    "tractionElementNos": [(nz-1)*nx*ny + j*nx + i for j in range(ny) for i in range(nx)],
+    "tractionVector": [0,0,10],
+    "dirichletBoundaryConditionsMode": "fix_floating",
+
+    # mesh
+    "nElements": [nx, ny, nz],
+    "inputMeshIsGlobal": True,
+    "physicalExtent": [2, 2, 5],
+    "physicalOffset": [0, 0, 0],
+    "OutputWriter" : [],
+  },
+}
+
+)";
+  DihuContext settings(argc, argv, pythonConfig);
+
+  TimeSteppingScheme::NonlinearElasticitySolverFebio problem(settings);
+
+  // first request
+  problem.run();
+
+  // second request to the same process
+  problem.setTimeSpan(0, 1);
+  problem.advanceTimeSpan();
+
+  std::vector<Vec3> referenceGeometry;
+  std::vector<Vec3> displacements;
+  problem.data().referenceGeometry()->getValuesWithoutGhosts(referenceGeometry);
+  problem.data().displacements()->getValuesWithoutGhosts(displacements);
+
+  ASSERT_EQ(displacements.size(), 54);
+  for (int i = 0; i < displacements.size(); i++)
+  {
+    EXPECT_NEAR(displacements[i][0], 0.0, 1e-12);
+    EXPECT_NEAR(displacements[i][2], 0.2*referenceGeometry[i][2], 1e-12);
+  }
+
+  problem.reset();
+}
+
+TEST(SolidMechanicsTest, ColoredNumericJacobianMatchesAnalyticJacobian)
+{
+  // the numeric jacobian computed with a coloring of the nonzero structure has to yield the same solution as the analytic jacobian
+  std::vector<Vec3> displacementsAnalytic = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,)");
+
+  SolverStatistics statisticsColored;
+  std::vector<Vec3> displacementsColored = solveHyperelasticity(R"(
+    "useAnalyticJacobian": False,
+    "useNumericJacobian": True,
+    "useColoringForNumericJacobian": True,)", &statisticsColored);
+
+  SolverStatistics statisticsUncolored;
+  std::vector<Vec3> displacementsUncolored = solveHyperelasticity(R"(
+    "useAnalyticJacobian": False,
+    "useNumericJacobian": True,
+    "useColoringForNumericJacobian": False,)", &statisticsUncolored);
+
+  // the combined mode uses the numeric jacobian as operator and the analytic jacobian for the preconditioner
+  std::vector<Vec3> displacementsCombined = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": True,
+    "useColoringForNumericJacobian": True,)");
+
+  expectEqualDisplacements(displacementsAnalytic, displacementsColored);
+  expectEqualDisplacements(displacementsAnalytic, displacementsUncolored);
+  expectEqualDisplacements(displacementsAnalytic, displacementsCombined);
+
+  // without coloring, every unknown is perturbed separately, with coloring only one evaluation per color is needed
+  LOG(INFO) << "residual evaluations with coloring: " << statisticsColored.nResidualEvaluations << " for " << statisticsColored.nJacobianComputations
+    << " jacobians, without coloring: " << statisticsUncolored.nResidualEvaluations << " for " << statisticsUncolored.nJacobianComputations << " jacobians";
+  ASSERT_GT(statisticsColored.nJacobianComputations, 0);
+  ASSERT_GT(statisticsUncolored.nJacobianComputations, 0);
+  EXPECT_LT(statisticsColored.nResidualEvaluations / statisticsColored.nJacobianComputations,
+            statisticsUncolored.nResidualEvaluations / statisticsUncolored.nJacobianComputations);
+}
+
+TEST(SolidMechanicsTest, MatrixFreeJacobianMatchesAnalyticJacobian)
+{
+  // the jacobian applied element by element without assembling it has to yield the same solution as the assembled analytic jacobian
+  std::vector<Vec3> displacementsAnalytic = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,)");
+
+  std::vector<Vec3> displacementsMatrixFree = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "useMatrixFreeJacobian": True,
+    "matrixFreePreconditionerType": "assembled",)");
+
+  // the default block preconditioner and the jacobi preconditioner never assemble a matrix
+  SolverStatistics statisticsBlock;
+  std::vector<Vec3> displacementsMatrixFreeBlock = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "useMatrixFreeJacobian": True,
+    "preconditionerType": "jacobi",)", &statisticsBlock);
+
+  SolverStatistics statisticsJacobi;
+  std::vector<Vec3> displacementsMatrixFreeJacobi = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "useMatrixFreeJacobian": True,
+    "matrixFreePreconditionerType": "jacobi",
+    "preconditionerType": "jacobi",)", &statisticsJacobi);
+
+  EXPECT_FALSE(statisticsBlock.jacobianMatrixAssembled);
+  EXPECT_FALSE(statisticsJacobi.jacobianMatrixAssembled);
+
+  expectEqualDisplacements(displacementsAnalytic, displacementsMatrixFree);
+  expectEqualDisplacements(displacementsAnalytic, displacementsMatrixFreeBlock);
+  expectEqualDisplacements(displacementsAnalytic, displacementsMatrixFreeJacobi);
+}
+
+TEST(SolidMechanicsTest, CachedQuadraturePointValuesGiveSameJacobian)
+{
+  // the jacobian computed from the quadrature point values of the preceding residual evaluation has to be identical
+  // to the jacobian that is computed from scratch
+  std::vector<double> jacobianValues;
+  std::vector<Vec3> displacements = computeHyperelasticityJacobian(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "cacheQuadraturePointValues": False,)", jacobianValues);
+
+  std::vector<double> jacobianValuesCached;
+  std::vector<Vec3> displacementsCached = computeHyperelasticityJacobian(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "cacheQuadraturePointValues": True,)", jacobianValuesCached);
+
+  expectEqualDisplacements(displacements, displacementsCached, 1e-12);
+
+  ASSERT_EQ(jacobianValues.size(), jacobianValuesCached.size());
+  for (int i = 0; i < jacobianValues.size(); i++)
+  {
+    EXPECT_NEAR(jacobianValues[i], jacobianValuesCached[i], 1e-12*std::max(1.0, fabs(jacobianValues[i]))) << "entry " << i;
+  }
+}
+
+TEST(SolidMechanicsTest, JacobianReassemblyToleranceReusesElements)
+{
+  // the element contributions of the jacobian are reused when the element state changed less than the tolerance,
+  // this must not change the solution, only the convergence of the nonlinear solver
+  SolverStatistics statisticsNoTolerance;
+  std::vector<Vec3> displacementsReference = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "jacobianReassemblyTolerance": 0,)", &statisticsNoTolerance);
+
+  SolverStatistics statisticsTolerance;
+  std::vector<Vec3> displacementsTolerance = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "jacobianReassemblyTolerance": 1e-3,)", &statisticsTolerance);
+
+  LOG(INFO) << "reused element jacobians: " << statisticsTolerance.nReusedElementJacobians << " in "
+    << statisticsTolerance.nJacobianComputations << " jacobian computations";
+  EXPECT_EQ(statisticsNoTolerance.nReusedElementJacobians, 0);
+  EXPECT_GT(statisticsTolerance.nReusedElementJacobians, 0);
+
+  expectEqualDisplacements(displacementsReference, displacementsTolerance);
+}
+
+TEST(SolidMechanicsTest, AdaptiveLoadSteppingMatchesSingleLoadStep)
+{
+  // the load factors chosen adaptively with extrapolated initial guesses have to yield the same solution as a single load step,
+  // and the extrapolation has to reduce the number of nonlinear iterations
+  std::vector<Vec3> displacementsSingleStep = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,)");
+
+  SolverStatistics statisticsAdaptive;
+  std::vector<Vec3> displacementsAdaptive = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "loadFactors": [0.1],
+    "adaptiveLoadStepping": True,
+    "adaptiveLoadSteppingNIterations": 3,
+    "extrapolateLoadStepInitialGuess": True,)", &statisticsAdaptive);
+
+  // without the extrapolated initial guess, the load steps need more iterations and are therefore also smaller
+  SolverStatistics statisticsAdaptiveWithoutExtrapolation;
+  solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "loadFactors": [0.1],
+    "adaptiveLoadStepping": True,
+    "adaptiveLoadSteppingNIterations": 3,
+    "extrapolateLoadStepInitialGuess": False,)", &statisticsAdaptiveWithoutExtrapolation);
+
+  LOG(INFO) << "nonlinear iterations with extrapolation: " << statisticsAdaptive.nNonlinearIterations
+    << ", without: " << statisticsAdaptiveWithoutExtrapolation.nNonlinearIterations;
+  EXPECT_GT(statisticsAdaptive.nNonlinearIterations, 0);
+  EXPECT_LT(statisticsAdaptive.nNonlinearIterations, statisticsAdaptiveWithoutExtrapolation.nNonlinearIterations);
+
+  expectEqualDisplacements(displacementsSingleStep, displacementsAdaptive);
+}
+
+TEST(SolidMechanicsTest, JacobianLagPersistsAcrossNonlinearSolves)
+{
+  // with a lag that is larger than the number of iterations, the jacobian is computed once at the beginning of every load step,
+  // unless the lag persists across the nonlinear solves of the load steps, then it is only computed once in total
+  std::vector<Vec3> displacementsSingleStep = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,)");
+
+  SolverStatistics statisticsPersisting;
+  std::vector<Vec3> displacementsPersisting = solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "loadFactors": [0.5, 1.0],
+    "snesRebuildJacobianFrequency": 100,
+    "snesRebuildFrequencyPersists": True,)", &statisticsPersisting);
+
+  SolverStatistics statisticsNotPersisting;
+  solveHyperelasticity(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "loadFactors": [0.5, 1.0],
+    "snesRebuildJacobianFrequency": 100,
+    "snesRebuildFrequencyPersists": False,)", &statisticsNotPersisting);
+
+  EXPECT_EQ(statisticsPersisting.nJacobianComputations, 1);
+  EXPECT_GE(statisticsNotPersisting.nJacobianComputations, 2);
+
+  // the solution with the reused jacobian has to be the same
+  expectEqualDisplacements(displacementsSingleStep, displacementsPersisting);
+}
+
+TEST(SolidMechanicsTest, ExplicitTimeIntegrationMatchesImplicitTimeIntegration)
+{
+  // the explicit central difference scheme with lumped mass matrix and the implicit scheme have to give similar displacements for small time steps,
+  // they are not equal because the schemes and the mass matrices differ
+  std::vector<Vec3> displacementsImplicit = solveDynamicHyperelasticity("implicit");
+  std::vector<Vec3> displacementsExplicit = solveDynamicHyperelasticity("explicit");
+
+  ASSERT_EQ(displacementsImplicit.size(), displacementsExplicit.size());
+
+  // the body has to be deformed at all, otherwise the comparison is meaningless
+  double maximumDisplacement = 0;
+  for (int i = 0; i < displacementsImplicit.size(); i++)
+  {
+    maximumDisplacement = std::max(maximumDisplacement, fabs(displacementsImplicit[i][2]));
+  }
+  EXPECT_GT(maximumDisplacement, 1e-4);
+
+  for (int i = 0; i < displacementsImplicit.size(); i++)
+  {
+    for (int componentNo = 0; componentNo < 3; componentNo++)
+    {
+      EXPECT_NEAR(displacementsImplicit[i][componentNo], displacementsExplicit[i][componentNo], 0.1*maximumDisplacement);
+    }
+  }
+}
+
+TEST(SolidMechanicsTest, BearingForcesMatchAppliedTraction)
+{
+  // the traction on the top face yields a homogeneous uniaxial deformation with stretch λ in z direction,
+  // the material traction S N0 on the top and bottom faces is then the applied traction divided by λ
+  Vec3 bearingForceBottom, bearingForceTop;
+  double topDisplacement;
+  computeHyperelasticityBearingForces(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,)", bearingForceBottom, bearingForceTop, topDisplacement);
+
+  // the same forces have to be computed if the stress fields are only computed for the bearing forces
+  Vec3 bearingForceBottomDeferred, bearingForceTopDeferred;
+  double topDisplacementDeferred;
+  computeHyperelasticityBearingForces(R"(
+    "useAnalyticJacobian": True,
+    "useNumericJacobian": False,
+    "deferStressFieldComputation": True,)", bearingForceBottomDeferred, bearingForceTopDeferred, topDisplacementDeferred);
+
+  EXPECT_GT(topDisplacement, 1e-3);
+  const double stretch = 1 + topDisplacement / 1.5;
+  const double totalForce = 5.0 / stretch;
+
+  for (int componentNo = 0; componentNo < 3; componentNo++)
+  {
+    double expectedForce = (componentNo == 2? totalForce : 0.0);
+    EXPECT_NEAR(fabs(bearingForceTop[componentNo]), expectedForce, 1e-6);
+    EXPECT_NEAR(bearingForceBottom[componentNo], -bearingForceTop[componentNo], 1e-6);
+
+    EXPECT_NEAR(bearingForceTop[componentNo], bearingForceTopDeferred[componentNo], 1e-12);
+    EXPECT_NEAR(bearingForceBottom[componentNo], bearingForceBottomDeferred[componentNo], 1e-12);
+  }
+}
+
+TEST(SolidMechanicsTest, ActiveStressAndLambdaMatchScalarComputation)
+{
+  // the active stress and λ are computed for several dofs at once, compare them to the computation for every single dof
+  std::string pythonConfig = R"(
+nx = 2
+ny = 1
+nz = 1
+mx = 2*nx + 1
+my = 2*ny + 1
+
+# fix the bottom face in z direction, the left edge in x direction and the front edge in y direction
+dirichlet_bc = {}
+for j in range(my):
+  for i in range(mx):
+    dirichlet_bc[j*mx + i] = [None, None, 0]
+for j in range(my):
+  dirichlet_bc[j*mx][0] = 0
+for i in range(mx):
+  dirichlet_bc[i][1] = 0
+
+config = {
+  "MuscleContractionSolver": {
+    "numberTimeSteps":           1,
+    "endTime":                   1.0,
+    "timeStepOutputInterval":    100,
+    "Pmax":                      1.0,
+    "enableForceLengthRelation": True,
+    "lambdaDotScalingFactor":    1.0,
+    "slotNames":                 [],
+    "OutputWriter":              [],
+    "mapGeometryToMeshes":       [],
+    "dynamic":                   False,
+
+    "HyperelasticitySolver": {
+      "materialParameters":         [10, 10, 1, 1],
+      "displacementsScalingFactor": 1.0,
+      "constantBodyForce":          [0.0, 0.0, 0.0],
+      "residualNormLogFilename":    "log_residual_norm.txt",
+      "useAnalyticJacobian":        True,
+      "useNumericJacobian":         False,
+      "dumpDenseMatlabVariables":   False,
+
+      # mesh
+      "nElements":         [nx, ny, nz],
+      "inputMeshIsGlobal": True,
+      "physicalExtent":    [2, 1, 1],
+      "physicalOffset":    [0, 0, 0],
+      "fiberMeshNames":    [],
+      "fiberDirection":    [0, 0.6, 0.8],
+
+      # nonlinear solver
+      "relativeTolerance":  1e-10,
+      "absoluteTolerance":  1e-10,
+      "solverType":         "gmres",
+      "preconditionerType": "lu",
+      "maxIterations":      1e4,
+      "dumpFilename":       "",
+      "dumpFormat":         "matlab",
+      "snesMaxFunctionEvaluations": 1e8,
+      "snesMaxIterations":          50,
+      "snesRelativeTolerance":      1e-10,
+      "snesAbsoluteTolerance":      1e-10,
+      "snesLineSearchType":         "l2",
+      "snesRebuildJacobianFrequency": 1,
+      "loadFactors":                [],
+      "nNonlinearSolveCalls":       1,
+
+      # boundary conditions
+      "dirichletBoundaryConditions": dirichlet_bc,
+      "neumannBoundaryConditions":   [],
+      "divideNeumannBoundaryConditionValuesByTotalArea": False,
+      "updateDirichletBoundaryConditionsFunction": None,
+      "updateDirichletBoundaryConditionsFunctionCallInterval": 1,
+
+      "OutputWriter":   [],
+      "pressure":       None,
+      "LoadIncrements": None,
+    },
+  },
+}
+)";
+
+  DihuContext settings(argc, argv, pythonConfig);
+
+  MuscleContractionSolver<> problem(settings);
+  problem.initialize();
+
+  // set λ and γ, such that the force-length relation is evaluated inside and outside of its range and the active stress is zero for λ=0,
+  // the number of dofs (45) is not a multiple of the vector size
+  const dof_no_t nDofsLocalWithoutGhosts = problem.data().functionSpace()->nDofsLocalWithoutGhosts();
+  std::vector<double> lambdaValues(nDofsLocalWithoutGhosts);
+  std::vector<double> gammaValues(nDofsLocalWithoutGhosts);
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+  {
+    lambdaValues[dofNoLocal] = 0.1*(dofNoLocal % 17);
+    gammaValues[dofNoLocal] = 0.1*(dofNoLocal % 7);
+  }
+
+  problem.data().lambda()->setValuesWithoutGhosts(lambdaValues);
+  problem.data().lambda()->zeroGhostBuffer();
+  problem.data().lambda()->finishGhostManipulation();
+  problem.data().lambda()->startGhostManipulation();
+
+  problem.data().gamma()->setValuesWithoutGhosts(gammaValues);
+  problem.data().gamma()->zeroGhostBuffer();
+  problem.data().gamma()->finishGhostManipulation();
+  problem.data().gamma()->startGhostManipulation();
+
+  // compute the active stress from λ and γ, solve and compute the new λ
+  problem.advanceTimeSpan(false);
+
+  std::shared_ptr<MuscleContractionSolver<>::StaticHyperelasticitySolverType> hyperelasticitySolver = problem.staticHyperelasticitySolver();
+
+  std::vector<Vec3> fiberDirections;
+  std::vector<std::array<double,6>> activeStresses;
+  std::vector<std::array<double,9>> deformationGradients;
+  std::vector<double> lambdaValuesNew;
+  hyperelasticitySolver->data().fiberDirection()->getValuesWithoutGhosts(fiberDirections);
+  hyperelasticitySolver->data().activePK2Stress()->getValuesWithoutGhosts(activeStresses);
+  hyperelasticitySolver->data().deformationGradient()->getValuesWithoutGhosts(deformationGradients);
+  problem.data().lambda()->getValuesWithoutGhosts(lambdaValuesNew);
+
+  ASSERT_EQ(activeStresses.size(), nDofsLocalWithoutGhosts);
+
+  const double lambdaOpt = 1.2;
+  const double pmax = 1.0;
+  for (dof_no_t dofNoLocal = 0; dofNoLocal < nDofsLocalWithoutGhosts; dofNoLocal++)
+  {
+    // active stress from the given λ and γ
+    const Vec3 &fiberDirection = fiberDirections[dofNoLocal];
+    const double lambda = lambdaValues[dofNoLocal];
+    const double lambdaRelative = lambda / lambdaOpt;
+
+    double f = 1.0;
+    if (0.6 <= lambdaRelative && lambdaRelative <= 1.4)
+      f = -25./4 * lambdaRelative*lambdaRelative + 25./2 * lambdaRelative - 5.25;
+
+    double factor = 0.0;
+    if (fabs(lambda) >= 1e-12)
+      factor = 1./lambda * pmax * f * gammaValues[dofNoLocal];
+
+    std::array<double,6> activeStressReference = {
+      factor * fiberDirection[0] * fiberDirection[0],
+      factor * fiberDirection[1] * fiberDirection[1],
+      factor * fiberDirection[2] * fiberDirection[2],
+      factor * fiberDirection[0] * fiberDirection[1],
+      factor * fiberDirection[1] * fiberDirection[2],
+      factor * fiberDirection[0] * fiberDirection[2]
+    };
+
+    for (int i = 0; i < 6; i++)
+    {
+      EXPECT_NEAR(activeStresses[dofNoLocal][i], activeStressReference[i], 1e-10) << "dof " << dofNoLocal << ", component " << i;
+    }
+
+    // λ = ||F a0|| after the solve, F is stored in row-major order
+    Vec3 fiberDirectionCurrentConfiguration = {0,0,0};
+    for (int i = 0; i < 3; i++)
+    {
+      for (int j = 0; j < 3; j++)
+      {
+        fiberDirectionCurrentConfiguration[i] += deformationGradients[dofNoLocal][i*3+j] * fiberDirection[j];
+      }
+    }
+    const double lambdaReference = MathUtility::norm<3>(fiberDirectionCurrentConfiguration);
+    EXPECT_NEAR(lambdaValuesNew[dofNoLocal], lambdaReference, 1e-10) << "dof " << dofNoLocal;
+  }
+}
@@ -0,0 +1,177 @@
+#include <Python.h>  // this has to be the first included header
+
+#include <iostream>
+#include <cstdlib>
+#include <fstream>
+#include <cassert>
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "opendihu.h"
+#include "../utility.h"
+#include "arg.h"
+
+namespace
+{
+
+typedef TimeSteppingScheme::StaticBidomainSolver<
+  SpatialDiscretization::FiniteElementMethod<       // FEM for initial potential flow, fiber directions
+    Mesh::StructuredDeformableOfDimension<3>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<3>,
+    Equation::Static::Laplace
+  >,
+  SpatialDiscretization::FiniteElementMethod<       // anisotropic diffusion
+    Mesh::StructuredDeformableOfDimension<3>,
+    BasisFunction::LagrangeOfOrder<1>,
+    Quadrature::Gauss<3>,
+    Equation::Dynamic::DirectionalDiffusion
+  >
+> StaticBidomainSolverType;
+
+// create the python config for the static bidomain solver with the given initial guess method and linear solver name
+std::string staticBidomainConfig(std::string initialGuessMethod, std::string solverName)
+{
+  std::stringstream pythonConfig;
+  pythonConfig << R"(
+nx = 8
+ny = 4
+nz = 4
+
+# potential flow from bottom to top, this gives fiber directions in z direction
+potential_flow_dirichlet_bc = {}
+for j in range(ny+1):
+  for i in range(nx+1):
+    potential_flow_dirichlet_bc[j*(nx+1) + i] = 0.0
+    potential_flow_dirichlet_bc[nz*(nx+1)*(ny+1) + j*(nx+1) + i] = 1.0
+
+initial_guess_method = ")" << initialGuessMethod << R"("
+solver_name = ")" << solverName << R"("
+
+config = {
+  "Meshes": {
+    "3Dmesh": {
+      "nElements": [nx, ny, nz],
+      "physicalExtent": [2.0, 1.0, 1.0],
+      "inputMeshIsGlobal": True,
+    },
+  },
+  "Solvers": {
+    "potentialFlowSolver": {
+      "relativeTolerance":  1e-10,
+      "absoluteTolerance":  1e-10,
+      "maxIterations":      1e4,
+      "solverType":         "gmres",
+      "preconditionerType": "none",
+      "dumpFilename":       "",
+      "dumpFormat":         "matlab",
+    },
+    solver_name: {
+      "relativeTolerance":  1e-10,
+      "absoluteTolerance":  1e-15,
+      "maxIterations":      1e4,
+      "solverType":         "cg",
+      "preconditionerType": "none",
+      "dumpFilename":       "",
+      "dumpFormat":         "matlab",
+    },
+  },
+  "StaticBidomainSolver": {
+    "timeStepWidth":          0.1,
+    "solverName":             solver_name,
+    "initialGuessNonzero":    True,
+    "initialGuessMethod":     initial_guess_method,
+    "nInitialGuessVectors":   5,
+    "slotNames":              [],
+    "PotentialFlow": {
+      "FiniteElementMethod" : {
+        "meshName":           "3Dmesh",
+        "solverName":         "potentialFlowSolver",
+        "prefactor":          1.0,
+        "dirichletBoundaryConditions": potential_flow_dirichlet_bc,
+        "dirichletOutputFilename":     None,
+        "neumannBoundaryConditions":   [],
+        "inputMeshIsGlobal":  True,
+        "slotName":           "",
+      },
+    },
+    "Activation": {
+      "FiniteElementMethod" : {
+        "meshName":           "3Dmesh",
+        "solverName":         solver_name,
+        "prefactor":          1.0,
+        "inputMeshIsGlobal":  True,
+        "dirichletBoundaryConditions": {},
+        "dirichletOutputFilename":     None,
+        "neumannBoundaryConditions":   [],
+        "slotName":           "",
+        "diffusionTensor": [[
+          8.93, 0, 0,
+          0, 0.893, 0,
+          0, 0, 0.893
+        ]],
+        "extracellularDiffusionTensor": [[
+          6.7, 0, 0,
+          0, 6.7, 0,
+          0, 0, 6.7,
+        ]],
+      },
+    },
+    "OutputWriter" : [],
+  },
+}
+)";
+  return pythonConfig.str();
+}
+
+// solve the static bidomain problem for a sequence of transmembrane potentials with a moving peak, return the total number of linear solver iterations
+int solveStaticBidomainSequence(StaticBidomainSolverType &problem, std::string solverName)
+{
+  problem.initialize();
+
+  std::vector<Vec3> geometryValues;
+  problem.data().transmembranePotential()->functionSpace()->geometryField().getValuesWithoutGhosts(geometryValues);
+
+  const int nSolves = 10;
+  int nIterationsTotal = 0;
+  for (int solveNo = 0; solveNo < nSolves; solveNo++)
+  {
+    // Vm is a peak that moves along the z axis
+    const double peakPosition = 0.2 + 0.05*solveNo;
+    std::vector<double> vmValues(geometryValues.size());
+    for (int i = 0; i < geometryValues.size(); i++)
+    {
+      const double distance = geometryValues[i][2] - peakPosition;
+      vmValues[i] = -80.0 + 100.0*exp(-distance*distance/0.02);
+    }
+    problem.data().transmembranePotential()->setValuesWithoutGhosts(vmValues);
+
+    problem.setTimeSpan(solveNo*0.1, (solveNo+1)*0.1);
+    problem.advanceTimeSpan(false);
+
+    std::string nIterations = Control::PerformanceMeasurement::getParameter(std::string("nIterations_") + solverName);
+    EXPECT_FALSE(nIterations.empty());
+    if (!nIterations.empty())
+      nIterationsTotal += std::stoi(nIterations);
+  }
+  return nIterationsTotal;
+}
+
+}  // namespace
+
+// the projection of the solution onto the previous solutions should give a better initial guess than the previous solution itself
+TEST(StaticBidomainTest, ProjectionInitialGuessNeedsFewerIterations)
+{
+  DihuContext settingsPrevious(argc, argv, staticBidomainConfig("previous", "bidomainSolverPrevious"));
+  StaticBidomainSolverType problemPrevious(settingsPrevious);
+  int nIterationsPrevious = solveStaticBidomainSequence(problemPrevious, "bidomainSolverPrevious");
+
+  DihuContext settingsProjection(argc, argv, staticBidomainConfig("projection", "bidomainSolverProjection"));
+  StaticBidomainSolverType problemProjection(settingsProjection);
+  int nIterationsProjection = solveStaticBidomainSequence(problemProjection, "bidomainSolverProjection");
+
+  LOG(INFO) << "total number of iterations, previous: " << nIterationsPrevious << ", projection: " << nIterationsProjection;
+
+  EXPECT_GT(nIterationsPrevious, 0);
+  EXPECT_LT(nIterationsProjection, nIterationsPrevious);
+}
@@ -46,6 +46,9 @@ EASYLOGGINGPP_DOWNLOAD = True
 # ADIOS2, adaptable I/O library, needed for interfacing MegaMol
 ADIOS_DOWNLOAD = True
 
+# HDF5, parallel I/O library, needed for the "HDF5" output writer, optional
+HDF5_DOWNLOAD = False
+
 # MegaMol, visualization framework of VISUS, optional, needs ADIOS2
 MEGAMOL_DOWNLOAD = False    # install MegaMol from official git repo, but needed is the private repo, ask Tobias Rau for access to use MegaMol with opendihu
 